@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file    agent-config.c
+ * @date    17 Oct 2026
+ * @brief   Runtime configuration of Machine Learning agent daemon
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ */
+
+#include <errno.h>
+#include <glib.h>
+
+#include "agent-config.h"
+#include "log.h"
+
+static struct agent_config g_agent_config = {
+  .buffer_pool_limit = 0,
+  .pipeline_fusion = FALSE,
+  .model_store = NULL,
+  .model_prefetch_budget = 0,
+  .compress_inactive = FALSE,
+  .model_cache_budget = 0,
+  .model_store_quota = 0,
+  .model_resident_budget = 0,
+  .model_resident_lock = FALSE,
+  .model_artifact_cache = NULL,
+  .model_artifact_quota = 0,
+  .io_queue_depth = 0,
+  .resource_prefetch = FALSE,
+  .idle_exit_timeout = 0,
+};
+
+static GOptionEntry g_agent_config_entries[] = {
+  { "buffer-pool-limit", 0, 0, G_OPTION_ARG_INT64, &g_agent_config.buffer_pool_limit,
+      "Share buffer memory among launched pipelines, capped at the given size in bytes (0: disabled)", "BYTES" },
+  { "enable-pipeline-fusion", 0, 0, G_OPTION_ARG_NONE, &g_agent_config.pipeline_fusion,
+      "Fuse the launched live pipelines sharing a common source prefix into one pipeline", NULL },
+  { "model-store", 0, 0, G_OPTION_ARG_FILENAME, &g_agent_config.model_store,
+      "Keep the registered model files in the content-addressed store at the given directory", "DIR" },
+  { "model-prefetch-budget", 0, 0, G_OPTION_ARG_INT64, &g_agent_config.model_prefetch_budget,
+      "Read ahead the activated model files into the page cache, up to the given size in bytes (0: disabled)", "BYTES" },
+  { "compress-inactive-models", 0, 0, G_OPTION_ARG_NONE, &g_agent_config.compress_inactive,
+      "Compress the inactive model versions in the model store", NULL },
+  { "model-cache-budget", 0, 0, G_OPTION_ARG_INT64, &g_agent_config.model_cache_budget,
+      "Keep the decompressed copies of the inactive model versions up to the given size in bytes (0: only the latest one)", "BYTES" },
+  { "model-store-quota", 0, 0, G_OPTION_ARG_INT64, &g_agent_config.model_store_quota,
+      "Evict the least recently used inactive model versions when the model store exceeds the given size in bytes (0: disable)", "BYTES" },
+  { "model-resident-budget", 0, 0, G_OPTION_ARG_INT64, &g_agent_config.model_resident_budget,
+      "Keep the recently served model files mapped up to the given size in bytes (0: disable). It cannot be used with the idle exit", "BYTES" },
+  { "model-resident-lock", 0, 0, G_OPTION_ARG_NONE, &g_agent_config.model_resident_lock,
+      "Lock the pages of the resident model files in the memory", NULL },
+  { "model-artifact-cache", 0, 0, G_OPTION_ARG_FILENAME, &g_agent_config.model_artifact_cache,
+      "Keep the compiled artifacts of the model backends at the given directory, given to the pipelines with @artifact_cache:MODEL:BACKEND[:OPTIONS]@", "DIR" },
+  { "model-artifact-quota", 0, 0, G_OPTION_ARG_INT64, &g_agent_config.model_artifact_quota,
+      "Remove the least recently used compiled artifacts when the artifact cache exceeds the given size in bytes (0: disable)", "BYTES" },
+  { "io-queue-depth", 0, 0, G_OPTION_ARG_INT, &g_agent_config.io_queue_depth,
+      "Keep up to the given number of the I/O operations in flight to hash, copy and prefetch the model files (0: default)", "N" },
+  { "prefetch-resources", 0, 0, G_OPTION_ARG_NONE, &g_agent_config.resource_prefetch,
+      "Read ahead the resource files into the page cache when they are registered", NULL },
+  { "idle-exit-timeout", 0, 0, G_OPTION_ARG_INT, &g_agent_config.idle_exit_timeout,
+      "Exit after the given seconds without the method calls and the running jobs, to be activated again on demand (0: disable). It cannot be used with the resident model files", "SECONDS" },
+  { NULL }
+};
+
+/**
+ * @brief Get the command line option entries for the runtime options.
+ */
+GOptionEntry *
+agent_config_get_option_entries (void)
+{
+  return g_agent_config_entries;
+}
+
+/**
+ * @brief Get the runtime options of the daemon.
+ */
+const struct agent_config *
+agent_config_get (void)
+{
+  return &g_agent_config;
+}
+
+/**
+ * @brief Check the runtime options given by the command line.
+ */
+int
+agent_config_validate (void)
+{
+  if (g_agent_config.idle_exit_timeout < 0) {
+    ml_loge ("The idle exit timeout should not be negative.");
+    return -EINVAL;
+  }
+
+  /* The resident model files are mapped by the daemon, so they are dropped whenever the daemon exits on idle. */
+  if (g_agent_config.idle_exit_timeout > 0 && g_agent_config.model_resident_budget > 0) {
+    ml_loge ("The idle exit cannot be used with the resident model files, the mapped files are released at the exit.");
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Release the runtime options and reset them to the default values.
+ */
+void
+agent_config_reset (void)
+{
+  g_agent_config.buffer_pool_limit = 0;
+  g_agent_config.pipeline_fusion = FALSE;
+  g_free (g_agent_config.model_store);
+  g_agent_config.model_store = NULL;
+  g_agent_config.model_prefetch_budget = 0;
+  g_agent_config.compress_inactive = FALSE;
+  g_agent_config.model_cache_budget = 0;
+  g_agent_config.model_store_quota = 0;
+  g_agent_config.model_resident_budget = 0;
+  g_agent_config.model_resident_lock = FALSE;
+  g_free (g_agent_config.model_artifact_cache);
+  g_agent_config.model_artifact_cache = NULL;
+  g_agent_config.model_artifact_quota = 0;
+  g_agent_config.io_queue_depth = 0;
+  g_agent_config.resource_prefetch = FALSE;
+  g_agent_config.idle_exit_timeout = 0;
+}
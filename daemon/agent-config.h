@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    agent-config.h
+ * @date    17 Oct 2026
+ * @brief   Internal header for the runtime configuration of Machine Learning agent daemon
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    This provides the runtime options of the daemon, which are filled by the command line parser.
+ */
+#ifndef __AGENT_CONFIG_H__
+#define __AGENT_CONFIG_H__
+
+#include <glib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Data structure for the runtime options of the Machine Learning agent daemon.
+ */
+struct agent_config
+{
+  gint64 buffer_pool_limit; /**< Global memory cap in bytes of the shared buffer allocator for launched pipelines. 0 disables it. */
+  gboolean pipeline_fusion; /**< Fuse the launched pipelines sharing a common source prefix into one pipeline. */
+  gchar *model_store; /**< Directory of the content-addressed store for the registered model files. NULL disables it. */
+  gint64 model_prefetch_budget; /**< Total size in bytes of the activated model files read ahead into the page cache. 0 disables it. */
+  gboolean compress_inactive; /**< Compress the blobs of the inactive model versions in the model store. */
+  gint64 model_cache_budget; /**< Total size in bytes of the decompressed copies of the inactive model versions. */
+  gint64 model_resident_budget; /**< Total size in bytes of the model files kept mapped by the daemon to be served as the file descriptors. 0 disables it. It cannot be used with the idle exit. */
+  gboolean model_resident_lock; /**< Lock the pages of the resident model files in the memory. */
+  gint64 model_store_quota; /**< Disk quota in bytes of the model store. The least recently used inactive versions are evicted over it. 0 disables it. */
+  gchar *model_artifact_cache; /**< Directory of the compiled artifacts of the model backends, given to the pipelines. NULL disables it. */
+  gint64 model_artifact_quota; /**< Disk quota in bytes of the artifact cache. The least recently used artifacts are removed over it. 0 disables it. */
+  gint io_queue_depth; /**< Maximum number of the operations in flight of the bulk I/O engine for the model files. 0 for the default. */
+  gboolean resource_prefetch; /**< Validate and read ahead the resource file into the page cache when it is registered. */
+  gint idle_exit_timeout; /**< Seconds without the method calls and the running jobs, after which the daemon exits until the next activation. 0 disables it. It cannot be used with the resident model files. */
+};
+
+/**
+ * @brief Get the command line option entries for the runtime options.
+ * @return The NULL-terminated array of option entries. Do not free it.
+ */
+GOptionEntry *agent_config_get_option_entries (void);
+
+/**
+ * @brief Get the runtime options of the daemon.
+ * @return The runtime options. Do not free it.
+ */
+const struct agent_config *agent_config_get (void);
+
+/**
+ * @brief Check the runtime options given by the command line.
+ * @return @c 0 on success. -EINVAL if the options are invalid or cannot be used together.
+ */
+int agent_config_validate (void);
+
+/**
+ * @brief Release the runtime options and reset them to the default values.
+ */
+void agent_config_reset (void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __AGENT_CONFIG_H__ */
@@ -22,6 +22,9 @@
 #define DBUS_ML_BUS_NAME                "org.tizen.machinelearning.service"
 #define DBUS_ML_PATH                    "/Org/Tizen/MachineLearning/Service"
 
+/* Emitted on every interface before the method call, to initialize the lazy module. */
+#define DBUS_ML_I_AUTHORIZE_METHOD_HANDLER "g-authorize-method"
+
 /* Pipeline Interface */
 #define DBUS_PIPELINE_INTERFACE          "org.tizen.machinelearning.service.pipeline"
 #define DBUS_PIPELINE_PATH               "/Org/Tizen/MachineLearning/Service/Pipeline"
@@ -35,18 +38,31 @@
 #define DBUS_PIPELINE_I_STOP_HANDLER            "handle-stop-pipeline"
 #define DBUS_PIPELINE_I_DESTROY_HANDLER         "handle-destroy-pipeline"
 #define DBUS_PIPELINE_I_GET_STATE_HANDLER       "handle-get-state"
+#define DBUS_PIPELINE_I_LIST_HANDLER            "handle-list-pipeline"
 
 /* Model Interface */
 #define DBUS_MODEL_INTERFACE            "org.tizen.machinelearning.service.model"
 #define DBUS_MODEL_PATH                 "/Org/Tizen/MachineLearning/Service/Model"
 
 #define DBUS_MODEL_I_HANDLER_REGISTER           "handle-register"
+#define DBUS_MODEL_I_HANDLER_REGISTER_FROM_FD   "handle-register-from-fd"
+#define DBUS_MODEL_I_HANDLER_REGISTER_DELTA     "handle-register-delta"
 #define DBUS_MODEL_I_HANDLER_UPDATE_DESCRIPTION "handle-update-description"
 #define DBUS_MODEL_I_HANDLER_ACTIVATE           "handle-activate"
 #define DBUS_MODEL_I_HANDLER_GET                "handle-get"
 #define DBUS_MODEL_I_HANDLER_GET_ACTIVATED      "handle-get-activated"
+#define DBUS_MODEL_I_HANDLER_GET_ACTIVATED_FD   "handle-get-activated-fd"
+#define DBUS_MODEL_I_HANDLER_GET_RESIDENT_STATS "handle-get-resident-stats"
+#define DBUS_MODEL_I_HANDLER_GET_STARTUP_STATS  "handle-get-startup-stats"
 #define DBUS_MODEL_I_HANDLER_GET_ALL            "handle-get-all"
+#define DBUS_MODEL_I_HANDLER_LIST               "handle-list"
+#define DBUS_MODEL_I_HANDLER_INSTALL            "handle-install"
+#define DBUS_MODEL_I_HANDLER_UPGRADE            "handle-upgrade"
+#define DBUS_MODEL_I_HANDLER_INSTALL_FROM_FD    "handle-install-from-fd"
+#define DBUS_MODEL_I_HANDLER_UPGRADE_FROM_FD    "handle-upgrade-from-fd"
 #define DBUS_MODEL_I_HANDLER_DELETE             "handle-delete"
+#define DBUS_MODEL_I_HANDLER_PIN                "handle-pin"
+#define DBUS_MODEL_I_HANDLER_EVICT              "handle-evict"
 
 /* Resource Interface */
 #define DBUS_RESOURCE_INTERFACE         "org.tizen.machinelearning.service.resource"
@@ -55,5 +71,7 @@
 #define DBUS_RESOURCE_I_HANDLER_ADD                "handle-add"
 #define DBUS_RESOURCE_I_HANDLER_GET                "handle-get"
 #define DBUS_RESOURCE_I_HANDLER_DELETE             "handle-delete"
+#define DBUS_RESOURCE_I_HANDLER_LIST               "handle-list"
+#define DBUS_RESOURCE_I_HANDLER_PREFETCH           "handle-prefetch"
 
 #endif /* __GDBUS_INTERFACE_H__ */
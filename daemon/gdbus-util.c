@@ -16,8 +16,35 @@
 
 #include "gdbus-util.h"
 #include "log.h"
+#include "startup-profile.h"
 
 static GDBusConnection *g_dbus_sys_conn = NULL;
+static guint g_dbus_name_id = 0U;
+static gint64 g_dbus_name_requested = 0; /**< The monotonic time when the name is requested. */
+static guint g_dbus_filter_id = 0U;
+static gint g_dbus_last_call = 0; /**< The monotonic time in seconds of the last method call. */
+
+/**
+ * @brief Internal function to get the monotonic time in seconds.
+ */
+static gint
+_get_monotonic_seconds (void)
+{
+  return (gint) (g_get_monotonic_time () / G_USEC_PER_SEC);
+}
+
+/**
+ * @brief Filter function to record the time of the incoming method call. It is called in the worker thread of the connection.
+ */
+static GDBusMessage *
+_record_method_call (GDBusConnection *connection, GDBusMessage *message,
+    gboolean incoming, gpointer user_data)
+{
+  if (incoming && g_dbus_message_get_message_type (message) == G_DBUS_MESSAGE_TYPE_METHOD_CALL)
+    g_atomic_int_set (&g_dbus_last_call, _get_monotonic_seconds ());
+
+  return message;
+}
 
 /**
  * @brief Export the DBus interface at the Object path on the bus connection.
@@ -47,6 +74,9 @@ static void
 name_acquired_cb (GDBusConnection * connection,
     const gchar * name, gpointer user_data)
 {
+  startup_profile_add ("bus_name_acquisition", g_dbus_name_requested);
+  startup_profile_ready ();
+
   sd_notify (0, "READY=1");
 }
 
@@ -58,14 +88,38 @@ gdbus_get_name (const char *name)
 {
   guint id;
 
+  g_dbus_name_requested = g_get_monotonic_time ();
   id = g_bus_own_name_on_connection (g_dbus_sys_conn, name,
       G_BUS_NAME_OWNER_FLAGS_NONE, name_acquired_cb, NULL, NULL, NULL);
   if (id == 0)
     return -ENOSYS;
 
+  g_dbus_name_id = id;
   return 0;
 }
 
+/**
+ * @brief Release the name acquired with gdbus_get_name().
+ */
+void
+gdbus_put_name (void)
+{
+  if (g_dbus_name_id > 0U) {
+    sd_notify (0, "STOPPING=1");
+    g_bus_unown_name (g_dbus_name_id);
+    g_dbus_name_id = 0U;
+  }
+}
+
+/**
+ * @brief Get the time in seconds since the last method call, or since the connection if there is no call.
+ */
+gint
+gdbus_get_idle_time (void)
+{
+  return _get_monotonic_seconds () - g_atomic_int_get (&g_dbus_last_call);
+}
+
 /**
  * @brief Connects the callback functions for each signal of the particular DBus interface.
  */
@@ -123,7 +177,7 @@ gdbus_get_system_connection (gboolean is_session)
   GError *err = NULL;
   GBusType bus_type = is_session ? G_BUS_TYPE_SESSION : G_BUS_TYPE_SYSTEM;
 
-  g_clear_object (&g_dbus_sys_conn);
+  gdbus_put_system_connection ();
   g_dbus_sys_conn = g_bus_get_sync (bus_type, NULL, &err);
   if (g_dbus_sys_conn == NULL) {
     ml_loge ("Cannot connect to the system message bus: %s", err ? err->message : "Unknown error");
@@ -131,6 +185,9 @@ gdbus_get_system_connection (gboolean is_session)
     return -ENOSYS;
   }
 
+  g_atomic_int_set (&g_dbus_last_call, _get_monotonic_seconds ());
+  g_dbus_filter_id = g_dbus_connection_add_filter (g_dbus_sys_conn, _record_method_call, NULL, NULL);
+
   return 0;
 }
 
@@ -140,6 +197,10 @@ gdbus_get_system_connection (gboolean is_session)
 void
 gdbus_put_system_connection (void)
 {
+  if (g_dbus_sys_conn && g_dbus_filter_id > 0U)
+    g_dbus_connection_remove_filter (g_dbus_sys_conn, g_dbus_filter_id);
+
+  g_dbus_filter_id = 0U;
   g_clear_object (&g_dbus_sys_conn);
 }
 
@@ -150,9 +211,11 @@ void
 gdbus_initialize (void)
 {
   GError *err = NULL;
+  gint64 start = g_get_monotonic_time ();
 
   if (!gst_init_check (NULL, NULL, &err))
     ml_loge ("Failed to initialize GStreamer: %s", (err ? err->message : "Unknown error"));
 
   g_clear_error (&err);
+  startup_profile_add ("gst_init", start);
 }
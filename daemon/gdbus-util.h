@@ -54,6 +54,18 @@ int gdbus_export_interface (gpointer instance, const char *obj_path);
  */
 int gdbus_get_name (const char *name);
 
+/**
+ * @brief Release the name acquired with gdbus_get_name().
+ * @remarks The bus activates the daemon again for the next method call to the name.
+ */
+void gdbus_put_name (void);
+
+/**
+ * @brief Get the idle time of the daemon.
+ * @return The time in seconds since the last incoming method call, or since the connection if there is no call.
+ */
+gint gdbus_get_idle_time (void);
+
 /**
  * @brief Connects the callback functions for each signal of the particular DBus interface.
  * @param instance The instance of the DBus interface.
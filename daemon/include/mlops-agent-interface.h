@@ -90,6 +90,35 @@ int ml_agent_pipeline_get_state (const int64_t id, int *state);
 int ml_agent_model_register (const char *name, const char *path, const int activate,
     const char *description, const char *app_info, uint32_t *version);
 
+/**
+ * @brief An interface exported for registering a model read from the file descriptor.
+ * @details The daemon copies the model into its model store, so the model store should be enabled.
+ * @param[in] name A name indicating the model that would be registered.
+ * @param[in] fd A file descriptor to read the model from. It may be a pipe, and the caller should close it.
+ * @param[in] activate An initial activation state.
+ * @param[in] description A stringified description of the given model.
+ * @param[in] app_info Application-specific information from Tizen's RPK.
+ * @param[out] version A pointer for the version of the given model registered.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_model_register_from_fd (const char *name, const int fd, const int activate,
+    const char *description, const char *app_info, uint32_t *version);
+
+/**
+ * @brief An interface exported for registering a new version of the model with the binary delta from the base version.
+ * @details The daemon reconstructs the model from the base version and the delta, and verifies it with the hash in the delta.
+ * @param[in] name A name indicating the model that would be registered.
+ * @param[in] base_version The version of the model which the delta is applied to.
+ * @param[in] delta_fd A file descriptor to read the delta from. It may be a pipe, and the caller should close it.
+ * @param[in] activate An initial activation state.
+ * @param[in] description A stringified description of the given model.
+ * @param[in] app_info Application-specific information from Tizen's RPK.
+ * @param[out] version A pointer for the version of the given model registered.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_model_register_delta (const char *name, const uint32_t base_version, const int delta_fd,
+    const int activate, const char *description, const char *app_info, uint32_t *version);
+
 /**
  * @brief An interface exported for updating the description of the model with @a name and @a version.
  * @param[in] name A name indicating the model whose description would be updated.
@@ -127,6 +156,33 @@ int ml_agent_model_get (const char *name, const uint32_t version, char **model_i
  */
 int ml_agent_model_get_activated (const char *name, char **model_info);
 
+/**
+ * @brief An interface exported for getting the information and the file descriptor of the activated model with @a name.
+ * @details The daemon keeps the recently served model files resident, so the client maps the file without reading the storage.
+ * @remarks If the function succeeds, @a model_info should be released using free(), and @a fd should be closed.
+ * @param[in] name A name indicating the model.
+ * @param[out] model_info A pointer for the information of an activated model of the given @a name.
+ * @param[out] fd The read-only file descriptor of the model file.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_model_get_activated_fd (const char *name, char **model_info, int *fd);
+
+/**
+ * @brief An interface exported for getting the statistics of the resident model cache of the daemon.
+ * @remarks If the function succeeds, @a stats should be released using free().
+ * @param[out] stats The JSON string of the budget, the resident size, and the counts of the hits, misses and evictions.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_model_get_resident_stats (char **stats);
+
+/**
+ * @brief An interface exported for getting the timing of the startup phases of the daemon.
+ * @remarks If the function succeeds, @a stats should be released using free().
+ * @param[out] stats The JSON string of the time to be ready, and the start time and the duration of each phase in microseconds.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_get_startup_stats (char **stats);
+
 /**
  * @brief An interface exported for getting the information of all the models corresponding to the given @a name.
  * @remarks If the function succeeds, @a model_info should be released using free().
@@ -147,6 +203,24 @@ int ml_agent_model_get_all (const char *name, char **model_info);
  */
 int ml_agent_model_delete (const char *name, const uint32_t version, const int force);
 
+/**
+ * @brief An interface exported for pinning the model of @a name and @a version not to be evicted from the model store.
+ * @param[in] name A name indicating the model.
+ * @param[in] version A version for identifying a specific model.
+ * @param[in] pinned Non-zero to pin the model, zero to unpin it.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_model_pin (const char *name, const uint32_t version, const int pinned);
+
+/**
+ * @brief An interface exported for evicting the least recently used inactive models over the quota of the model store.
+ * @details The active and pinned models are never evicted.
+ * @param[in] dry_run Non-zero to report the models to be evicted without deleting them.
+ * @param[out] report The JSON string of the evicted models and the reclaimed size. Call free() to release it.
+ * @return 0 on success, a negative error value if failed. -ENOTSUP if the quota is not set.
+ */
+int ml_agent_model_evict (const int dry_run, char **report);
+
 /**
  * @brief An interface exported for adding the resource.
  * @param[in] name A name indicating the resource.
@@ -174,6 +248,73 @@ int ml_agent_resource_delete (const char *name);
  */
 int ml_agent_resource_get (const char *name, char **res_info);
 
+/**
+ * @brief An interface exported for validating and reading ahead all files of the resource with @a name.
+ * @remarks If the function returns 0 or a negative error value of the files, @a info should be released using free().
+ * @param[in] name A name indicating the resource.
+ * @param[out] info The JSON string of the total bytes and the path, size and result of each file.
+ * @return 0 if all files are read ahead, a negative error value if failed.
+ */
+int ml_agent_resource_prefetch (const char *name, char **info);
+
+/**
+ * @brief An interface exported for listing the registered names of the given @a kind, a page at a time.
+ * @remarks If the function succeeds, @a list should be released using free().
+ * @param[in] kind The kind of the names, "pipeline", "model" or "resource".
+ * @param[in] pattern The GLOB pattern of the names. NULL for all names.
+ * @param[in] cursor The cursor in the @a list of the previous page. NULL for the first page.
+ * @param[in] limit The maximum number of the names in the page, up to 1000. 0 for the default, 100.
+ * @param[out] list The JSON string of the sorted "names" array and the "cursor" of the next page. The cursor is empty at the last page.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_registry_list (const char *kind, const char *pattern, const char *cursor, unsigned int limit, char **list);
+
+/**
+ * @brief An interface exported for installing the models, pipelines and resources of the configuration at once.
+ * @details All entries are registered in a transaction. If any entry is invalid, none of them is registered.
+ * @remarks If the function succeeds, @a models should be released using free().
+ * @param[in] config The JSON string of the configuration, in the format of rpk_config.json.
+ * @param[in] app_info The application information of the models and resources.
+ * @param[out] models The JSON array of the name, version and activation of the registered models.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_registry_install (const char *config, const char *app_info, char **models);
+
+/**
+ * @brief An interface exported for applying the changes of the package to the models, pipelines and resources of the configuration at once.
+ * @details The models and resources registered with the same "pkg_id" in @a app_info are compared with the configuration in a transaction.
+ *          The unchanged models keep their versions and active states. The models and resources not in the configuration are deleted.
+ * @remarks If the function succeeds, @a models should be released using free().
+ * @param[in] config The JSON string of the configuration, in the format of rpk_config.json.
+ * @param[in] app_info The application information with the package id of the models and resources.
+ * @param[out] models The JSON array of the name, version and activation of the models in the configuration.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_registry_upgrade (const char *config, const char *app_info, char **models);
+
+/**
+ * @brief An interface exported for installing the models, pipelines and resources of the configuration file at once.
+ * @details The daemon reads the file in the chunks and registers the entries as they are read, in a transaction.
+ *          So the memory of the caller and the daemon does not grow with the size of the configuration.
+ * @remarks If the function succeeds, @a models should be released using free().
+ * @param[in] fd A file descriptor of the configuration file, in the format of rpk_config.json. The caller should close it.
+ * @param[in] app_info The application information of the models and resources.
+ * @param[out] models The JSON array of the name, version and activation of the registered models.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_registry_install_from_fd (const int fd, const char *app_info, char **models);
+
+/**
+ * @brief An interface exported for applying the changes of the package in the configuration file at once.
+ * @details It is same as ml_agent_registry_upgrade(), but the daemon reads the configuration from the file in the chunks.
+ * @remarks If the function succeeds, @a models should be released using free().
+ * @param[in] fd A file descriptor of the configuration file, in the format of rpk_config.json. The caller should close it.
+ * @param[in] app_info The application information with the package id of the models and resources.
+ * @param[out] models The JSON array of the name, version and activation of the models in the configuration.
+ * @return 0 on success, a negative error value if failed.
+ */
+int ml_agent_registry_upgrade_from_fd (const int fd, const char *app_info, char **models);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
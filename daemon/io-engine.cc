@@ -0,0 +1,629 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      io-engine.cc
+ * @date      18 Oct 2026
+ * @brief     Bulk I/O engine for the model files.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   With io_uring, the operations are queued in the backlog and moved into the ring while it has room.
+ *            One thread reaps the completions, resubmits the short transfers and refills the ring.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glib.h>
+#include <unistd.h>
+
+#if defined(ENABLE_IO_URING)
+#include <liburing.h>
+#endif
+
+#include "io-engine.h"
+#include "log.h"
+
+/**
+ * @brief Structure for the batch of the operations.
+ */
+typedef struct {
+  io_engine_op_s *ops;
+  guint num;
+  gint pending; /**< The number of the operations not completed. */
+  io_engine_done_cb cb;
+  gpointer user_data;
+  GMainContext *context;
+} io_engine_batch_s;
+
+/**
+ * @brief Structure for the I/O engine.
+ */
+typedef struct {
+  GMutex lock;
+  GCond cond;
+  gboolean running;
+  gboolean stopping;
+  guint depth;
+  guint active; /**< The number of the batches not completed. */
+  const gchar *backend;
+  GThreadPool *pool; /**< The workers of the thread-pool backend. */
+#if defined(ENABLE_IO_URING)
+  struct io_uring ring;
+  GThread *reaper; /**< The thread to reap the completions of io_uring. */
+  GQueue backlog; /**< The operations waiting for the room in the ring. */
+  guint inflight; /**< The number of the operations in the ring, including the entries not consumed by the kernel. */
+#endif
+} io_engine_s;
+
+static io_engine_s g_engine;
+
+/**
+ * @brief Structure to wait for the batch.
+ */
+typedef struct {
+  GMutex lock;
+  GCond cond;
+  gboolean done;
+} io_engine_waiter_s;
+
+/**
+ * @brief Internal function to run the operation with the blocking system calls.
+ */
+static gssize
+_run_op (io_engine_op_s *op)
+{
+  if (op->type == IO_ENGINE_OP_READAHEAD) {
+    int err = posix_fadvise (op->fd, op->offset, (off_t) op->length, POSIX_FADV_WILLNEED);
+
+    return (err != 0) ? -err : (gssize) op->length;
+  }
+
+  while (op->done < op->length) {
+    ssize_t n;
+
+    if (op->type == IO_ENGINE_OP_READ)
+      n = pread (op->fd, op->buf + op->done, op->length - op->done, op->offset + op->done);
+    else
+      n = pwrite (op->fd, op->buf + op->done, op->length - op->done, op->offset + op->done);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      return -errno;
+    if (n == 0) {
+      /* The end of the file. */
+      if (op->type == IO_ENGINE_OP_WRITE)
+        return -EIO;
+      break;
+    }
+
+    op->done += n;
+  }
+
+  return (gssize) op->done;
+}
+
+/**
+ * @brief Internal function to call the callback of the batch and release it.
+ */
+static gboolean
+_dispatch_cb (gpointer data)
+{
+  io_engine_batch_s *batch = (io_engine_batch_s *) data;
+
+  batch->cb (batch->ops, batch->num, batch->user_data);
+
+  if (batch->context)
+    g_main_context_unref (batch->context);
+  g_free (batch);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Internal function to notify the completion of the batch.
+ */
+static void
+_complete_batch (io_engine_batch_s *batch)
+{
+  g_mutex_lock (&g_engine.lock);
+  if (--g_engine.active == 0U)
+    g_cond_broadcast (&g_engine.cond);
+  g_mutex_unlock (&g_engine.lock);
+
+  if (batch->context)
+    g_main_context_invoke_full (batch->context, G_PRIORITY_DEFAULT, _dispatch_cb, batch, NULL);
+  else
+    _dispatch_cb (batch);
+}
+
+/**
+ * @brief Internal function to set the result of the operation, and to complete the batch with the last one.
+ */
+static void
+_finish_op (io_engine_op_s *op, gssize result)
+{
+  io_engine_batch_s *batch = (io_engine_batch_s *) op->batch;
+
+  op->result = result;
+  if (g_atomic_int_dec_and_test (&batch->pending))
+    _complete_batch (batch);
+}
+
+/**
+ * @brief The worker function of the thread-pool backend.
+ */
+static void
+_pool_worker (gpointer data, gpointer user_data)
+{
+  io_engine_op_s *op = (io_engine_op_s *) data;
+
+  _finish_op (op, _run_op (op));
+}
+
+/**
+ * @brief Internal function to run the operations which cannot be submitted to the engine. Call it without the lock.
+ */
+static void
+_run_fallback (GQueue *fallback)
+{
+  io_engine_op_s *op;
+
+  while ((op = (io_engine_op_s *) g_queue_pop_head (fallback)) != NULL)
+    _finish_op (op, _run_op (op));
+}
+
+#if defined(ENABLE_IO_URING)
+/**
+ * @brief The interval to submit the entries again when no completion comes, in microseconds.
+ */
+#define IO_ENGINE_RETRY_INTERVAL (1000UL)
+
+/**
+ * @brief The max interval to submit the entries again, in microseconds.
+ */
+#define IO_ENGINE_RETRY_INTERVAL_MAX (100000UL)
+
+/**
+ * @brief Internal function to put the operation into the ring. Call it with the lock.
+ */
+static gboolean
+_uring_prep_locked (io_engine_op_s *op)
+{
+  struct io_uring_sqe *sqe = io_uring_get_sqe (&g_engine.ring);
+  gsize remain = MIN (op->length - op->done, (gsize) G_MAXINT32);
+
+  if (!sqe)
+    return FALSE;
+
+  switch (op->type) {
+    case IO_ENGINE_OP_READ:
+      io_uring_prep_read (sqe, op->fd, op->buf + op->done, remain, op->offset + op->done);
+      break;
+    case IO_ENGINE_OP_WRITE:
+      io_uring_prep_write (sqe, op->fd, op->buf + op->done, remain, op->offset + op->done);
+      break;
+    default:
+      io_uring_prep_fadvise (sqe, op->fd, op->offset, op->length, POSIX_FADV_WILLNEED);
+      break;
+  }
+
+  io_uring_sqe_set_data (sqe, op);
+  g_engine.inflight++;
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to move the operations in the backlog into the ring, and submit them. Call it with the lock.
+ * @param[out] fallback The operations which cannot be submitted. Run them with _run_fallback() after releasing the lock.
+ * @details The operations put into the ring are owned by the ring until their completions come. Only the operations
+ *          in the backlog are run without io_uring if the submission fails.
+ */
+static void
+_uring_fill_locked (GQueue *fallback)
+{
+  gulong interval = IO_ENGINE_RETRY_INTERVAL;
+  guint prepared = 0;
+  int ret;
+
+  while (!g_queue_is_empty (&g_engine.backlog) && g_engine.inflight < g_engine.depth) {
+    if (!_uring_prep_locked ((io_engine_op_s *) g_queue_peek_head (&g_engine.backlog)))
+      break;
+
+    g_queue_pop_head (&g_engine.backlog);
+    prepared++;
+  }
+
+  /* The entries not consumed by the last call are submitted again. */
+  if (prepared == 0U && io_uring_sq_ready (&g_engine.ring) == 0U)
+    return;
+
+  ret = io_uring_submit (&g_engine.ring);
+  if (ret >= 0 && io_uring_sq_ready (&g_engine.ring) == 0U)
+    return;
+
+  /* The completion queue is full, the reaper submits them again after reaping the completions. */
+  if (ret != -EBUSY) {
+    ml_logw ("Failed to submit the I/O operations to io_uring (%d), run the waiting ones without it.", ret);
+
+    while (!g_queue_is_empty (&g_engine.backlog))
+      g_queue_push_tail (fallback, g_queue_pop_head (&g_engine.backlog));
+  }
+
+  /**
+   * No completion comes to submit the entries again if the kernel has consumed none of them.
+   * Submit them again until the kernel consumes them, they cannot be taken back from the ring.
+   */
+  while (g_engine.inflight > 0U && g_engine.inflight == io_uring_sq_ready (&g_engine.ring)) {
+    g_usleep (interval);
+    interval = MIN (interval * 2UL, IO_ENGINE_RETRY_INTERVAL_MAX);
+
+    ret = io_uring_submit (&g_engine.ring);
+    if (ret < 0 && interval == IO_ENGINE_RETRY_INTERVAL_MAX)
+      ml_loge ("Failed to submit the I/O operations to io_uring (%d), retry it.", ret);
+  }
+}
+
+/**
+ * @brief Internal function to handle the completion of the operation. Call it with the lock.
+ * @return TRUE if the operation is finished, FALSE if the rest is submitted again.
+ */
+static gboolean
+_uring_complete_locked (io_engine_op_s *op, gint res, gssize *result)
+{
+  gboolean finished = TRUE;
+
+  if (res == -EINTR || res == -EAGAIN) {
+    finished = FALSE;
+  } else if (res < 0) {
+    *result = res;
+  } else if (op->type == IO_ENGINE_OP_READAHEAD) {
+    *result = (gssize) op->length;
+  } else if (res == 0) {
+    /* The end of the file. */
+    *result = (op->type == IO_ENGINE_OP_WRITE) ? -EIO : (gssize) op->done;
+  } else {
+    op->done += res;
+    finished = (op->done >= op->length);
+    *result = (gssize) op->done;
+  }
+
+  if (!finished)
+    g_queue_push_head (&g_engine.backlog, op);
+
+  return finished;
+}
+
+/**
+ * @brief The thread to reap the completions of io_uring.
+ */
+static gpointer
+_uring_reaper (gpointer data)
+{
+  struct io_uring_cqe *cqe;
+  io_engine_op_s *op;
+  GQueue fallback = G_QUEUE_INIT;
+  gboolean finished;
+  gssize result = 0;
+  gint res;
+  int ret;
+
+  while (TRUE) {
+    ret = io_uring_wait_cqe (&g_engine.ring, &cqe);
+    if (ret == -EINTR)
+      continue;
+    if (ret < 0) {
+      ml_loge ("Failed to wait for the completion of io_uring (%d).", ret);
+      break;
+    }
+
+    op = (io_engine_op_s *) io_uring_cqe_get_data (cqe);
+    res = cqe->res;
+    io_uring_cqe_seen (&g_engine.ring, cqe);
+
+    /* The stop mark. */
+    if (!op)
+      break;
+
+    g_mutex_lock (&g_engine.lock);
+    g_engine.inflight--;
+    finished = _uring_complete_locked (op, res, &result);
+    _uring_fill_locked (&fallback);
+    g_mutex_unlock (&g_engine.lock);
+
+    /* The callback may submit the next batch. */
+    if (finished)
+      _finish_op (op, result);
+    _run_fallback (&fallback);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Internal function to start io_uring. Call it with the lock.
+ */
+static gint
+_uring_start_locked (guint depth)
+{
+  struct io_uring_probe *probe;
+  gboolean supported;
+  int ret;
+
+  ret = io_uring_queue_init (depth, &g_engine.ring, 0);
+  if (ret < 0) {
+    ml_logi ("io_uring is not available (%d), use the thread pool for the bulk I/O.", ret);
+    return ret;
+  }
+
+  probe = io_uring_get_probe_ring (&g_engine.ring);
+  supported = (probe && io_uring_opcode_supported (probe, IORING_OP_READ)
+               && io_uring_opcode_supported (probe, IORING_OP_WRITE)
+               && io_uring_opcode_supported (probe, IORING_OP_FADVISE));
+  if (probe)
+    io_uring_free_probe (probe);
+
+  if (!supported) {
+    ml_logi ("The kernel does not support the I/O operations of io_uring, use the thread pool for the bulk I/O.");
+    io_uring_queue_exit (&g_engine.ring);
+    return -ENOTSUP;
+  }
+
+  g_queue_init (&g_engine.backlog);
+  g_engine.inflight = 0;
+  g_engine.reaper = g_thread_new ("io-engine", _uring_reaper, NULL);
+  return 0;
+}
+#endif /* ENABLE_IO_URING */
+
+/**
+ * @brief Internal function to start the engine. Call it with the lock.
+ */
+static gint
+_start_locked (guint depth)
+{
+  g_engine.depth = depth;
+  g_engine.active = 0;
+
+#if defined(ENABLE_IO_URING)
+  if (_uring_start_locked (depth) == 0) {
+    g_engine.backend = "io_uring";
+    g_engine.running = TRUE;
+    return 0;
+  }
+#endif
+
+  g_engine.pool = g_thread_pool_new (_pool_worker, NULL, (gint) depth, FALSE, NULL);
+  if (!g_engine.pool) {
+    ml_loge ("Failed to create the threads of the I/O engine.");
+    return -ENOMEM;
+  }
+
+  g_engine.backend = "thread-pool";
+  g_engine.running = TRUE;
+  return 0;
+}
+
+/**
+ * @brief Start the engine.
+ */
+gint
+io_engine_init (guint depth)
+{
+  gint ret;
+
+  io_engine_fini ();
+
+  g_mutex_lock (&g_engine.lock);
+  ret = _start_locked (depth > 0U ? depth : IO_ENGINE_DEFAULT_DEPTH);
+  g_mutex_unlock (&g_engine.lock);
+
+  if (ret == 0)
+    ml_logi ("The I/O engine is started with %s, queue depth %u.", g_engine.backend, g_engine.depth);
+
+  return ret;
+}
+
+/**
+ * @brief Wait for the operations in flight and stop the engine.
+ */
+void
+io_engine_fini (void)
+{
+  GThreadPool *pool;
+#if defined(ENABLE_IO_URING)
+  GThread *reaper;
+  struct io_uring_sqe *sqe;
+#endif
+
+  g_mutex_lock (&g_engine.lock);
+  if (!g_engine.running) {
+    g_mutex_unlock (&g_engine.lock);
+    return;
+  }
+
+  /* The new batch is run without the engine while stopping it. */
+  g_engine.stopping = TRUE;
+  while (g_engine.active > 0U)
+    g_cond_wait (&g_engine.cond, &g_engine.lock);
+
+  pool = g_engine.pool;
+  g_engine.pool = NULL;
+
+#if defined(ENABLE_IO_URING)
+  reaper = g_engine.reaper;
+  g_engine.reaper = NULL;
+
+  if (reaper) {
+    /* Wake up the reaper with the operation without the data. */
+    while (!(sqe = io_uring_get_sqe (&g_engine.ring)))
+      io_uring_submit (&g_engine.ring);
+
+    io_uring_prep_nop (sqe);
+    io_uring_sqe_set_data (sqe, NULL);
+    io_uring_submit (&g_engine.ring);
+  }
+#endif
+  g_mutex_unlock (&g_engine.lock);
+
+  if (pool)
+    g_thread_pool_free (pool, FALSE, TRUE);
+
+#if defined(ENABLE_IO_URING)
+  if (reaper) {
+    g_thread_join (reaper);
+    io_uring_queue_exit (&g_engine.ring);
+  }
+#endif
+
+  g_mutex_lock (&g_engine.lock);
+  g_engine.running = g_engine.stopping = FALSE;
+  g_engine.backend = NULL;
+  g_mutex_unlock (&g_engine.lock);
+}
+
+/**
+ * @brief Get the name of the backend of the engine.
+ */
+const gchar *
+io_engine_get_backend (void)
+{
+  const gchar *backend;
+
+  g_mutex_lock (&g_engine.lock);
+  backend = g_engine.backend;
+  g_mutex_unlock (&g_engine.lock);
+
+  return backend;
+}
+
+/**
+ * @brief Submit the batch of the operations.
+ */
+gint
+io_engine_submit (io_engine_op_s *ops, guint num, io_engine_done_cb cb, gpointer user_data, GMainContext *context)
+{
+  io_engine_batch_s *batch;
+  GThreadPool *pool = NULL;
+  GQueue fallback = G_QUEUE_INIT;
+  guint i;
+  gint ret = 0;
+
+  if (!ops || num == 0U || !cb)
+    return -EINVAL;
+
+  batch = g_new0 (io_engine_batch_s, 1);
+  batch->ops = ops;
+  batch->num = num;
+  batch->pending = (gint) num;
+  batch->cb = cb;
+  batch->user_data = user_data;
+  batch->context = context ? g_main_context_ref (context) : NULL;
+
+  for (i = 0; i < num; i++) {
+    ops[i].done = 0;
+    ops[i].result = 0;
+    ops[i].batch = batch;
+  }
+
+  g_mutex_lock (&g_engine.lock);
+  if (g_engine.stopping)
+    ret = -ECANCELED;
+  else if (!g_engine.running)
+    ret = _start_locked (IO_ENGINE_DEFAULT_DEPTH);
+
+  if (ret == 0) {
+    g_engine.active++;
+    pool = g_engine.pool;
+
+#if defined(ENABLE_IO_URING)
+    if (!pool) {
+      for (i = 0; i < num; i++)
+        g_queue_push_tail (&g_engine.backlog, &ops[i]);
+      _uring_fill_locked (&fallback);
+    }
+#endif
+  }
+  g_mutex_unlock (&g_engine.lock);
+
+  _run_fallback (&fallback);
+
+  if (ret != 0) {
+    if (batch->context)
+      g_main_context_unref (batch->context);
+    g_free (batch);
+    return ret;
+  }
+
+  /* The engine is not stopped until the batch completes, push them out of the lock. */
+  if (pool) {
+    for (i = 0; i < num; i++) {
+      if (!g_thread_pool_push (pool, &ops[i], NULL))
+        _pool_worker (&ops[i], NULL);
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to wake up the thread waiting for the batch.
+ */
+static void
+_wake_cb (io_engine_op_s *ops, guint num, gpointer user_data)
+{
+  io_engine_waiter_s *waiter = (io_engine_waiter_s *) user_data;
+
+  g_mutex_lock (&waiter->lock);
+  waiter->done = TRUE;
+  g_cond_signal (&waiter->cond);
+  g_mutex_unlock (&waiter->lock);
+}
+
+/**
+ * @brief Run the batch of the operations and wait for the completion.
+ */
+gint
+io_engine_run (io_engine_op_s *ops, guint num)
+{
+  io_engine_waiter_s waiter;
+  guint i;
+
+  if (!ops)
+    return -EINVAL;
+
+  if (num == 0U)
+    return 0;
+
+  g_mutex_init (&waiter.lock);
+  g_cond_init (&waiter.cond);
+  waiter.done = FALSE;
+
+  if (io_engine_submit (ops, num, _wake_cb, &waiter, NULL) == 0) {
+    g_mutex_lock (&waiter.lock);
+    while (!waiter.done)
+      g_cond_wait (&waiter.cond, &waiter.lock);
+    g_mutex_unlock (&waiter.lock);
+  } else {
+    for (i = 0; i < num; i++) {
+      ops[i].done = 0;
+      ops[i].result = _run_op (&ops[i]);
+    }
+  }
+
+  g_mutex_clear (&waiter.lock);
+  g_cond_clear (&waiter.cond);
+
+  for (i = 0; i < num; i++) {
+    if (ops[i].result < 0)
+      return (gint) ops[i].result;
+    if ((gsize) ops[i].result < ops[i].length)
+      return -EIO;
+  }
+
+  return 0;
+}
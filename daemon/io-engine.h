@@ -0,0 +1,103 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    io-engine.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the bulk I/O engine for the model files
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The reads, writes and read-aheads of the large files are submitted in a batch and kept in flight up to the queue depth.
+ *    The engine uses io_uring if the daemon is built with liburing and the kernel supports it.
+ *    Otherwise the operations run on a thread pool with as many threads as the queue depth.
+ *    The completion of a batch is notified on the engine thread, or dispatched in the given main context.
+ */
+#ifndef __IO_ENGINE_H__
+#define __IO_ENGINE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The default queue depth of the engine.
+ */
+#define IO_ENGINE_DEFAULT_DEPTH (32U)
+
+/**
+ * @brief The types of the operation.
+ */
+typedef enum {
+  IO_ENGINE_OP_READ = 0,
+  IO_ENGINE_OP_WRITE,
+  IO_ENGINE_OP_READAHEAD /**< Read ahead the range into the page cache, without the buffer. */
+} io_engine_op_e;
+
+/**
+ * @brief Structure for the operation. Fill the type, fd, buf, length and offset, and keep it until the batch completes.
+ */
+typedef struct {
+  io_engine_op_e type;
+  int fd;
+  guint8 *buf;
+  gsize length;
+  goffset offset;
+  gssize result; /**< The transferred length, or a negative error value. The read is shorter than the length at the end of the file. */
+
+  /* Internal states of the engine. */
+  gsize done;
+  gpointer batch;
+} io_engine_op_s;
+
+/**
+ * @brief The callback to be called when all operations of the batch complete.
+ * @param[in] ops The operations given with the batch, with the results.
+ * @param[in] num The number of the operations.
+ * @param[in] user_data The user data given with the batch.
+ */
+typedef void (*io_engine_done_cb) (io_engine_op_s *ops, guint num, gpointer user_data);
+
+/**
+ * @brief Start the engine. If it is not called, the engine starts with the default depth at the first submission.
+ * @param[in] depth The maximum number of the operations in flight. 0 for the default.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint io_engine_init (guint depth);
+
+/**
+ * @brief Wait for the operations in flight and stop the engine.
+ */
+void io_engine_fini (void);
+
+/**
+ * @brief Get the name of the backend of the engine, "io_uring" or "thread-pool". NULL if the engine is not started.
+ */
+const gchar *io_engine_get_backend (void);
+
+/**
+ * @brief Submit the batch of the operations. It returns immediately.
+ * @param[in] ops The array of the operations.
+ * @param[in] num The number of the operations.
+ * @param[in] cb The callback to be called when all operations complete.
+ * @param[in] user_data The user data to be passed to the callback.
+ * @param[in] context The main context to dispatch the callback. If it is NULL, the callback is called on the engine thread.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint io_engine_submit (io_engine_op_s *ops, guint num, io_engine_done_cb cb, gpointer user_data, GMainContext *context);
+
+/**
+ * @brief Run the batch of the operations and wait for the completion.
+ * @param[in] ops The array of the operations.
+ * @param[in] num The number of the operations.
+ * @return @c 0 if all operations transferred the whole length. Otherwise a negative error value, -EIO for the short read.
+ */
+gint io_engine_run (io_engine_op_s *ops, guint num);
+
+G_END_DECLS
+#endif /* __IO_ENGINE_H__ */
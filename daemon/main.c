@@ -16,17 +16,30 @@
 #include <gio/gio.h>
 #include <errno.h>
 
+#include "agent-config.h"
 #include "common.h"
 #include "modules.h"
 #include "gdbus-util.h"
 #include "log.h"
 #include "dbus-interface.h"
 #include "service-db-util.h"
+#include "startup-profile.h"
+
+/**
+ * @brief The maximum interval in seconds to check the idle time of the daemon.
+ */
+#define IDLE_EXIT_CHECK_INTERVAL (10U)
+
+/**
+ * @brief The time in milliseconds to handle the method calls in flight after the name is released.
+ */
+#define IDLE_EXIT_DRAIN_TIME (200U)
 
 static GMainLoop *g_mainloop = NULL;
 static gboolean verbose = FALSE;
 static gboolean is_session = FALSE;
 static gchar *db_path = NULL;
+static guint idle_exit_id = 0U;
 
 /**
  * @brief Handle the SIGTERM signal and quit the main loop
@@ -38,6 +51,40 @@ handle_sigterm (int signo)
   g_main_loop_quit (g_mainloop);
 }
 
+/**
+ * @brief Quit the main loop after the method calls in flight are handled.
+ */
+static gboolean
+quit_main_loop (gpointer user_data)
+{
+  g_main_loop_quit (g_mainloop);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Exit the daemon if there is no method call and no running job for the idle exit timeout.
+ */
+static gboolean
+check_idle_exit (gpointer user_data)
+{
+  const gint timeout = agent_config_get ()->idle_exit_timeout;
+
+  if (gdbus_get_idle_time () < timeout || busy_modules (NULL))
+    return G_SOURCE_CONTINUE;
+
+  ml_logi ("No method call and no running job for %d seconds, exit until the next activation.", timeout);
+
+  /**
+   * The bus queues the new calls and activates the daemon again after the name is released.
+   * The calls received before it are handled until the main loop quits, and the modules flush their states on exit.
+   */
+  gdbus_put_name ();
+  g_timeout_add (IDLE_EXIT_DRAIN_TIME, quit_main_loop, NULL);
+
+  idle_exit_id = 0U;
+  return G_SOURCE_REMOVE;
+}
+
 /**
  * @brief Handle the post init tasks before starting the main loop.
  * @return @c 0 on success. Otherwise a negative error value.
@@ -54,6 +101,12 @@ postinit (void)
   if (ret < 0)
     return ret;
 
+  if (agent_config_get ()->idle_exit_timeout > 0) {
+    idle_exit_id = g_timeout_add_seconds (
+        MIN ((guint) agent_config_get ()->idle_exit_timeout, IDLE_EXIT_CHECK_INTERVAL),
+        check_idle_exit, NULL);
+  }
+
   return 0;
 }
 
@@ -82,6 +135,7 @@ parse_args (gint *argc, gchar ***argv)
   }
 
   g_option_context_add_main_entries (context, entries, NULL);
+  g_option_context_add_main_entries (context, agent_config_get_option_entries (), NULL);
   g_option_context_set_help_enabled (context, TRUE);
   g_option_context_set_ignore_unknown_options (context, TRUE);
 
@@ -93,7 +147,7 @@ parse_args (gint *argc, gchar ***argv)
     return -EINVAL;
   }
 
-  return 0;
+  return agent_config_validate ();
 }
 
 /**
@@ -103,26 +157,48 @@ int
 main (int argc, char **argv)
 {
   int ret = 0;
+  gint64 start;
 
+  startup_profile_begin ();
+
+  start = g_get_monotonic_time ();
   if (parse_args (&argc, &argv)) {
     ret = -EINVAL;
     goto error;
   }
+  startup_profile_add ("parse_args", start);
 
   /* path to database */
   if (!db_path)
     db_path = g_strdup (DB_PATH);
+
+  start = g_get_monotonic_time ();
   svcdb_initialize (db_path);
+  startup_profile_add ("svcdb_initialize", start);
 
   g_mainloop = g_main_loop_new (NULL, FALSE);
+
+  start = g_get_monotonic_time ();
   gdbus_get_system_connection (is_session);
+  startup_profile_add ("gdbus_get_system_connection", start);
 
+  start = g_get_monotonic_time ();
   init_modules (NULL);
+  startup_profile_add ("init_modules", start);
+
+  /* The bus name is acquired in the main loop, the profile is logged then. */
   if (postinit () < 0)
     ml_loge ("cannot init system");
 
   g_main_loop_run (g_mainloop);
+
+  if (idle_exit_id > 0U) {
+    g_source_remove (idle_exit_id);
+    idle_exit_id = 0U;
+  }
+
   exit_modules (NULL);
+  gdbus_put_name ();
 
   gdbus_put_system_connection ();
   g_main_loop_unref (g_mainloop);
@@ -134,5 +210,7 @@ error:
   is_session = verbose = FALSE;
   g_free (db_path);
   db_path = NULL;
+  agent_config_reset ();
+  startup_profile_reset ();
   return ret;
 }
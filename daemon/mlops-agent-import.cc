@@ -0,0 +1,264 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file    mlops-agent-import.cc
+ * @date    18 Oct 2026
+ * @brief   Offline tool to import the configurations of the RPK packages into the service database
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The image build provisions the packages without the bus and the daemon.
+ *    The rpk_config.json files given with the arguments or the manifest are imported into the database in a transaction.
+ *    The manifest is the JSON array of the objects with the members below.
+ *      - "config": The path of rpk_config.json. Relative to the directory of the manifest.
+ *      - "root": The root path of the package, if "config" is not given. The config is "<root>/res/global/<res_type>/rpk_config.json".
+ *      - "pkg_id", "app_id", "res_type" and "res_version": The package information, to upgrade and uninstall the package later.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <json-glib/json-glib.h>
+#include <stdexcept>
+
+#include "service-db-util.h"
+
+static gchar *db_path = NULL;
+static gchar *manifest = NULL;
+static gchar **config_files = NULL;
+
+/**
+ * @brief Internal function to get the string member of the entry in the manifest. NULL if it does not exist.
+ */
+static const gchar *
+_get_entry_member (JsonObject *entry, const gchar *member)
+{
+  if (!json_object_has_member (entry, member))
+    return NULL;
+
+  return json_object_get_string_member (entry, member);
+}
+
+/**
+ * @brief Internal function to make the application information of the package, as the plugin parser does.
+ */
+static gchar *
+_make_pkg_info (JsonObject *entry)
+{
+  g_autoptr (JsonBuilder) builder = NULL;
+  g_autoptr (JsonNode) root = NULL;
+  g_autoptr (JsonGenerator) gen = NULL;
+  const gchar *members[] = { "pkg_id", "app_id", "res_type", "res_version", NULL };
+  guint i;
+
+  if (!json_object_has_member (entry, "pkg_id"))
+    return g_strdup ("");
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "is_rpk");
+  json_builder_add_string_value (builder, "T");
+
+  for (i = 0; members[i]; i++) {
+    const gchar *value = _get_entry_member (entry, members[i]);
+
+    json_builder_set_member_name (builder, members[i]);
+    json_builder_add_string_value (builder, value ? value : "");
+  }
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  gen = json_generator_new ();
+  json_generator_set_root (gen, root);
+  json_generator_set_pretty (gen, TRUE);
+
+  return json_generator_to_data (gen, NULL);
+}
+
+/**
+ * @brief Internal function to read the configuration file.
+ * @return The contents of the file. NULL if it fails.
+ */
+static gchar *
+_read_config (const gchar *path)
+{
+  g_autoptr (GError) err = NULL;
+  gchar *contents = NULL;
+
+  if (!g_file_get_contents (path, &contents, NULL, &err)) {
+    g_printerr ("Failed to read the configuration file '%s' (%s).\n", path,
+        err ? err->message : "Unknown error");
+    return NULL;
+  }
+
+  return contents;
+}
+
+/**
+ * @brief Internal function to add the configurations in the manifest.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+static gint
+_add_manifest (const gchar *path, GPtrArray *configs, GPtrArray *app_infos)
+{
+  g_autoptr (JsonParser) parser = json_parser_new ();
+  g_autoptr (GError) err = NULL;
+  g_autofree gchar *dir = g_path_get_dirname (path);
+  JsonNode *root;
+  JsonArray *array;
+  guint i;
+
+  if (!json_parser_load_from_file (parser, path, &err)) {
+    g_printerr ("Failed to load the manifest '%s' (%s).\n", path, err ? err->message : "Unknown error");
+    return -EINVAL;
+  }
+
+  root = json_parser_get_root (parser);
+  if (!root || !JSON_NODE_HOLDS_ARRAY (root)) {
+    g_printerr ("Invalid manifest '%s', it should be an array of the packages.\n", path);
+    return -EINVAL;
+  }
+
+  array = json_node_get_array (root);
+
+  for (i = 0; i < json_array_get_length (array); i++) {
+    JsonObject *entry = json_array_get_object_element (array, i);
+    g_autofree gchar *config_path = NULL;
+    const gchar *config, *pkg_root;
+    gchar *contents;
+
+    if (!entry) {
+      g_printerr ("Invalid package at %u of the manifest.\n", i);
+      return -EINVAL;
+    }
+
+    config = _get_entry_member (entry, "config");
+    pkg_root = _get_entry_member (entry, "root");
+
+    if (config) {
+      config_path = g_path_is_absolute (config) ? g_strdup (config) : g_build_filename (dir, config, NULL);
+    } else if (pkg_root) {
+      const gchar *res_type = _get_entry_member (entry, "res_type");
+
+      config_path = g_build_filename (pkg_root, "res", "global", res_type ? res_type : "", "rpk_config.json", NULL);
+    } else {
+      g_printerr ("No config or root of the package at %u of the manifest.\n", i);
+      return -EINVAL;
+    }
+
+    contents = _read_config (config_path);
+    if (!contents)
+      return -EIO;
+
+    g_ptr_array_add (configs, contents);
+    g_ptr_array_add (app_infos, _make_pkg_info (entry));
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Parse commandline option.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+static int
+parse_args (gint *argc, gchar ***argv)
+{
+  g_autoptr (GError) err = NULL;
+  GOptionContext *context = NULL;
+  gboolean ret;
+
+  static GOptionEntry entries[] = {
+    { "path", 'p', 0, G_OPTION_ARG_STRING, &db_path, "Path to database", NULL },
+    { "manifest", 'm', 0, G_OPTION_ARG_FILENAME, &manifest, "The manifest of the packages to be imported", NULL },
+    { G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &config_files, NULL, "[rpk_config.json...]" },
+    { NULL }
+  };
+
+  context = g_option_context_new ("- import the configurations into the service database");
+  if (!context) {
+    g_printerr ("Failed to call g_option_context_new\n");
+    return -ENOMEM;
+  }
+
+  g_option_context_add_main_entries (context, entries, NULL);
+  g_option_context_set_help_enabled (context, TRUE);
+
+  ret = g_option_context_parse (context, argc, argv, &err);
+  g_option_context_free (context);
+  if (!ret) {
+    g_printerr ("Fail to option parsing: %s\n", err->message);
+    return -EINVAL;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief main function of the offline import tool.
+ */
+int
+main (int argc, char **argv)
+{
+  g_autoptr (GPtrArray) configs = g_ptr_array_new_with_free_func (g_free);
+  g_autoptr (GPtrArray) app_infos = g_ptr_array_new_with_free_func (g_free);
+  guint num_models = 0U;
+  guint i;
+  gint ret;
+
+  ret = parse_args (&argc, &argv);
+  if (ret != 0)
+    goto done;
+
+  for (i = 0; config_files && config_files[i]; i++) {
+    gchar *contents = _read_config (config_files[i]);
+
+    if (!contents) {
+      ret = -EIO;
+      goto done;
+    }
+
+    g_ptr_array_add (configs, contents);
+    g_ptr_array_add (app_infos, g_strdup (""));
+  }
+
+  if (manifest && (ret = _add_manifest (manifest, configs, app_infos)) != 0)
+    goto done;
+
+  if (configs->len == 0U) {
+    g_printerr ("No configuration to import, give the rpk_config.json files or the manifest.\n");
+    ret = -EINVAL;
+    goto done;
+  }
+
+  if (!db_path)
+    db_path = g_strdup (DB_PATH);
+
+  try {
+    svcdb_initialize (db_path);
+  } catch (const std::exception &e) {
+    g_printerr ("Failed to open the database in '%s' (%s).\n", db_path, e.what ());
+    ret = -EIO;
+    goto done;
+  }
+
+  ret = svcdb_import (configs->len, (const gchar *const *) configs->pdata,
+      (const gchar *const *) app_infos->pdata, &num_models);
+  svcdb_finalize ();
+
+  if (ret == 0)
+    g_print ("Imported %u configurations with %u models into '%s'.\n", configs->len, num_models, db_path);
+  else
+    g_printerr ("Failed to import the configurations, nothing is imported (%d).\n", ret);
+
+done:
+  g_free (db_path);
+  g_free (manifest);
+  g_strfreev (config_files);
+
+  return (ret == 0) ? 0 : 1;
+}
@@ -9,6 +9,7 @@
  */
 
 #include <errno.h>
+#include <gio/gunixfdlist.h>
 #include <glib.h>
 #include <stdint.h>
 
@@ -326,6 +327,92 @@ ml_agent_model_register (const char *name, const char *path,
   return 0;
 }
 
+/**
+ * @brief An interface exported for registering a model read from the file descriptor.
+ */
+int
+ml_agent_model_register_from_fd (const char *name, const int fd,
+    const int activate, const char *description, const char *app_info,
+    uint32_t * version)
+{
+  MachinelearningServiceModel *mlsm;
+  GUnixFDList *fd_list;
+  GError *err = NULL;
+  gboolean result;
+  gint index;
+  gint ret;
+
+  if (!STR_IS_VALID (name) || fd < 0 || !version) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  fd_list = g_unix_fd_list_new ();
+  index = g_unix_fd_list_append (fd_list, fd, &err);
+  if (index < 0) {
+    g_clear_error (&err);
+    g_object_unref (fd_list);
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_object_unref (fd_list);
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_register_from_fd_sync (mlsm,
+      name, index, activate, description ? description : "",
+      app_info ? app_info : "", fd_list, version, &ret, NULL, NULL, NULL);
+  g_object_unref (mlsm);
+  g_object_unref (fd_list);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for registering a new version of the model with the binary delta from the base version.
+ */
+int
+ml_agent_model_register_delta (const char *name, const uint32_t base_version,
+    const int delta_fd, const int activate, const char *description,
+    const char *app_info, uint32_t * version)
+{
+  MachinelearningServiceModel *mlsm;
+  GUnixFDList *fd_list;
+  GError *err = NULL;
+  gboolean result;
+  gint index;
+  gint ret;
+
+  if (!STR_IS_VALID (name) || base_version == 0U || delta_fd < 0 || !version) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  fd_list = g_unix_fd_list_new ();
+  index = g_unix_fd_list_append (fd_list, delta_fd, &err);
+  if (index < 0) {
+    g_clear_error (&err);
+    g_object_unref (fd_list);
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_object_unref (fd_list);
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_register_delta_sync (mlsm,
+      name, base_version, index, activate, description ? description : "",
+      app_info ? app_info : "", fd_list, version, &ret, NULL, NULL, NULL);
+  g_object_unref (mlsm);
+  g_object_unref (fd_list);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
 /**
  * @brief An interface exported for updating the description of the model with @a name and @a version.
  */
@@ -435,6 +522,102 @@ ml_agent_model_get_activated (const char *name, char **model_info)
   return 0;
 }
 
+/**
+ * @brief An interface exported for getting the information and the file descriptor of the activated model with @a name.
+ */
+int
+ml_agent_model_get_activated_fd (const char *name, char **model_info, int *fd)
+{
+  MachinelearningServiceModel *mlsm;
+  GUnixFDList *out_fd_list = NULL;
+  GError *err = NULL;
+  gboolean result;
+  gint index = -1;
+  gint ret;
+
+  if (!STR_IS_VALID (name) || !model_info || !fd) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_get_activated_fd_sync (mlsm,
+      name, NULL, model_info, &index, &ret, &out_fd_list, NULL, NULL);
+  g_object_unref (mlsm);
+
+  if (result && ret == 0) {
+    /* It duplicates the descriptor, the original one is closed with the list. */
+    *fd = g_unix_fd_list_get (out_fd_list, index, &err);
+    if (*fd < 0) {
+      g_clear_error (&err);
+      g_clear_pointer (model_info, g_free);
+      ret = -EIO;
+    }
+  }
+
+  g_clear_object (&out_fd_list);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the statistics of the resident model cache of the daemon.
+ */
+int
+ml_agent_model_get_resident_stats (char **stats)
+{
+  MachinelearningServiceModel *mlsm;
+  gboolean result;
+  gint ret;
+
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_get_resident_stats_sync (mlsm,
+      stats, &ret, NULL, NULL);
+  g_object_unref (mlsm);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for getting the timing of the startup phases of the daemon.
+ */
+int
+ml_agent_get_startup_stats (char **stats)
+{
+  MachinelearningServiceModel *mlsm;
+  gboolean result;
+  gint ret;
+
+  if (!stats) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_get_startup_stats_sync (mlsm,
+      stats, &ret, NULL, NULL);
+  g_object_unref (mlsm);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
 /**
  * @brief An interface exported for getting the information of all the models corresponding to the given @a name.
  */
@@ -491,6 +674,60 @@ ml_agent_model_delete (const char *name, const uint32_t version,
   return 0;
 }
 
+/**
+ * @brief An interface exported for pinning the model of @a name and @a version not to be evicted.
+ */
+int
+ml_agent_model_pin (const char *name, const uint32_t version, const int pinned)
+{
+  MachinelearningServiceModel *mlsm;
+  gboolean result;
+  gint ret;
+
+  if (!STR_IS_VALID (name) || version == 0U) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_pin_sync (mlsm,
+      name, version, pinned, &ret, NULL, NULL);
+  g_object_unref (mlsm);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for evicting the least recently used inactive models over the quota of the model store.
+ */
+int
+ml_agent_model_evict (const int dry_run, char **report)
+{
+  MachinelearningServiceModel *mlsm;
+  gboolean result;
+  gint ret;
+
+  if (!report) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_evict_sync (mlsm,
+      dry_run, report, &ret, NULL, NULL);
+  g_object_unref (mlsm);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
 /**
  * @brief An interface exported for adding the resource.
  */
@@ -573,3 +810,211 @@ ml_agent_resource_get (const char *name, char **res_info)
   g_return_val_if_fail (ret == 0 && result, ret);
   return 0;
 }
+
+/**
+ * @brief An interface exported for validating and reading ahead all files of the resource with @a name.
+ */
+int
+ml_agent_resource_prefetch (const char *name, char **info)
+{
+  MachinelearningServiceResource *mlsr;
+  gboolean result;
+  gint ret;
+
+  if (!STR_IS_VALID (name) || !info) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsr = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_RESOURCE);
+  if (!mlsr) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_resource_call_prefetch_sync (mlsr,
+      name, info, &ret, NULL, NULL);
+  g_object_unref (mlsr);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for listing the registered names of the given @a kind, a page at a time.
+ */
+int
+ml_agent_registry_list (const char *kind, const char *pattern, const char *cursor,
+    unsigned int limit, char **list)
+{
+  gboolean result = FALSE;
+  gint ret = -EINVAL;
+
+  if (!STR_IS_VALID (kind) || !list) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  if (!pattern)
+    pattern = "";
+  if (!cursor)
+    cursor = "";
+
+  if (g_str_equal (kind, "pipeline")) {
+    MachinelearningServicePipeline *mlsp;
+
+    mlsp = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_PIPELINE);
+    if (!mlsp) {
+      g_return_val_if_reached (-EIO);
+    }
+
+    result = machinelearning_service_pipeline_call_list_pipeline_sync (mlsp,
+        pattern, cursor, limit, &ret, list, NULL, NULL);
+    g_object_unref (mlsp);
+  } else if (g_str_equal (kind, "model")) {
+    MachinelearningServiceModel *mlsm;
+
+    mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+    if (!mlsm) {
+      g_return_val_if_reached (-EIO);
+    }
+
+    result = machinelearning_service_model_call_list_sync (mlsm,
+        pattern, cursor, limit, list, &ret, NULL, NULL);
+    g_object_unref (mlsm);
+  } else if (g_str_equal (kind, "resource")) {
+    MachinelearningServiceResource *mlsr;
+
+    mlsr = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_RESOURCE);
+    if (!mlsr) {
+      g_return_val_if_reached (-EIO);
+    }
+
+    result = machinelearning_service_resource_call_list_sync (mlsr,
+        pattern, cursor, limit, list, &ret, NULL, NULL);
+    g_object_unref (mlsr);
+  } else {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for installing the models, pipelines and resources of the configuration at once.
+ */
+int
+ml_agent_registry_install (const char *config, const char *app_info, char **models)
+{
+  MachinelearningServiceModel *mlsm;
+  gboolean result;
+  gint ret;
+
+  if (!STR_IS_VALID (config) || !models) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_install_sync (mlsm,
+      config, app_info ? app_info : "", models, &ret, NULL, NULL);
+  g_object_unref (mlsm);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for applying the changes of the package to the models, pipelines and resources of the configuration at once.
+ */
+int
+ml_agent_registry_upgrade (const char *config, const char *app_info, char **models)
+{
+  MachinelearningServiceModel *mlsm;
+  gboolean result;
+  gint ret;
+
+  if (!STR_IS_VALID (config) || !STR_IS_VALID (app_info) || !models) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_return_val_if_reached (-EIO);
+  }
+
+  result = machinelearning_service_model_call_upgrade_sync (mlsm,
+      config, app_info, models, &ret, NULL, NULL);
+  g_object_unref (mlsm);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief Internal function to install or upgrade with the configuration file read from the file descriptor.
+ */
+static int
+_registry_install_from_fd (const int fd, const char *app_info,
+    const gboolean upgrade, char **models)
+{
+  MachinelearningServiceModel *mlsm;
+  GUnixFDList *fd_list;
+  GError *err = NULL;
+  gboolean result;
+  gint index;
+  gint ret;
+
+  fd_list = g_unix_fd_list_new ();
+  index = g_unix_fd_list_append (fd_list, fd, &err);
+  if (index < 0) {
+    g_clear_error (&err);
+    g_object_unref (fd_list);
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  mlsm = _get_proxy_new_for_bus_sync (ML_AGENT_SERVICE_MODEL);
+  if (!mlsm) {
+    g_object_unref (fd_list);
+    g_return_val_if_reached (-EIO);
+  }
+
+  if (upgrade)
+    result = machinelearning_service_model_call_upgrade_from_fd_sync (mlsm,
+        index, app_info, fd_list, models, &ret, NULL, NULL, NULL);
+  else
+    result = machinelearning_service_model_call_install_from_fd_sync (mlsm,
+        index, app_info ? app_info : "", fd_list, models, &ret, NULL, NULL, NULL);
+  g_object_unref (mlsm);
+  g_object_unref (fd_list);
+
+  g_return_val_if_fail (ret == 0 && result, ret);
+  return 0;
+}
+
+/**
+ * @brief An interface exported for installing the models, pipelines and resources of the configuration file at once.
+ */
+int
+ml_agent_registry_install_from_fd (const int fd, const char *app_info, char **models)
+{
+  if (fd < 0 || !models) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return _registry_install_from_fd (fd, app_info, FALSE, models);
+}
+
+/**
+ * @brief An interface exported for applying the changes of the package in the configuration file at once.
+ */
+int
+ml_agent_registry_upgrade_from_fd (const int fd, const char *app_info, char **models)
+{
+  if (fd < 0 || !STR_IS_VALID (app_info) || !models) {
+    g_return_val_if_reached (-EINVAL);
+  }
+
+  return _registry_install_from_fd (fd, app_info, TRUE, models);
+}
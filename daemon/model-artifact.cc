@@ -0,0 +1,439 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-artifact.cc
+ * @date      18 Oct 2026
+ * @brief     Cache of the compiled artifacts of the model backends.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   The modification time of the artifact directory is updated whenever it is acquired or released,
+ *            so the least recently used directory is the oldest one. The quota is enforced in the idle time of the main loop.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "log.h"
+#include "model-artifact.h"
+
+/**
+ * @brief The maximum length of the model hash.
+ */
+#define MODEL_ARTIFACT_HASH_MAX_LEN (128U)
+
+/**
+ * @brief Structure for the artifact cache.
+ */
+typedef struct {
+  gchar *dir;
+  guint64 quota;
+  GHashTable *refs; /**< The number of the running pipelines, keyed by the path of the artifact directory. */
+  guint enforce_id; /**< The idle source to enforce the quota. */
+} model_artifact_s;
+
+/**
+ * @brief Structure for the artifact directory found in the cache.
+ */
+typedef struct {
+  std::string path;
+  gint64 mtime; /**< The modification time in microseconds, the last use of the directory. */
+  guint64 size;
+} model_artifact_entry_s;
+
+G_LOCK_DEFINE_STATIC (model_artifact_lock);
+static model_artifact_s g_artifact = { NULL, 0, NULL, 0 };
+
+/**
+ * @brief Internal function to check the string is a valid hash, not to escape the cache directory.
+ */
+static gboolean
+_is_valid_hash (const gchar *hash)
+{
+  gsize i, len;
+
+  if (!hash)
+    return FALSE;
+
+  len = strlen (hash);
+  if (len == 0U || len > MODEL_ARTIFACT_HASH_MAX_LEN)
+    return FALSE;
+
+  for (i = 0; i < len; i++) {
+    if (!g_ascii_isxdigit (hash[i]) || g_ascii_isupper (hash[i]))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the total size of the files in the directory, without following the symbolic links.
+ */
+static guint64
+_get_tree_size (const gchar *path)
+{
+  GStatBuf st;
+  GDir *dir;
+  const gchar *name;
+  guint64 size = 0;
+
+  if (g_lstat (path, &st) != 0)
+    return 0;
+
+  if (!S_ISDIR (st.st_mode))
+    return S_ISREG (st.st_mode) ? (guint64) st.st_size : 0;
+
+  dir = g_dir_open (path, 0, NULL);
+  if (!dir)
+    return 0;
+
+  while ((name = g_dir_read_name (dir)) != NULL) {
+    g_autofree gchar *child = g_build_filename (path, name, NULL);
+
+    size += _get_tree_size (child);
+  }
+
+  g_dir_close (dir);
+  return size;
+}
+
+/**
+ * @brief Internal function to remove the file or the directory with its contents.
+ */
+static void
+_remove_tree (const gchar *path)
+{
+  GStatBuf st;
+  GDir *dir;
+  const gchar *name;
+
+  if (g_lstat (path, &st) != 0)
+    return;
+
+  if (S_ISDIR (st.st_mode)) {
+    dir = g_dir_open (path, 0, NULL);
+    if (dir) {
+      while ((name = g_dir_read_name (dir)) != NULL) {
+        g_autofree gchar *child = g_build_filename (path, name, NULL);
+
+        _remove_tree (child);
+      }
+
+      g_dir_close (dir);
+    }
+
+    if (g_rmdir (path) != 0)
+      ml_logw ("Failed to remove the artifact directory '%s' (%d).", path, errno);
+  } else if (g_unlink (path) != 0) {
+    ml_logw ("Failed to remove the artifact file '%s' (%d).", path, errno);
+  }
+}
+
+/**
+ * @brief Internal function to check the artifact directories of the model are in use. Call it with the lock.
+ */
+static gboolean
+_hash_in_use_locked (const gchar *hash_dir)
+{
+  GHashTableIter iter;
+  gpointer key;
+  gsize len = strlen (hash_dir);
+
+  g_hash_table_iter_init (&iter, g_artifact.refs);
+  while (g_hash_table_iter_next (&iter, &key, NULL)) {
+    const gchar *path = (const gchar *) key;
+
+    if (strncmp (path, hash_dir, len) == 0 && path[len] == G_DIR_SEPARATOR)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Internal function to enforce the quota in the idle time.
+ */
+static gboolean
+_enforce_cb (gpointer user_data)
+{
+  G_LOCK (model_artifact_lock);
+  g_artifact.enforce_id = 0;
+  G_UNLOCK (model_artifact_lock);
+
+  model_artifact_enforce_quota (NULL);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Enable the artifact cache at the given directory.
+ */
+gint
+model_artifact_init (const gchar *dir, guint64 quota)
+{
+  if (!dir || dir[0] == '\0')
+    return 0;
+
+  if (g_mkdir_with_parents (dir, 0700) != 0) {
+    ml_loge ("Failed to create the artifact cache directory '%s' (%d).", dir, errno);
+    return -errno;
+  }
+
+  G_LOCK (model_artifact_lock);
+  g_free (g_artifact.dir);
+  g_artifact.dir = g_strdup (dir);
+  g_artifact.quota = quota;
+
+  if (!g_artifact.refs)
+    g_artifact.refs = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  if (quota > 0 && g_artifact.enforce_id == 0)
+    g_artifact.enforce_id = g_idle_add_full (G_PRIORITY_LOW, _enforce_cb, NULL, NULL);
+  G_UNLOCK (model_artifact_lock);
+
+  ml_logi ("The artifact cache is enabled at '%s'.", dir);
+  return 0;
+}
+
+/**
+ * @brief Disable the artifact cache. The cached artifacts are kept.
+ */
+void
+model_artifact_fini (void)
+{
+  G_LOCK (model_artifact_lock);
+  if (g_artifact.enforce_id > 0) {
+    g_source_remove (g_artifact.enforce_id);
+    g_artifact.enforce_id = 0;
+  }
+
+  g_clear_pointer (&g_artifact.dir, g_free);
+  g_clear_pointer (&g_artifact.refs, g_hash_table_destroy);
+  g_artifact.quota = 0;
+  G_UNLOCK (model_artifact_lock);
+}
+
+/**
+ * @brief Check whether the artifact cache is enabled.
+ */
+gboolean
+model_artifact_is_enabled (void)
+{
+  gboolean enabled;
+
+  G_LOCK (model_artifact_lock);
+  enabled = (g_artifact.dir != NULL);
+  G_UNLOCK (model_artifact_lock);
+
+  return enabled;
+}
+
+/**
+ * @brief Get the artifact directory for the model and the backend, and mark it in use.
+ */
+gint
+model_artifact_acquire (const gchar *hash, const gchar *backend, const gchar *options, gchar **dir)
+{
+  g_autoptr (GChecksum) checksum = NULL;
+  gchar *path;
+  guint refs;
+  gint ret = 0;
+
+  if (!_is_valid_hash (hash) || !backend || backend[0] == '\0' || !dir)
+    return -EINVAL;
+
+  /* The terminating null characters separate the backend and the options. */
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) backend, strlen (backend) + 1);
+  g_checksum_update (checksum, (const guchar *) (options ? options : ""), strlen (options ? options : "") + 1);
+
+  G_LOCK (model_artifact_lock);
+  if (!g_artifact.dir) {
+    G_UNLOCK (model_artifact_lock);
+    return -ENOTSUP;
+  }
+
+  path = g_build_filename (g_artifact.dir, hash, g_checksum_get_string (checksum), NULL);
+
+  /* Create it with the lock, not to be removed by the quota before it is marked in use. */
+  if (g_mkdir_with_parents (path, 0700) != 0) {
+    ret = -errno;
+    ml_loge ("Failed to create the artifact directory '%s' (%d).", path, errno);
+  } else {
+    refs = GPOINTER_TO_UINT (g_hash_table_lookup (g_artifact.refs, path));
+    g_hash_table_insert (g_artifact.refs, g_strdup (path), GUINT_TO_POINTER (refs + 1));
+    g_utime (path, NULL);
+  }
+  G_UNLOCK (model_artifact_lock);
+
+  if (ret != 0) {
+    g_free (path);
+    return ret;
+  }
+
+  *dir = path;
+  return 0;
+}
+
+/**
+ * @brief Release the artifact directory, and enforce the quota in the background.
+ */
+void
+model_artifact_release (const gchar *dir)
+{
+  guint refs;
+
+  if (!dir)
+    return;
+
+  G_LOCK (model_artifact_lock);
+  if (g_artifact.refs) {
+    refs = GPOINTER_TO_UINT (g_hash_table_lookup (g_artifact.refs, dir));
+
+    if (refs > 1U)
+      g_hash_table_insert (g_artifact.refs, g_strdup (dir), GUINT_TO_POINTER (refs - 1));
+    else
+      g_hash_table_remove (g_artifact.refs, dir);
+
+    /* The backend may have written the artifacts, mark it recently used. */
+    g_utime (dir, NULL);
+
+    if (g_artifact.quota > 0 && g_artifact.enforce_id == 0)
+      g_artifact.enforce_id = g_idle_add_full (G_PRIORITY_LOW, _enforce_cb, NULL, NULL);
+  }
+  G_UNLOCK (model_artifact_lock);
+}
+
+/**
+ * @brief Remove the artifacts of the models not registered anymore.
+ */
+void
+model_artifact_retain (const gchar *const *hashes)
+{
+  GDir *top;
+  const gchar *name;
+
+  G_LOCK (model_artifact_lock);
+  if (!g_artifact.dir) {
+    G_UNLOCK (model_artifact_lock);
+    return;
+  }
+
+  top = g_dir_open (g_artifact.dir, 0, NULL);
+  if (top) {
+    while ((name = g_dir_read_name (top)) != NULL) {
+      g_autofree gchar *hash_dir = NULL;
+
+      if (hashes && g_strv_contains (hashes, name))
+        continue;
+
+      /* The running pipeline keeps it until the next call. */
+      hash_dir = g_build_filename (g_artifact.dir, name, NULL);
+      if (_hash_in_use_locked (hash_dir))
+        continue;
+
+      ml_logd ("The artifacts of the model '%s' are removed.", name);
+      _remove_tree (hash_dir);
+    }
+
+    g_dir_close (top);
+  }
+  G_UNLOCK (model_artifact_lock);
+}
+
+/**
+ * @brief Remove the least recently used artifact directories until the cache is under the quota.
+ */
+gint
+model_artifact_enforce_quota (guint64 *usage)
+{
+  std::vector<model_artifact_entry_s> entries;
+  g_autofree gchar *root = NULL;
+  GDir *top;
+  const gchar *name;
+  guint64 quota, total = 0;
+
+  G_LOCK (model_artifact_lock);
+  root = g_strdup (g_artifact.dir);
+  quota = g_artifact.quota;
+  G_UNLOCK (model_artifact_lock);
+
+  if (!root)
+    return -ENOTSUP;
+
+  top = g_dir_open (root, 0, NULL);
+  if (!top)
+    return -EIO;
+
+  /* Scan the cache out of the lock, the backends may write the artifacts now. */
+  while ((name = g_dir_read_name (top)) != NULL) {
+    g_autofree gchar *hash_dir = g_build_filename (root, name, NULL);
+    const gchar *key;
+    GDir *sub;
+
+    sub = g_dir_open (hash_dir, 0, NULL);
+    if (!sub)
+      continue;
+
+    while ((key = g_dir_read_name (sub)) != NULL) {
+      g_autofree gchar *path = g_build_filename (hash_dir, key, NULL);
+      model_artifact_entry_s entry;
+      GStatBuf st;
+
+      if (g_lstat (path, &st) != 0)
+        continue;
+
+      entry.path = path;
+      entry.mtime = (gint64) st.st_mtim.tv_sec * G_USEC_PER_SEC + st.st_mtim.tv_nsec / 1000;
+      entry.size = _get_tree_size (path);
+      total += entry.size;
+      entries.push_back (entry);
+    }
+
+    g_dir_close (sub);
+  }
+
+  g_dir_close (top);
+
+  if (quota > 0 && total > quota) {
+    std::sort (entries.begin (), entries.end (),
+        [] (const model_artifact_entry_s &a, const model_artifact_entry_s &b) {
+          return a.mtime < b.mtime;
+        });
+
+    G_LOCK (model_artifact_lock);
+    for (const model_artifact_entry_s &entry : entries) {
+      g_autofree gchar *hash_dir = NULL;
+
+      if (total <= quota || !g_artifact.refs)
+        break;
+
+      if (g_hash_table_contains (g_artifact.refs, entry.path.c_str ()))
+        continue;
+
+      ml_logd ("The artifact directory '%s' is evicted from the cache.", entry.path.c_str ());
+      _remove_tree (entry.path.c_str ());
+      total -= entry.size;
+
+      /* Remove the directory of the model if it is empty. */
+      hash_dir = g_path_get_dirname (entry.path.c_str ());
+      g_rmdir (hash_dir);
+    }
+    G_UNLOCK (model_artifact_lock);
+  }
+
+  if (usage)
+    *usage = total;
+
+  return 0;
+}
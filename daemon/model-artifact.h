@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-artifact.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the cache of the compiled artifacts of the model backends
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The backends which can serialize the prepared state of the model (delegate caches, compiled graphs)
+ *    are given a directory to keep it across the pipeline launches. The directory is keyed by the hash of the model,
+ *    the backend and the backend options:
+ *
+ *      <cache dir>/<model hash>/<sha256 of the backend and the options>
+ *
+ *    A new model version has another hash, so it never reads the artifacts of the old one.
+ *    The artifacts of the hashes not registered anymore are removed, and the least recently used directories are removed over the quota.
+ *    The directories in use by the running pipelines are never removed.
+ */
+#ifndef __MODEL_ARTIFACT_H__
+#define __MODEL_ARTIFACT_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Enable the artifact cache at the given directory.
+ * @param[in] dir The root directory of the cache. If it is NULL or empty, the cache is disabled.
+ * @param[in] quota The disk quota in bytes of the cache. If it is 0, the cache is not limited.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_artifact_init (const gchar *dir, guint64 quota);
+
+/**
+ * @brief Disable the artifact cache. The cached artifacts are kept.
+ */
+void model_artifact_fini (void);
+
+/**
+ * @brief Check whether the artifact cache is enabled.
+ */
+gboolean model_artifact_is_enabled (void);
+
+/**
+ * @brief Get the artifact directory for the model and the backend, and mark it in use.
+ * @param[in] hash The hash of the model file.
+ * @param[in] backend The name of the backend, e.g., "tensorflow-lite".
+ * @param[in] options The backend options. It can be NULL.
+ * @param[out] dir The path of the artifact directory, created if it does not exist. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value. -ENOTSUP if the cache is disabled.
+ * @note Call model_artifact_release() when the pipeline using the directory is destroyed.
+ */
+gint model_artifact_acquire (const gchar *hash, const gchar *backend, const gchar *options, gchar **dir);
+
+/**
+ * @brief Release the artifact directory given by model_artifact_acquire(), and enforce the quota in the background.
+ * @param[in] dir The path of the artifact directory.
+ */
+void model_artifact_release (const gchar *dir);
+
+/**
+ * @brief Remove the artifacts of the models not registered anymore.
+ * @param[in] hashes The NULL-terminated array of the hashes of the registered models.
+ */
+void model_artifact_retain (const gchar *const *hashes);
+
+/**
+ * @brief Remove the least recently used artifact directories until the cache is under the quota.
+ * @param[out] usage The size in bytes of the cache after the removal. It can be NULL.
+ * @return @c 0 on success. Otherwise a negative error value. -ENOTSUP if the cache is disabled.
+ */
+gint model_artifact_enforce_quota (guint64 *usage);
+
+G_END_DECLS
+#endif /* __MODEL_ARTIFACT_H__ */
@@ -11,17 +11,38 @@
  */
 
 #include <errno.h>
+#include <gio/gunixfdlist.h>
 #include <glib.h>
+#include <json-glib/json-glib.h>
+#include <unistd.h>
 
+#include "agent-config.h"
 #include "common.h"
 #include "dbus-interface.h"
 #include "gdbus-util.h"
+#include "io-engine.h"
 #include "log.h"
+#include "model-artifact.h"
 #include "model-dbus.h"
+#include "model-integrity.h"
+#include "model-prefetch.h"
+#include "model-quota.h"
+#include "model-resident.h"
+#include "registry-watch.h"
+#include "model-store.h"
+#include "resource-files.h"
 #include "modules.h"
 #include "service-db-util.h"
+#include "startup-profile.h"
 
 static MachinelearningServiceModel *g_gdbus_instance = NULL;
+static gboolean g_model_initialized = FALSE;
+static GHashTable *g_inactive_blobs = NULL; /**< The hashes of the inactive blobs already requested to compress. */
+
+/**
+ * @brief The name of this module.
+ */
+#define MODEL_MODULE_NAME "model-interface"
 
 /**
  * @brief Utility function to get the DBus proxy of Model interface.
@@ -41,6 +62,396 @@ gdbus_put_model_instance (MachinelearningServiceModel **instance)
   g_clear_object (instance);
 }
 
+/**
+ * @brief Internal function to parse the model information.
+ * @return The root node of the model information. NULL if it is invalid. Call json_node_unref() to release it.
+ */
+static JsonNode *
+_parse_model_info (const gchar *model_info)
+{
+  g_autoptr (JsonParser) parser = json_parser_new ();
+  JsonNode *root;
+
+  if (!model_info || !json_parser_load_from_data (parser, model_info, -1, NULL))
+    return NULL;
+
+  root = json_parser_get_root (parser);
+  if (!root)
+    return NULL;
+
+  return json_node_ref (root);
+}
+
+/**
+ * @brief Internal function to get the string member of the model information.
+ * @return The value of the member. Call g_free() to release it.
+ */
+static gchar *
+_get_model_info_member (const gchar *model_info, const gchar *member)
+{
+  JsonNode *root = _parse_model_info (model_info);
+  gchar *value = NULL;
+
+  if (!root)
+    return NULL;
+
+  if (JSON_NODE_HOLDS_OBJECT (root)
+      && json_object_has_member (json_node_get_object (root), member))
+    value = g_strdup (json_object_get_string_member (json_node_get_object (root), member));
+
+  json_node_unref (root);
+  return value;
+}
+
+/**
+ * @brief Internal function to get the string member of the model object. NULL if it does not exist.
+ */
+static const gchar *
+_get_model_member (JsonObject *model, const gchar *member)
+{
+  if (!json_object_has_member (model, member))
+    return NULL;
+
+  return json_object_get_string_member (model, member);
+}
+
+/**
+ * @brief Internal function to add the runtime states of the model files to the model information.
+ * @details It does not decompress the model file. The blob of the model is decompressed when the model is activated.
+ * @param[in,out] model_info The model information, an object or an array of the objects.
+ * @param[in] prefetch Add the prefetch state of the model file.
+ */
+static void
+_update_model_info (gchar **model_info, gboolean prefetch)
+{
+  g_autoptr (JsonGenerator) gen = NULL;
+  JsonNode *root = _parse_model_info (*model_info);
+  JsonArray *array = NULL;
+  guint i, length = 1U;
+
+  if (!root)
+    return;
+
+  if (JSON_NODE_HOLDS_ARRAY (root)) {
+    array = json_node_get_array (root);
+    length = json_array_get_length (array);
+  } else if (!JSON_NODE_HOLDS_OBJECT (root)) {
+    json_node_unref (root);
+    return;
+  }
+
+  for (i = 0; i < length; i++) {
+    JsonObject *model = array ? json_array_get_object_element (array, i) : json_node_get_object (root);
+    const gchar *path, *hash;
+    model_integrity_e integrity;
+    guint64 reclaimed = 0;
+
+    if (!model)
+      continue;
+
+    path = _get_model_member (model, "path");
+    hash = _get_model_member (model, "hash");
+
+    if (hash && hash[0] != '\0' && model_store_is_enabled ()) {
+      if (model_store_get_compressed_info (hash, &reclaimed)) {
+        json_object_set_string_member (model, "storage", "compressed");
+        json_object_set_int_member (model, "reclaimed", (gint64) reclaimed);
+      } else {
+        json_object_set_string_member (model, "storage", "plain");
+      }
+    }
+
+    integrity = model_integrity_verify (path, hash, _get_model_member (model, "fingerprint"));
+    json_object_set_string_member (model, "integrity", model_integrity_to_string (integrity));
+    json_object_set_boolean_member (model, "valid", registry_watch_is_valid (path));
+
+    if (prefetch)
+      json_object_set_string_member (model, "prefetch", model_prefetch_get_state (path));
+  }
+
+  gen = json_generator_new ();
+  json_generator_set_root (gen, root);
+  g_free (*model_info);
+  *model_info = json_generator_to_data (gen, NULL);
+
+  json_node_unref (root);
+}
+
+/**
+ * @brief Internal function to prepare the file of the activated model.
+ *        It pins the blob in the model store, and requests the prefetch of the model file.
+ */
+static void
+_prepare_active_model (const gchar *name, const guint version)
+{
+  g_autofree gchar *model_info = NULL;
+  g_autofree gchar *path = NULL;
+  g_autofree gchar *hash = NULL;
+
+  if (!model_store_is_enabled () && !model_prefetch_is_enabled ())
+    return;
+
+  if (svcdb_model_get (name, version, &model_info) != 0)
+    return;
+
+  hash = _get_model_info_member (model_info, "hash");
+  if (hash && hash[0] != '\0' && model_store_is_enabled ())
+    model_store_materialize (hash, TRUE);
+
+  path = _get_model_info_member (model_info, "path");
+  model_prefetch_request (path);
+}
+
+/**
+ * @brief Internal function to request the compression of the blobs which are not referred by any active model.
+ *        Only the blobs which just became inactive are requested, the decompressed copies of the others are kept by the cache budget of the model store.
+ */
+static void
+_compress_inactive_models (void)
+{
+  g_autofree gchar *blobs = NULL;
+  GHashTable *inactive;
+  JsonNode *root;
+  JsonArray *array;
+  guint i;
+
+  if (!agent_config_get ()->compress_inactive || !model_store_is_enabled ())
+    return;
+
+  if (svcdb_model_list_blobs (&blobs) != 0)
+    return;
+
+  root = _parse_model_info (blobs);
+  if (!root)
+    return;
+
+  inactive = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  if (JSON_NODE_HOLDS_ARRAY (root)) {
+    array = json_node_get_array (root);
+
+    for (i = 0; i < json_array_get_length (array); i++) {
+      JsonObject *blob = json_array_get_object_element (array, i);
+      const gchar *hash;
+
+      if (!blob || g_strcmp0 (_get_model_member (blob, "active"), "T") == 0)
+        continue;
+
+      hash = _get_model_member (blob, "hash");
+      if (!hash)
+        continue;
+
+      if (!g_inactive_blobs || !g_hash_table_contains (g_inactive_blobs, hash))
+        model_store_compress_async (hash);
+
+      g_hash_table_add (inactive, g_strdup (hash));
+    }
+  }
+
+  if (g_inactive_blobs)
+    g_hash_table_destroy (g_inactive_blobs);
+  g_inactive_blobs = inactive;
+
+  json_node_unref (root);
+}
+
+/**
+ * @brief Internal function to remove the compiled artifacts of the models not registered anymore.
+ */
+static void
+_retain_model_artifacts (void)
+{
+  g_autofree gchar *blobs = NULL;
+  g_autoptr (GPtrArray) hashes = NULL;
+  JsonNode *root;
+  JsonArray *array;
+  guint i;
+
+  if (!model_artifact_is_enabled () || svcdb_model_list_blobs (&blobs) != 0)
+    return;
+
+  root = _parse_model_info (blobs);
+  if (!root)
+    return;
+
+  hashes = g_ptr_array_new ();
+
+  if (JSON_NODE_HOLDS_ARRAY (root)) {
+    array = json_node_get_array (root);
+
+    for (i = 0; i < json_array_get_length (array); i++) {
+      JsonObject *blob = json_array_get_object_element (array, i);
+
+      if (blob && _get_model_member (blob, "hash"))
+        g_ptr_array_add (hashes, (gpointer) _get_model_member (blob, "hash"));
+    }
+  }
+
+  g_ptr_array_add (hashes, NULL);
+  model_artifact_retain ((const gchar *const *) hashes->pdata);
+
+  json_node_unref (root);
+}
+
+/**
+ * @brief Internal function to record the access of the model in the model information.
+ */
+static void
+_touch_model (const gchar *name, const gchar *model_info)
+{
+  g_autofree gchar *version = _get_model_info_member (model_info, "version");
+
+  if (version)
+    model_quota_touch (name, (guint) g_ascii_strtoull (version, NULL, 10));
+}
+
+/**
+ * @brief Internal function to watch the files of all registered models, except the blobs in the model store.
+ */
+static void
+_watch_registered_models (void)
+{
+  g_autofree gchar *paths = NULL;
+  g_autoptr (GPtrArray) array = NULL;
+  JsonNode *root;
+  JsonArray *list;
+  guint i;
+
+  if (svcdb_model_list_paths (&paths) != 0)
+    return;
+
+  root = _parse_model_info (paths);
+  if (!root)
+    return;
+
+  array = g_ptr_array_new ();
+
+  if (JSON_NODE_HOLDS_ARRAY (root)) {
+    list = json_node_get_array (root);
+
+    /* The blobs in the model store may be compressed and removed by the store itself. */
+    for (i = 0; i < json_array_get_length (list); i++) {
+      const gchar *path = json_array_get_string_element (list, i);
+
+      if (!model_store_owns_path (path))
+        g_ptr_array_add (array, (gpointer) path);
+    }
+  }
+
+  g_ptr_array_add (array, NULL);
+  registry_watch_sync (REGISTRY_WATCH_MODEL, (const gchar *const *) array->pdata);
+
+  json_node_unref (root);
+}
+
+/**
+ * @brief Internal function to drop the cached states of the changed model file, and to notify the clients.
+ */
+static void
+_model_file_changed (const gchar *path, const gchar *event, gboolean valid, gpointer user_data)
+{
+  model_integrity_invalidate (path);
+  model_resident_invalidate (path);
+
+  if (g_gdbus_instance)
+    machinelearning_service_model_emit_file_changed (g_gdbus_instance, path, event, valid);
+}
+
+/**
+ * @brief Internal function to prepare the files of all activated models, as they are activated.
+ *        It pins the blobs in the model store, and requests the prefetch of the model files.
+ */
+static void
+_prepare_activated_models (void)
+{
+  g_autofree gchar *models = NULL;
+  JsonNode *root;
+  JsonArray *array;
+  guint i;
+
+  if (!model_store_is_enabled () && !model_prefetch_is_enabled ())
+    return;
+
+  if (svcdb_model_list_activated (&models) != 0)
+    return;
+
+  root = _parse_model_info (models);
+  if (!root)
+    return;
+
+  if (JSON_NODE_HOLDS_ARRAY (root)) {
+    array = json_node_get_array (root);
+
+    for (i = 0; i < json_array_get_length (array); i++) {
+      JsonObject *model = json_array_get_object_element (array, i);
+      const gchar *hash;
+
+      if (!model)
+        continue;
+
+      hash = _get_model_member (model, "hash");
+      if (hash && hash[0] != '\0' && model_store_is_enabled ())
+        model_store_materialize (hash, TRUE);
+
+      model_prefetch_request (_get_model_member (model, "path"));
+    }
+  }
+
+  json_node_unref (root);
+}
+
+/**
+ * @brief Internal function to release the prefetch budget of the model files deactivated or deleted.
+ */
+static void
+_retain_prefetched_models (void)
+{
+  g_autofree gchar *models = NULL;
+  g_autoptr (GPtrArray) paths = NULL;
+  JsonNode *root;
+  JsonArray *array;
+  guint i;
+
+  if (!model_prefetch_is_enabled ())
+    return;
+
+  if (svcdb_model_list_activated (&models) != 0)
+    return;
+
+  root = _parse_model_info (models);
+  if (!root)
+    return;
+
+  paths = g_ptr_array_new ();
+
+  if (JSON_NODE_HOLDS_ARRAY (root)) {
+    array = json_node_get_array (root);
+
+    for (i = 0; i < json_array_get_length (array); i++) {
+      JsonObject *model = json_array_get_object_element (array, i);
+
+      if (model && json_object_has_member (model, "path"))
+        g_ptr_array_add (paths, (gpointer) json_object_get_string_member (model, "path"));
+    }
+  }
+
+  g_ptr_array_add (paths, NULL);
+  model_prefetch_retain ((const gchar *const *) paths->pdata);
+
+  json_node_unref (root);
+}
+
+/**
+ * @brief The callback function to initialize this module before the method call, if it is not initialized in the background yet.
+ */
+static gboolean
+gdbus_cb_model_authorize_method (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, gpointer user_data)
+{
+  ensure_module (MODEL_MODULE_NAME);
+  return TRUE;
+}
+
 /**
  * @brief The callback function of Register method
  *
@@ -63,6 +474,160 @@ gdbus_cb_model_register (MachinelearningServiceModel *obj,
   ret = svcdb_model_add (name, path, is_active, description, app_info, &version);
   machinelearning_service_model_complete_register (obj, invoc, version, ret);
 
+  if (ret == 0 && is_active) {
+    _prepare_active_model (name, version);
+    _retain_prefetched_models ();
+  }
+  if (ret == 0) {
+    _compress_inactive_models ();
+    _watch_registered_models ();
+    model_quota_schedule ();
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of RegisterFromFd method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param fd_list The list of file descriptors passed with the message.
+ * @param name The name of target model.
+ * @param fd_index The index of the file descriptor of the model in @a fd_list.
+ * @param is_active The active status of target model.
+ * @param description The description of target model.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_register_from_fd (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, GUnixFDList *fd_list, const gchar *name,
+    gint fd_index, const bool is_active, const gchar *description, const gchar *app_info)
+{
+  g_autofree gchar *blob_path = NULL;
+  g_autofree gchar *hash = NULL;
+  GError *err = NULL;
+  gint ret = 0;
+  guint version = 0U;
+  int fd = -1;
+
+  if (!name || name[0] == '\0' || !fd_list) {
+    ret = -EINVAL;
+    goto done;
+  }
+
+  fd = g_unix_fd_list_get (fd_list, fd_index, &err);
+  if (fd < 0) {
+    ml_loge ("Failed to get the file descriptor of the model '%s' (%s).", name,
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+    ret = -EINVAL;
+    goto done;
+  }
+
+  /* Stage the model into the store before inserting the row, the row always refers to the complete blob. */
+  ret = model_store_add_from_fd (fd, &blob_path, &hash);
+  close (fd);
+
+  if (ret == 0)
+    ret = svcdb_model_add (name, blob_path, is_active, description, app_info, &version);
+
+done:
+  machinelearning_service_model_complete_register_from_fd (obj, invoc, NULL, version, ret);
+
+  if (ret == 0 && is_active) {
+    _prepare_active_model (name, version);
+    _retain_prefetched_models ();
+  }
+  if (ret == 0) {
+    _compress_inactive_models ();
+    _watch_registered_models ();
+    model_quota_schedule ();
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of RegisterDelta method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param fd_list The list of file descriptors passed with the message.
+ * @param name The name of target model.
+ * @param base_version The version of the model which the delta is applied to.
+ * @param fd_index The index of the file descriptor of the delta in @a fd_list.
+ * @param is_active The active status of target model.
+ * @param description The description of target model.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_register_delta (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, GUnixFDList *fd_list, const gchar *name,
+    const guint base_version, gint fd_index, const bool is_active,
+    const gchar *description, const gchar *app_info)
+{
+  g_autofree gchar *base_info = NULL;
+  g_autofree gchar *base_path = NULL;
+  g_autofree gchar *base_hash = NULL;
+  g_autofree gchar *blob_path = NULL;
+  g_autofree gchar *hash = NULL;
+  GError *err = NULL;
+  gint ret = 0;
+  guint version = 0U;
+  int fd = -1;
+
+  if (!name || name[0] == '\0' || base_version == 0U || !fd_list) {
+    ret = -EINVAL;
+    goto done;
+  }
+
+  ret = svcdb_model_get (name, base_version, &base_info);
+  if (ret != 0)
+    goto done;
+
+  base_path = _get_model_info_member (base_info, "path");
+  if (!base_path) {
+    ret = -EINVAL;
+    goto done;
+  }
+
+  /* The base of the inactive model may be compressed in the model store. */
+  base_hash = _get_model_info_member (base_info, "hash");
+  if (base_hash && base_hash[0] != '\0' && model_store_is_enabled ()) {
+    ret = model_store_materialize (base_hash, FALSE);
+    if (ret != 0)
+      goto done;
+  }
+
+  fd = g_unix_fd_list_get (fd_list, fd_index, &err);
+  if (fd < 0) {
+    ml_loge ("Failed to get the file descriptor of the delta of the model '%s' (%s).",
+        name, err ? err->message : "unknown reason");
+    g_clear_error (&err);
+    ret = -EINVAL;
+    goto done;
+  }
+
+  ret = model_store_add_delta (base_path, fd, &blob_path, &hash);
+  close (fd);
+
+  if (ret == 0)
+    ret = svcdb_model_add (name, blob_path, is_active, description, app_info, &version);
+
+done:
+  machinelearning_service_model_complete_register_delta (obj, invoc, NULL, version, ret);
+
+  if (ret == 0 && is_active) {
+    _prepare_active_model (name, version);
+    _retain_prefetched_models ();
+  }
+  if (ret == 0) {
+    _compress_inactive_models ();
+    _watch_registered_models ();
+    model_quota_schedule ();
+  }
+
   return TRUE;
 }
 
@@ -105,8 +670,21 @@ gdbus_cb_model_activate (MachinelearningServiceModel *obj,
   gint ret = 0;
 
   ret = svcdb_model_activate (name, version);
+
+  /* Decompress the model before replying, the client may open it right away. */
+  if (ret == 0) {
+    _prepare_active_model (name, version);
+    model_quota_touch (name, version);
+  }
+
   machinelearning_service_model_complete_activate (obj, invoc, ret);
 
+  if (ret == 0) {
+    _retain_prefetched_models ();
+    _compress_inactive_models ();
+    model_quota_schedule ();
+  }
+
   return TRUE;
 }
 
@@ -126,6 +704,11 @@ gdbus_cb_model_get (MachinelearningServiceModel *obj,
   g_autofree gchar *model_info = NULL;
 
   ret = svcdb_model_get (name, version, &model_info);
+  if (ret == 0) {
+    _update_model_info (&model_info, FALSE);
+    _touch_model (name, model_info);
+  }
+
   machinelearning_service_model_complete_get (obj, invoc, model_info, ret);
 
   return TRUE;
@@ -147,11 +730,96 @@ gdbus_cb_model_get_activated (MachinelearningServiceModel *obj,
   g_autofree gchar *model_info = NULL;
 
   ret = svcdb_model_get_activated (name, &model_info);
+  if (ret == 0) {
+    _update_model_info (&model_info, model_prefetch_is_enabled ());
+    _touch_model (name, model_info);
+  }
+
   machinelearning_service_model_complete_get_activated (obj, invoc, model_info, ret);
 
   return TRUE;
 }
 
+/**
+ * @brief The callback function of get activated fd method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param fd_list The list of file descriptors passed with the message.
+ * @param name The name of target model.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_get_activated_fd (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, GUnixFDList *fd_list, const gchar *name)
+{
+  g_autofree gchar *model_info = NULL;
+  g_autofree gchar *path = NULL;
+  GUnixFDList *out_fd_list = NULL;
+  gint ret = 0;
+  gint index = -1;
+  int fd = -1;
+
+  ret = svcdb_model_get_activated (name, &model_info);
+  if (ret == 0) {
+    _update_model_info (&model_info, model_prefetch_is_enabled ());
+    _touch_model (name, model_info);
+
+    path = _get_model_info_member (model_info, "path");
+    ret = path ? model_resident_open (path, &fd, NULL) : -EINVAL;
+  }
+
+  /* The list owns the descriptor, and closes it after the reply is sent. */
+  if (ret == 0) {
+    out_fd_list = g_unix_fd_list_new_from_array (&fd, 1);
+    index = 0;
+  }
+
+  machinelearning_service_model_complete_get_activated_fd (obj, invoc, out_fd_list,
+      model_info ? model_info : "", index, ret);
+
+  if (out_fd_list)
+    g_object_unref (out_fd_list);
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of get resident stats method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_get_resident_stats (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc)
+{
+  g_autofree gchar *stats = model_resident_get_stats ();
+
+  machinelearning_service_model_complete_get_resident_stats (obj, invoc, stats, 0);
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of GetStartupStats method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_get_startup_stats (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc)
+{
+  g_autofree gchar *stats = startup_profile_get_json ();
+
+  machinelearning_service_model_complete_get_startup_stats (obj, invoc, stats, 0);
+
+  return TRUE;
+}
+
 /**
  * @brief The callback function of get all method
  *
@@ -168,11 +836,221 @@ gdbus_cb_model_get_all (MachinelearningServiceModel *obj,
   g_autofree gchar *model_info = NULL;
 
   ret = svcdb_model_get_all (name, &model_info);
+  if (ret == 0)
+    _update_model_info (&model_info, FALSE);
+
   machinelearning_service_model_complete_get_all (obj, invoc, model_info, ret);
 
   return TRUE;
 }
 
+/**
+ * @brief Internal function to prepare the models installed with the configuration, and update the states of the registry.
+ * @param[in] models The JSON array of the name, version and activation of the installed models.
+ */
+static void
+_apply_installed_models (const gchar *models)
+{
+  JsonNode *root;
+  JsonArray *array;
+  guint i;
+
+  root = _parse_model_info (models);
+  if (root && JSON_NODE_HOLDS_ARRAY (root)) {
+    array = json_node_get_array (root);
+
+    for (i = 0; i < json_array_get_length (array); i++) {
+      JsonObject *model = json_array_get_object_element (array, i);
+
+      if (model && json_object_get_boolean_member (model, "active"))
+        _prepare_active_model (json_object_get_string_member (model, "name"),
+            (guint) json_object_get_int_member (model, "version"));
+    }
+
+    if (json_array_get_length (array) > 0U) {
+      _retain_prefetched_models ();
+      _compress_inactive_models ();
+      _watch_registered_models ();
+      model_quota_schedule ();
+    }
+  }
+
+  if (root)
+    json_node_unref (root);
+
+  /* The resources installed with the models are read ahead as they are added. */
+  resource_files_sync (TRUE);
+}
+
+/**
+ * @brief The callback function of install method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param config The JSON string of the models, pipelines and resources, in the format of rpk_config.json.
+ * @param app_info The application information of the models and resources.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_install (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, const gchar *config, const gchar *app_info)
+{
+  gint ret = 0;
+  g_autofree gchar *models = NULL;
+
+  ret = svcdb_install (config, app_info, &models);
+  machinelearning_service_model_complete_install (obj, invoc, models ? models : "", ret);
+
+  if (ret == 0)
+    _apply_installed_models (models);
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of upgrade method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param config The JSON string of the models, pipelines and resources, in the format of rpk_config.json.
+ * @param app_info The application information with the package id of the models and resources.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_upgrade (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, const gchar *config, const gchar *app_info)
+{
+  gint ret = 0;
+  g_autofree gchar *models = NULL;
+
+  ret = svcdb_upgrade (config, app_info, &models);
+  machinelearning_service_model_complete_upgrade (obj, invoc, models ? models : "", ret);
+
+  if (ret == 0) {
+    _apply_installed_models (models);
+
+    /* The models removed from the package are deleted. */
+    _retain_prefetched_models ();
+    _watch_registered_models ();
+    _retain_model_artifacts ();
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the file descriptor of the configuration passed with the message.
+ */
+static gint
+_get_config_fd (GUnixFDList *fd_list, gint fd_index)
+{
+  GError *err = NULL;
+  gint fd;
+
+  if (!fd_list)
+    return -1;
+
+  fd = g_unix_fd_list_get (fd_list, fd_index, &err);
+  if (fd < 0) {
+    ml_loge ("Failed to get the file descriptor of the configuration (%s).",
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+  }
+
+  return fd;
+}
+
+/**
+ * @brief The callback function of InstallFromFd method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param fd_list The list of file descriptors passed with the message.
+ * @param fd_index The index of the file descriptor of the configuration file in @a fd_list.
+ * @param app_info The application information of the models and resources.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_install_from_fd (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, GUnixFDList *fd_list, gint fd_index, const gchar *app_info)
+{
+  gint ret = -EINVAL;
+  g_autofree gchar *models = NULL;
+  gint fd = _get_config_fd (fd_list, fd_index);
+
+  if (fd >= 0) {
+    ret = svcdb_install_from_fd (fd, app_info, &models);
+    close (fd);
+  }
+
+  machinelearning_service_model_complete_install_from_fd (obj, invoc, NULL, models ? models : "", ret);
+
+  if (ret == 0)
+    _apply_installed_models (models);
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of UpgradeFromFd method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param fd_list The list of file descriptors passed with the message.
+ * @param fd_index The index of the file descriptor of the configuration file in @a fd_list.
+ * @param app_info The application information with the package id of the models and resources.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_upgrade_from_fd (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, GUnixFDList *fd_list, gint fd_index, const gchar *app_info)
+{
+  gint ret = -EINVAL;
+  g_autofree gchar *models = NULL;
+  gint fd = _get_config_fd (fd_list, fd_index);
+
+  if (fd >= 0) {
+    ret = svcdb_upgrade_from_fd (fd, app_info, &models);
+    close (fd);
+  }
+
+  machinelearning_service_model_complete_upgrade_from_fd (obj, invoc, NULL, models ? models : "", ret);
+
+  if (ret == 0) {
+    _apply_installed_models (models);
+
+    /* The models removed from the package are deleted. */
+    _retain_prefetched_models ();
+    _watch_registered_models ();
+    _retain_model_artifacts ();
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of list method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param pattern The GLOB pattern of the model names. Empty string for all models.
+ * @param cursor The cursor returned with the previous page. Empty string for the first page.
+ * @param limit The maximum number of the names in the page. 0 for the default.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_list (MachinelearningServiceModel *obj, GDBusMethodInvocation *invoc,
+    const gchar *pattern, const gchar *cursor, guint limit)
+{
+  gint ret = 0;
+  g_autofree gchar *list = NULL;
+
+  ret = svcdb_list_names ("model", pattern, cursor, limit, &list);
+  machinelearning_service_model_complete_list (obj, invoc, list ? list : "", ret);
+
+  return TRUE;
+}
+
 /**
  * @brief The callback function of delete method
  *
@@ -192,6 +1070,69 @@ gdbus_cb_model_delete (MachinelearningServiceModel *obj,
   ret = svcdb_model_delete (name, version, force);
   machinelearning_service_model_complete_delete (obj, invoc, ret);
 
+  if (ret == 0) {
+    _retain_prefetched_models ();
+    _watch_registered_models ();
+    _retain_model_artifacts ();
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of pin method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param name The name of target model.
+ * @param version The version of target model.
+ * @param pinned If it is @c TRUE, the target model is never evicted from the model store.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_pin (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, const gchar *name, const guint version, const gboolean pinned)
+{
+  gint ret = 0;
+
+  ret = svcdb_model_pin (name, version, pinned);
+  machinelearning_service_model_complete_pin (obj, invoc, ret);
+
+  /* The unpinned model may be evicted now. */
+  if (ret == 0 && !pinned)
+    model_quota_schedule ();
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of evict method
+ *
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param dry_run If it is @c TRUE, only report the models to be evicted.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_model_evict (MachinelearningServiceModel *obj,
+    GDBusMethodInvocation *invoc, const gboolean dry_run)
+{
+  gint ret = 0;
+  g_autofree gchar *report = NULL;
+  guint64 quota = model_quota_get ();
+
+  if (quota == 0 || !model_store_is_enabled ())
+    ret = -ENOTSUP;
+  else
+    ret = model_quota_evict (quota, dry_run, 0U, &report);
+
+  machinelearning_service_model_complete_evict (obj, invoc, report ? report : "", ret);
+
+  if (ret == 0 && !dry_run) {
+    _watch_registered_models ();
+    _retain_model_artifacts ();
+  }
+
   return TRUE;
 }
 
@@ -199,12 +1140,30 @@ gdbus_cb_model_delete (MachinelearningServiceModel *obj,
  * @brief Event handler list of Model interface
  */
 static struct gdbus_signal_info handler_infos[] = {
+  {
+      .signal_name = DBUS_ML_I_AUTHORIZE_METHOD_HANDLER,
+      .cb = G_CALLBACK (gdbus_cb_model_authorize_method),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
   {
       .signal_name = DBUS_MODEL_I_HANDLER_REGISTER,
       .cb = G_CALLBACK (gdbus_cb_model_register),
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_REGISTER_FROM_FD,
+      .cb = G_CALLBACK (gdbus_cb_model_register_from_fd),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_REGISTER_DELTA,
+      .cb = G_CALLBACK (gdbus_cb_model_register_delta),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
   {
       .signal_name = DBUS_MODEL_I_HANDLER_UPDATE_DESCRIPTION,
       .cb = G_CALLBACK (gdbus_cb_model_update_description),
@@ -229,18 +1188,78 @@ static struct gdbus_signal_info handler_infos[] = {
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_GET_ACTIVATED_FD,
+      .cb = G_CALLBACK (gdbus_cb_model_get_activated_fd),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_GET_STARTUP_STATS,
+      .cb = G_CALLBACK (gdbus_cb_model_get_startup_stats),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_GET_RESIDENT_STATS,
+      .cb = G_CALLBACK (gdbus_cb_model_get_resident_stats),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
   {
       .signal_name = DBUS_MODEL_I_HANDLER_GET_ALL,
       .cb = G_CALLBACK (gdbus_cb_model_get_all),
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_INSTALL,
+      .cb = G_CALLBACK (gdbus_cb_model_install),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_UPGRADE,
+      .cb = G_CALLBACK (gdbus_cb_model_upgrade),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_INSTALL_FROM_FD,
+      .cb = G_CALLBACK (gdbus_cb_model_install_from_fd),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_UPGRADE_FROM_FD,
+      .cb = G_CALLBACK (gdbus_cb_model_upgrade_from_fd),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_LIST,
+      .cb = G_CALLBACK (gdbus_cb_model_list),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
   {
       .signal_name = DBUS_MODEL_I_HANDLER_DELETE,
       .cb = G_CALLBACK (gdbus_cb_model_delete),
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_PIN,
+      .cb = G_CALLBACK (gdbus_cb_model_pin),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_MODEL_I_HANDLER_EVICT,
+      .cb = G_CALLBACK (gdbus_cb_model_evict),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
 };
 
 /**
@@ -287,11 +1306,45 @@ out:
 
 /**
  * @brief The callback function for initializing Model Interface module.
+ * @details It is called in the idle time of the main loop after the daemon is ready, or at the first method call.
  */
 static void
 init_model_module (void *data)
 {
-  gdbus_initialize ();
+  g_model_initialized = TRUE;
+
+  if (io_engine_init ((guint) MAX (agent_config_get ()->io_queue_depth, 0)) != 0)
+    ml_logw ("The I/O engine is not available, the model files are read with the blocking I/O.");
+
+  if (model_store_init (agent_config_get ()->model_store) != 0)
+    ml_logw ("The model store is not available, register the model files as they are.");
+
+  model_store_set_cache_budget ((guint64) MAX (agent_config_get ()->model_cache_budget, 0));
+  model_prefetch_init ((guint64) MAX (agent_config_get ()->model_prefetch_budget, 0));
+  model_resident_init ((guint64) MAX (agent_config_get ()->model_resident_budget, 0),
+      agent_config_get ()->model_resident_lock);
+  _prepare_activated_models ();
+  _compress_inactive_models ();
+
+  if (registry_watch_init () == 0) {
+    registry_watch_set_listener (REGISTRY_WATCH_MODEL, _model_file_changed, NULL);
+    _watch_registered_models ();
+  }
+
+  if (model_artifact_init (agent_config_get ()->model_artifact_cache,
+          (guint64) MAX (agent_config_get ()->model_artifact_quota, 0)) == 0)
+    _retain_model_artifacts ();
+
+  model_quota_init ((guint64) MAX (agent_config_get ()->model_store_quota, 0));
+}
+
+/**
+ * @brief Check this module has the model files being read ahead, or the blobs to be compressed or evicted.
+ */
+static int
+busy_model_module (void *data)
+{
+  return (model_prefetch_is_running () || model_store_is_compressing () || model_quota_is_evicting ());
 }
 
 /**
@@ -300,15 +1353,29 @@ init_model_module (void *data)
 static void
 exit_model_module (void *data)
 {
+  if (g_model_initialized) {
+    registry_watch_fini ();
+    model_artifact_fini ();
+    model_quota_fini ();
+    model_resident_fini ();
+    model_prefetch_fini ();
+    model_store_fini ();
+    io_engine_fini ();
+    g_clear_pointer (&g_inactive_blobs, g_hash_table_destroy);
+    g_model_initialized = FALSE;
+  }
+
   gdbus_disconnect_signal (g_gdbus_instance, ARRAY_SIZE (handler_infos), handler_infos);
   gdbus_put_model_instance (&g_gdbus_instance);
 }
 
 static const struct module_ops model_ops = {
-  .name = "model-interface",
+  .name = MODEL_MODULE_NAME,
   .probe = probe_model_module,
   .init = init_model_module,
   .exit = exit_model_module,
+  .init_type = MODULE_INIT_BACKGROUND,
+  .busy = busy_model_module,
 };
 
 MODULE_OPS_REGISTER (&model_ops)
@@ -0,0 +1,276 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-delta.cc
+ * @date      18 Oct 2026
+ * @brief     Binary delta between the model versions.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This applies the copy and insert operations of the delta to reconstruct the new version of the model.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "model-delta.h"
+
+/**
+ * @brief The size of the buffer to read the delta and to copy the base.
+ */
+#define MODEL_DELTA_BUFFER_SIZE (256U * 1024U)
+
+/**
+ * @brief The length of the hex string of the target hash.
+ */
+#define MODEL_DELTA_HASH_LEN (64U)
+
+/**
+ * @brief Structure for the buffered reader of the delta.
+ */
+typedef struct {
+  int fd;
+  guint8 buf[MODEL_DELTA_BUFFER_SIZE];
+  gsize pos;
+  gsize len;
+} model_delta_reader_s;
+
+/**
+ * @brief Internal function to read the bytes from the delta.
+ */
+static gint
+_reader_read (model_delta_reader_s *reader, guint8 *data, gsize length)
+{
+  while (length > 0) {
+    gsize n;
+
+    if (reader->pos == reader->len) {
+      ssize_t r = read (reader->fd, reader->buf, sizeof (reader->buf));
+
+      if (r < 0 && errno == EINTR)
+        continue;
+      if (r < 0)
+        return -errno;
+      if (r == 0)
+        return -EBADMSG;
+
+      reader->pos = 0;
+      reader->len = (gsize) r;
+    }
+
+    n = MIN (length, reader->len - reader->pos);
+    memcpy (data, reader->buf + reader->pos, n);
+    reader->pos += n;
+    data += n;
+    length -= n;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to read the 64-bit integer from the delta.
+ */
+static gint
+_reader_read_u64 (model_delta_reader_s *reader, guint64 *value)
+{
+  guint64 le;
+  gint ret = _reader_read (reader, (guint8 *) &le, sizeof (le));
+
+  if (ret == 0)
+    *value = GUINT64_FROM_LE (le);
+
+  return ret;
+}
+
+/**
+ * @brief Internal function to write the whole buffer at the offset of the file.
+ */
+static gint
+_write_full (int fd, const guint8 *buf, gsize length, goffset offset)
+{
+  gsize done = 0;
+
+  while (done < length) {
+    ssize_t n = pwrite (fd, buf + done, length - done, offset + done);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return (n < 0) ? -errno : -EIO;
+
+    done += n;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to copy the range of the base into the target.
+ */
+static gint
+_copy_range (int base_fd, goffset offset, int out_fd, goffset out_offset, guint64 length, guint8 *buf)
+{
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 27)
+  /* The kernel may share the extents if the base and the target are in the same file system. */
+  while (length > 0) {
+    loff_t in_off = offset, out_off = out_offset;
+    ssize_t n = copy_file_range (base_fd, &in_off, out_fd, &out_off, length, 0);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+
+    offset += n;
+    out_offset += n;
+    length -= n;
+  }
+#endif
+#endif
+
+  while (length > 0) {
+    gsize len = (gsize) MIN ((guint64) MODEL_DELTA_BUFFER_SIZE, length);
+    ssize_t n = pread (base_fd, buf, len, offset);
+    gint ret;
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return (n < 0) ? -errno : -EIO;
+
+    ret = _write_full (out_fd, buf, n, out_offset);
+    if (ret != 0)
+      return ret;
+
+    offset += n;
+    out_offset += n;
+    length -= n;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to apply the operations of the delta.
+ */
+static gint
+_apply_ops (model_delta_reader_s *reader, int base_fd, guint64 base_size, int out_fd, guint64 target_size)
+{
+  guint8 *buf;
+  guint64 written = 0;
+  gint ret = 0;
+
+  buf = (guint8 *) g_try_malloc (MODEL_DELTA_BUFFER_SIZE);
+  if (!buf)
+    return -ENOMEM;
+
+  while (ret == 0) {
+    guint64 offset = 0, length = 0;
+    guint8 op;
+
+    ret = _reader_read (reader, &op, 1);
+    if (ret != 0)
+      break;
+
+    if (op == MODEL_DELTA_OP_END) {
+      if (written != target_size)
+        ret = -EBADMSG;
+      break;
+    }
+
+    if (op == MODEL_DELTA_OP_COPY)
+      ret = _reader_read_u64 (reader, &offset);
+    if (ret == 0)
+      ret = _reader_read_u64 (reader, &length);
+    if (ret != 0)
+      break;
+
+    /* Never write out of the target, and never read out of the base. */
+    if (length > target_size - written) {
+      ret = -EBADMSG;
+      break;
+    }
+
+    if (op == MODEL_DELTA_OP_COPY) {
+      if (offset > base_size || length > base_size - offset)
+        ret = -EBADMSG;
+      else
+        ret = _copy_range (base_fd, offset, out_fd, written, length, buf);
+
+      written += length;
+    } else if (op == MODEL_DELTA_OP_INSERT) {
+      while (ret == 0 && length > 0) {
+        gsize len = (gsize) MIN ((guint64) MODEL_DELTA_BUFFER_SIZE, length);
+
+        ret = _reader_read (reader, buf, len);
+        if (ret == 0)
+          ret = _write_full (out_fd, buf, len, written);
+
+        written += len;
+        length -= len;
+      }
+    } else {
+      ml_loge ("Unknown operation '0x%02x' in the model delta.", op);
+      ret = -EBADMSG;
+    }
+  }
+
+  g_free (buf);
+  return ret;
+}
+
+/**
+ * @brief Reconstruct the target file from the base file and the delta.
+ */
+gint
+model_delta_apply (int base_fd, int delta_fd, int out_fd, gchar **target_hash)
+{
+  model_delta_reader_s *reader;
+  guint8 magic[MODEL_DELTA_MAGIC_LEN];
+  gchar hash[MODEL_DELTA_HASH_LEN + 1];
+  guint64 target_size = 0;
+  struct stat st;
+  gint ret;
+
+  g_return_val_if_fail (base_fd >= 0 && delta_fd >= 0 && out_fd >= 0 && target_hash != NULL, -EINVAL);
+
+  if (fstat (base_fd, &st) != 0)
+    return -errno;
+
+  reader = g_new0 (model_delta_reader_s, 1);
+  reader->fd = delta_fd;
+
+  ret = _reader_read (reader, magic, sizeof (magic));
+  if (ret == 0 && memcmp (magic, MODEL_DELTA_MAGIC, MODEL_DELTA_MAGIC_LEN) != 0)
+    ret = -EBADMSG;
+  if (ret == 0)
+    ret = _reader_read_u64 (reader, &target_size);
+  if (ret == 0)
+    ret = _reader_read (reader, (guint8 *) hash, MODEL_DELTA_HASH_LEN);
+
+  if (ret == 0) {
+    hash[MODEL_DELTA_HASH_LEN] = '\0';
+    ret = _apply_ops (reader, base_fd, (guint64) st.st_size, out_fd, target_size);
+  }
+
+  g_free (reader);
+
+  if (ret != 0) {
+    ml_loge ("Failed to apply the model delta (%d).", ret);
+    return ret;
+  }
+
+  *target_hash = g_ascii_strdown (hash, -1);
+  return 0;
+}
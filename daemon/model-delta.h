@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-delta.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the binary delta between the model versions
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The new version of the model is reconstructed from the base version and the delta.
+ *    The delta starts with the header, followed by the operations. All integers are 64-bit little endian.
+ *
+ *      header : "MLDELTA1" | target size | target hash (64 hex characters, see model-store.h)
+ *      'C'    : offset | length          copy the range of the base
+ *      'I'    : length | data            insert the data
+ *      'E'    :                          end of the delta
+ */
+#ifndef __MODEL_DELTA_H__
+#define __MODEL_DELTA_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+#define MODEL_DELTA_MAGIC "MLDELTA1"
+#define MODEL_DELTA_MAGIC_LEN (8U)
+
+#define MODEL_DELTA_OP_COPY 'C'
+#define MODEL_DELTA_OP_INSERT 'I'
+#define MODEL_DELTA_OP_END 'E'
+
+/**
+ * @brief Reconstruct the target file from the base file and the delta.
+ * @param[in] base_fd The file descriptor of the base version.
+ * @param[in] delta_fd The file descriptor to read the delta from. It may be a pipe.
+ * @param[in] out_fd The file descriptor to write the target. It should be empty.
+ * @param[out] target_hash The hash of the target written in the delta header. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value. -EBADMSG if the delta is malformed.
+ */
+gint model_delta_apply (int base_fd, int delta_fd, int out_fd, gchar **target_hash);
+
+G_END_DECLS
+#endif /* __MODEL_DELTA_H__ */
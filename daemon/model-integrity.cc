@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-integrity.cc
+ * @date      18 Oct 2026
+ * @brief     Integrity verification of the registered model files.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This caches the verified state of the model files keyed by the file fingerprint.
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <sys/stat.h>
+
+#include "log.h"
+#include "model-integrity.h"
+#include "model-store.h"
+
+/**
+ * @brief Structure for the cached result of the model file.
+ */
+typedef struct {
+  gchar *fingerprint; /**< The device, inode, size and mtime of the file. */
+  gchar *hash; /**< The registered hash which the file is compared with. */
+  model_integrity_e integrity;
+} model_integrity_entry_s;
+
+static GHashTable *g_integrity_cache = NULL;
+G_LOCK_DEFINE_STATIC (integrity_lock);
+
+/**
+ * @brief Internal function to release the cached result.
+ */
+static void
+_entry_free (gpointer data)
+{
+  model_integrity_entry_s *entry = (model_integrity_entry_s *) data;
+
+  g_free (entry->fingerprint);
+  g_free (entry->hash);
+  g_free (entry);
+}
+
+/**
+ * @brief Internal function to get the fingerprint string of the file status.
+ */
+static gchar *
+_get_fingerprint (const struct stat *st)
+{
+  return g_strdup_printf ("%" G_GUINT64_FORMAT ":%" G_GUINT64_FORMAT ":%" G_GINT64_FORMAT ":%" G_GINT64_FORMAT ".%09ld",
+      (guint64) st->st_dev, (guint64) st->st_ino, (gint64) st->st_size,
+      (gint64) st->st_mtim.tv_sec, (long) st->st_mtim.tv_nsec);
+}
+
+/**
+ * @brief Internal function to cache the result of the model file.
+ */
+static void
+_cache_result (const gchar *path, gchar *fingerprint, const gchar *hash, model_integrity_e integrity)
+{
+  model_integrity_entry_s *entry;
+
+  entry = g_new0 (model_integrity_entry_s, 1);
+  entry->fingerprint = fingerprint;
+  entry->hash = g_strdup (hash);
+  entry->integrity = integrity;
+
+  G_LOCK (integrity_lock);
+  if (!g_integrity_cache)
+    g_integrity_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, _entry_free);
+  g_hash_table_replace (g_integrity_cache, g_strdup (path), entry);
+  G_UNLOCK (integrity_lock);
+}
+
+/**
+ * @brief Verify the model file with the registered hash.
+ */
+model_integrity_e
+model_integrity_verify (const gchar *path, const gchar *hash, const gchar *fingerprint)
+{
+  model_integrity_entry_s *entry;
+  model_integrity_e integrity = MODEL_INTEGRITY_UNKNOWN;
+  g_autofree gchar *current = NULL;
+  gchar *current_fp;
+  struct stat st;
+
+  if (!path || !hash || hash[0] == '\0')
+    return MODEL_INTEGRITY_UNKNOWN;
+
+  if (g_stat (path, &st) != 0 || !S_ISREG (st.st_mode))
+    return MODEL_INTEGRITY_UNKNOWN;
+
+  current_fp = _get_fingerprint (&st);
+
+  G_LOCK (integrity_lock);
+  if (g_integrity_cache) {
+    entry = (model_integrity_entry_s *) g_hash_table_lookup (g_integrity_cache, path);
+    if (entry && g_str_equal (entry->fingerprint, current_fp) && g_str_equal (entry->hash, hash))
+      integrity = entry->integrity;
+  }
+  G_UNLOCK (integrity_lock);
+
+  if (integrity != MODEL_INTEGRITY_UNKNOWN) {
+    g_free (current_fp);
+    return integrity;
+  }
+
+  /* The file is not changed since the registration, it is not hashed again after the daemon restarts. */
+  if (g_strcmp0 (fingerprint, current_fp) == 0) {
+    _cache_result (path, current_fp, hash, MODEL_INTEGRITY_VERIFIED);
+    return MODEL_INTEGRITY_VERIFIED;
+  }
+
+  /* The file is changed or not verified yet. */
+  if (model_store_hash_file (path, &current) != 0) {
+    g_free (current_fp);
+    return MODEL_INTEGRITY_UNKNOWN;
+  }
+
+  integrity = g_str_equal (current, hash) ? MODEL_INTEGRITY_VERIFIED : MODEL_INTEGRITY_MISMATCH;
+  if (integrity == MODEL_INTEGRITY_MISMATCH)
+    ml_loge ("The model file '%s' is modified since the registration.", path);
+
+  _cache_result (path, current_fp, hash, integrity);
+  return integrity;
+}
+
+/**
+ * @brief Get the fingerprint of the file.
+ */
+gchar *
+model_integrity_get_fingerprint (const gchar *path)
+{
+  struct stat st;
+
+  if (!path || g_stat (path, &st) != 0 || !S_ISREG (st.st_mode))
+    return NULL;
+
+  return _get_fingerprint (&st);
+}
+
+/**
+ * @brief Record the model file as verified, where the hash of the file is computed.
+ */
+void
+model_integrity_seed (const gchar *path, const gchar *hash, const gchar *fingerprint)
+{
+  gchar *current_fp;
+
+  if (!hash || hash[0] == '\0' || !fingerprint)
+    return;
+
+  /* The file may be changed while computing the hash. */
+  current_fp = model_integrity_get_fingerprint (path);
+  if (g_strcmp0 (current_fp, fingerprint) != 0) {
+    g_free (current_fp);
+    return;
+  }
+
+  _cache_result (path, current_fp, hash, MODEL_INTEGRITY_VERIFIED);
+}
+
+/**
+ * @brief Get the string of the integrity state.
+ */
+const gchar *
+model_integrity_to_string (model_integrity_e integrity)
+{
+  switch (integrity) {
+    case MODEL_INTEGRITY_VERIFIED:
+      return "verified";
+    case MODEL_INTEGRITY_MISMATCH:
+      return "mismatch";
+    default:
+      break;
+  }
+
+  return "unknown";
+}
+
+/**
+ * @brief Drop the cached result of the model file.
+ */
+void
+model_integrity_invalidate (const gchar *path)
+{
+  G_LOCK (integrity_lock);
+  if (g_integrity_cache) {
+    if (path)
+      g_hash_table_remove (g_integrity_cache, path);
+    else
+      g_hash_table_remove_all (g_integrity_cache);
+  }
+  G_UNLOCK (integrity_lock);
+}
@@ -0,0 +1,73 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-integrity.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the integrity verification of the registered model files
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The model file is compared with the hash stored at the registration.
+ *    The result is cached with the fingerprint (device, inode, size and mtime) of the file,
+ *    and the file is hashed again only if the fingerprint is changed. So the verification costs one stat() if the file is not changed.
+ *    The fingerprint taken at the registration is kept in the DB, so the file is not hashed again after the daemon restarts.
+ */
+#ifndef __MODEL_INTEGRITY_H__
+#define __MODEL_INTEGRITY_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The integrity states of the model file.
+ */
+typedef enum {
+  MODEL_INTEGRITY_UNKNOWN = 0, /**< No hash is registered, or the file is not accessible. */
+  MODEL_INTEGRITY_VERIFIED,    /**< The file is matched with the registered hash. */
+  MODEL_INTEGRITY_MISMATCH     /**< The file is modified since the registration. */
+} model_integrity_e;
+
+/**
+ * @brief Verify the model file with the registered hash.
+ * @param[in] path The path of the model file.
+ * @param[in] hash The hash of the file registered in the DB.
+ * @param[in] fingerprint The fingerprint of the file registered in the DB. NULL if it is not registered.
+ * @return The integrity state of the model file.
+ */
+model_integrity_e model_integrity_verify (const gchar *path, const gchar *hash, const gchar *fingerprint);
+
+/**
+ * @brief Get the fingerprint of the file.
+ * @param[in] path The path of the file.
+ * @return The fingerprint string of the device, inode, size and mtime. NULL if the file is not a regular file. Caller should free it.
+ */
+gchar *model_integrity_get_fingerprint (const gchar *path);
+
+/**
+ * @brief Record the model file as verified, where the hash of the file is computed.
+ * @param[in] path The path of the model file.
+ * @param[in] hash The hash of the file.
+ * @param[in] fingerprint The fingerprint of the file taken before computing the hash. Nothing is recorded if the file is changed since.
+ */
+void model_integrity_seed (const gchar *path, const gchar *hash, const gchar *fingerprint);
+
+/**
+ * @brief Get the string of the integrity state.
+ */
+const gchar *model_integrity_to_string (model_integrity_e integrity);
+
+/**
+ * @brief Drop the cached result of the model file, then the file is hashed again at the next verification.
+ * @param[in] path The path of the model file. If it is NULL, all cached results are dropped.
+ */
+void model_integrity_invalidate (const gchar *path);
+
+G_END_DECLS
+#endif /* __MODEL_INTEGRITY_H__ */
@@ -0,0 +1,315 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-metadata.cc
+ * @date      18 Oct 2026
+ * @brief     Metadata extraction of the model files.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This reads the tensor information from the header of the model file without loading the weights.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+#include "log.h"
+#include "model-metadata.h"
+
+/**
+ * @brief Structure for the parser of a model format.
+ */
+typedef struct {
+  const gchar *format;
+  gboolean (*identify) (const guint8 *data, gsize size);
+  gboolean (*parse) (const guint8 *data, gsize size, JsonArray *inputs, JsonArray *outputs);
+} model_metadata_parser_s;
+
+/**
+ * @brief Structure for the bounds-checked flatbuffer.
+ */
+typedef struct {
+  const guint8 *data;
+  gsize size;
+} flatbuffer_s;
+
+/**
+ * @brief The names of the TensorType in the TFLite schema.
+ */
+static const gchar *g_tflite_types[] = {
+  "float32", "float16", "int32", "uint8", "int64", "string", "bool", "int16",
+  "complex64", "int8", "float64", "complex128", "uint64", "resource", "variant",
+  "uint32", "uint16", "int4"
+};
+
+/**
+ * @brief The field indices of the tables in the TFLite schema.
+ */
+#define TFLITE_MODEL_SUBGRAPHS (2U)
+#define TFLITE_SUBGRAPH_TENSORS (0U)
+#define TFLITE_SUBGRAPH_INPUTS (1U)
+#define TFLITE_SUBGRAPH_OUTPUTS (2U)
+#define TFLITE_TENSOR_SHAPE (0U)
+#define TFLITE_TENSOR_TYPE (1U)
+#define TFLITE_TENSOR_NAME (3U)
+
+/**
+ * @brief Internal function to read the unsigned integer from the flatbuffer.
+ */
+static gboolean
+_fb_read (const flatbuffer_s *fb, gsize pos, gsize length, guint32 *value)
+{
+  guint32 v = 0;
+  guint16 v16 = 0;
+
+  if (pos > fb->size || length > fb->size - pos)
+    return FALSE;
+
+  if (length == sizeof (guint16)) {
+    memcpy (&v16, fb->data + pos, length);
+    v = GUINT16_FROM_LE (v16);
+  } else if (length == sizeof (guint32)) {
+    memcpy (&v, fb->data + pos, length);
+    v = GUINT32_FROM_LE (v);
+  } else {
+    v = fb->data[pos];
+  }
+
+  *value = v;
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the position of the field in the table.
+ */
+static gboolean
+_fb_field (const flatbuffer_s *fb, gsize table, guint field, gsize *pos)
+{
+  guint32 soffset, vt_size, offset;
+  gint64 vtable;
+
+  if (!_fb_read (fb, table, sizeof (guint32), &soffset))
+    return FALSE;
+
+  vtable = (gint64) table - (gint32) soffset;
+  if (vtable < 0 || !_fb_read (fb, (gsize) vtable, sizeof (guint16), &vt_size))
+    return FALSE;
+
+  /* The field is not in the vtable, it is written by the older schema. */
+  if (4U + 2U * field + 2U > vt_size)
+    return FALSE;
+
+  if (!_fb_read (fb, (gsize) vtable + 4U + 2U * field, sizeof (guint16), &offset) || offset == 0)
+    return FALSE;
+
+  *pos = table + offset;
+  return (*pos < fb->size);
+}
+
+/**
+ * @brief Internal function to follow the offset at the position.
+ */
+static gboolean
+_fb_deref (const flatbuffer_s *fb, gsize pos, gsize *target)
+{
+  guint32 offset;
+
+  if (!_fb_read (fb, pos, sizeof (guint32), &offset))
+    return FALSE;
+
+  *target = pos + offset;
+  return (*target < fb->size);
+}
+
+/**
+ * @brief Internal function to get the vector of the field in the table.
+ */
+static gboolean
+_fb_vector (const flatbuffer_s *fb, gsize table, guint field, gsize elem_size, gsize *start, guint32 *length)
+{
+  gsize pos, vector;
+
+  if (!_fb_field (fb, table, field, &pos) || !_fb_deref (fb, pos, &vector)
+      || !_fb_read (fb, vector, sizeof (guint32), length))
+    return FALSE;
+
+  *start = vector + sizeof (guint32);
+  return (*start <= fb->size && *length <= (fb->size - *start) / elem_size);
+}
+
+/**
+ * @brief Internal function to get the table of the element in the vector of the tables.
+ */
+static gboolean
+_fb_vector_table (const flatbuffer_s *fb, gsize start, guint32 length, guint32 index, gsize *table)
+{
+  if (index >= length)
+    return FALSE;
+
+  return _fb_deref (fb, start + (gsize) index * sizeof (guint32), table);
+}
+
+/**
+ * @brief Internal function to identify the TFLite model with the file identifier.
+ */
+static gboolean
+_tflite_identify (const guint8 *data, gsize size)
+{
+  return (size >= 8U && memcmp (data + 4, "TFL3", 4) == 0);
+}
+
+/**
+ * @brief Internal function to get the tensor information of the TFLite model.
+ */
+static JsonObject *
+_tflite_get_tensor (const flatbuffer_s *fb, gsize tensor)
+{
+  JsonObject *object = json_object_new ();
+  JsonArray *shape = json_array_new ();
+  gsize pos, start;
+  guint32 type = 0, length = 0, dim, i;
+
+  if (_fb_vector (fb, tensor, TFLITE_TENSOR_NAME, 1U, &start, &length)) {
+    g_autofree gchar *name = g_strndup ((const gchar *) fb->data + start, length);
+
+    json_object_set_string_member (object, "name", name);
+  }
+
+  /* The type is omitted if it is the default value, float32. */
+  if (_fb_field (fb, tensor, TFLITE_TENSOR_TYPE, &pos))
+    _fb_read (fb, pos, 1U, &type);
+
+  json_object_set_string_member (object, "type",
+      (type < G_N_ELEMENTS (g_tflite_types)) ? g_tflite_types[type] : "unknown");
+
+  if (_fb_vector (fb, tensor, TFLITE_TENSOR_SHAPE, sizeof (gint32), &start, &length)) {
+    for (i = 0; i < length; i++) {
+      if (_fb_read (fb, start + (gsize) i * sizeof (gint32), sizeof (gint32), &dim))
+        json_array_add_int_element (shape, (gint32) dim);
+    }
+  }
+
+  json_object_set_array_member (object, "shape", shape);
+  return object;
+}
+
+/**
+ * @brief Internal function to add the tensors of the indices to the array.
+ */
+static gboolean
+_tflite_add_tensors (const flatbuffer_s *fb, gsize subgraph, guint field, JsonArray *array)
+{
+  gsize tensors, indices, tensor;
+  guint32 num_tensors, num_indices, index, i;
+
+  if (!_fb_vector (fb, subgraph, TFLITE_SUBGRAPH_TENSORS, sizeof (guint32), &tensors, &num_tensors)
+      || !_fb_vector (fb, subgraph, field, sizeof (gint32), &indices, &num_indices))
+    return FALSE;
+
+  for (i = 0; i < num_indices; i++) {
+    if (!_fb_read (fb, indices + (gsize) i * sizeof (gint32), sizeof (gint32), &index)
+        || !_fb_vector_table (fb, tensors, num_tensors, index, &tensor))
+      return FALSE;
+
+    json_array_add_object_element (array, _tflite_get_tensor (fb, tensor));
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to parse the input and output tensors of the main subgraph of the TFLite model.
+ */
+static gboolean
+_tflite_parse (const guint8 *data, gsize size, JsonArray *inputs, JsonArray *outputs)
+{
+  flatbuffer_s fb = { data, size };
+  gsize model, subgraphs, subgraph;
+  guint32 num_subgraphs;
+
+  if (!_fb_deref (&fb, 0, &model)
+      || !_fb_vector (&fb, model, TFLITE_MODEL_SUBGRAPHS, sizeof (guint32), &subgraphs, &num_subgraphs)
+      || !_fb_vector_table (&fb, subgraphs, num_subgraphs, 0, &subgraph))
+    return FALSE;
+
+  return (_tflite_add_tensors (&fb, subgraph, TFLITE_SUBGRAPH_INPUTS, inputs)
+          && _tflite_add_tensors (&fb, subgraph, TFLITE_SUBGRAPH_OUTPUTS, outputs));
+}
+
+/**
+ * @brief The parsers of the model formats.
+ */
+static const model_metadata_parser_s g_parsers[] = {
+  { "tflite", _tflite_identify, _tflite_parse },
+};
+
+/**
+ * @brief Extract the metadata of the model file.
+ */
+gint
+model_metadata_extract (const gchar *path, gchar **metadata)
+{
+  g_autoptr (JsonGenerator) gen = NULL;
+  GMappedFile *mapped;
+  GError *err = NULL;
+  JsonObject *object;
+  JsonNode *root;
+  const guint8 *data;
+  gsize size, i;
+
+  g_return_val_if_fail (path != NULL && metadata != NULL, -EINVAL);
+
+  /* Only the header pages are read. */
+  mapped = g_mapped_file_new (path, FALSE, &err);
+  if (!mapped) {
+    gint ret = (err && err->domain == G_FILE_ERROR && err->code == G_FILE_ERROR_NOENT) ? -ENOENT : -EIO;
+
+    g_clear_error (&err);
+    return ret;
+  }
+
+  data = (const guint8 *) g_mapped_file_get_contents (mapped);
+  size = g_mapped_file_get_length (mapped);
+
+  object = json_object_new ();
+  json_object_set_string_member (object, "format", "unknown");
+  json_object_set_int_member (object, "size", (gint64) size);
+
+  for (i = 0; i < G_N_ELEMENTS (g_parsers) && data; i++) {
+    JsonArray *inputs, *outputs;
+
+    if (!g_parsers[i].identify (data, size))
+      continue;
+
+    inputs = json_array_new ();
+    outputs = json_array_new ();
+
+    json_object_set_string_member (object, "format", g_parsers[i].format);
+    if (g_parsers[i].parse (data, size, inputs, outputs)) {
+      json_object_set_array_member (object, "inputs", inputs);
+      json_object_set_array_member (object, "outputs", outputs);
+    } else {
+      ml_logw ("Failed to parse the tensors of the %s model '%s'.", g_parsers[i].format, path);
+      json_array_unref (inputs);
+      json_array_unref (outputs);
+    }
+    break;
+  }
+
+  g_mapped_file_unref (mapped);
+
+  root = json_node_init_object (json_node_alloc (), object);
+  gen = json_generator_new ();
+  json_generator_set_root (gen, root);
+  *metadata = json_generator_to_data (gen, NULL);
+
+  json_node_unref (root);
+  json_object_unref (object);
+  return 0;
+}
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-metadata.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the metadata extraction of the model files
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The metadata is extracted once when the model is registered, and kept in the DB.
+ *    It is a JSON object with the format and the size of the model file, and the input and output tensors:
+ *
+ *      { "format": "tflite", "size": 1234,
+ *        "inputs": [ { "name": "input", "type": "uint8", "shape": [ 1, 224, 224, 3 ] } ],
+ *        "outputs": [ ... ] }
+ *
+ *    The tensors are given only for the known formats. Other formats are added to the parser table in model-metadata.cc.
+ */
+#ifndef __MODEL_METADATA_H__
+#define __MODEL_METADATA_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Extract the metadata of the model file.
+ * @param[in] path The path of the model file.
+ * @param[out] metadata The JSON string of the metadata. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value. The unknown format is not an error.
+ */
+gint model_metadata_extract (const gchar *path, gchar **metadata);
+
+G_END_DECLS
+#endif /* __MODEL_METADATA_H__ */
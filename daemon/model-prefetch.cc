@@ -0,0 +1,592 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-prefetch.cc
+ * @date      17 Oct 2026
+ * @brief     Page-cache warming for the activated models.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This reads ahead the ranges of the model files in a batch with the I/O engine.
+ *            The files of a resource are validated and read ahead by the jobs of the files, not limited by the budget.
+ *            The number of the files opened at a time is bounded.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <json-glib/json-glib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "io-engine.h"
+#include "log.h"
+#include "model-prefetch.h"
+
+/**
+ * @brief The size of the range read ahead by an operation. The ranges of a file are in flight together.
+ */
+#define MODEL_PREFETCH_RANGE_SIZE (16 * 1024 * 1024)
+
+/**
+ * @brief The maximum number of the files of a resource being validated and read ahead at a time.
+ */
+#define MODEL_PREFETCH_FILES_INFLIGHT (8)
+
+/**
+ * @brief Prefetch states of the model file.
+ */
+typedef enum {
+  PREFETCH_STATE_NONE = 0,
+  PREFETCH_STATE_QUEUED,
+  PREFETCH_STATE_RUNNING,
+  PREFETCH_STATE_DONE,
+  PREFETCH_STATE_SKIPPED,
+  PREFETCH_STATE_FAILED
+} model_prefetch_state_e;
+
+static const gchar *g_prefetch_state_str[] = {
+  "none", "queued", "running", "done", "skipped", "failed"
+};
+
+/**
+ * @brief Structure for the prefetch entry of the model file.
+ */
+typedef struct {
+  model_prefetch_state_e state;
+  guint64 size; /**< The size counted in the budget. */
+} model_prefetch_entry_s;
+
+/**
+ * @brief Structure for the prefetch.
+ */
+typedef struct {
+  GMutex lock;
+  GCond cond;
+  gboolean enabled;
+  guint inflight; /**< The number of the files being read ahead by the I/O engine. */
+  GHashTable *entries; /**< Prefetch entries, keyed by the file path. */
+  guint64 budget;
+  guint64 used; /**< The size of the files warmed or to be warmed. */
+  GThreadPool *files_pool; /**< The jobs to validate and read ahead the files of a resource. */
+} model_prefetch_s;
+
+static model_prefetch_s g_prefetch;
+
+/**
+ * @brief Structure for the read-ahead of the model file.
+ */
+typedef struct {
+  gchar *path;
+  int fd;
+  guint num;
+  io_engine_op_s *ops;
+} model_prefetch_job_s;
+
+typedef struct _model_prefetch_batch_s model_prefetch_batch_s;
+
+/**
+ * @brief Structure for the file in the batch of the files.
+ */
+typedef struct {
+  gchar *path;
+  gint result; /**< 0 if the file is valid and read ahead. Otherwise a negative error value. */
+  guint64 size;
+  model_prefetch_batch_s *batch;
+} model_prefetch_file_s;
+
+/**
+ * @brief Structure for the read-ahead of the files in a batch.
+ */
+struct _model_prefetch_batch_s {
+  model_prefetch_file_s *files;
+  guint num_files;
+  gint remaining; /**< The number of the files not finished. */
+  model_prefetch_files_cb cb;
+  gpointer user_data;
+  GMainContext *context;
+  gint result;
+  gchar *info;
+};
+
+/**
+ * @brief Internal function to set the state of the entry.
+ */
+static void
+_set_state (const gchar *path, model_prefetch_state_e state)
+{
+  model_prefetch_entry_s *entry;
+
+  g_mutex_lock (&g_prefetch.lock);
+  entry = (model_prefetch_entry_s *) g_hash_table_lookup (g_prefetch.entries, path);
+  if (entry) {
+    /* Release the budget if the file is not warmed. */
+    if (state == PREFETCH_STATE_FAILED) {
+      g_prefetch.used -= entry->size;
+      entry->size = 0;
+    }
+
+    entry->state = state;
+  }
+  g_mutex_unlock (&g_prefetch.lock);
+}
+
+/**
+ * @brief Internal function to release the read-ahead job, and wake up the thread waiting for the jobs.
+ */
+static void
+_job_free (model_prefetch_job_s *job)
+{
+  if (job->fd >= 0)
+    close (job->fd);
+
+  g_free (job->ops);
+  g_free (job->path);
+  g_free (job);
+
+  g_mutex_lock (&g_prefetch.lock);
+  if (--g_prefetch.inflight == 0U)
+    g_cond_broadcast (&g_prefetch.cond);
+  g_mutex_unlock (&g_prefetch.lock);
+}
+
+/**
+ * @brief The callback of the I/O engine, all ranges of the file are read ahead.
+ */
+static void
+_prefetch_done_cb (io_engine_op_s *ops, guint num, gpointer user_data)
+{
+  model_prefetch_job_s *job = (model_prefetch_job_s *) user_data;
+  model_prefetch_state_e state = PREFETCH_STATE_DONE;
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    if (ops[i].result < 0) {
+      ml_logw ("Failed to prefetch the model file '%s' (%d).", job->path, (gint) -ops[i].result);
+      state = PREFETCH_STATE_FAILED;
+      break;
+    }
+  }
+
+  _set_state (job->path, state);
+  _job_free (job);
+}
+
+/**
+ * @brief Internal function to submit the ranges of the file to the I/O engine.
+ * @note Count the file in flight before calling it, it is released when the read-ahead completes or fails.
+ */
+static void
+_prefetch_file (const gchar *path)
+{
+  model_prefetch_job_s *job;
+  struct stat st;
+  off_t offset = 0;
+  guint i;
+
+  job = g_new0 (model_prefetch_job_s, 1);
+  job->path = g_strdup (path);
+  job->fd = open (path, O_RDONLY | O_CLOEXEC);
+
+  if (job->fd < 0 || fstat (job->fd, &st) != 0) {
+    ml_logw ("Failed to open the model file '%s' to prefetch (%d).", path, errno);
+    _set_state (path, PREFETCH_STATE_FAILED);
+    _job_free (job);
+    return;
+  }
+
+  job->num = (guint) MAX ((st.st_size + MODEL_PREFETCH_RANGE_SIZE - 1) / MODEL_PREFETCH_RANGE_SIZE, 1);
+  job->ops = g_new0 (io_engine_op_s, job->num);
+
+  for (i = 0; i < job->num; i++) {
+    job->ops[i].type = IO_ENGINE_OP_READAHEAD;
+    job->ops[i].fd = job->fd;
+    job->ops[i].offset = offset;
+    job->ops[i].length = (gsize) MIN ((off_t) MODEL_PREFETCH_RANGE_SIZE, st.st_size - offset);
+    offset += (off_t) job->ops[i].length;
+  }
+
+  if (io_engine_submit (job->ops, job->num, _prefetch_done_cb, job, NULL) != 0) {
+    ml_logw ("Failed to submit the prefetch of the model file '%s'.", path);
+    _set_state (path, PREFETCH_STATE_FAILED);
+    _job_free (job);
+  }
+}
+
+/**
+ * @brief Enable the prefetch.
+ */
+void
+model_prefetch_init (guint64 budget)
+{
+  model_prefetch_fini ();
+
+  if (budget == 0U)
+    return;
+
+  g_mutex_lock (&g_prefetch.lock);
+  g_prefetch.budget = budget;
+  g_prefetch.used = 0;
+  g_prefetch.entries = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  g_prefetch.enabled = TRUE;
+  g_mutex_unlock (&g_prefetch.lock);
+}
+
+/**
+ * @brief Wait for the read-ahead in flight, and clear the prefetch states.
+ */
+void
+model_prefetch_fini (void)
+{
+  GThreadPool *pool;
+
+  g_mutex_lock (&g_prefetch.lock);
+  g_prefetch.enabled = FALSE;
+  g_prefetch.budget = 0;
+
+  while (g_prefetch.inflight > 0U)
+    g_cond_wait (&g_prefetch.cond, &g_prefetch.lock);
+
+  g_clear_pointer (&g_prefetch.entries, g_hash_table_destroy);
+  g_prefetch.used = 0;
+  pool = g_prefetch.files_pool;
+  g_prefetch.files_pool = NULL;
+  g_mutex_unlock (&g_prefetch.lock);
+
+  /* No file is in flight, the workers are idle. */
+  if (pool)
+    g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+/**
+ * @brief Check whether the prefetch is enabled.
+ */
+gboolean
+model_prefetch_is_enabled (void)
+{
+  gboolean enabled;
+
+  g_mutex_lock (&g_prefetch.lock);
+  enabled = g_prefetch.enabled;
+  g_mutex_unlock (&g_prefetch.lock);
+
+  return enabled;
+}
+
+/**
+ * @brief Check whether the files are being read ahead.
+ */
+gboolean
+model_prefetch_is_running (void)
+{
+  gboolean running;
+
+  g_mutex_lock (&g_prefetch.lock);
+  running = (g_prefetch.inflight > 0U);
+  g_mutex_unlock (&g_prefetch.lock);
+
+  return running;
+}
+
+/**
+ * @brief Request to read ahead the model file into the page cache.
+ */
+void
+model_prefetch_request (const gchar *path)
+{
+  model_prefetch_entry_s *entry;
+  struct stat st;
+  guint64 size;
+  gboolean submit = FALSE;
+
+  if (!path || !model_prefetch_is_enabled ())
+    return;
+
+  if (g_stat (path, &st) != 0 || !S_ISREG (st.st_mode)) {
+    ml_logw ("Cannot prefetch the model file '%s', it is not a regular file.", path);
+    return;
+  }
+
+  size = (guint64) st.st_size;
+
+  g_mutex_lock (&g_prefetch.lock);
+  if (!g_prefetch.enabled) {
+    g_mutex_unlock (&g_prefetch.lock);
+    return;
+  }
+
+  entry = (model_prefetch_entry_s *) g_hash_table_lookup (g_prefetch.entries, path);
+  if (!entry) {
+    entry = g_new0 (model_prefetch_entry_s, 1);
+    g_hash_table_insert (g_prefetch.entries, g_strdup (path), entry);
+  } else if (entry->state == PREFETCH_STATE_QUEUED || entry->state == PREFETCH_STATE_RUNNING) {
+    g_mutex_unlock (&g_prefetch.lock);
+    return;
+  }
+
+  /* The file may be changed since the last request. */
+  g_prefetch.used -= entry->size;
+  entry->size = 0;
+
+  if (g_prefetch.used + size > g_prefetch.budget) {
+    ml_logi ("Skip to prefetch the model file '%s', the prefetch budget is exhausted.", path);
+    entry->state = PREFETCH_STATE_SKIPPED;
+  } else {
+    g_prefetch.used += size;
+    entry->size = size;
+    entry->state = PREFETCH_STATE_RUNNING;
+    g_prefetch.inflight++;
+    submit = TRUE;
+  }
+  g_mutex_unlock (&g_prefetch.lock);
+
+  if (submit)
+    _prefetch_file (path);
+}
+
+/**
+ * @brief Get the prefetch state of the model file.
+ */
+const gchar *
+model_prefetch_get_state (const gchar *path)
+{
+  model_prefetch_entry_s *entry = NULL;
+  model_prefetch_state_e state = PREFETCH_STATE_NONE;
+
+  g_mutex_lock (&g_prefetch.lock);
+  if (path && g_prefetch.entries)
+    entry = (model_prefetch_entry_s *) g_hash_table_lookup (g_prefetch.entries, path);
+  if (entry)
+    state = entry->state;
+  g_mutex_unlock (&g_prefetch.lock);
+
+  return g_prefetch_state_str[state];
+}
+
+/**
+ * @brief Drop the prefetch states of the files which are not activated anymore.
+ */
+void
+model_prefetch_retain (const gchar *const *paths)
+{
+  g_autoptr (GHashTable) retained = NULL;
+  GHashTableIter iter;
+  gpointer key, value;
+  guint i;
+
+  retained = g_hash_table_new (g_str_hash, g_str_equal);
+  for (i = 0; paths && paths[i]; i++)
+    g_hash_table_add (retained, (gpointer) paths[i]);
+
+  g_mutex_lock (&g_prefetch.lock);
+  if (g_prefetch.entries) {
+    g_hash_table_iter_init (&iter, g_prefetch.entries);
+
+    /* The read-ahead in flight finds no entry, and does not update the state. */
+    while (g_hash_table_iter_next (&iter, &key, &value)) {
+      model_prefetch_entry_s *entry = (model_prefetch_entry_s *) value;
+
+      if (!g_hash_table_contains (retained, key)) {
+        g_prefetch.used -= entry->size;
+        g_hash_table_iter_remove (&iter);
+      }
+    }
+  }
+  g_mutex_unlock (&g_prefetch.lock);
+}
+
+/**
+ * @brief Internal function to get the result of the files in the JSON string.
+ */
+static gchar *
+_files_to_json (model_prefetch_batch_s *batch)
+{
+  g_autoptr (JsonGenerator) gen = json_generator_new ();
+  JsonObject *object = json_object_new ();
+  JsonArray *array = json_array_new ();
+  JsonObject *file;
+  JsonNode *root;
+  guint64 total = 0;
+  gchar *info;
+  guint i;
+
+  for (i = 0; i < batch->num_files; i++) {
+    file = json_object_new ();
+    json_object_set_string_member (file, "path", batch->files[i].path);
+    json_object_set_int_member (file, "size", (gint64) batch->files[i].size);
+    json_object_set_int_member (file, "result", batch->files[i].result);
+    json_array_add_object_element (array, file);
+
+    if (batch->files[i].result == 0)
+      total += batch->files[i].size;
+  }
+
+  json_object_set_int_member (object, "total_bytes", (gint64) total);
+  json_object_set_array_member (object, "files", array);
+
+  root = json_node_init_object (json_node_alloc (), object);
+  json_generator_set_root (gen, root);
+  info = json_generator_to_data (gen, NULL);
+
+  json_node_unref (root);
+  json_object_unref (object);
+  return info;
+}
+
+/**
+ * @brief Internal function to call the callback with the result of the files, and release the batch.
+ */
+static gboolean
+_notify_files (gpointer data)
+{
+  model_prefetch_batch_s *batch = (model_prefetch_batch_s *) data;
+
+  batch->cb (batch->result, batch->info, batch->user_data);
+
+  if (batch->context)
+    g_main_context_unref (batch->context);
+  g_free (batch->info);
+  g_free (batch);
+
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Internal function to notify the result of the files, when all files are finished.
+ */
+static void
+_finish_files (model_prefetch_batch_s *batch)
+{
+  gint result = 0;
+  guint i;
+
+  for (i = 0; i < batch->num_files; i++) {
+    model_prefetch_file_s *file = &batch->files[i];
+
+    if (file->result != 0) {
+      ml_logw ("Failed to prefetch the file '%s' (%d).", file->path, -file->result);
+      if (result == 0)
+        result = file->result;
+    }
+  }
+
+  batch->result = result;
+  if (batch->cb)
+    batch->info = _files_to_json (batch);
+
+  for (i = 0; i < batch->num_files; i++)
+    g_free (batch->files[i].path);
+  g_clear_pointer (&batch->files, g_free);
+
+  /* The files are closed, do not wait for the main context to stop the prefetch. */
+  g_mutex_lock (&g_prefetch.lock);
+  if (--g_prefetch.inflight == 0U)
+    g_cond_broadcast (&g_prefetch.cond);
+  g_mutex_unlock (&g_prefetch.lock);
+
+  if (!batch->cb) {
+    if (batch->context)
+      g_main_context_unref (batch->context);
+    g_free (batch);
+  } else if (batch->context) {
+    g_main_context_invoke_full (batch->context, G_PRIORITY_DEFAULT, _notify_files, batch, NULL);
+  } else {
+    _notify_files (batch);
+  }
+}
+
+/**
+ * @brief The job to validate the file and read it ahead with the I/O engine. The file is opened only while the job runs.
+ */
+static void
+_prefetch_file_worker (gpointer data, gpointer user_data)
+{
+  model_prefetch_file_s *file = (model_prefetch_file_s *) data;
+  model_prefetch_batch_s *batch = file->batch;
+  g_autofree io_engine_op_s *ops = NULL;
+  struct stat st;
+  off_t offset = 0;
+  guint i, num;
+  int fd;
+
+  fd = open (file->path, O_RDONLY | O_CLOEXEC);
+
+  if (fd < 0 || fstat (fd, &st) != 0) {
+    file->result = -errno;
+  } else if (!S_ISREG (st.st_mode)) {
+    file->result = -EINVAL;
+  } else {
+    file->size = (guint64) st.st_size;
+    num = (guint) ((st.st_size + MODEL_PREFETCH_RANGE_SIZE - 1) / MODEL_PREFETCH_RANGE_SIZE);
+    ops = g_new0 (io_engine_op_s, MAX (num, 1U));
+
+    for (i = 0; i < num; i++) {
+      ops[i].type = IO_ENGINE_OP_READAHEAD;
+      ops[i].fd = fd;
+      ops[i].offset = offset;
+      ops[i].length = (gsize) MIN ((guint64) MODEL_PREFETCH_RANGE_SIZE, file->size - (guint64) offset);
+      offset += (off_t) ops[i].length;
+    }
+
+    /* The ranges of the file are in flight together, it runs without the engine while stopping it. */
+    file->result = io_engine_run (ops, num);
+  }
+
+  if (fd >= 0)
+    close (fd);
+
+  if (g_atomic_int_dec_and_test (&batch->remaining))
+    _finish_files (batch);
+}
+
+/**
+ * @brief Validate the files and read them ahead into the page cache, with the bounded number of the files in flight.
+ */
+gint
+model_prefetch_files (const gchar *const *paths, model_prefetch_files_cb cb,
+    gpointer user_data, GMainContext *context)
+{
+  model_prefetch_batch_s *batch;
+  model_prefetch_file_s *files;
+  GThreadPool *pool;
+  guint i, num_files;
+
+  if (!paths || !paths[0])
+    return -EINVAL;
+
+  batch = g_new0 (model_prefetch_batch_s, 1);
+  batch->num_files = g_strv_length ((gchar **) paths);
+  batch->files = g_new0 (model_prefetch_file_s, batch->num_files);
+  batch->remaining = (gint) batch->num_files;
+  batch->cb = cb;
+  batch->user_data = user_data;
+  batch->context = context ? g_main_context_ref (context) : NULL;
+
+  num_files = batch->num_files;
+  files = batch->files;
+
+  for (i = 0; i < num_files; i++) {
+    files[i].path = g_strdup (paths[i]);
+    files[i].batch = batch;
+  }
+
+  g_mutex_lock (&g_prefetch.lock);
+  if (!g_prefetch.files_pool)
+    g_prefetch.files_pool = g_thread_pool_new (_prefetch_file_worker, NULL, MODEL_PREFETCH_FILES_INFLIGHT, FALSE, NULL);
+  pool = g_prefetch.files_pool;
+  g_prefetch.inflight++;
+  g_mutex_unlock (&g_prefetch.lock);
+
+  /* Do not touch the batch after the last job is pushed, it may be finished and released. */
+  for (i = 0; i < num_files; i++) {
+    if (!pool || !g_thread_pool_push (pool, &files[i], NULL))
+      _prefetch_file_worker (&files[i], NULL);
+  }
+
+  return 0;
+}
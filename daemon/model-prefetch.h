@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-prefetch.h
+ * @date    17 Oct 2026
+ * @brief   Internal header of the page-cache warming for the activated models
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The files of the activated models are read ahead into the page cache with the I/O engine,
+ *    so the first inference does not wait for the flash storage.
+ *    The total size of the warmed files is limited by the budget, and the files over the budget are skipped.
+ */
+#ifndef __MODEL_PREFETCH_H__
+#define __MODEL_PREFETCH_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The callback to be called when the files are read ahead.
+ * @param[in] result 0 if all files are valid and read ahead. Otherwise the error value of the first failed file.
+ * @param[in] info The JSON string of the total bytes and the path, size and result of each file.
+ * @param[in] user_data The user data given with the request.
+ */
+typedef void (*model_prefetch_files_cb) (gint result, const gchar *info, gpointer user_data);
+
+/**
+ * @brief Start the prefetch thread.
+ * @param[in] budget The total size in bytes of the model files to be warmed. If it is 0, the prefetch is disabled.
+ */
+void model_prefetch_init (guint64 budget);
+
+/**
+ * @brief Stop the prefetch thread and clear the prefetch states.
+ */
+void model_prefetch_fini (void);
+
+/**
+ * @brief Check whether the prefetch is enabled.
+ */
+gboolean model_prefetch_is_enabled (void);
+
+/**
+ * @brief Check whether the files are being read ahead.
+ */
+gboolean model_prefetch_is_running (void);
+
+/**
+ * @brief Request to read ahead the model file into the page cache. It returns immediately.
+ * @param[in] path The path of the model file.
+ */
+void model_prefetch_request (const gchar *path);
+
+/**
+ * @brief Get the prefetch state of the model file.
+ * @param[in] path The path of the model file.
+ * @return The state string, one of "none", "queued", "running", "done", "skipped" and "failed". Do not free it.
+ */
+const gchar *model_prefetch_get_state (const gchar *path);
+
+/**
+ * @brief Drop the prefetch states of the files not in the given list, and release the budget counted for them.
+ * @param[in] paths The NULL-terminated array of the paths of the activated model files.
+ */
+void model_prefetch_retain (const gchar *const *paths);
+
+/**
+ * @brief Validate the files and read them ahead into the page cache in parallel. It is not limited by the budget, and works without it.
+ * @param[in] paths The NULL-terminated array of the file paths.
+ * @param[in] cb The callback to be called when all files are read ahead. NULL not to get the result.
+ * @param[in] user_data The user data to be passed to the callback.
+ * @param[in] context The main context to dispatch the callback. If it is NULL, the callback may be called on the I/O thread.
+ * @return @c 0 if the request is accepted, then the callback is called once. Otherwise a negative error value.
+ */
+gint model_prefetch_files (const gchar *const *paths, model_prefetch_files_cb cb, gpointer user_data, GMainContext *context);
+
+G_END_DECLS
+#endif /* __MODEL_PREFETCH_H__ */
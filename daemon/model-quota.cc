@@ -0,0 +1,380 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-quota.cc
+ * @date      18 Oct 2026
+ * @brief     Disk quota and LRU eviction of the model store.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   The eviction runs in the idle time of the main loop, one model at a time, so the method calls are not blocked.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <json-glib/json-glib.h>
+
+#include "log.h"
+#include "model-quota.h"
+#include "model-store.h"
+#include "service-db-util.h"
+
+/**
+ * @brief The interval in seconds to write the access times to the DB.
+ */
+#define MODEL_QUOTA_FLUSH_INTERVAL (30U)
+
+/**
+ * @brief Structure for the quota of the model store.
+ */
+typedef struct {
+  guint64 quota;
+  GHashTable *access; /**< The pending access times, keyed by the name and the version. */
+  guint flush_id; /**< The timer source to write the access times. */
+  guint evict_id; /**< The idle source to evict the models. */
+} model_quota_s;
+
+G_LOCK_DEFINE_STATIC (model_quota_lock);
+static model_quota_s g_quota = { 0, NULL, 0, 0 };
+
+/**
+ * @brief Internal function to release the access record.
+ */
+static void
+_free_access (gpointer data)
+{
+  svcdb_model_access_s *record = (svcdb_model_access_s *) data;
+
+  g_free (record->name);
+  g_free (record);
+}
+
+/**
+ * @brief Internal function to write the access times periodically.
+ */
+static gboolean
+_flush_cb (gpointer user_data)
+{
+  model_quota_flush ();
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @brief Internal function to evict one model in the idle time.
+ */
+static gboolean
+_evict_cb (gpointer user_data)
+{
+  g_autofree gchar *report = NULL;
+  JsonNode *root;
+  guint64 quota;
+  gboolean again = FALSE;
+
+  G_LOCK (model_quota_lock);
+  quota = g_quota.quota;
+  G_UNLOCK (model_quota_lock);
+
+  if (quota > 0 && model_quota_evict (quota, FALSE, 1U, &report) == 0) {
+    root = json_from_string (report, NULL);
+
+    /* Continue while a model is evicted and the store is still over the quota. */
+    if (root && JSON_NODE_HOLDS_OBJECT (root)) {
+      JsonObject *object = json_node_get_object (root);
+      JsonArray *evicted = json_object_get_array_member (object, "evicted");
+
+      again = (json_array_get_length (evicted) > 0
+               && (guint64) json_object_get_int_member (object, "used") > quota);
+    }
+
+    if (root)
+      json_node_unref (root);
+  }
+
+  if (!again) {
+    G_LOCK (model_quota_lock);
+    g_quota.evict_id = 0;
+    G_UNLOCK (model_quota_lock);
+  }
+
+  return again ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Start to track the access times of the models and to enforce the quota.
+ */
+void
+model_quota_init (guint64 quota)
+{
+  G_LOCK (model_quota_lock);
+  g_quota.quota = quota;
+
+  if (!g_quota.access)
+    g_quota.access = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, _free_access);
+
+  if (g_quota.flush_id == 0)
+    g_quota.flush_id = g_timeout_add_seconds (MODEL_QUOTA_FLUSH_INTERVAL, _flush_cb, NULL);
+  G_UNLOCK (model_quota_lock);
+
+  if (quota > 0)
+    model_quota_schedule ();
+}
+
+/**
+ * @brief Write the pending access times to the DB and stop the quota.
+ */
+void
+model_quota_fini (void)
+{
+  model_quota_flush ();
+
+  G_LOCK (model_quota_lock);
+  if (g_quota.flush_id > 0)
+    g_source_remove (g_quota.flush_id);
+  if (g_quota.evict_id > 0)
+    g_source_remove (g_quota.evict_id);
+
+  g_quota.flush_id = g_quota.evict_id = 0;
+  g_quota.quota = 0;
+  g_clear_pointer (&g_quota.access, g_hash_table_destroy);
+  G_UNLOCK (model_quota_lock);
+}
+
+/**
+ * @brief Record the access of the model. It is written to the DB later.
+ */
+void
+model_quota_touch (const gchar *name, const guint version)
+{
+  svcdb_model_access_s *record;
+  gchar *key;
+
+  if (!name || name[0] == '\0' || version == 0U)
+    return;
+
+  key = g_strdup_printf ("%u:%s", version, name);
+
+  G_LOCK (model_quota_lock);
+  if (!g_quota.access) {
+    g_free (key);
+  } else {
+    record = (svcdb_model_access_s *) g_hash_table_lookup (g_quota.access, key);
+
+    if (record) {
+      g_free (key);
+    } else {
+      record = g_new0 (svcdb_model_access_s, 1);
+      record->name = g_strdup (name);
+      record->version = version;
+      g_hash_table_insert (g_quota.access, key, record);
+    }
+
+    record->last_access = g_get_real_time () / G_USEC_PER_SEC;
+  }
+  G_UNLOCK (model_quota_lock);
+}
+
+/**
+ * @brief Write the pending access times to the DB in a transaction.
+ */
+gint
+model_quota_flush (void)
+{
+  GHashTable *access = NULL;
+  GHashTableIter iter;
+  gpointer value;
+  svcdb_model_access_s *records;
+  guint i = 0, num;
+  gint ret;
+
+  G_LOCK (model_quota_lock);
+  if (g_quota.access && g_hash_table_size (g_quota.access) > 0) {
+    access = g_quota.access;
+    g_quota.access = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, _free_access);
+  }
+  G_UNLOCK (model_quota_lock);
+
+  if (!access)
+    return 0;
+
+  num = g_hash_table_size (access);
+  records = g_new (svcdb_model_access_s, num);
+
+  g_hash_table_iter_init (&iter, access);
+  while (g_hash_table_iter_next (&iter, NULL, &value))
+    records[i++] = *((svcdb_model_access_s *) value);
+
+  ret = svcdb_model_update_access (records, num);
+  if (ret != 0)
+    ml_logw ("Failed to write the access times of %u models (%d).", num, ret);
+
+  g_free (records);
+  g_hash_table_destroy (access);
+  return ret;
+}
+
+/**
+ * @brief Request to evict the models over the quota in the background.
+ */
+void
+model_quota_schedule (void)
+{
+  G_LOCK (model_quota_lock);
+  if (g_quota.quota > 0 && g_quota.evict_id == 0 && model_store_is_enabled ())
+    g_quota.evict_id = g_idle_add_full (G_PRIORITY_LOW, _evict_cb, NULL, NULL);
+  G_UNLOCK (model_quota_lock);
+}
+
+/**
+ * @brief Check whether the eviction is scheduled or running in the background.
+ */
+gboolean
+model_quota_is_evicting (void)
+{
+  gboolean evicting;
+
+  G_LOCK (model_quota_lock);
+  evicting = (g_quota.evict_id > 0);
+  G_UNLOCK (model_quota_lock);
+
+  return evicting;
+}
+
+/**
+ * @brief Get the disk quota of the model store given at the initialization.
+ */
+guint64
+model_quota_get (void)
+{
+  guint64 quota;
+
+  G_LOCK (model_quota_lock);
+  quota = g_quota.quota;
+  G_UNLOCK (model_quota_lock);
+
+  return quota;
+}
+
+/**
+ * @brief Evict the least recently accessed inactive models until the model store is under the quota.
+ */
+gint
+model_quota_evict (guint64 quota, gboolean dry_run, guint max_evict, gchar **report)
+{
+  g_autofree gchar *candidates = NULL;
+  g_autoptr (GHashTable) refs = NULL;
+  JsonNode *root = NULL;
+  JsonArray *array = NULL, *evicted;
+  JsonObject *object;
+  guint64 used = 0, total = 0;
+  guint i, length = 0, count = 0;
+  gint ret;
+
+  ret = model_store_get_usage (&used);
+  if (ret != 0)
+    return ret;
+
+  /* The order of the eviction follows the latest access times. */
+  model_quota_flush ();
+
+  if (used > quota) {
+    ret = svcdb_model_list_eviction_candidates (&candidates);
+    if (ret != 0)
+      return ret;
+
+    root = json_from_string (candidates, NULL);
+    if (!root || !JSON_NODE_HOLDS_ARRAY (root)) {
+      if (root)
+        json_node_unref (root);
+      return -EIO;
+    }
+
+    array = json_node_get_array (root);
+    length = json_array_get_length (array);
+  }
+
+  /* The remaining references of the blobs, the blob is reclaimed when the last one is evicted. */
+  refs = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  evicted = json_array_new ();
+
+  for (i = 0; i < length && used > quota && (max_evict == 0U || count < max_evict); i++) {
+    JsonObject *model = json_array_get_object_element (array, i);
+    const gchar *name, *hash;
+    guint version;
+    gint64 remaining;
+    guint64 size = 0, reclaimed = 0;
+
+    if (!model)
+      continue;
+
+    name = json_object_get_string_member (model, "name");
+    hash = json_object_get_string_member (model, "hash");
+    version = (guint) json_object_get_int_member (model, "version");
+
+    /* The blob is shared with an active or pinned model. */
+    if (json_object_get_int_member (model, "kept") > 0)
+      continue;
+
+    /* The model file is not in the model store, deleting it reclaims nothing. */
+    if (model_store_get_blob_size (hash, &size) != 0 || size == 0)
+      continue;
+
+    if (!g_hash_table_contains (refs, hash))
+      g_hash_table_insert (refs, g_strdup (hash),
+          GINT_TO_POINTER ((gint) json_object_get_int_member (model, "refs")));
+
+    remaining = GPOINTER_TO_INT (g_hash_table_lookup (refs, hash)) - 1;
+    if (remaining <= 0)
+      reclaimed = size;
+
+    if (!dry_run && svcdb_model_delete (name, version, FALSE) != 0) {
+      ml_logw ("Failed to evict the model '%s' version %u.", name, version);
+      continue;
+    }
+
+    g_hash_table_insert (refs, g_strdup (hash), GINT_TO_POINTER ((gint) remaining));
+
+    object = json_object_new ();
+    json_object_set_string_member (object, "name", name);
+    json_object_set_int_member (object, "version", version);
+    json_object_set_string_member (object, "hash", hash);
+    json_object_set_int_member (object, "reclaimed", (gint64) reclaimed);
+    json_array_add_object_element (evicted, object);
+
+    if (!dry_run)
+      ml_logi ("The model '%s' version %u is evicted from the model store.", name, version);
+
+    used -= MIN (used, reclaimed);
+    total += reclaimed;
+    count++;
+  }
+
+  if (root)
+    json_node_unref (root);
+
+  if (report) {
+    g_autoptr (JsonGenerator) gen = json_generator_new ();
+    JsonNode *node;
+
+    object = json_object_new ();
+    json_object_set_int_member (object, "quota", (gint64) quota);
+    json_object_set_int_member (object, "used", (gint64) used);
+    json_object_set_boolean_member (object, "dry_run", dry_run);
+    json_object_set_int_member (object, "reclaimed", (gint64) total);
+    json_object_set_array_member (object, "evicted", evicted);
+
+    node = json_node_init_object (json_node_alloc (), object);
+    json_generator_set_root (gen, node);
+    *report = json_generator_to_data (gen, NULL);
+
+    json_node_unref (node);
+    json_object_unref (object);
+  } else {
+    json_array_unref (evicted);
+  }
+
+  return 0;
+}
@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-quota.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the disk quota of the model store
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    When the model store exceeds the quota, the inactive model versions are deleted, the least recently accessed first.
+ *    The active and pinned versions, and the versions sharing the blob with them, are never evicted.
+ *    The access times are kept in memory and written to the DB in a batch, so an access costs no DB write.
+ *    The eviction report is a JSON object:
+ *
+ *      { "quota": 1000, "used": 1200, "dry_run": true, "reclaimed": 300,
+ *        "evicted": [ { "name": "model", "version": 1, "hash": "...", "reclaimed": 300 } ] }
+ */
+#ifndef __MODEL_QUOTA_H__
+#define __MODEL_QUOTA_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Start to track the access times of the models and to enforce the quota.
+ * @param[in] quota The disk quota in bytes of the model store. If it is 0, the eviction is disabled.
+ */
+void model_quota_init (guint64 quota);
+
+/**
+ * @brief Write the pending access times to the DB and stop the quota.
+ */
+void model_quota_fini (void);
+
+/**
+ * @brief Record the access of the model. It is written to the DB later.
+ * @param[in] name The name of the model.
+ * @param[in] version The version of the model.
+ */
+void model_quota_touch (const gchar *name, const guint version);
+
+/**
+ * @brief Write the pending access times to the DB in a transaction.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_quota_flush (void);
+
+/**
+ * @brief Request to evict the models over the quota in the background. It returns immediately.
+ */
+void model_quota_schedule (void);
+
+/**
+ * @brief Check whether the eviction is scheduled or running in the background.
+ */
+gboolean model_quota_is_evicting (void);
+
+/**
+ * @brief Evict the least recently accessed inactive models until the model store is under the quota.
+ * @param[in] quota The disk quota in bytes of the model store.
+ * @param[in] dry_run If it is TRUE, only report the models to be evicted.
+ * @param[in] max_evict The maximum number of the models to evict. 0 for no limit.
+ * @param[out] report The JSON string of the eviction report. It can be NULL. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value. -ENOTSUP if the model store is disabled.
+ */
+gint model_quota_evict (guint64 quota, gboolean dry_run, guint max_evict, gchar **report);
+
+/**
+ * @brief Get the disk quota of the model store given at the initialization.
+ */
+guint64 model_quota_get (void);
+
+G_END_DECLS
+#endif /* __MODEL_QUOTA_H__ */
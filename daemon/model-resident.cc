@@ -0,0 +1,335 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-resident.cc
+ * @date      18 Oct 2026
+ * @brief     Resident cache of the model files.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   The file is mapped once and kept until it is evicted. Each client gets its own descriptor of the file,
+ *            so the file offset is not shared, and the pages are shared with the mapping of the daemon.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <json-glib/json-glib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "model-resident.h"
+
+/**
+ * @brief Structure for the mapped model file.
+ */
+typedef struct {
+  gchar *path;
+  dev_t dev;
+  ino_t ino;
+  off_t size;
+  struct timespec mtime;
+  void *addr;
+  gboolean locked;
+  GList *link; /**< The link in the LRU queue. */
+} model_resident_entry_s;
+
+/**
+ * @brief Structure for the resident cache.
+ */
+typedef struct {
+  GHashTable *entries; /**< The mapped files, keyed by the path. */
+  GQueue lru; /**< The mapped files, the most recently used first. */
+  guint64 budget;
+  guint64 used;
+  gboolean lock;
+  guint64 hits;
+  guint64 misses;
+  guint64 evictions;
+  guint64 bypasses; /**< The files opened without the cache, larger than the budget. */
+} model_resident_s;
+
+G_LOCK_DEFINE_STATIC (resident_lock);
+static model_resident_s g_resident = { NULL, G_QUEUE_INIT, 0, 0, FALSE, 0, 0, 0, 0 };
+
+/**
+ * @brief Internal function to unmap the file and release the entry.
+ */
+static void
+_entry_free (gpointer data)
+{
+  model_resident_entry_s *entry = (model_resident_entry_s *) data;
+
+  if (entry->addr)
+    munmap (entry->addr, (size_t) entry->size);
+
+  g_free (entry->path);
+  g_free (entry);
+}
+
+/**
+ * @brief Internal function to check the mapped file is not changed.
+ */
+static gboolean
+_entry_is_valid (const model_resident_entry_s *entry, const struct stat *st)
+{
+  return (entry->dev == st->st_dev && entry->ino == st->st_ino && entry->size == st->st_size
+          && entry->mtime.tv_sec == st->st_mtim.tv_sec
+          && entry->mtime.tv_nsec == st->st_mtim.tv_nsec);
+}
+
+/**
+ * @brief Internal function to remove the entry. Call it with the lock.
+ */
+static void
+_remove_locked (model_resident_entry_s *entry)
+{
+  g_queue_delete_link (&g_resident.lru, entry->link);
+  g_resident.used -= (guint64) entry->size;
+  g_hash_table_remove (g_resident.entries, entry->path);
+}
+
+/**
+ * @brief Internal function to unmap the least recently used files over the budget, except the given one. Call it with the lock.
+ */
+static void
+_evict_locked (model_resident_entry_s *keep)
+{
+  while (g_resident.used > g_resident.budget) {
+    model_resident_entry_s *victim = (model_resident_entry_s *) g_queue_peek_tail (&g_resident.lru);
+
+    if (!victim || victim == keep)
+      break;
+
+    ml_logd ("The model file '%s' is evicted from the resident cache.", victim->path);
+    _remove_locked (victim);
+    g_resident.evictions++;
+  }
+}
+
+/**
+ * @brief Internal function to map the file and make its pages resident.
+ */
+static model_resident_entry_s *
+_entry_new (const gchar *path, int fd, const struct stat *st, gboolean lock)
+{
+  model_resident_entry_s *entry;
+  void *addr;
+
+  addr = mmap (NULL, (size_t) st->st_size, PROT_READ, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    ml_logw ("Failed to map the model file '%s' (%d).", path, errno);
+    return NULL;
+  }
+
+  entry = g_new0 (model_resident_entry_s, 1);
+  entry->path = g_strdup (path);
+  entry->dev = st->st_dev;
+  entry->ino = st->st_ino;
+  entry->size = st->st_size;
+  entry->mtime = st->st_mtim;
+  entry->addr = addr;
+
+  /* The lock may fail with the limit of the locked memory, then the pages are only read ahead. */
+  if (lock) {
+    if (mlock (addr, (size_t) st->st_size) == 0)
+      entry->locked = TRUE;
+    else
+      ml_logw ("Failed to lock the model file '%s' in the memory (%d).", path, errno);
+  }
+
+  if (!entry->locked)
+    madvise (addr, (size_t) st->st_size, MADV_WILLNEED);
+
+  return entry;
+}
+
+/**
+ * @brief Initialize the resident cache.
+ */
+void
+model_resident_init (guint64 budget, gboolean lock)
+{
+  G_LOCK (resident_lock);
+  if (!g_resident.entries)
+    g_resident.entries = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, _entry_free);
+
+  g_resident.budget = budget;
+  g_resident.lock = lock;
+  _evict_locked (NULL);
+  G_UNLOCK (resident_lock);
+}
+
+/**
+ * @brief Unmap all model files and clear the statistics.
+ */
+void
+model_resident_fini (void)
+{
+  G_LOCK (resident_lock);
+  g_queue_clear (&g_resident.lru);
+  g_clear_pointer (&g_resident.entries, g_hash_table_destroy);
+  g_resident.budget = g_resident.used = 0;
+  g_resident.lock = FALSE;
+  g_resident.hits = g_resident.misses = g_resident.evictions = g_resident.bypasses = 0;
+  G_UNLOCK (resident_lock);
+}
+
+/**
+ * @brief Check whether the resident cache is enabled.
+ */
+gboolean
+model_resident_is_enabled (void)
+{
+  gboolean enabled;
+
+  G_LOCK (resident_lock);
+  enabled = (g_resident.entries != NULL && g_resident.budget > 0);
+  G_UNLOCK (resident_lock);
+
+  return enabled;
+}
+
+/**
+ * @brief Open the model file to be passed to the client, and keep it resident.
+ */
+gint
+model_resident_open (const gchar *path, int *fd, gboolean *hit)
+{
+  model_resident_entry_s *entry, *added = NULL;
+  gboolean found = FALSE, enabled, lock;
+  struct stat st;
+  int file;
+
+  g_return_val_if_fail (path != NULL && fd != NULL, -EINVAL);
+
+  file = g_open (path, O_RDONLY | O_CLOEXEC, 0);
+  if (file < 0)
+    return -errno;
+
+  if (fstat (file, &st) != 0 || !S_ISREG (st.st_mode)) {
+    close (file);
+    return -EINVAL;
+  }
+
+  G_LOCK (resident_lock);
+  enabled = (g_resident.entries != NULL && g_resident.budget > 0);
+  lock = g_resident.lock;
+
+  if (enabled) {
+    entry = (model_resident_entry_s *) g_hash_table_lookup (g_resident.entries, path);
+
+    if (entry && _entry_is_valid (entry, &st)) {
+      /* Move it to the head of the LRU queue. */
+      g_queue_unlink (&g_resident.lru, entry->link);
+      g_queue_push_head_link (&g_resident.lru, entry->link);
+      g_resident.hits++;
+      found = TRUE;
+    } else {
+      /* The file is replaced or modified, the old mapping is stale. */
+      if (entry)
+        _remove_locked (entry);
+
+      g_resident.misses++;
+      if (st.st_size == 0 || (guint64) st.st_size > g_resident.budget) {
+        g_resident.bypasses++;
+        enabled = FALSE;
+      }
+    }
+  }
+  G_UNLOCK (resident_lock);
+
+  /* Map and lock the file out of the lock, it reads the whole file. */
+  if (enabled && !found)
+    added = _entry_new (path, file, &st, lock);
+
+  if (added) {
+    G_LOCK (resident_lock);
+    if (!g_resident.entries || g_hash_table_contains (g_resident.entries, path)) {
+      /* The cache is cleared, or another request mapped it first. */
+      _entry_free (added);
+    } else {
+      g_hash_table_insert (g_resident.entries, added->path, added);
+      g_queue_push_head (&g_resident.lru, added);
+      added->link = g_queue_peek_head_link (&g_resident.lru);
+      g_resident.used += (guint64) added->size;
+      _evict_locked (added);
+    }
+    G_UNLOCK (resident_lock);
+  }
+
+  *fd = file;
+  if (hit)
+    *hit = found;
+
+  return 0;
+}
+
+/**
+ * @brief Unmap the model file, then it is mapped again at the next open.
+ */
+void
+model_resident_invalidate (const gchar *path)
+{
+  model_resident_entry_s *entry;
+
+  G_LOCK (resident_lock);
+  if (g_resident.entries) {
+    if (path) {
+      entry = (model_resident_entry_s *) g_hash_table_lookup (g_resident.entries, path);
+      if (entry)
+        _remove_locked (entry);
+    } else {
+      g_queue_clear (&g_resident.lru);
+      g_hash_table_remove_all (g_resident.entries);
+      g_resident.used = 0;
+    }
+  }
+  G_UNLOCK (resident_lock);
+}
+
+/**
+ * @brief Get the statistics of the resident cache.
+ */
+gchar *
+model_resident_get_stats (void)
+{
+  g_autoptr (JsonGenerator) gen = json_generator_new ();
+  JsonObject *object = json_object_new ();
+  JsonNode *root;
+  gchar *stats;
+  guint entries = 0, locked = 0;
+  GList *l;
+
+  G_LOCK (resident_lock);
+  for (l = g_resident.lru.head; l; l = l->next) {
+    entries++;
+    if (((model_resident_entry_s *) l->data)->locked)
+      locked++;
+  }
+
+  json_object_set_int_member (object, "budget", (gint64) g_resident.budget);
+  json_object_set_int_member (object, "used", (gint64) g_resident.used);
+  json_object_set_int_member (object, "entries", entries);
+  json_object_set_int_member (object, "locked", locked);
+  json_object_set_int_member (object, "hits", (gint64) g_resident.hits);
+  json_object_set_int_member (object, "misses", (gint64) g_resident.misses);
+  json_object_set_int_member (object, "evictions", (gint64) g_resident.evictions);
+  json_object_set_int_member (object, "bypasses", (gint64) g_resident.bypasses);
+  G_UNLOCK (resident_lock);
+
+  root = json_node_init_object (json_node_alloc (), object);
+  json_generator_set_root (gen, root);
+  stats = json_generator_to_data (gen, NULL);
+
+  json_node_unref (root);
+  json_object_unref (object);
+  return stats;
+}
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-resident.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the resident cache of the model files
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The daemon keeps the recently served model files mapped, and optionally locked, in its memory.
+ *    So the pages stay resident when the client process switches the models or restarts,
+ *    and the client maps the file from the descriptor without the page faults to the storage.
+ *    The total size of the mapped files is limited by the budget, and the least recently used ones are unmapped first.
+ */
+#ifndef __MODEL_RESIDENT_H__
+#define __MODEL_RESIDENT_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Initialize the resident cache.
+ * @param[in] budget The total size in bytes of the mapped model files. If it is 0, the files are opened without the cache.
+ * @param[in] lock Lock the pages of the mapped files in the memory.
+ */
+void model_resident_init (guint64 budget, gboolean lock);
+
+/**
+ * @brief Unmap all model files and clear the statistics.
+ */
+void model_resident_fini (void);
+
+/**
+ * @brief Check whether the resident cache is enabled.
+ */
+gboolean model_resident_is_enabled (void);
+
+/**
+ * @brief Open the model file to be passed to the client, and keep it resident.
+ * @param[in] path The path of the model file.
+ * @param[out] fd The read-only file descriptor. The caller should close it.
+ * @param[out] hit It is TRUE if the file was already resident. It can be NULL.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_resident_open (const gchar *path, int *fd, gboolean *hit);
+
+/**
+ * @brief Unmap the model file, then it is mapped again at the next open.
+ * @param[in] path The path of the model file. If it is NULL, all files are unmapped.
+ */
+void model_resident_invalidate (const gchar *path);
+
+/**
+ * @brief Get the statistics of the resident cache.
+ * @return The JSON string with the budget, the resident size, and the counts of the hits, misses and evictions. Call g_free() to release it.
+ */
+gchar *model_resident_get_stats (void);
+
+G_END_DECLS
+#endif /* __MODEL_RESIDENT_H__ */
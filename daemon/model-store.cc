@@ -0,0 +1,1614 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      model-store.cc
+ * @date      17 Oct 2026
+ * @brief     Content-addressed store of the registered model files.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This reads the model files with the I/O engine and hashes the chunks with the thread pool,
+ *            and copies (or reflinks) them into the store directory only if the same contents are not stored yet.
+ *            The model streamed from a file descriptor is hashed while it is copied into the store.
+ *            The blobs of the inactive models may be compressed, and decompressed again on demand.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <gio/gio.h>
+#include <gio/gunixinputstream.h>
+#include <gio/gunixoutputstream.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <deque>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/fs.h>
+#endif
+
+#include "io-engine.h"
+#include "log.h"
+#include "model-delta.h"
+#include "model-store.h"
+
+/**
+ * @brief The size of the chunk hashed by a worker thread.
+ */
+#define MODEL_STORE_CHUNK_SIZE (4U * 1024U * 1024U)
+
+/**
+ * @brief The size of the buffer to copy the file without the kernel support.
+ */
+#define MODEL_STORE_COPY_BUFFER_SIZE (1024U * 1024U)
+
+/**
+ * @brief The number of the buffers read or written in a batch to copy the file without the kernel support.
+ */
+#define MODEL_STORE_COPY_DEPTH (8U)
+
+/**
+ * @brief The length of the hex string of the hash.
+ */
+#define MODEL_STORE_HASH_LEN (64U)
+
+/**
+ * @brief Structure for the hash job of a file.
+ */
+typedef struct {
+  int fd;
+  GThreadPool *workers;
+  GMutex lock;
+  GCond cond;
+  guint pending;
+  gboolean failed;
+} model_store_hash_job_s;
+
+/**
+ * @brief Structure for the chunk of a file to be hashed.
+ */
+typedef struct {
+  model_store_hash_job_s *job;
+  goffset offset;
+  gsize length;
+  guint8 *buf; /**< The contents of the chunk, released when it is hashed. */
+  io_engine_op_s op;
+  guint8 digest[32];
+} model_store_hash_chunk_s;
+
+/**
+ * @brief The suffix of the compressed blob.
+ */
+#define MODEL_STORE_COMPRESSED_SUFFIX ".gz"
+
+/**
+ * @brief Structure for the decompressed copy of the compressed blob.
+ */
+typedef struct {
+  GList *link; /**< The link in the LRU queue, the data is the key of the cache table. */
+  guint64 size;
+} model_store_cache_entry_s;
+
+/**
+ * @brief Structure for the model store.
+ */
+typedef struct {
+  gchar *dir;
+  GThreadPool *workers;
+  GThreadPool *compressor; /**< The thread to compress the blobs in the background. */
+  GHashTable *pinned; /**< The hashes of the active blobs, which are never compressed. */
+  GHashTable *cache; /**< The decompressed copies, keyed by the hash. */
+  GQueue lru; /**< The hashes of the decompressed copies, the most recently used first. */
+  guint64 cache_used;
+  guint64 cache_budget;
+  guint compressing; /**< The number of the blobs queued or being compressed. */
+} model_store_s;
+
+static model_store_s g_store = { NULL, NULL, NULL, NULL, NULL, G_QUEUE_INIT, 0, 0, 0 };
+G_LOCK_DEFINE_STATIC (model_store_lock);
+
+/**
+ * @brief The lock of the hash workers. The files are hashed without the store lock.
+ */
+G_LOCK_DEFINE_STATIC (model_store_workers_lock);
+
+/**
+ * @brief Internal function to read the whole range of the file.
+ */
+static gboolean
+_read_full (int fd, guint8 *buf, gsize length, goffset offset)
+{
+  gsize done = 0;
+
+  while (done < length) {
+    ssize_t n = pread (fd, buf + done, length - done, offset + done);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return FALSE;
+
+    done += n;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to write the whole buffer at the offset of the file.
+ */
+static gint
+_write_full (int fd, const guint8 *buf, gsize length, goffset offset)
+{
+  gsize done = 0;
+
+  while (done < length) {
+    ssize_t n = pwrite (fd, buf + done, length - done, offset + done);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return (n < 0) ? -errno : -EIO;
+
+    done += n;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to release the buffer of the chunk, and wake up the thread waiting for the job.
+ */
+static void
+_finish_chunk (model_store_hash_chunk_s *chunk, gboolean hashed)
+{
+  model_store_hash_job_s *job = chunk->job;
+
+  g_free (chunk->buf);
+  chunk->buf = NULL;
+
+  g_mutex_lock (&job->lock);
+  if (!hashed)
+    job->failed = TRUE;
+  job->pending--;
+  g_cond_signal (&job->cond);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * @brief The worker function to compute the digest of the chunk read into the buffer.
+ */
+static void
+_hash_worker (gpointer data, gpointer user_data)
+{
+  model_store_hash_chunk_s *chunk = (model_store_hash_chunk_s *) data;
+  GChecksum *sum = g_checksum_new (G_CHECKSUM_SHA256);
+  gsize len = sizeof (chunk->digest);
+
+  g_checksum_update (sum, chunk->buf, chunk->length);
+  g_checksum_get_digest (sum, chunk->digest, &len);
+  g_checksum_free (sum);
+
+  _finish_chunk (chunk, TRUE);
+}
+
+/**
+ * @brief The callback of the I/O engine, the chunk is read. Hash it on the workers, not to block the I/O.
+ */
+static void
+_chunk_read_cb (io_engine_op_s *ops, guint num, gpointer user_data)
+{
+  model_store_hash_chunk_s *chunk = (model_store_hash_chunk_s *) user_data;
+  GThreadPool *workers = chunk->job->workers;
+
+  if (ops[0].result < 0 || (gsize) ops[0].result != chunk->length) {
+    _finish_chunk (chunk, FALSE);
+    return;
+  }
+
+  if (!workers || !g_thread_pool_push (workers, chunk, NULL))
+    _hash_worker (chunk, NULL);
+}
+
+/**
+ * @brief Internal function to read the chunk with the I/O engine and hash it in the background.
+ * @note Count the chunk in the pending ones of the job before calling it.
+ */
+static void
+_hash_chunk_async (model_store_hash_chunk_s *chunk)
+{
+  model_store_hash_job_s *job = chunk->job;
+
+  chunk->buf = (guint8 *) g_try_malloc (MAX (chunk->length, 1U));
+  if (!chunk->buf) {
+    _finish_chunk (chunk, FALSE);
+    return;
+  }
+
+  chunk->op.type = IO_ENGINE_OP_READ;
+  chunk->op.fd = job->fd;
+  chunk->op.buf = chunk->buf;
+  chunk->op.length = chunk->length;
+  chunk->op.offset = chunk->offset;
+
+  if (io_engine_submit (&chunk->op, 1U, _chunk_read_cb, chunk, NULL) != 0) {
+    /* The engine is stopping, read it by ourselves. */
+    if (_read_full (job->fd, chunk->buf, chunk->length, chunk->offset))
+      _hash_worker (chunk, NULL);
+    else
+      _finish_chunk (chunk, FALSE);
+  }
+}
+
+/**
+ * @brief Internal function to wait until the number of the pending chunks of the job is not more than the limit.
+ */
+static void
+_wait_chunks (model_store_hash_job_s *job, guint limit)
+{
+  g_mutex_lock (&job->lock);
+  while (job->pending > limit)
+    g_cond_wait (&job->cond, &job->lock);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * @brief Internal function to get the workers to hash the chunks.
+ */
+static GThreadPool *
+_get_workers (void)
+{
+  GThreadPool *workers;
+
+  G_LOCK (model_store_workers_lock);
+  /* The hash is also used to verify the models registered without the store. */
+  if (!g_store.workers)
+    g_store.workers = g_thread_pool_new (
+        _hash_worker, NULL, MAX (g_get_num_processors (), 1U), FALSE, NULL);
+  workers = g_store.workers;
+  G_UNLOCK (model_store_workers_lock);
+
+  return workers;
+}
+
+/**
+ * @brief Internal function to get the hash from the digests of the chunks.
+ */
+static gchar *
+_get_hash_string (const std::vector<model_store_hash_chunk_s> &chunks)
+{
+  GChecksum *sum = g_checksum_new (G_CHECKSUM_SHA256);
+  gchar *hash;
+  size_t i;
+
+  for (i = 0; i < chunks.size (); i++)
+    g_checksum_update (sum, chunks[i].digest, sizeof (chunks[i].digest));
+
+  hash = g_strdup (g_checksum_get_string (sum));
+  g_checksum_free (sum);
+
+  return hash;
+}
+
+/**
+ * @brief Internal function to compute the hash of the opened file.
+ */
+static gint
+_hash_fd (int fd, gchar **hash)
+{
+  struct stat st;
+  model_store_hash_job_s job;
+  std::vector<model_store_hash_chunk_s> chunks;
+  guint max_pending = MAX (g_get_num_processors (), 1U) * 2U;
+  goffset offset = 0;
+  size_t i;
+
+  if (fstat (fd, &st) != 0)
+    return -errno;
+
+  do {
+    model_store_hash_chunk_s chunk = {};
+
+    chunk.job = &job;
+    chunk.offset = offset;
+    chunk.length = (gsize) MIN ((goffset) MODEL_STORE_CHUNK_SIZE, st.st_size - offset);
+    chunks.push_back (chunk);
+    offset += chunk.length;
+  } while (offset < st.st_size);
+
+  job.fd = fd;
+  job.workers = _get_workers ();
+  job.failed = FALSE;
+  job.pending = 0;
+  g_mutex_init (&job.lock);
+  g_cond_init (&job.cond);
+
+  /* Keep the reads of the next chunks in flight while hashing the read ones, bounding the buffers. */
+  for (i = 0; i < chunks.size (); i++) {
+    gboolean failed;
+
+    _wait_chunks (&job, max_pending - 1U);
+
+    g_mutex_lock (&job.lock);
+    failed = job.failed;
+    if (!failed)
+      job.pending++;
+    g_mutex_unlock (&job.lock);
+
+    if (failed)
+      break;
+
+    _hash_chunk_async (&chunks[i]);
+  }
+
+  _wait_chunks (&job, 0U);
+
+  g_mutex_clear (&job.lock);
+  g_cond_clear (&job.cond);
+
+  if (job.failed)
+    return -EIO;
+
+  *hash = _get_hash_string (chunks);
+  return 0;
+}
+
+/**
+ * @brief Internal function to check the string is a valid hash.
+ */
+static gboolean
+_is_valid_hash (const gchar *hash)
+{
+  gsize i;
+
+  if (!hash || strlen (hash) != MODEL_STORE_HASH_LEN)
+    return FALSE;
+
+  for (i = 0; i < MODEL_STORE_HASH_LEN; i++) {
+    if (!g_ascii_isxdigit (hash[i]) || g_ascii_isupper (hash[i]))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the path of the blob. Call it with the store lock.
+ */
+static gchar *
+_get_blob_path_locked (const gchar *hash)
+{
+  g_autofree gchar *prefix = g_strndup (hash, 2);
+
+  return g_build_filename (g_store.dir, prefix, hash, NULL);
+}
+
+/**
+ * @brief Internal function to copy the file contents with read and write.
+ */
+static gint
+_copy_rw (int src, int dst, goffset offset, goffset size)
+{
+  io_engine_op_s ops[MODEL_STORE_COPY_DEPTH];
+  guint8 *buf;
+  guint i, num;
+  gint ret = 0;
+
+  buf = (guint8 *) g_try_malloc (MODEL_STORE_COPY_BUFFER_SIZE * MODEL_STORE_COPY_DEPTH);
+  if (!buf)
+    return -ENOMEM;
+
+  /* Read the buffers in a batch, then write them in a batch, to keep the storage queue busy. */
+  while (offset < size && ret == 0) {
+    for (num = 0; num < MODEL_STORE_COPY_DEPTH && offset < size; num++) {
+      ops[num].type = IO_ENGINE_OP_READ;
+      ops[num].fd = src;
+      ops[num].buf = buf + (gsize) num * MODEL_STORE_COPY_BUFFER_SIZE;
+      ops[num].length = (gsize) MIN ((goffset) MODEL_STORE_COPY_BUFFER_SIZE, size - offset);
+      ops[num].offset = offset;
+      offset += ops[num].length;
+    }
+
+    ret = io_engine_run (ops, num);
+    if (ret != 0)
+      break;
+
+    for (i = 0; i < num; i++) {
+      ops[i].type = IO_ENGINE_OP_WRITE;
+      ops[i].fd = dst;
+    }
+
+    ret = io_engine_run (ops, num);
+  }
+
+  g_free (buf);
+  return ret;
+}
+
+/**
+ * @brief Internal function to copy the range of the file contents, from the offset to the end.
+ */
+static gint
+_copy_range (int src, int dst, goffset offset, goffset end, gboolean *kernel_copy)
+{
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 27)
+  while (*kernel_copy && offset < end) {
+    loff_t in_off = offset, out_off = offset;
+    ssize_t n = copy_file_range (src, &in_off, dst, &out_off, end - offset, 0);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      *kernel_copy = FALSE;
+    if (n <= 0)
+      break;
+
+    offset += n;
+  }
+#endif
+#endif
+
+  /* The kernel cannot copy the file across the file systems, do it by ourselves. */
+  return _copy_rw (src, dst, offset, end);
+}
+
+/**
+ * @brief Internal function to copy the file contents, and hash the copied contents in the same pass.
+ * @details It shares the extents if the file system supports it, then only the clone is read to hash it.
+ *          Otherwise the copied chunks are hashed in the background while copying the next ones.
+ */
+static gint
+_copy_hash_fd (int src, int dst, goffset size, gchar **hash)
+{
+  model_store_hash_job_s job;
+  std::deque<model_store_hash_chunk_s> chunks;
+  guint max_pending = MAX (g_get_num_processors (), 1U) * 2U;
+  gboolean kernel_copy = TRUE;
+  goffset offset = 0;
+  gint ret = 0;
+
+#if defined(FICLONE)
+  if (ioctl (dst, FICLONE, src) == 0)
+    return _hash_fd (dst, hash);
+#endif
+
+  job.fd = dst;
+  job.workers = _get_workers ();
+  job.failed = FALSE;
+  job.pending = 0;
+  g_mutex_init (&job.lock);
+  g_cond_init (&job.cond);
+
+  /* Split the chunks same as hashing the file, an empty file has one empty chunk. */
+  do {
+    model_store_hash_chunk_s chunk = {};
+    gboolean failed;
+
+    chunk.job = &job;
+    chunk.offset = offset;
+    chunk.length = (gsize) MIN ((goffset) MODEL_STORE_CHUNK_SIZE, size - offset);
+
+    ret = _copy_range (src, dst, offset, offset + (goffset) chunk.length, &kernel_copy);
+    if (ret != 0)
+      break;
+
+    chunks.push_back (chunk);
+    offset += chunk.length;
+
+    /* The chunk is in the page cache, hash it while copying the next one. */
+    _wait_chunks (&job, max_pending - 1U);
+
+    g_mutex_lock (&job.lock);
+    failed = job.failed;
+    if (!failed)
+      job.pending++;
+    g_mutex_unlock (&job.lock);
+
+    if (failed)
+      break;
+
+    _hash_chunk_async (&chunks.back ());
+  } while (offset < size);
+
+  _wait_chunks (&job, 0U);
+
+  g_mutex_clear (&job.lock);
+  g_cond_clear (&job.cond);
+
+  if (ret == 0 && job.failed)
+    ret = -EIO;
+
+  if (ret == 0) {
+    std::vector<model_store_hash_chunk_s> digests (chunks.begin (), chunks.end ());
+
+    *hash = _get_hash_string (digests);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Internal function to sync the directory entries.
+ */
+static void
+_sync_dir (const gchar *dir)
+{
+  int fd = open (dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+  if (fd >= 0) {
+    fsync (fd);
+    close (fd);
+  }
+}
+
+/**
+ * @brief Internal function to copy the next chunk from the stream. It returns the copied length or a negative error value.
+ */
+static gssize
+_stream_chunk (int src, int dst, goffset offset, guint8 **buf, gboolean *kernel_copy)
+{
+  gsize length = 0;
+
+  while (length < MODEL_STORE_CHUNK_SIZE) {
+    ssize_t n = -1;
+
+#if defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 27)
+    if (*kernel_copy) {
+      loff_t out_off = offset + length;
+
+      /* The kernel copies the data from the current position of the source. */
+      n = copy_file_range (src, NULL, dst, &out_off, MODEL_STORE_CHUNK_SIZE - length, 0);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n < 0)
+        *kernel_copy = FALSE;
+    }
+#else
+    *kernel_copy = FALSE;
+#endif
+#else
+    *kernel_copy = FALSE;
+#endif
+
+    if (!*kernel_copy) {
+      /* The source is a pipe or a socket, or the kernel cannot copy it across the file systems. */
+      if (!*buf && !(*buf = (guint8 *) g_try_malloc (MODEL_STORE_COPY_BUFFER_SIZE)))
+        return -ENOMEM;
+
+      n = read (src, *buf, MIN (MODEL_STORE_COPY_BUFFER_SIZE, MODEL_STORE_CHUNK_SIZE - length));
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n > 0) {
+        gint ret = _write_full (dst, *buf, n, offset + length);
+
+        if (ret != 0)
+          return ret;
+      }
+    }
+
+    if (n < 0)
+      return -errno;
+    if (n == 0)
+      break;
+
+    length += n;
+  }
+
+  return (gssize) length;
+}
+
+/**
+ * @brief Internal function to copy the stream into the file, and hash the copied chunks in parallel.
+ */
+static gint
+_stream_fd (int src, int dst, gchar **hash)
+{
+  model_store_hash_job_s job;
+  std::deque<model_store_hash_chunk_s> chunks;
+  guint max_pending = MAX (g_get_num_processors (), 1U) * 2U;
+  gboolean kernel_copy = TRUE;
+  guint8 *buf = NULL;
+  goffset offset = 0;
+  gssize length;
+  gint ret = 0;
+
+  job.fd = dst;
+  job.workers = _get_workers ();
+  job.failed = FALSE;
+  job.pending = 0;
+  g_mutex_init (&job.lock);
+  g_cond_init (&job.cond);
+
+  do {
+    model_store_hash_chunk_s chunk = {};
+
+    length = _stream_chunk (src, dst, offset, &buf, &kernel_copy);
+    if (length < 0) {
+      ret = (gint) length;
+      break;
+    }
+
+    /* Split the chunks same as hashing the file, an empty file has one empty chunk. */
+    if (length == 0 && !chunks.empty ())
+      break;
+
+    chunk.job = &job;
+    chunk.offset = offset;
+    chunk.length = (gsize) length;
+    chunks.push_back (chunk);
+    offset += length;
+
+    /* The chunk is in the page cache, hash it while copying the next one. */
+    _wait_chunks (&job, max_pending - 1U);
+
+    g_mutex_lock (&job.lock);
+    job.pending++;
+    g_mutex_unlock (&job.lock);
+
+    _hash_chunk_async (&chunks.back ());
+  } while (length == (gssize) MODEL_STORE_CHUNK_SIZE);
+
+  _wait_chunks (&job, 0U);
+
+  g_mutex_clear (&job.lock);
+  g_cond_clear (&job.cond);
+  g_free (buf);
+
+  if (ret == 0 && job.failed)
+    ret = -EIO;
+
+  if (ret == 0) {
+    std::vector<model_store_hash_chunk_s> digests (chunks.begin (), chunks.end ());
+
+    *hash = _get_hash_string (digests);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Internal function to find the blob if the path is in the model store.
+ */
+static gboolean
+_find_blob (const gchar *path, gchar **blob_path, gchar **hash)
+{
+  g_autofree gchar *name = g_path_get_basename (path);
+  gchar *blob = NULL;
+
+  if (!_is_valid_hash (name))
+    return FALSE;
+
+  G_LOCK (model_store_lock);
+  if (g_store.dir)
+    blob = _get_blob_path_locked (name);
+  G_UNLOCK (model_store_lock);
+
+  if (!blob || !g_str_equal (blob, path) || !g_file_test (blob, G_FILE_TEST_IS_REGULAR)) {
+    g_free (blob);
+    return FALSE;
+  }
+
+  *blob_path = blob;
+  *hash = g_steal_pointer (&name);
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the path of the compressed blob. Call it with the store lock.
+ */
+static gchar *
+_get_compressed_path_locked (const gchar *hash)
+{
+  g_autofree gchar *blob = _get_blob_path_locked (hash);
+
+  return g_strconcat (blob, MODEL_STORE_COMPRESSED_SUFFIX, NULL);
+}
+
+/**
+ * @brief Internal function to drop the decompressed copy from the cache. Call it with the store lock.
+ */
+static void
+_cache_remove_locked (const gchar *hash)
+{
+  model_store_cache_entry_s *entry;
+
+  if (!g_store.cache)
+    return;
+
+  entry = (model_store_cache_entry_s *) g_hash_table_lookup (g_store.cache, hash);
+  if (!entry)
+    return;
+
+  g_queue_delete_link (&g_store.lru, entry->link);
+  g_store.cache_used -= entry->size;
+  g_hash_table_remove (g_store.cache, hash);
+}
+
+/**
+ * @brief Internal function to mark the decompressed copy as recently used, and evict the least recently used copies over the budget.
+ *        Call it with the store lock.
+ */
+static void
+_cache_touch_locked (const gchar *hash, guint64 size)
+{
+  model_store_cache_entry_s *entry;
+  gchar *key;
+
+  if (!g_store.cache)
+    return;
+
+  entry = (model_store_cache_entry_s *) g_hash_table_lookup (g_store.cache, hash);
+  if (entry) {
+    g_queue_unlink (&g_store.lru, entry->link);
+    g_queue_push_head_link (&g_store.lru, entry->link);
+  } else {
+    key = g_strdup (hash);
+    entry = g_new0 (model_store_cache_entry_s, 1);
+    entry->size = size;
+
+    g_queue_push_head (&g_store.lru, key);
+    entry->link = g_queue_peek_head_link (&g_store.lru);
+    g_hash_table_insert (g_store.cache, key, entry);
+    g_store.cache_used += size;
+  }
+
+  /* Keep the latest one even if it is over the budget, the caller is about to use it. */
+  while (g_store.cache_used > g_store.cache_budget && g_queue_get_length (&g_store.lru) > 1) {
+    g_autofree gchar *victim = g_strdup ((const gchar *) g_queue_peek_tail (&g_store.lru));
+    g_autofree gchar *blob = _get_blob_path_locked (victim);
+    g_autofree gchar *compressed = _get_compressed_path_locked (victim);
+
+    if (g_file_test (compressed, G_FILE_TEST_IS_REGULAR))
+      g_unlink (blob);
+
+    _cache_remove_locked (victim);
+  }
+}
+
+/**
+ * @brief Internal function to compress the file into the opened file.
+ */
+static gint
+_compress_file (int src, int dst)
+{
+  GZlibCompressor *compressor = g_zlib_compressor_new (G_ZLIB_COMPRESSOR_FORMAT_GZIP, -1);
+  GOutputStream *base = g_unix_output_stream_new (dst, FALSE);
+  GOutputStream *out = g_converter_output_stream_new (base, G_CONVERTER (compressor));
+  GError *err = NULL;
+  guint8 *buf;
+  goffset offset = 0;
+  gint ret = 0;
+
+  buf = (guint8 *) g_try_malloc (MODEL_STORE_COPY_BUFFER_SIZE);
+  if (!buf)
+    ret = -ENOMEM;
+
+  while (ret == 0) {
+    ssize_t n = pread (src, buf, MODEL_STORE_COPY_BUFFER_SIZE, offset);
+
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      ret = -errno;
+    if (n <= 0)
+      break;
+
+    if (!g_output_stream_write_all (out, buf, n, NULL, NULL, &err))
+      ret = -EIO;
+
+    offset += n;
+  }
+
+  /* Closing the converter flushes the trailer of the compressed stream. */
+  if (!g_output_stream_close (out, NULL, (ret == 0) ? &err : NULL) && ret == 0)
+    ret = -EIO;
+
+  if (err) {
+    ml_loge ("Failed to compress the blob (%s).", err->message);
+    g_clear_error (&err);
+  }
+
+  g_object_unref (out);
+  g_object_unref (base);
+  g_object_unref (compressor);
+  g_free (buf);
+  return ret;
+}
+
+/**
+ * @brief Internal function to decompress the file into the opened file.
+ */
+static gint
+_decompress_file (int src, int dst)
+{
+  GZlibDecompressor *decompressor = g_zlib_decompressor_new (G_ZLIB_COMPRESSOR_FORMAT_GZIP);
+  GInputStream *base = g_unix_input_stream_new (src, FALSE);
+  GInputStream *in = g_converter_input_stream_new (base, G_CONVERTER (decompressor));
+  GError *err = NULL;
+  guint8 *buf;
+  goffset offset = 0;
+  gint ret = 0;
+
+  buf = (guint8 *) g_try_malloc (MODEL_STORE_COPY_BUFFER_SIZE);
+  if (!buf)
+    ret = -ENOMEM;
+
+  while (ret == 0) {
+    gssize n = g_input_stream_read (in, buf, MODEL_STORE_COPY_BUFFER_SIZE, NULL, &err);
+
+    if (n < 0)
+      ret = -EIO;
+    if (n <= 0)
+      break;
+
+    ret = _write_full (dst, buf, n, offset);
+    offset += n;
+  }
+
+  if (err) {
+    ml_loge ("Failed to decompress the blob (%s).", err->message);
+    g_clear_error (&err);
+  }
+
+  g_input_stream_close (in, NULL, NULL);
+  g_object_unref (in);
+  g_object_unref (base);
+  g_object_unref (decompressor);
+  g_free (buf);
+  return ret;
+}
+
+/**
+ * @brief The worker function to compress the blob in the background.
+ */
+static void
+_compress_worker (gpointer data, gpointer user_data)
+{
+  gchar *hash = (gchar *) data;
+  guint64 reclaimed = 0;
+
+  if (model_store_compress (hash, &reclaimed) == 0 && reclaimed > 0)
+    ml_logi ("The blob '%s' is compressed, %" G_GUINT64_FORMAT " bytes are reclaimed.", hash, reclaimed);
+
+  g_free (hash);
+
+  G_LOCK (model_store_lock);
+  g_store.compressing--;
+  G_UNLOCK (model_store_lock);
+}
+
+/**
+ * @brief Initialize the model store.
+ */
+gint
+model_store_init (const gchar *dir)
+{
+  if (!dir || dir[0] == '\0')
+    return 0;
+
+  if (g_mkdir_with_parents (dir, 0755) != 0) {
+    ml_loge ("Failed to create the model store directory '%s' (%d).", dir, errno);
+    return -errno;
+  }
+
+  G_LOCK (model_store_lock);
+  g_free (g_store.dir);
+  g_store.dir = g_strdup (dir);
+
+  if (!g_store.pinned)
+    g_store.pinned = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+  if (!g_store.cache)
+    g_store.cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  G_UNLOCK (model_store_lock);
+
+  ml_logi ("The model store is enabled at '%s'.", dir);
+  return 0;
+}
+
+/**
+ * @brief Disable the model store. The stored blobs are kept.
+ */
+void
+model_store_fini (void)
+{
+  GThreadPool *workers, *compressor;
+
+  G_LOCK (model_store_lock);
+  g_free (g_store.dir);
+  g_store.dir = NULL;
+  compressor = g_store.compressor;
+  g_store.compressor = NULL;
+  G_UNLOCK (model_store_lock);
+
+  G_LOCK (model_store_workers_lock);
+  workers = g_store.workers;
+  g_store.workers = NULL;
+  G_UNLOCK (model_store_workers_lock);
+
+  /* The queued blobs are skipped quickly, the store is already disabled. */
+  if (compressor)
+    g_thread_pool_free (compressor, FALSE, TRUE);
+  if (workers)
+    g_thread_pool_free (workers, FALSE, TRUE);
+
+  G_LOCK (model_store_lock);
+  g_clear_pointer (&g_store.pinned, g_hash_table_destroy);
+  g_clear_pointer (&g_store.cache, g_hash_table_destroy);
+  g_queue_clear (&g_store.lru);
+  g_store.cache_used = 0;
+  G_UNLOCK (model_store_lock);
+}
+
+/**
+ * @brief Set the total size of the decompressed copies of the compressed blobs.
+ */
+void
+model_store_set_cache_budget (guint64 budget)
+{
+  G_LOCK (model_store_lock);
+  g_store.cache_budget = budget;
+  G_UNLOCK (model_store_lock);
+}
+
+/**
+ * @brief Check whether the model store is enabled.
+ */
+gboolean
+model_store_is_enabled (void)
+{
+  gboolean enabled;
+
+  G_LOCK (model_store_lock);
+  enabled = (g_store.dir != NULL);
+  G_UNLOCK (model_store_lock);
+
+  return enabled;
+}
+
+/**
+ * @brief Check whether the path is in the model store.
+ */
+gboolean
+model_store_owns_path (const gchar *path)
+{
+  gboolean owned = FALSE;
+  gsize len;
+
+  if (!path)
+    return FALSE;
+
+  G_LOCK (model_store_lock);
+  if (g_store.dir) {
+    len = strlen (g_store.dir);
+    owned = (strncmp (path, g_store.dir, len) == 0 && path[len] == G_DIR_SEPARATOR);
+  }
+  G_UNLOCK (model_store_lock);
+
+  return owned;
+}
+
+/**
+ * @brief Compute the hash of the file contents.
+ */
+gint
+model_store_hash_file (const gchar *path, gchar **hash)
+{
+  int fd;
+  gint ret;
+
+  g_return_val_if_fail (path != NULL && hash != NULL, -EINVAL);
+
+  fd = open (path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return -errno;
+
+  ret = _hash_fd (fd, hash);
+  close (fd);
+
+  return ret;
+}
+
+/**
+ * @brief Internal function to create the temporary file in the model store.
+ */
+static int
+_create_staging_file (gchar **tmp_path)
+{
+  gchar *path = NULL;
+  int fd;
+
+  G_LOCK (model_store_lock);
+  if (g_store.dir)
+    path = g_build_filename (g_store.dir, ".import-XXXXXX", NULL);
+  G_UNLOCK (model_store_lock);
+
+  if (!path)
+    return -ENOTSUP;
+
+  fd = g_mkstemp_full (path, O_RDWR | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    fd = -errno;
+    g_free (path);
+    return fd;
+  }
+
+  *tmp_path = path;
+  return fd;
+}
+
+/**
+ * @brief Internal function to move the staged file to the blob of the hash.
+ *        The staged file is removed if it fails or if the blob already exists.
+ */
+static gint
+_commit_staging_file (const gchar *tmp_path, int fd, gint ret, const gchar *hash, gchar **blob_path)
+{
+  gchar *blob = NULL;
+  gboolean staged = FALSE;
+
+  if (ret == 0 && fsync (fd) != 0)
+    ret = -errno;
+  if (ret == 0 && fchmod (fd, 0444) != 0)
+    ret = -errno;
+
+  close (fd);
+
+  if (ret == 0) {
+    G_LOCK (model_store_lock);
+    if (!g_store.dir) {
+      ret = -ENOTSUP;
+    } else {
+      g_autofree gchar *dir = NULL;
+
+      blob = _get_blob_path_locked (hash);
+      dir = g_path_get_dirname (blob);
+
+      if (g_file_test (blob, G_FILE_TEST_IS_REGULAR)) {
+        ml_logi ("The staged model is already stored as '%s'.", blob);
+      } else if (g_mkdir_with_parents (dir, 0755) != 0 || g_rename (tmp_path, blob) != 0) {
+        ret = -errno;
+      } else {
+        staged = TRUE;
+        _sync_dir (dir);
+      }
+    }
+    G_UNLOCK (model_store_lock);
+  }
+
+  if (!staged)
+    g_unlink (tmp_path);
+
+  if (ret != 0) {
+    g_free (blob);
+    return ret;
+  }
+
+  *blob_path = blob;
+  return 0;
+}
+
+/**
+ * @brief Add the file to the model store.
+ */
+gint
+model_store_add (const gchar *path, gchar **blob_path, gchar **hash)
+{
+  struct stat st;
+  g_autofree gchar *tmp_path = NULL;
+  g_autofree gchar *h = NULL;
+  int fd, dst;
+  gint ret;
+
+  g_return_val_if_fail (path != NULL && blob_path != NULL && hash != NULL, -EINVAL);
+
+  if (!model_store_is_enabled ())
+    return -ENOTSUP;
+
+  /* The blob is already stored, e.g., it is staged from the file descriptor. */
+  if (_find_blob (path, blob_path, hash))
+    return 0;
+
+  fd = open (path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return -errno;
+
+  if (fstat (fd, &st) != 0 || !S_ISREG (st.st_mode)) {
+    close (fd);
+    return -EINVAL;
+  }
+
+  dst = _create_staging_file (&tmp_path);
+  if (dst < 0) {
+    close (fd);
+    return dst;
+  }
+
+  /**
+   * Copy and hash without the lock, it takes the most of the time.
+   * The hash is computed from the staged copy, so the blob is matched with it even if the file is changed while copying.
+   */
+  ret = _copy_hash_fd (fd, dst, st.st_size, &h);
+  close (fd);
+
+  ret = _commit_staging_file (tmp_path, dst, ret, h, blob_path);
+  if (ret != 0) {
+    ml_loge ("Failed to add the model '%s' to the model store (%d).", path, ret);
+    return ret;
+  }
+
+  *hash = g_steal_pointer (&h);
+  return 0;
+}
+
+/**
+ * @brief Add the contents read from the file descriptor to the model store.
+ */
+gint
+model_store_add_from_fd (int fd, gchar **blob_path, gchar **hash)
+{
+  g_autofree gchar *tmp_path = NULL;
+  g_autofree gchar *h = NULL;
+  int dst;
+  gint ret;
+
+  g_return_val_if_fail (fd >= 0 && blob_path != NULL && hash != NULL, -EINVAL);
+
+  dst = _create_staging_file (&tmp_path);
+  if (dst < 0)
+    return dst;
+
+  /* Copy and hash in one pass, the name of the blob is known only at the end. */
+  ret = _stream_fd (fd, dst, &h);
+  ret = _commit_staging_file (tmp_path, dst, ret, h, blob_path);
+
+  if (ret != 0) {
+    ml_loge ("Failed to add the streamed model to the model store (%d).", ret);
+    return ret;
+  }
+
+  *hash = g_steal_pointer (&h);
+  return 0;
+}
+
+/**
+ * @brief Reconstruct the model from the base and the delta, and add it to the model store.
+ */
+gint
+model_store_add_delta (const gchar *base_path, int delta_fd, gchar **blob_path, gchar **hash)
+{
+  g_autofree gchar *tmp_path = NULL;
+  g_autofree gchar *expected = NULL;
+  g_autofree gchar *h = NULL;
+  int base, dst;
+  gint ret;
+
+  g_return_val_if_fail (base_path != NULL && delta_fd >= 0, -EINVAL);
+  g_return_val_if_fail (blob_path != NULL && hash != NULL, -EINVAL);
+
+  base = open (base_path, O_RDONLY | O_CLOEXEC);
+  if (base < 0)
+    return -errno;
+
+  dst = _create_staging_file (&tmp_path);
+  if (dst < 0) {
+    close (base);
+    return dst;
+  }
+
+  ret = model_delta_apply (base, delta_fd, dst, &expected);
+  close (base);
+
+  /* The delta is applied to the exact base, otherwise the result is not the expected model. */
+  if (ret == 0 && (ret = _hash_fd (dst, &h)) == 0 && !g_str_equal (h, expected)) {
+    ml_loge ("The model reconstructed from '%s' is not matched with the hash of the delta.", base_path);
+    ret = -EBADMSG;
+  }
+
+  ret = _commit_staging_file (tmp_path, dst, ret, h, blob_path);
+  if (ret != 0) {
+    ml_loge ("Failed to add the model reconstructed from the delta (%d).", ret);
+    return ret;
+  }
+
+  *hash = g_steal_pointer (&h);
+  return 0;
+}
+
+/**
+ * @brief Compress the blob of the inactive model.
+ */
+gint
+model_store_compress (const gchar *hash, guint64 *reclaimed)
+{
+  g_autofree gchar *blob = NULL;
+  g_autofree gchar *compressed = NULL;
+  g_autofree gchar *tmp_path = NULL;
+  struct stat st, cst = {};
+  int src, dst;
+  gint ret = 0;
+
+  g_return_val_if_fail (reclaimed != NULL, -EINVAL);
+
+  *reclaimed = 0;
+  if (!_is_valid_hash (hash))
+    return -EINVAL;
+
+  G_LOCK (model_store_lock);
+  if (g_store.dir) {
+    blob = _get_blob_path_locked (hash);
+    compressed = _get_compressed_path_locked (hash);
+  }
+  G_UNLOCK (model_store_lock);
+
+  if (!blob)
+    return -ENOTSUP;
+
+  src = open (blob, O_RDONLY | O_CLOEXEC);
+  if (src < 0)
+    return -errno;
+
+  if (fstat (src, &st) != 0) {
+    ret = -errno;
+    close (src);
+    return ret;
+  }
+
+  /* The size of the decompressed blob is read from the gzip trailer, which is 32-bit. */
+  if ((guint64) st.st_size > G_MAXUINT32) {
+    close (src);
+    return -EFBIG;
+  }
+
+  /* The decompressed copy of the compressed blob is removed by the cache budget only, the clients may use it. */
+  if (g_file_test (compressed, G_FILE_TEST_IS_REGULAR)) {
+    close (src);
+    return 0;
+  }
+
+  dst = _create_staging_file (&tmp_path);
+  if (dst < 0) {
+    close (src);
+    return dst;
+  }
+
+  ret = _compress_file (src, dst);
+  if (ret == 0 && fsync (dst) != 0)
+    ret = -errno;
+  if (ret == 0 && fchmod (dst, 0444) != 0)
+    ret = -errno;
+  if (ret == 0 && fstat (dst, &cst) != 0)
+    ret = -errno;
+
+  close (dst);
+  close (src);
+
+  /* The model is not compressible, e.g., it is already quantized and packed. */
+  if (ret == 0 && cst.st_size >= st.st_size) {
+    g_unlink (tmp_path);
+    return 0;
+  }
+
+  if (ret == 0) {
+    G_LOCK (model_store_lock);
+    if (!g_store.dir) {
+      ret = -ENOTSUP;
+    } else if (g_hash_table_contains (g_store.pinned, hash)) {
+      /* The model is activated while compressing it. */
+      ret = -EBUSY;
+    } else if (!g_file_test (blob, G_FILE_TEST_IS_REGULAR)) {
+      /* The blob is removed while compressing it. */
+      ret = -ENOENT;
+    } else if (g_rename (tmp_path, compressed) != 0) {
+      ret = -errno;
+    } else {
+      g_clear_pointer (&tmp_path, g_free);
+
+      if (g_unlink (blob) != 0)
+        ret = -errno;
+
+      _cache_remove_locked (hash);
+    }
+    G_UNLOCK (model_store_lock);
+  }
+
+  if (tmp_path)
+    g_unlink (tmp_path);
+
+  if (ret != 0)
+    return ret;
+
+  if (g_stat (compressed, &cst) == 0 && cst.st_size < st.st_size)
+    *reclaimed = (guint64) (st.st_size - cst.st_size);
+
+  return 0;
+}
+
+/**
+ * @brief Request to compress the blob of the inactive model in the background.
+ */
+void
+model_store_compress_async (const gchar *hash)
+{
+  if (!_is_valid_hash (hash))
+    return;
+
+  G_LOCK (model_store_lock);
+  if (g_store.dir) {
+    /* The model is deactivated. */
+    g_hash_table_remove (g_store.pinned, hash);
+
+    if (!g_store.compressor)
+      g_store.compressor = g_thread_pool_new (_compress_worker, NULL, 1, FALSE, NULL);
+
+    if (g_store.compressor && g_thread_pool_push (g_store.compressor, g_strdup (hash), NULL))
+      g_store.compressing++;
+  }
+  G_UNLOCK (model_store_lock);
+}
+
+/**
+ * @brief Check whether the blobs are queued or being compressed in the background.
+ */
+gboolean
+model_store_is_compressing (void)
+{
+  gboolean compressing;
+
+  G_LOCK (model_store_lock);
+  compressing = (g_store.compressing > 0U);
+  G_UNLOCK (model_store_lock);
+
+  return compressing;
+}
+
+/**
+ * @brief Make the blob available at its path, decompressing it if it is compressed.
+ */
+gint
+model_store_materialize (const gchar *hash, gboolean pin)
+{
+  g_autofree gchar *blob = NULL;
+  g_autofree gchar *compressed = NULL;
+  struct stat st;
+  gint ret = 0;
+
+  if (!_is_valid_hash (hash))
+    return -EINVAL;
+
+  G_LOCK (model_store_lock);
+  if (g_store.dir) {
+    blob = _get_blob_path_locked (hash);
+    compressed = _get_compressed_path_locked (hash);
+  }
+  G_UNLOCK (model_store_lock);
+
+  if (!blob)
+    return -ENOTSUP;
+
+  if (!g_file_test (blob, G_FILE_TEST_IS_REGULAR)) {
+    g_autofree gchar *tmp_path = NULL;
+    g_autofree gchar *h = NULL;
+    gchar *committed = NULL;
+    int src, dst;
+
+    src = open (compressed, O_RDONLY | O_CLOEXEC);
+    if (src < 0)
+      return -errno;
+
+    dst = _create_staging_file (&tmp_path);
+    if (dst < 0) {
+      close (src);
+      return dst;
+    }
+
+    ret = _decompress_file (src, dst);
+    close (src);
+
+    if (ret == 0 && (ret = _hash_fd (dst, &h)) == 0 && !g_str_equal (h, hash)) {
+      ml_loge ("The compressed blob '%s' is corrupted.", compressed);
+      ret = -EBADMSG;
+    }
+
+    ret = _commit_staging_file (tmp_path, dst, ret, hash, &committed);
+    g_free (committed);
+
+    if (ret != 0) {
+      ml_loge ("Failed to decompress the blob '%s' (%d).", hash, ret);
+      return ret;
+    }
+  }
+
+  G_LOCK (model_store_lock);
+  if (!g_store.dir) {
+    ret = -ENOTSUP;
+  } else if (pin) {
+    /* The active model stays decompressed. */
+    g_hash_table_add (g_store.pinned, g_strdup (hash));
+    _cache_remove_locked (hash);
+    g_unlink (compressed);
+  } else if (g_file_test (compressed, G_FILE_TEST_IS_REGULAR) && g_stat (blob, &st) == 0) {
+    _cache_touch_locked (hash, (guint64) st.st_size);
+  }
+  G_UNLOCK (model_store_lock);
+
+  return ret;
+}
+
+/**
+ * @brief Check whether the blob is compressed, and get the size reclaimed by the compression.
+ */
+gboolean
+model_store_get_compressed_info (const gchar *hash, guint64 *reclaimed)
+{
+  g_autofree gchar *compressed = NULL;
+  guint32 isize = 0;
+  struct stat st;
+  int fd;
+
+  if (reclaimed)
+    *reclaimed = 0;
+
+  if (!_is_valid_hash (hash))
+    return FALSE;
+
+  G_LOCK (model_store_lock);
+  if (g_store.dir)
+    compressed = _get_compressed_path_locked (hash);
+  G_UNLOCK (model_store_lock);
+
+  if (!compressed)
+    return FALSE;
+
+  fd = open (compressed, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return FALSE;
+
+  /* The gzip trailer ends with the size of the decompressed data. */
+  if (reclaimed && fstat (fd, &st) == 0 && st.st_size >= (off_t) sizeof (isize)
+      && _read_full (fd, (guint8 *) &isize, sizeof (isize), st.st_size - (off_t) sizeof (isize))
+      && GUINT32_FROM_LE (isize) > (guint64) st.st_size)
+    *reclaimed = GUINT32_FROM_LE (isize) - (guint64) st.st_size;
+
+  close (fd);
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the size of the file, or 0 if it does not exist.
+ */
+static guint64
+_get_file_size (const gchar *path)
+{
+  GStatBuf st;
+
+  if (g_stat (path, &st) != 0 || !S_ISREG (st.st_mode))
+    return 0;
+
+  return (guint64) st.st_size;
+}
+
+/**
+ * @brief Get the total size of the blobs in the model store.
+ */
+gint
+model_store_get_usage (guint64 *usage)
+{
+  g_autofree gchar *dir = NULL;
+  GDir *top;
+  const gchar *prefix;
+  guint64 total = 0;
+
+  g_return_val_if_fail (usage != NULL, -EINVAL);
+
+  G_LOCK (model_store_lock);
+  dir = g_strdup (g_store.dir);
+  G_UNLOCK (model_store_lock);
+
+  if (!dir)
+    return -ENOTSUP;
+
+  top = g_dir_open (dir, 0, NULL);
+  if (!top)
+    return -EIO;
+
+  /* The blobs are in the sub-directories of the hash prefix. The staged files in the top directory are not counted. */
+  while ((prefix = g_dir_read_name (top)) != NULL) {
+    g_autofree gchar *sub_path = NULL;
+    GDir *sub;
+    const gchar *name;
+
+    if (strlen (prefix) != 2U)
+      continue;
+
+    sub_path = g_build_filename (dir, prefix, NULL);
+    sub = g_dir_open (sub_path, 0, NULL);
+    if (!sub)
+      continue;
+
+    while ((name = g_dir_read_name (sub)) != NULL) {
+      g_autofree gchar *path = g_build_filename (sub_path, name, NULL);
+
+      total += _get_file_size (path);
+    }
+
+    g_dir_close (sub);
+  }
+
+  g_dir_close (top);
+
+  *usage = total;
+  return 0;
+}
+
+/**
+ * @brief Get the size of the blob on the disk, including the compressed one and the decompressed copy.
+ */
+gint
+model_store_get_blob_size (const gchar *hash, guint64 *size)
+{
+  gint ret = 0;
+
+  if (!_is_valid_hash (hash) || !size)
+    return -EINVAL;
+
+  G_LOCK (model_store_lock);
+  if (!g_store.dir) {
+    ret = -ENOTSUP;
+  } else {
+    g_autofree gchar *blob = _get_blob_path_locked (hash);
+    g_autofree gchar *compressed = _get_compressed_path_locked (hash);
+
+    *size = _get_file_size (blob) + _get_file_size (compressed);
+  }
+  G_UNLOCK (model_store_lock);
+
+  return ret;
+}
+
+/**
+ * @brief Remove the blob from the model store.
+ */
+gint
+model_store_remove (const gchar *hash)
+{
+  g_autofree gchar *blob = NULL;
+  gint ret = 0;
+
+  if (!_is_valid_hash (hash))
+    return -EINVAL;
+
+  G_LOCK (model_store_lock);
+  if (!g_store.dir) {
+    ret = -ENOTSUP;
+  } else {
+    g_autofree gchar *compressed = NULL;
+
+    blob = _get_blob_path_locked (hash);
+    compressed = g_strconcat (blob, MODEL_STORE_COMPRESSED_SUFFIX, NULL);
+
+    /* The blob may be compressed, or may have both the compressed one and the decompressed copy. */
+    if (g_unlink (blob) != 0)
+      ret = -errno;
+    if (g_unlink (compressed) == 0)
+      ret = 0;
+
+    _cache_remove_locked (hash);
+    g_hash_table_remove (g_store.pinned, hash);
+  }
+  G_UNLOCK (model_store_lock);
+
+  if (ret == 0)
+    ml_logi ("The blob '%s' is removed from the model store.", hash);
+
+  return ret;
+}
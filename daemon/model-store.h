@@ -0,0 +1,158 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    model-store.h
+ * @date    17 Oct 2026
+ * @brief   Internal header of the content-addressed model store
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The registered model files are copied into the store directory and named by the hash of the contents,
+ *    so byte-identical models registered by different applications share one blob.
+ *    The blob of the hash 'abcd...' is placed at '<store>/ab/abcd...'.
+ *    The hash is the SHA-256 of the SHA-256 digests of the 4 MiB chunks, which are computed in parallel.
+ *
+ *    The blob of the inactive model may be compressed to '<store>/ab/abcd....gz'.
+ *    It is decompressed to its original path on demand, and the decompressed copies of the inactive models
+ *    are kept up to the cache budget. The blob of the active model is pinned, it is never compressed.
+ */
+#ifndef __MODEL_STORE_H__
+#define __MODEL_STORE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Initialize the model store.
+ * @param[in] dir The directory of the model store. If it is NULL or empty, the model store is disabled.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_store_init (const gchar *dir);
+
+/**
+ * @brief Disable the model store. The stored blobs are kept.
+ */
+void model_store_fini (void);
+
+/**
+ * @brief Check whether the model store is enabled.
+ */
+gboolean model_store_is_enabled (void);
+
+/**
+ * @brief Check whether the path is in the model store. The blobs are managed by the store, not by the owner of the path.
+ */
+gboolean model_store_owns_path (const gchar *path);
+
+/**
+ * @brief Compute the hash of the file contents. It is available even if the model store is disabled.
+ * @param[in] path The path of the file.
+ * @param[out] hash The hex string of the hash. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_store_hash_file (const gchar *path, gchar **hash);
+
+/**
+ * @brief Add the file to the model store. The blob is shared if the same contents are already stored.
+ * @param[in] path The path of the model file.
+ * @param[out] blob_path The path of the blob in the model store. Call g_free() to release it.
+ * @param[out] hash The hex string of the hash. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value. -ENOENT if the file does not exist.
+ */
+gint model_store_add (const gchar *path, gchar **blob_path, gchar **hash);
+
+/**
+ * @brief Add the contents read from the file descriptor to the model store.
+ * @details The contents are copied into a temporary file in the store and hashed in the same pass,
+ *          then the file is synced and renamed to the blob. The descriptor may be a pipe or a socket.
+ * @param[in] fd The file descriptor to read the model from. It is read until the end of file, and the caller should close it.
+ * @param[out] blob_path The path of the blob in the model store. Call g_free() to release it.
+ * @param[out] hash The hex string of the hash. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value. -ENOTSUP if the model store is disabled.
+ */
+gint model_store_add_from_fd (int fd, gchar **blob_path, gchar **hash);
+
+/**
+ * @brief Reconstruct the model from the base and the delta, and add it to the model store.
+ * @details The reconstructed model is verified with the hash in the delta header before it is stored. See model-delta.h.
+ * @param[in] base_path The path of the base model file.
+ * @param[in] delta_fd The file descriptor to read the delta from. The caller should close it.
+ * @param[out] blob_path The path of the blob in the model store. Call g_free() to release it.
+ * @param[out] hash The hex string of the hash. Call g_free() to release it.
+ * @return @c 0 on success. Otherwise a negative error value. -EBADMSG if the delta is malformed or not matched with the base.
+ */
+gint model_store_add_delta (const gchar *base_path, int delta_fd, gchar **blob_path, gchar **hash);
+
+/**
+ * @brief Set the total size of the decompressed copies of the compressed blobs.
+ *        The least recently used copies over the budget are removed, except the latest one.
+ */
+void model_store_set_cache_budget (guint64 budget);
+
+/**
+ * @brief Compress the blob of the inactive model. The blob is kept as it is if it is not compressible.
+ * @param[in] hash The hash of the blob.
+ * @param[out] reclaimed The size in bytes reclaimed by the compression.
+ * @return @c 0 on success. Otherwise a negative error value. -EBUSY if the blob is pinned.
+ */
+gint model_store_compress (const gchar *hash, guint64 *reclaimed);
+
+/**
+ * @brief Request to compress the blob of the inactive model in the background. It also unpins the blob.
+ * @param[in] hash The hash of the blob.
+ */
+void model_store_compress_async (const gchar *hash);
+
+/**
+ * @brief Check whether the blobs are queued or being compressed in the background.
+ */
+gboolean model_store_is_compressing (void);
+
+/**
+ * @brief Make the blob available at its path, decompressing it if it is compressed.
+ * @param[in] hash The hash of the blob.
+ * @param[in] pin If it is TRUE, the blob is for the active model. The compressed one is removed, and the blob is never compressed until it is unpinned.
+ *                Otherwise, the decompressed copy is kept in the cache.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_store_materialize (const gchar *hash, gboolean pin);
+
+/**
+ * @brief Check whether the blob is compressed, and get the size reclaimed by the compression.
+ * @param[in] hash The hash of the blob.
+ * @param[out] reclaimed The size in bytes reclaimed by the compression. It can be NULL.
+ * @return TRUE if the blob is compressed.
+ */
+gboolean model_store_get_compressed_info (const gchar *hash, guint64 *reclaimed);
+
+/**
+ * @brief Get the total size of the blobs in the model store.
+ * @param[out] usage The size in bytes of the blobs on the disk.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_store_get_usage (guint64 *usage);
+
+/**
+ * @brief Get the size of the blob on the disk, including the compressed one and the decompressed copy.
+ * @param[in] hash The hash of the blob.
+ * @param[out] size The size in bytes. It is 0 if the blob does not exist.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_store_get_blob_size (const gchar *hash, guint64 *size);
+
+/**
+ * @brief Remove the blob from the model store.
+ * @param[in] hash The hash of the blob. The caller should check no model refers to it.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint model_store_remove (const gchar *hash);
+
+G_END_DECLS
+#endif /* __MODEL_STORE_H__ */
@@ -16,9 +16,91 @@
 #include "common.h"
 #include "modules.h"
 #include "log.h"
+#include "startup-profile.h"
 
 static GList *module_head = NULL;
 
+/**
+ * @brief The modules which are probed but not initialized yet.
+ */
+static GList *pending_head = NULL;
+static void *pending_data = NULL;
+static guint background_id = 0U;
+static GRecMutex module_lock;
+
+/**
+ * @brief Internal function to initialize the module, after its dependencies.
+ */
+static void
+_init_module (const struct module_ops *module, void *data)
+{
+  g_autofree gchar *phase = g_strdup_printf ("init:%s", module->name);
+  gint64 start;
+  guint i;
+
+  /* It does nothing for the dependencies which are already initialized. */
+  for (i = 0; module->depends && module->depends[i]; i++)
+    ensure_module (module->depends[i]);
+
+  start = g_get_monotonic_time ();
+  if (module->init)
+    module->init (data);
+  startup_profile_add (phase, start);
+}
+
+/**
+ * @brief Internal function to initialize the pending module. The caller should hold the lock.
+ */
+static void
+_init_pending_module (const struct module_ops *module)
+{
+  gint64 start = g_get_monotonic_time ();
+
+  /* Removed first, not to be initialized again by the circular dependencies. */
+  pending_head = g_list_remove (pending_head, (gconstpointer) module);
+  _init_module (module, pending_data);
+
+  if (module->init_type != MODULE_INIT_EAGER)
+    ml_logi ("[%s] initialized lazily in %" G_GINT64_FORMAT " us",
+        module->name, g_get_monotonic_time () - start);
+}
+
+/**
+ * @brief Internal function to initialize the background modules one by one in the idle time of the main loop.
+ */
+static gboolean
+_init_background_module (gpointer user_data)
+{
+  GList *elem;
+  const struct module_ops *module;
+  gboolean remaining = FALSE;
+
+  g_rec_mutex_lock (&module_lock);
+
+  for (elem = pending_head; elem != NULL; elem = elem->next) {
+    module = elem->data;
+
+    if (module->init_type == MODULE_INIT_BACKGROUND) {
+      _init_pending_module (module);
+      break;
+    }
+  }
+
+  for (elem = pending_head; elem != NULL; elem = elem->next) {
+    module = elem->data;
+
+    if (module->init_type == MODULE_INIT_BACKGROUND)
+      remaining = TRUE;
+  }
+
+  if (!remaining)
+    background_id = 0U;
+
+  g_rec_mutex_unlock (&module_lock);
+
+  return remaining ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
 /**
  * @brief Add the specific DBus interface into the Machine Learning agent daemon.
  */
@@ -35,33 +117,109 @@ void
 remove_module (const struct module_ops *module)
 {
   module_head = g_list_remove (module_head, (gconstpointer) module);
+
+  g_rec_mutex_lock (&module_lock);
+  pending_head = g_list_remove (pending_head, (gconstpointer) module);
+  g_rec_mutex_unlock (&module_lock);
+}
+
+/**
+ * @brief Initialize the lazy module if it is not initialized yet.
+ */
+void
+ensure_module (const char *name)
+{
+  GList *elem;
+  const struct module_ops *module;
+
+  g_rec_mutex_lock (&module_lock);
+
+  for (elem = pending_head; elem != NULL; elem = elem->next) {
+    module = elem->data;
+
+    if (g_strcmp0 (module->name, name) == 0) {
+      _init_pending_module (module);
+      break;
+    }
+  }
+
+  g_rec_mutex_unlock (&module_lock);
 }
 
 /**
  * @brief Initialize all added modules by calling probe and init callback functions.
+ * @details The probe callbacks are called in order, and then the eager modules are initialized in order after the modules they depend on.
+ *          The init callback of the lazy module is deferred, and the background modules are initialized after the main loop starts.
  */
 void
 init_modules (void *data)
 {
   GList *elem, *elem_n;
+  GList *eager = NULL;
   const struct module_ops *module;
+  gboolean background = FALSE;
+
+  g_rec_mutex_lock (&module_lock);
+  pending_data = data;
 
   elem = module_head;
   while (elem != NULL) {
+    g_autofree gchar *probe_phase = NULL;
+    gint64 start;
+
     module = elem->data;
     elem_n = elem->next;
 
+    probe_phase = g_strdup_printf ("probe:%s", module->name);
+    start = g_get_monotonic_time ();
     if (module->probe && module->probe (data) != 0) {
       ml_loge ("[%s] probe fail", module->name);
       module_head = g_list_remove (module_head, (gconstpointer) module);
       elem = elem_n;
       continue;
     }
+    startup_profile_add (probe_phase, start);
+
+    /* All modules are pending first, then the dependencies of the eager module are initialized before it in any order. */
+    pending_head = g_list_append (pending_head, (gpointer) module);
 
-    if (module->init)
-      module->init (data);
+    if (module->init_type == MODULE_INIT_EAGER)
+      eager = g_list_append (eager, (gpointer) module);
+    else
+      background |= (module->init_type == MODULE_INIT_BACKGROUND);
     elem = elem_n;
   }
+
+  for (elem = eager; elem != NULL; elem = elem->next) {
+    /* It may be initialized already as a dependency of the previous one. */
+    if (g_list_find (pending_head, elem->data))
+      _init_pending_module (elem->data);
+  }
+  g_list_free (eager);
+
+  if (background && background_id == 0U)
+    background_id = g_idle_add_full (G_PRIORITY_LOW, _init_background_module, NULL, NULL);
+  g_rec_mutex_unlock (&module_lock);
+}
+
+/**
+ * @brief Check any module has the running jobs by calling the busy callback functions.
+ */
+int
+busy_modules (void *data)
+{
+  GList *elem;
+  const struct module_ops *module;
+
+  for (elem = module_head; elem != NULL; elem = elem->next) {
+    module = elem->data;
+    if (module->busy && module->busy (data)) {
+      ml_logd ("[%s] busy", module->name);
+      return 1;
+    }
+  }
+
+  return 0;
 }
 
 /**
@@ -73,6 +231,19 @@ exit_modules (void *data)
   GList *elem;
   const struct module_ops *module;
 
+  g_rec_mutex_lock (&module_lock);
+
+  if (background_id > 0U) {
+    g_source_remove (background_id);
+    background_id = 0U;
+  }
+
+  g_list_free (pending_head);
+  pending_head = NULL;
+  pending_data = NULL;
+
+  g_rec_mutex_unlock (&module_lock);
+
   for (elem = module_head; elem != NULL; elem = elem->next) {
     module = elem->data;
     if (module->exit)
@@ -22,6 +22,19 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/**
+ * @brief The time to call the init callback of the module.
+ * @details The probe callback is always called at the startup, so that the DBus interface is exported immediately.
+ *          The init callback of the module is called after the modules it depends on, regardless of their init types.
+ *          The lazy module should call ensure_module() before the method call, and its exit callback is called even if it is not initialized.
+ */
+typedef enum
+{
+  MODULE_INIT_EAGER = 0,  /**< Initialize the module at the startup. */
+  MODULE_INIT_BACKGROUND, /**< Initialize the module in the idle time of the main loop, or at the first method call. */
+  MODULE_INIT_ON_DEMAND,  /**< Initialize the module at the first method call. */
+} module_init_e;
+
 /**
  * @brief Data structure contains the name and callback functions for a specific DBus interface.
  */
@@ -31,6 +44,9 @@ struct module_ops
   int (*probe) (void *data);    /**< Callback function for probing the DBus Interface */
   void (*init) (void *data);    /**< Callback function for initializing the DBus Interface */
   void (*exit) (void *data);    /**< Callback function for exiting the DBus Interface */
+  module_init_e init_type;      /**< The time to call the init callback */
+  int (*busy) (void *data);     /**< Callback function to check the DBus Interface has the running jobs, which keep the daemon alive. Optional. */
+  const char *const *depends;   /**< NULL-terminated names of the modules to be initialized before this module. Optional. */
 };
 
 /**
@@ -58,6 +74,19 @@ void init_modules (void *data);
  */
 void exit_modules (void *data);
 
+/**
+ * @brief Check any module has the running jobs by calling the busy callback functions.
+ * @param[in/out] data user data for passing the callback functions.
+ * @return Non-zero if any module is busy.
+ */
+int busy_modules (void *data);
+
+/**
+ * @brief Initialize the lazy module if it is not initialized yet.
+ * @param[in] name The name of the module.
+ */
+void ensure_module (const char *name);
+
 /**
  * @brief Add the specific DBus interface into the Machine Learning agent daemon.
  * @param[in] module DBus interface information.
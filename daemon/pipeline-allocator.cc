@@ -0,0 +1,511 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      pipeline-allocator.cc
+ * @date      17 Oct 2026
+ * @brief     Daemon-wide buffer allocator shared by launched pipelines.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This implements a GstAllocator with a global memory cap and the free lists
+ *            reused across the pipelines launched by the daemon.
+ */
+
+#include <glib.h>
+#include <gst/gst.h>
+#include <iterator>
+#include <map>
+#include <string.h>
+#include <vector>
+
+#include "log.h"
+#include "pipeline-allocator.h"
+
+/**
+ * @brief The granularity of memory chunks. Requests are rounded up to it so that the chunks of similar sizes are reused.
+ */
+#define POOL_CHUNK_ALIGN (4096U)
+
+/**
+ * @brief Memory allocated by the shared allocator.
+ */
+typedef struct {
+  GstMemory mem;
+  guint8 *data; /**< The aligned base address of the memory. */
+  gpointer chunk; /**< The chunk from the pool. NULL if it is a sub-memory. */
+  gsize chunk_size; /**< The size of the chunk. */
+} MLAgentMemory;
+
+/**
+ * @brief The shared allocator.
+ */
+typedef struct {
+  GstAllocator parent;
+} MLAgentAllocator;
+
+/**
+ * @brief The class of the shared allocator.
+ */
+typedef struct {
+  GstAllocatorClass parent_class;
+} MLAgentAllocatorClass;
+
+/**
+ * @brief The pool of memory chunks shared by all pipelines.
+ */
+typedef struct {
+  GMutex lock;
+  GstAllocator *allocator;
+  std::map<gsize, std::vector<gpointer>> free_chunks; /**< Released chunks, keyed by the chunk size. */
+  pipeline_allocator_stats_s stats;
+} pipeline_allocator_pool_s;
+
+static pipeline_allocator_pool_s g_pool;
+
+GType ml_agent_allocator_get_type (void);
+G_DEFINE_TYPE (MLAgentAllocator, ml_agent_allocator, GST_TYPE_ALLOCATOR);
+
+/**
+ * @brief Internal function to release the largest cached chunks until the new chunk fits in the limit. Call it with the pool lock.
+ */
+static void
+_pool_evict_locked (gsize chunk_size)
+{
+  while (g_pool.stats.in_use + g_pool.stats.cached + chunk_size > g_pool.stats.limit
+         && !g_pool.free_chunks.empty ()) {
+    auto last = std::prev (g_pool.free_chunks.end ());
+    std::vector<gpointer> &chunks = last->second;
+
+    g_free (chunks.back ());
+    chunks.pop_back ();
+    g_pool.stats.cached -= last->first;
+
+    if (chunks.empty ())
+      g_pool.free_chunks.erase (last);
+  }
+}
+
+/**
+ * @brief Internal function to get a chunk from the free lists or the heap.
+ * @return The chunk, or NULL if the shared memory reached the limit.
+ */
+static gpointer
+_pool_acquire (gsize chunk_size)
+{
+  gpointer chunk = NULL;
+
+  g_mutex_lock (&g_pool.lock);
+
+  auto found = g_pool.free_chunks.find (chunk_size);
+  if (found != g_pool.free_chunks.end ()) {
+    chunk = found->second.back ();
+    found->second.pop_back ();
+    if (found->second.empty ())
+      g_pool.free_chunks.erase (found);
+
+    g_pool.stats.cached -= chunk_size;
+    g_pool.stats.reused++;
+  } else {
+    _pool_evict_locked (chunk_size);
+
+    if (g_pool.stats.in_use + g_pool.stats.cached + chunk_size <= g_pool.stats.limit)
+      chunk = g_try_malloc (chunk_size);
+  }
+
+  if (chunk) {
+    g_pool.stats.in_use += chunk_size;
+    g_pool.stats.peak = MAX (g_pool.stats.peak, g_pool.stats.in_use + g_pool.stats.cached);
+  } else {
+    g_pool.stats.fallback++;
+  }
+
+  g_mutex_unlock (&g_pool.lock);
+
+  return chunk;
+}
+
+/**
+ * @brief Internal function to put the chunk back into the free lists.
+ */
+static void
+_pool_release (gpointer chunk, gsize chunk_size)
+{
+  g_mutex_lock (&g_pool.lock);
+
+  g_pool.stats.in_use -= chunk_size;
+  if (g_pool.stats.limit > 0) {
+    g_pool.free_chunks[chunk_size].push_back (chunk);
+    g_pool.stats.cached += chunk_size;
+    chunk = NULL;
+  }
+
+  g_mutex_unlock (&g_pool.lock);
+
+  /* The allocator is disabled, no need to keep it. */
+  g_free (chunk);
+}
+
+/**
+ * @brief Implementation of GstAllocator::alloc.
+ */
+static GstMemory *
+ml_agent_allocator_alloc (GstAllocator *allocator, gsize size, GstAllocationParams *params)
+{
+  MLAgentMemory *mem;
+  gsize maxsize = size + params->prefix + params->padding;
+  gsize align = params->align | gst_memory_alignment;
+  gsize chunk_size, aoffset;
+  gpointer chunk;
+  guint8 *data;
+
+  chunk_size = ((maxsize + align) + POOL_CHUNK_ALIGN - 1) & ~((gsize) POOL_CHUNK_ALIGN - 1);
+  chunk = _pool_acquire (chunk_size);
+  if (!chunk) {
+    /* The cap should not fail the pipeline, the memory over it is not shared. */
+    ml_logd ("The shared buffer memory reached the limit, allocate %" G_GSIZE_FORMAT " bytes from the system memory.", size);
+    return gst_allocator_alloc (NULL, size, params);
+  }
+
+  data = (guint8 *) chunk;
+  if ((aoffset = ((guintptr) data & align)))
+    data += (align + 1) - aoffset;
+
+  mem = g_new0 (MLAgentMemory, 1);
+  mem->data = data;
+  mem->chunk = chunk;
+  mem->chunk_size = chunk_size;
+
+  gst_memory_init (GST_MEMORY_CAST (mem), params->flags, allocator, NULL,
+      maxsize, align, params->prefix, size);
+
+  if (params->prefix && (params->flags & GST_MEMORY_FLAG_ZERO_PREFIXED))
+    memset (data, 0, params->prefix);
+
+  if (params->padding && (params->flags & GST_MEMORY_FLAG_ZERO_PADDED))
+    memset (data + params->prefix + size, 0, params->padding);
+
+  return GST_MEMORY_CAST (mem);
+}
+
+/**
+ * @brief Implementation of GstAllocator::free.
+ */
+static void
+ml_agent_allocator_free (GstAllocator *allocator, GstMemory *memory)
+{
+  MLAgentMemory *mem = (MLAgentMemory *) memory;
+
+  if (mem->chunk)
+    _pool_release (mem->chunk, mem->chunk_size);
+
+  g_free (mem);
+}
+
+/**
+ * @brief Implementation of GstMemoryMapFunction.
+ */
+static gpointer
+ml_agent_memory_map (GstMemory *memory, gsize maxsize, GstMapFlags flags)
+{
+  return ((MLAgentMemory *) memory)->data;
+}
+
+/**
+ * @brief Implementation of GstMemoryUnmapFunction.
+ */
+static void
+ml_agent_memory_unmap (GstMemory *memory)
+{
+}
+
+/**
+ * @brief Implementation of GstMemoryShareFunction.
+ */
+static GstMemory *
+ml_agent_memory_share (GstMemory *memory, gssize offset, gssize size)
+{
+  MLAgentMemory *sub;
+  GstMemory *parent;
+
+  /* Find the real parent. */
+  if ((parent = memory->parent) == NULL)
+    parent = memory;
+
+  if (size == -1)
+    size = memory->size - offset;
+
+  sub = g_new0 (MLAgentMemory, 1);
+  sub->data = ((MLAgentMemory *) memory)->data;
+
+  /* The shared memory is always read-only. */
+  gst_memory_init (GST_MEMORY_CAST (sub),
+      (GstMemoryFlags) (GST_MINI_OBJECT_FLAGS (parent) | GST_MINI_OBJECT_FLAG_LOCK_READONLY),
+      memory->allocator, parent, memory->maxsize, memory->align,
+      memory->offset + offset, size);
+
+  return GST_MEMORY_CAST (sub);
+}
+
+/**
+ * @brief Initialize the class of the shared allocator.
+ */
+static void
+ml_agent_allocator_class_init (MLAgentAllocatorClass *klass)
+{
+  GstAllocatorClass *allocator_class = GST_ALLOCATOR_CLASS (klass);
+
+  allocator_class->alloc = ml_agent_allocator_alloc;
+  allocator_class->free = ml_agent_allocator_free;
+}
+
+/**
+ * @brief Initialize the instance of the shared allocator.
+ */
+static void
+ml_agent_allocator_init (MLAgentAllocator *self)
+{
+  GstAllocator *allocator = GST_ALLOCATOR_CAST (self);
+
+  allocator->mem_type = PIPELINE_ALLOCATOR_MEM_TYPE;
+  allocator->mem_map = ml_agent_memory_map;
+  allocator->mem_unmap = ml_agent_memory_unmap;
+  allocator->mem_share = ml_agent_memory_share;
+}
+
+/**
+ * @brief Initialize the shared allocator.
+ */
+void
+pipeline_allocator_init (guint64 limit)
+{
+  GstAllocator *allocator = NULL;
+
+  if (limit > 0) {
+    allocator = GST_ALLOCATOR_CAST (g_object_new (ml_agent_allocator_get_type (), NULL));
+    gst_object_ref_sink (allocator);
+    ml_logi ("The shared buffer allocator is enabled, limit %" G_GUINT64_FORMAT " bytes.", limit);
+  }
+
+  g_mutex_lock (&g_pool.lock);
+  g_pool.stats.limit = limit;
+  std::swap (g_pool.allocator, allocator);
+  g_mutex_unlock (&g_pool.lock);
+
+  if (allocator)
+    gst_object_unref (allocator);
+}
+
+/**
+ * @brief Release the cached chunks and disable the shared allocator.
+ */
+void
+pipeline_allocator_fini (void)
+{
+  pipeline_allocator_stats_s stats;
+
+  pipeline_allocator_get_stats (&stats);
+  if (stats.limit > 0) {
+    ml_logi ("The shared buffer allocator: peak %" G_GUINT64_FORMAT " bytes, reused %" G_GUINT64_FORMAT " times, over the limit %" G_GUINT64_FORMAT " times.",
+        stats.peak, stats.reused, stats.fallback);
+  }
+
+  pipeline_allocator_init (0);
+  pipeline_allocator_trim ();
+}
+
+/**
+ * @brief Check whether the shared allocator is enabled.
+ */
+gboolean
+pipeline_allocator_is_enabled (void)
+{
+  gboolean enabled;
+
+  g_mutex_lock (&g_pool.lock);
+  enabled = (g_pool.allocator != NULL);
+  g_mutex_unlock (&g_pool.lock);
+
+  return enabled;
+}
+
+/**
+ * @brief Get the shared allocator.
+ */
+GstAllocator *
+pipeline_allocator_get (void)
+{
+  GstAllocator *allocator = NULL;
+
+  g_mutex_lock (&g_pool.lock);
+  if (g_pool.allocator)
+    allocator = GST_ALLOCATOR_CAST (gst_object_ref (g_pool.allocator));
+  g_mutex_unlock (&g_pool.lock);
+
+  return allocator;
+}
+
+/**
+ * @brief Internal function to check whether the allocator can be replaced by the shared one.
+ */
+static gboolean
+_allocator_is_replaceable (GstAllocator *allocator)
+{
+  if (!allocator)
+    return TRUE;
+
+  return (g_strcmp0 (allocator->mem_type, GST_ALLOCATOR_SYSMEM) == 0);
+}
+
+/**
+ * @brief Probe for the allocation queries. Propose the shared allocator if the downstream uses the system memory.
+ */
+static GstPadProbeReturn
+_allocation_query_probe (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+  GstQuery *query = GST_PAD_PROBE_INFO_QUERY (info);
+  GstAllocator *shared, *allocator = NULL;
+  GstAllocationParams params;
+
+  /* Handle the query after the downstream answered it. */
+  if (GST_QUERY_TYPE (query) != GST_QUERY_ALLOCATION
+      || !(GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_PULL))
+    return GST_PAD_PROBE_OK;
+
+  if (!gst_query_is_writable (query))
+    return GST_PAD_PROBE_OK;
+
+  shared = pipeline_allocator_get ();
+  if (!shared)
+    return GST_PAD_PROBE_OK;
+
+  if (gst_query_get_n_allocation_params (query) == 0) {
+    gst_allocation_params_init (&params);
+    gst_query_add_allocation_param (query, shared, &params);
+  } else {
+    gst_query_parse_nth_allocation_param (query, 0, &allocator, &params);
+
+    if (allocator != shared && _allocator_is_replaceable (allocator))
+      gst_query_set_nth_allocation_param (query, 0, shared, &params);
+
+    if (allocator)
+      gst_object_unref (allocator);
+  }
+
+  gst_object_unref (shared);
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Internal function to add the allocation query probe on the source pad.
+ */
+static void
+_attach_pad (GstPad *pad)
+{
+  if (GST_PAD_IS_SRC (pad))
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM,
+        _allocation_query_probe, NULL, NULL);
+}
+
+/**
+ * @brief Callback for the dynamically added pads.
+ */
+static void
+_pad_added_cb (GstElement *element, GstPad *pad, gpointer user_data)
+{
+  _attach_pad (pad);
+}
+
+/**
+ * @brief Internal function to iterate the source pads.
+ */
+static void
+_attach_pad_foreach (const GValue *item, gpointer user_data)
+{
+  _attach_pad (GST_PAD (g_value_get_object (item)));
+}
+
+/**
+ * @brief Internal function to add the probes to the source pads of the element.
+ */
+static void
+_attach_element (GstElement *element)
+{
+  GstIterator *it = gst_element_iterate_src_pads (element);
+
+  gst_iterator_foreach (it, _attach_pad_foreach, NULL);
+  gst_iterator_free (it);
+
+  g_signal_connect (element, "pad-added", G_CALLBACK (_pad_added_cb), NULL);
+}
+
+/**
+ * @brief Internal function to iterate the elements.
+ */
+static void
+_attach_element_foreach (const GValue *item, gpointer user_data)
+{
+  _attach_element (GST_ELEMENT (g_value_get_object (item)));
+}
+
+/**
+ * @brief Callback for the elements added into the pipeline after launched.
+ */
+static void
+_deep_element_added_cb (GstBin *bin, GstBin *sub_bin, GstElement *element, gpointer user_data)
+{
+  _attach_element (element);
+}
+
+/**
+ * @brief Propose the shared allocator in the allocation queries of the given pipeline.
+ */
+void
+pipeline_allocator_attach (GstElement *pipeline)
+{
+  GstIterator *it;
+
+  if (!GST_IS_BIN (pipeline) || !pipeline_allocator_is_enabled ())
+    return;
+
+  it = gst_bin_iterate_recurse (GST_BIN (pipeline));
+  gst_iterator_foreach (it, _attach_element_foreach, NULL);
+  gst_iterator_free (it);
+
+  g_signal_connect (pipeline, "deep-element-added", G_CALLBACK (_deep_element_added_cb), NULL);
+}
+
+/**
+ * @brief Release all cached chunks in the free lists.
+ */
+void
+pipeline_allocator_trim (void)
+{
+  std::map<gsize, std::vector<gpointer>> chunks;
+
+  g_mutex_lock (&g_pool.lock);
+  std::swap (chunks, g_pool.free_chunks);
+  g_pool.stats.cached = 0;
+  g_mutex_unlock (&g_pool.lock);
+
+  for (auto &it : chunks) {
+    for (gpointer chunk : it.second)
+      g_free (chunk);
+  }
+}
+
+/**
+ * @brief Get the statistics of the shared allocator.
+ */
+void
+pipeline_allocator_get_stats (pipeline_allocator_stats_s *stats)
+{
+  g_return_if_fail (stats != NULL);
+
+  g_mutex_lock (&g_pool.lock);
+  *stats = g_pool.stats;
+  g_mutex_unlock (&g_pool.lock);
+}
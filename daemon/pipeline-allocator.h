@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    pipeline-allocator.h
+ * @date    17 Oct 2026
+ * @brief   Internal header of the daemon-wide buffer allocator shared by launched pipelines
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The pipelines launched by the daemon get a shared GstAllocator proposed in the allocation queries.
+ *    Released memory chunks are kept in the free lists and reused by any pipeline,
+ *    and the total size of allocated and cached chunks never exceeds the global limit.
+ */
+#ifndef __PIPELINE_ALLOCATOR_H__
+#define __PIPELINE_ALLOCATOR_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The memory type of the shared allocator.
+ */
+#define PIPELINE_ALLOCATOR_MEM_TYPE "MLAgentSharedMemory"
+
+/**
+ * @brief Data structure for the statistics of the shared allocator.
+ */
+typedef struct {
+  guint64 limit;    /**< The global memory cap in bytes. */
+  guint64 in_use;   /**< The size of chunks currently used by pipelines. */
+  guint64 cached;   /**< The size of released chunks kept for the reuse. */
+  guint64 peak;     /**< The peak size of in-use and cached chunks. */
+  guint64 reused;   /**< The number of allocations served from the free lists. */
+  guint64 fallback; /**< The number of allocations over the memory cap, served by the system memory allocator. */
+} pipeline_allocator_stats_s;
+
+/**
+ * @brief Initialize the shared allocator.
+ * @param[in] limit The global memory cap in bytes. If it is 0, the shared allocator is disabled.
+ */
+void pipeline_allocator_init (guint64 limit);
+
+/**
+ * @brief Release the cached chunks and disable the shared allocator.
+ * @remarks The memory still used by the pipelines is released when the pipelines free it.
+ */
+void pipeline_allocator_fini (void);
+
+/**
+ * @brief Check whether the shared allocator is enabled.
+ */
+gboolean pipeline_allocator_is_enabled (void);
+
+/**
+ * @brief Get the shared allocator.
+ * @return The new reference of the shared allocator, or NULL if it is disabled. Call gst_object_unref() to release it.
+ */
+GstAllocator *pipeline_allocator_get (void);
+
+/**
+ * @brief Propose the shared allocator in the allocation queries of the given pipeline.
+ * @param[in] pipeline The pipeline launched by the daemon.
+ */
+void pipeline_allocator_attach (GstElement *pipeline);
+
+/**
+ * @brief Release all cached chunks in the free lists.
+ */
+void pipeline_allocator_trim (void);
+
+/**
+ * @brief Get the statistics of the shared allocator.
+ * @param[out] stats The statistics to be filled.
+ */
+void pipeline_allocator_get_stats (pipeline_allocator_stats_s *stats);
+
+G_END_DECLS
+#endif /* __PIPELINE_ALLOCATOR_H__ */
@@ -16,33 +16,78 @@
 
 #include <glib.h>
 #include <gst/gst.h>
+#include <json-glib/json-glib.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "agent-config.h"
 #include "common.h"
 #include "dbus-interface.h"
 #include "gdbus-util.h"
 #include "log.h"
+#include "model-artifact.h"
+#include "model-integrity.h"
 #include "modules.h"
+#include "pipeline-allocator.h"
 #include "pipeline-dbus.h"
+#include "pipeline-fusion.h"
 #include "service-db-util.h"
 
 static MachinelearningServicePipeline *g_gdbus_instance = NULL;
 static GHashTable *pipeline_table = NULL;
 G_LOCK_DEFINE_STATIC (pipeline_table_lock);
 
+/**
+ * @brief The prefix of the placeholder replaced with the artifact directory, "@artifact_cache:MODEL:BACKEND[:OPTIONS]@".
+ */
+#define ARTIFACT_CACHE_PLACEHOLDER "@artifact_cache:"
+
+/**
+ * @brief The name of this module.
+ */
+#define PIPELINE_MODULE_NAME "pipeline"
+
+/**
+ * @brief The methods on the pipeline descriptions in the database, which do not require GStreamer.
+ */
+static const gchar *pipeline_db_methods[] = {
+  "set_pipeline", "get_pipeline", "delete_pipeline", "list_pipeline", NULL
+};
+
+/**
+ * @brief The modules to be initialized before this module. The launched pipelines use the model artifacts.
+ */
+static const char *const pipeline_depends[] = { "model-interface", NULL };
+
 /**
  * @brief Structure for pipeline.
  */
 typedef struct _pipeline {
-  GstElement *element;
+  GstElement *element; /**< NULL if the pipeline is fused with other pipelines. */
+  pipeline_fusion_branch_s *branch;
   gint64 id;
   GMutex lock;
   gchar *service_name;
   gchar *description;
+  GPtrArray *artifacts; /**< The artifact directories used by the pipeline. */
 } pipeline_s;
 
+/**
+ * @brief Internal function to release the artifact directories used by the pipeline.
+ */
+static void
+_release_artifacts (GPtrArray *artifacts)
+{
+  guint i;
+
+  for (i = 0; i < artifacts->len; i++)
+    model_artifact_release ((const gchar *) g_ptr_array_index (artifacts, i));
+
+  g_ptr_array_free (artifacts, TRUE);
+}
+
 /**
  * @brief Internal function to destroy pipeline instances.
  */
@@ -61,6 +106,12 @@ _pipeline_free (gpointer data)
   if (p->element)
     gst_object_unref (p->element);
 
+  if (p->branch)
+    pipeline_fusion_destroy (p->branch);
+
+  if (p->artifacts)
+    _release_artifacts (p->artifacts);
+
   g_free (p->service_name);
   g_free (p->description);
   g_mutex_clear (&p->lock);
@@ -86,6 +137,19 @@ gdbus_put_pipeline_instance (MachinelearningServicePipeline **instance)
   g_clear_object (instance);
 }
 
+/**
+ * @brief Initialize this module before the method call. GStreamer is initialized when a pipeline is launched or controlled first.
+ */
+static gboolean
+dbus_cb_core_authorize_method (MachinelearningServicePipeline *obj,
+    GDBusMethodInvocation *invoc, gpointer user_data)
+{
+  if (!g_strv_contains (pipeline_db_methods, g_dbus_method_invocation_get_method_name (invoc)))
+    ensure_module (PIPELINE_MODULE_NAME);
+
+  return TRUE;
+}
+
 /**
  * @brief Set the service with given description. Return the call result.
  */
@@ -117,6 +181,22 @@ dbus_cb_core_get_pipeline (MachinelearningServicePipeline *obj,
   return TRUE;
 }
 
+/**
+ * @brief List the names of the services matching the pattern. Return the call result and the page of the names.
+ */
+static gboolean
+dbus_cb_core_list_pipeline (MachinelearningServicePipeline *obj, GDBusMethodInvocation *invoc,
+    const gchar *pattern, const gchar *cursor, guint limit, gpointer user_data)
+{
+  gint result = 0;
+  g_autofree gchar *list = NULL;
+
+  result = svcdb_list_names ("pipeline", pattern, cursor, limit, &list);
+  machinelearning_service_pipeline_complete_list_pipeline (obj, invoc, result, list ? list : "");
+
+  return TRUE;
+}
+
 /**
  * @brief Delete the pipeline description of the given service. Return the call result.
  */
@@ -132,6 +212,106 @@ dbus_cb_core_delete_pipeline (MachinelearningServicePipeline *obj,
   return TRUE;
 }
 
+/**
+ * @brief Internal function to get the artifact directory of the activated model for the backend.
+ * @return @c 0 on success. The directory is NULL if the artifacts cannot be cached.
+ */
+static gint
+_get_artifact_dir (const gchar *name, const gchar *backend, const gchar *options, gchar **dir)
+{
+  g_autofree gchar *model_info = NULL;
+  g_autoptr (JsonParser) parser = NULL;
+  JsonObject *model;
+  const gchar *hash = NULL, *path = NULL, *fingerprint = NULL;
+  gint ret;
+
+  *dir = NULL;
+
+  ret = svcdb_model_get_activated (name, &model_info);
+  if (ret != 0) {
+    ml_loge ("Failed to get the activated model '%s' for the artifact cache.", name);
+    return ret;
+  }
+
+  parser = json_parser_new ();
+  if (json_parser_load_from_data (parser, model_info, -1, NULL)
+      && JSON_NODE_HOLDS_OBJECT (json_parser_get_root (parser))) {
+    model = json_node_get_object (json_parser_get_root (parser));
+
+    if (json_object_has_member (model, "hash"))
+      hash = json_object_get_string_member (model, "hash");
+    if (json_object_has_member (model, "path"))
+      path = json_object_get_string_member (model, "path");
+    if (json_object_has_member (model, "fingerprint"))
+      fingerprint = json_object_get_string_member (model, "fingerprint");
+  }
+
+  /* The backend compiles the model as before, if the artifacts cannot be cached. */
+  if (!model_artifact_is_enabled () || !hash || hash[0] == '\0') {
+    ml_logw ("The artifacts of the model '%s' are not cached.", name);
+  } else if (model_integrity_verify (path, hash, fingerprint) == MODEL_INTEGRITY_MISMATCH) {
+    ml_logw ("The model file '%s' is modified since the registration, the artifacts are not cached.", path);
+  } else if (model_artifact_acquire (hash, backend, options, dir) != 0) {
+    ml_logw ("Failed to get the artifact directory of the model '%s'.", name);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to replace the artifact cache placeholders in the description.
+ * @param[in] desc The pipeline description.
+ * @param[out] expanded The description with the artifact directories.
+ * @param[out] artifacts The acquired artifact directories, to be released with the pipeline.
+ */
+static gint
+_expand_artifact_cache (const gchar *desc, gchar **expanded, GPtrArray *artifacts)
+{
+  GString *str = g_string_new (NULL);
+  const gchar *pos = desc, *start, *end;
+  const gsize prefix_len = strlen (ARTIFACT_CACHE_PLACEHOLDER);
+  gint ret = 0;
+
+  while ((start = strstr (pos, ARTIFACT_CACHE_PLACEHOLDER)) != NULL) {
+    g_autofree gchar *token = NULL;
+    g_autofree gchar *dir = NULL;
+    g_auto (GStrv) fields = NULL;
+
+    end = strchr (start + prefix_len, '@');
+    if (!end) {
+      ml_loge ("The artifact cache placeholder is not closed in the pipeline description.");
+      ret = -EINVAL;
+      break;
+    }
+
+    /* The options may have the colons, e.g., "Delegate:GPU". */
+    token = g_strndup (start + prefix_len, end - start - prefix_len);
+    fields = g_strsplit (token, ":", 3);
+    if (g_strv_length (fields) < 2U || fields[0][0] == '\0' || fields[1][0] == '\0') {
+      ml_loge ("Invalid artifact cache placeholder '%s', it should be @artifact_cache:MODEL:BACKEND[:OPTIONS]@.", token);
+      ret = -EINVAL;
+      break;
+    }
+
+    ret = _get_artifact_dir (fields[0], fields[1], fields[2], &dir);
+    if (ret != 0)
+      break;
+
+    g_string_append_len (str, pos, start - pos);
+    if (dir) {
+      g_string_append (str, dir);
+      g_ptr_array_add (artifacts, g_steal_pointer (&dir));
+    }
+
+    pos = end + 1;
+  }
+
+  g_string_append (str, pos);
+  *expanded = g_string_free (str, FALSE);
+
+  return ret;
+}
+
 /**
  * @brief Launch the pipeline with given description. Return the call result and its id.
  */
@@ -141,11 +321,12 @@ dbus_cb_core_launch_pipeline (MachinelearningServicePipeline *obj,
 {
   gint result = 0;
   gint64 id = -1;
-  GError *err = NULL;
-  GstStateChangeReturn sc_ret;
   GstElement *pipeline = NULL;
+  pipeline_fusion_branch_s *branch = NULL;
   pipeline_s *p;
   g_autofree gchar *desc = NULL;
+  g_autofree gchar *expanded = NULL;
+  GPtrArray *artifacts = g_ptr_array_new_with_free_func (g_free);
 
   result = svcdb_pipeline_get (service_name, &desc);
   if (result != 0) {
@@ -153,35 +334,37 @@ dbus_cb_core_launch_pipeline (MachinelearningServicePipeline *obj,
     goto error;
   }
 
-  pipeline = gst_parse_launch (desc, &err);
-  if (!pipeline || err) {
-    ml_loge ("Failed to launch pipeline '%s' (error msg: %s).",
-        desc, (err) ? err->message : "unknown reason");
-    g_clear_error (&err);
-
-    if (pipeline)
-      gst_object_unref (pipeline);
-
-    result = -ESTRPIPE;
+  /** give the backends the directories to keep the compiled artifacts */
+  result = _expand_artifact_cache (desc, &expanded, artifacts);
+  if (result != 0) {
+    ml_loge ("Failed to get the artifact cache of the pipeline '%s'.", service_name);
     goto error;
   }
 
-  /** now set pipeline as paused state */
-  sc_ret = gst_element_set_state (pipeline, GST_STATE_PAUSED);
-  if (sc_ret == GST_STATE_CHANGE_FAILURE) {
-    ml_loge ("Failed to set the state of the pipeline to PAUSED. For the detail, please check the GStreamer log message. The input pipeline was '%s'.",
-        desc);
+  /** share the source with the running pipelines if possible */
+  if (agent_config_get ()->pipeline_fusion) {
+    result = pipeline_fusion_launch (expanded, &branch);
+    if (result != 0) {
+      ml_loge ("Failed to launch the fused pipeline of '%s'.", service_name);
+      goto error;
+    }
+  }
 
-    gst_object_unref (pipeline);
-    result = -ESTRPIPE;
-    goto error;
+  if (!branch) {
+    pipeline = pipeline_fusion_launch_plain (expanded, NULL);
+    if (!pipeline) {
+      result = -ESTRPIPE;
+      goto error;
+    }
   }
 
   /** now fill the struct and store into hash table */
   p = g_new0 (pipeline_s, 1);
   p->element = pipeline;
+  p->branch = branch;
   p->description = g_strdup (desc);
   p->service_name = g_strdup (service_name);
+  p->artifacts = g_steal_pointer (&artifacts);
   g_mutex_init (&p->lock);
 
   G_LOCK (pipeline_table_lock);
@@ -190,6 +373,9 @@ dbus_cb_core_launch_pipeline (MachinelearningServicePipeline *obj,
   G_UNLOCK (pipeline_table_lock);
 
 error:
+  if (artifacts)
+    _release_artifacts (artifacts);
+
   machinelearning_service_pipeline_complete_launch_pipeline (obj, invoc, result, id);
 
   return TRUE;
@@ -216,7 +402,10 @@ dbus_cb_core_start_pipeline (MachinelearningServicePipeline *obj,
   } else {
     g_mutex_lock (&p->lock);
     G_UNLOCK (pipeline_table_lock);
-    sc_ret = gst_element_set_state (p->element, GST_STATE_PLAYING);
+    if (p->branch)
+      sc_ret = pipeline_fusion_set_state (p->branch, GST_STATE_PLAYING);
+    else
+      sc_ret = gst_element_set_state (p->element, GST_STATE_PLAYING);
     g_mutex_unlock (&p->lock);
 
     if (sc_ret == GST_STATE_CHANGE_FAILURE) {
@@ -252,7 +441,10 @@ dbus_cb_core_stop_pipeline (MachinelearningServicePipeline *obj,
   } else {
     g_mutex_lock (&p->lock);
     G_UNLOCK (pipeline_table_lock);
-    sc_ret = gst_element_set_state (p->element, GST_STATE_PAUSED);
+    if (p->branch)
+      sc_ret = pipeline_fusion_set_state (p->branch, GST_STATE_PAUSED);
+    else
+      sc_ret = gst_element_set_state (p->element, GST_STATE_PAUSED);
     g_mutex_unlock (&p->lock);
 
     if (sc_ret == GST_STATE_CHANGE_FAILURE) {
@@ -300,6 +492,10 @@ dbus_cb_core_destroy_pipeline (MachinelearningServicePipeline *obj,
      *   }
      */
     g_hash_table_remove (pipeline_table, GINT_TO_POINTER (id));
+
+    /** no pipeline uses the cached buffer memory anymore */
+    if (g_hash_table_size (pipeline_table) == 0U)
+      pipeline_allocator_trim ();
   }
 
   G_UNLOCK (pipeline_table_lock);
@@ -333,7 +529,10 @@ dbus_cb_core_get_state (MachinelearningServicePipeline *obj,
 
   g_mutex_lock (&p->lock);
   G_UNLOCK (pipeline_table_lock);
-  sc_ret = gst_element_get_state (p->element, &state, NULL, GST_MSECOND);
+  if (p->branch)
+    sc_ret = pipeline_fusion_get_state (p->branch, &state);
+  else
+    sc_ret = gst_element_get_state (p->element, &state, NULL, GST_MSECOND);
   g_mutex_unlock (&p->lock);
 
   if (sc_ret == GST_STATE_CHANGE_FAILURE) {
@@ -348,6 +547,12 @@ dbus_cb_core_get_state (MachinelearningServicePipeline *obj,
 }
 
 static struct gdbus_signal_info handler_infos[] = {
+  {
+      .signal_name = DBUS_ML_I_AUTHORIZE_METHOD_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_authorize_method),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
   {
       .signal_name = DBUS_PIPELINE_I_SET_HANDLER,
       .cb = G_CALLBACK (dbus_cb_core_set_pipeline),
@@ -396,6 +601,12 @@ static struct gdbus_signal_info handler_infos[] = {
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_PIPELINE_I_LIST_HANDLER,
+      .cb = G_CALLBACK (dbus_cb_core_list_pipeline),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
 };
 
 /**
@@ -438,7 +649,7 @@ out:
 }
 
 /**
- * @brief Initialize this module.
+ * @brief Initialize this module. It is called at the first method call which requires GStreamer.
  */
 static void
 init_pipeline_module (void *data)
@@ -449,6 +660,23 @@ init_pipeline_module (void *data)
   g_assert (NULL == pipeline_table); /** Internal error */
   pipeline_table = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, _pipeline_free);
   G_UNLOCK (pipeline_table_lock);
+
+  pipeline_allocator_init ((guint64) MAX (agent_config_get ()->buffer_pool_limit, 0));
+}
+
+/**
+ * @brief Check this module has the launched pipelines.
+ */
+static int
+busy_pipeline_module (void *data)
+{
+  int busy;
+
+  G_LOCK (pipeline_table_lock);
+  busy = (pipeline_table && g_hash_table_size (pipeline_table) > 0U);
+  G_UNLOCK (pipeline_table_lock);
+
+  return busy;
 }
 
 /**
@@ -457,21 +685,29 @@ init_pipeline_module (void *data)
 static void
 exit_pipeline_module (void *data)
 {
+  gboolean initialized;
+
   G_LOCK (pipeline_table_lock);
-  g_assert (pipeline_table); /** Internal error */
-  g_hash_table_destroy (pipeline_table);
-  pipeline_table = NULL;
+  initialized = (pipeline_table != NULL);
+  g_clear_pointer (&pipeline_table, g_hash_table_destroy);
   G_UNLOCK (pipeline_table_lock);
 
+  /* The module is not initialized if no pipeline is launched. */
+  if (initialized)
+    pipeline_allocator_fini ();
+
   gdbus_disconnect_signal (g_gdbus_instance, ARRAY_SIZE (handler_infos), handler_infos);
   gdbus_put_pipeline_instance (&g_gdbus_instance);
 }
 
 static const struct module_ops pipeline_ops = {
-  .name = "pipeline",
+  .name = PIPELINE_MODULE_NAME,
   .probe = probe_pipeline_module,
   .init = init_pipeline_module,
   .exit = exit_pipeline_module,
+  .init_type = MODULE_INIT_ON_DEMAND,
+  .busy = busy_pipeline_module,
+  .depends = pipeline_depends,
 };
 
 MODULE_OPS_REGISTER (&pipeline_ops)
@@ -0,0 +1,762 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      pipeline-fusion.cc
+ * @date      17 Oct 2026
+ * @brief     Optimizer fusing the pipelines sharing a common source prefix.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This merges the linear pipelines with the same source and pre-processing chain
+ *            into one pipeline with a tee at the divergence point.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "log.h"
+#include "pipeline-allocator.h"
+#include "pipeline-fusion.h"
+
+/**
+ * @brief The name of the tee at the divergence point.
+ */
+#define FUSION_TEE_NAME "mlagent_fusion_tee"
+
+/**
+ * @brief Time to wait for the tee to be idle before flushing the branch, in milliseconds.
+ */
+#define FUSION_UNLINK_TIMEOUT (1000U)
+
+struct _pipeline_fusion_group;
+
+/**
+ * @brief Structure for the branch of the fused pipeline. Each launched pipeline has one.
+ */
+struct _pipeline_fusion_branch {
+  struct _pipeline_fusion_group *group;
+  std::vector<std::string> tokens; /**< The elements of the pipeline description. */
+  GstElement *bin; /**< The elements after the trunk. NULL until the pipeline is split, or while it is unlinked. */
+  GstPad *tee_pad; /**< The request pad of the tee, linked while the branch is started. */
+  gboolean started;
+};
+
+/**
+ * @brief Structure for the branch being unlinked from the tee.
+ * @details The idle probe releases the tee pad, then the elements are removed from the pipeline in the main context.
+ *          The branch gives its elements to this, and creates new ones if it is started again.
+ */
+typedef struct {
+  gint ref_count;
+  GMutex lock;
+  GstElement *pipeline;
+  GstElement *tee;
+  GstElement *bin;
+  GstPad *tee_pad;
+  gulong probe_id;
+  guint timeout_id; /**< The source to flush the branch, or to unlink it forcibly if the tee is not idle. */
+  gboolean flushed;
+  gboolean unlinking; /**< The idle probe started to unlink the branch. */
+  gboolean forced; /**< The branch is unlinked without the idle probe, which should do nothing. */
+} pipeline_fusion_unlink_s;
+
+/**
+ * @brief Structure for the pipeline shared by the branches.
+ */
+typedef struct _pipeline_fusion_group {
+  GstElement *pipeline;
+  GstElement *tee; /**< The tee at the end of the trunk. NULL if the pipeline is not split yet. */
+  gsize trunk_len; /**< The number of elements in the trunk. */
+  gboolean live; /**< The pipeline has a live source. */
+  guint started; /**< The number of started branches. */
+  std::vector<pipeline_fusion_branch_s *> branches;
+} pipeline_fusion_group_s;
+
+static std::list<pipeline_fusion_group_s *> g_fusion_groups;
+static GMutex g_fusion_lock;
+
+/**
+ * @brief Internal function to split the pipeline description into the elements.
+ * @return @c true if the description is a single chain of elements.
+ */
+static bool
+_split_description (const gchar *description, std::vector<std::string> &tokens)
+{
+  std::string token;
+  gchar quote = '\0';
+  bool space = false;
+  const gchar *c;
+
+  for (c = description; *c != '\0'; c++) {
+    if (quote) {
+      if (*c == '\\' && c[1] != '\0') {
+        token += *c++;
+      } else if (*c == quote) {
+        quote = '\0';
+      }
+
+      token += *c;
+      continue;
+    }
+
+    if (*c == '!') {
+      if (token.empty ())
+        return false;
+
+      tokens.push_back (token);
+      token.clear ();
+      space = false;
+    } else if (g_ascii_isspace (*c)) {
+      space = !token.empty ();
+    } else {
+      if (space)
+        token += ' ';
+      space = false;
+
+      if (*c == '"' || *c == '\'')
+        quote = *c;
+      token += *c;
+    }
+  }
+
+  if (quote || token.empty ())
+    return false;
+
+  tokens.push_back (token);
+  return true;
+}
+
+/**
+ * @brief Internal function to check the token is an element (or caps) with its properties.
+ * Pad references, bins and branches make the pipeline non-linear.
+ */
+static bool
+_is_single_element (const std::string &token)
+{
+  std::vector<std::string> words;
+  std::string word;
+  gchar quote = '\0';
+
+  for (gchar c : token) {
+    if (!quote && c == ' ') {
+      words.push_back (word);
+      word.clear ();
+      continue;
+    }
+
+    if (quote && c == quote)
+      quote = '\0';
+    else if (!quote && (c == '"' || c == '\''))
+      quote = c;
+
+    word += c;
+  }
+  words.push_back (word);
+
+  std::string name = words[0].substr (0, words[0].find (','));
+  if (!g_ascii_isalpha (name[0]) || name.find ('.') != std::string::npos
+      || name.find ('=') != std::string::npos)
+    return false;
+
+  for (size_t i = 1; i < words.size (); i++) {
+    if (words[i].empty () || words[i][0] == '=' || words[i].find ('=') == std::string::npos)
+      return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Internal function to join the elements into the pipeline description.
+ */
+static std::string
+_join_tokens (const std::vector<std::string> &tokens, size_t begin, size_t end)
+{
+  std::string desc;
+
+  for (size_t i = begin; i < end; i++) {
+    if (i > begin)
+      desc += " ! ";
+    desc += tokens[i];
+  }
+
+  return desc;
+}
+
+/**
+ * @brief Internal function to get the number of elements in the common prefix.
+ */
+static size_t
+_common_prefix (const std::vector<std::string> &a, const std::vector<std::string> &b)
+{
+  size_t n = 0;
+
+  while (n < a.size () && n < b.size () && a[n] == b[n])
+    n++;
+
+  return n;
+}
+
+/**
+ * @brief Launch the pipeline description without fusing it, and set it as paused state.
+ */
+GstElement *
+pipeline_fusion_launch_plain (const gchar *description, GstStateChangeReturn *sc_ret)
+{
+  GError *err = NULL;
+  GstElement *pipeline;
+  GstStateChangeReturn ret;
+
+  pipeline = gst_parse_launch (description, &err);
+  if (!pipeline || err) {
+    ml_loge ("Failed to launch pipeline '%s' (error msg: %s).", description,
+        (err) ? err->message : "unknown reason");
+    g_clear_error (&err);
+
+    if (pipeline)
+      gst_object_unref (pipeline);
+    return NULL;
+  }
+
+  /* Propose the shared allocator before the buffer pools are negotiated. */
+  pipeline_allocator_attach (pipeline);
+
+  ret = gst_element_set_state (pipeline, GST_STATE_PAUSED);
+  if (sc_ret)
+    *sc_ret = ret;
+
+  if (ret == GST_STATE_CHANGE_FAILURE) {
+    ml_loge ("Failed to set the state of the pipeline to PAUSED. For the detail, please check the GStreamer log message. The input pipeline was '%s'.",
+        description);
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+    return NULL;
+  }
+
+  return pipeline;
+}
+
+/**
+ * @brief Internal function to create the bin of the elements after the trunk.
+ */
+static GstElement *
+_create_branch_bin (const std::vector<std::string> &tokens, size_t trunk_len)
+{
+  GError *err = NULL;
+  GstElement *bin;
+  std::string desc = "queue ! " + _join_tokens (tokens, trunk_len, tokens.size ());
+
+  bin = gst_parse_bin_from_description (desc.c_str (), TRUE, &err);
+  if (!bin || err) {
+    ml_loge ("Failed to create the branch '%s' (error msg: %s).", desc.c_str (),
+        (err) ? err->message : "unknown reason");
+    g_clear_error (&err);
+
+    if (bin)
+      gst_object_unref (bin);
+    return NULL;
+  }
+
+  /* Keep the bin while it is removed from the pipeline. */
+  return GST_ELEMENT (gst_object_ref_sink (bin));
+}
+
+/**
+ * @brief Internal function to release the branch.
+ */
+static void
+_branch_free (pipeline_fusion_branch_s *branch)
+{
+  if (branch->bin) {
+    gst_element_set_state (branch->bin, GST_STATE_NULL);
+    gst_object_unref (branch->bin);
+  }
+
+  delete branch;
+}
+
+/**
+ * @brief Internal function to split the plain pipeline at the divergence point.
+ */
+static gboolean
+_split_group (pipeline_fusion_group_s *group, size_t trunk_len, pipeline_fusion_branch_s *branch)
+{
+  pipeline_fusion_branch_s *plain = group->branches.front ();
+  GstStateChangeReturn sc_ret = GST_STATE_CHANGE_FAILURE;
+  GstElement *trunk, *plain_bin, *new_bin;
+  std::string desc = _join_tokens (plain->tokens, 0, trunk_len)
+                     + " ! tee name=" FUSION_TEE_NAME " allow-not-linked=true";
+
+  plain_bin = _create_branch_bin (plain->tokens, trunk_len);
+  new_bin = _create_branch_bin (branch->tokens, trunk_len);
+  if (!plain_bin || !new_bin)
+    goto error;
+
+  /* Release the source of the plain pipeline before the trunk opens it. */
+  gst_element_set_state (group->pipeline, GST_STATE_NULL);
+
+  trunk = pipeline_fusion_launch_plain (desc.c_str (), &sc_ret);
+  if (!trunk || sc_ret != GST_STATE_CHANGE_NO_PREROLL) {
+    ml_logw ("Failed to fuse the pipeline, the trunk '%s' is not available.", desc.c_str ());
+
+    if (trunk) {
+      gst_element_set_state (trunk, GST_STATE_NULL);
+      gst_object_unref (trunk);
+    }
+
+    gst_element_set_state (group->pipeline, GST_STATE_PAUSED);
+    goto error;
+  }
+
+  gst_object_unref (group->pipeline);
+  group->pipeline = trunk;
+  group->tee = gst_bin_get_by_name (GST_BIN (trunk), FUSION_TEE_NAME);
+  group->trunk_len = trunk_len;
+  plain->bin = plain_bin;
+  branch->bin = new_bin;
+
+  ml_logi ("Fused the pipelines at the divergence point, trunk: '%s'.", desc.c_str ());
+  return TRUE;
+
+error:
+  if (plain_bin)
+    gst_object_unref (plain_bin);
+  if (new_bin)
+    gst_object_unref (new_bin);
+  return FALSE;
+}
+
+/**
+ * @brief Internal function to get the request pad of the tee.
+ */
+static GstPad *
+_request_tee_pad (GstElement *tee)
+{
+#if GST_CHECK_VERSION(1, 20, 0)
+  return gst_element_request_pad_simple (tee, "src_%u");
+#else
+  return gst_element_get_request_pad (tee, "src_%u");
+#endif
+}
+
+/**
+ * @brief Internal function to unlink the branch from the tee and release the request pad.
+ */
+static void
+_release_tee_pad (pipeline_fusion_unlink_s *job)
+{
+  GstPad *sinkpad = gst_element_get_static_pad (job->bin, "sink");
+
+  if (sinkpad) {
+    gst_pad_unlink (job->tee_pad, sinkpad);
+    gst_object_unref (sinkpad);
+  }
+
+  gst_element_release_request_pad (job->tee, job->tee_pad);
+}
+
+/**
+ * @brief Internal function to increase the reference count of the branch being unlinked.
+ */
+static pipeline_fusion_unlink_s *
+_unlink_ref (pipeline_fusion_unlink_s *job)
+{
+  g_atomic_int_inc (&job->ref_count);
+  return job;
+}
+
+/**
+ * @brief Internal function to decrease the reference count of the branch being unlinked, and release it.
+ */
+static void
+_unlink_unref (gpointer data)
+{
+  pipeline_fusion_unlink_s *job = (pipeline_fusion_unlink_s *) data;
+
+  if (!g_atomic_int_dec_and_test (&job->ref_count))
+    return;
+
+  gst_object_unref (job->tee_pad);
+  gst_object_unref (job->bin);
+  gst_object_unref (job->tee);
+  gst_object_unref (job->pipeline);
+  g_mutex_clear (&job->lock);
+  g_free (job);
+}
+
+/**
+ * @brief Internal function to remove the unlinked branch from the pipeline. Call it in the main context.
+ */
+static void
+_unlink_finish (pipeline_fusion_unlink_s *job)
+{
+  if (job->timeout_id > 0U) {
+    g_source_remove (job->timeout_id);
+    job->timeout_id = 0;
+  }
+
+  gst_element_set_state (job->bin, GST_STATE_NULL);
+  gst_bin_remove (GST_BIN (job->pipeline), job->bin);
+}
+
+/**
+ * @brief Idle callback to remove the branch unlinked by the probe. The elements cannot change the state in the streaming thread.
+ */
+static gboolean
+_unlink_finish_cb (gpointer user_data)
+{
+  _unlink_finish ((pipeline_fusion_unlink_s *) user_data);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Probe to unlink the branch when the tee pad is idle.
+ */
+static GstPadProbeReturn
+_unlink_probe (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+  pipeline_fusion_unlink_s *job = (pipeline_fusion_unlink_s *) user_data;
+  gboolean forced;
+
+  g_mutex_lock (&job->lock);
+  forced = job->forced;
+  job->unlinking = !forced;
+  g_mutex_unlock (&job->lock);
+
+  if (!forced) {
+    _release_tee_pad (job);
+    g_idle_add_full (G_PRIORITY_DEFAULT, _unlink_finish_cb, _unlink_ref (job), _unlink_unref);
+  }
+
+  return GST_PAD_PROBE_REMOVE;
+}
+
+/**
+ * @brief Timeout callback to flush the branch blocking the tee, and to unlink it forcibly if the tee is still busy.
+ */
+static gboolean
+_unlink_timeout_cb (gpointer user_data)
+{
+  pipeline_fusion_unlink_s *job = (pipeline_fusion_unlink_s *) user_data;
+  gboolean unlinking;
+
+  g_mutex_lock (&job->lock);
+  unlinking = job->unlinking;
+  if (!unlinking && job->flushed)
+    job->forced = TRUE;
+  g_mutex_unlock (&job->lock);
+
+  /* The probe released the pad, the idle callback removes the branch. */
+  if (unlinking) {
+    job->timeout_id = 0;
+    return G_SOURCE_REMOVE;
+  }
+
+  if (!job->flushed) {
+    /* The tee is blocked by this branch. Flushing the branch makes the tee idle. */
+    ml_logw ("The branch is busy, flush it to unlink from the fused pipeline.");
+    job->flushed = TRUE;
+    gst_element_set_state (job->bin, GST_STATE_NULL);
+    return G_SOURCE_CONTINUE;
+  }
+
+  /* Do not keep the branch with the stuck streaming thread. */
+  ml_loge ("The tee is still busy, unlink the branch from the fused pipeline forcibly.");
+  gst_pad_remove_probe (job->tee_pad, job->probe_id);
+  _release_tee_pad (job);
+
+  job->timeout_id = 0;
+  _unlink_finish (job);
+  return G_SOURCE_REMOVE;
+}
+
+/**
+ * @brief Internal function to unlink the branch from the trunk and remove it from the pipeline.
+ * @details This does not wait for the tee. The branch is removed in the main context after the tee pad is idle.
+ */
+static void
+_unlink_branch (pipeline_fusion_branch_s *branch)
+{
+  pipeline_fusion_unlink_s *job = g_new0 (pipeline_fusion_unlink_s, 1);
+
+  job->ref_count = 1;
+  g_mutex_init (&job->lock);
+  job->pipeline = GST_ELEMENT (gst_object_ref (branch->group->pipeline));
+  job->tee = GST_ELEMENT (gst_object_ref (branch->group->tee));
+  job->bin = branch->bin;
+  job->tee_pad = branch->tee_pad;
+  branch->bin = NULL;
+  branch->tee_pad = NULL;
+
+  /* Add the timeout first, the probe may be called in this thread if the tee pad is idle. */
+  job->timeout_id = g_timeout_add_full (G_PRIORITY_DEFAULT, FUSION_UNLINK_TIMEOUT,
+      _unlink_timeout_cb, job, _unlink_unref);
+  job->probe_id = gst_pad_add_probe (job->tee_pad, GST_PAD_PROBE_TYPE_IDLE, _unlink_probe,
+      _unlink_ref (job), _unlink_unref);
+}
+
+/**
+ * @brief Internal function to link the branch to the trunk and start it.
+ */
+static GstStateChangeReturn
+_start_branch (pipeline_fusion_branch_s *branch)
+{
+  pipeline_fusion_group_s *group = branch->group;
+  GstStateChangeReturn sc_ret = GST_STATE_CHANGE_SUCCESS;
+  GstPad *sinkpad;
+
+  /* The elements given to the previous unlink may still be in the pipeline. */
+  if (!branch->bin) {
+    branch->bin = _create_branch_bin (branch->tokens, group->trunk_len);
+    if (!branch->bin)
+      return GST_STATE_CHANGE_FAILURE;
+  }
+
+  sinkpad = gst_element_get_static_pad (branch->bin, "sink");
+  if (!sinkpad)
+    return GST_STATE_CHANGE_FAILURE;
+
+  gst_bin_add (GST_BIN (group->pipeline), branch->bin);
+  branch->tee_pad = _request_tee_pad (group->tee);
+
+  if (!branch->tee_pad || gst_pad_link (branch->tee_pad, sinkpad) != GST_PAD_LINK_OK) {
+    ml_loge ("Failed to link the branch to the fused pipeline.");
+    gst_object_unref (sinkpad);
+
+    if (branch->tee_pad) {
+      gst_element_release_request_pad (group->tee, branch->tee_pad);
+      gst_object_unref (branch->tee_pad);
+      branch->tee_pad = NULL;
+    }
+
+    gst_bin_remove (GST_BIN (group->pipeline), branch->bin);
+    return GST_STATE_CHANGE_FAILURE;
+  }
+
+  gst_object_unref (sinkpad);
+  gst_element_sync_state_with_parent (branch->bin);
+
+  if (group->started == 0)
+    sc_ret = gst_element_set_state (group->pipeline, GST_STATE_PLAYING);
+
+  if (sc_ret == GST_STATE_CHANGE_FAILURE)
+    _unlink_branch (branch);
+
+  return sc_ret;
+}
+
+/**
+ * @brief Launch the pipeline description as a branch of the fused pipeline.
+ */
+gint
+pipeline_fusion_launch (const gchar *description, pipeline_fusion_branch_s **branch)
+{
+  std::vector<std::string> tokens;
+  pipeline_fusion_group_s *group = NULL, *candidate = NULL;
+  pipeline_fusion_branch_s *b;
+  GstStateChangeReturn sc_ret = GST_STATE_CHANGE_FAILURE;
+  GstElement *pipeline;
+  size_t best = 0;
+  gint result = 0;
+
+  g_return_val_if_fail (description != NULL && branch != NULL, -EINVAL);
+  *branch = NULL;
+
+  if (!_split_description (description, tokens) || tokens.size () < 2)
+    return 0;
+
+  for (const std::string &token : tokens) {
+    if (!_is_single_element (token))
+      return 0;
+  }
+
+  b = new pipeline_fusion_branch_s ();
+  b->group = NULL;
+  b->tokens = tokens;
+  b->bin = NULL;
+  b->tee_pad = NULL;
+  b->started = FALSE;
+
+  g_mutex_lock (&g_fusion_lock);
+
+  /* Attach to the fused pipeline whose trunk is the prefix of the description. */
+  for (pipeline_fusion_group_s *g : g_fusion_groups) {
+    if (!g->tee || g->trunk_len >= tokens.size ()
+        || _common_prefix (g->branches.front ()->tokens, tokens) < g->trunk_len)
+      continue;
+
+    b->bin = _create_branch_bin (tokens, g->trunk_len);
+    if (!b->bin) {
+      result = -ESTRPIPE;
+      goto done;
+    }
+
+    group = g;
+    break;
+  }
+
+  /* Split the plain pipeline, if it is not started yet. */
+  if (!group) {
+    for (pipeline_fusion_group_s *g : g_fusion_groups) {
+      const std::vector<std::string> &other = g->branches.front ()->tokens;
+      size_t n;
+
+      if (g->tee || !g->live || g->started > 0)
+        continue;
+
+      n = _common_prefix (other, tokens);
+      if (n > best && n < other.size () && n < tokens.size ()) {
+        best = n;
+        candidate = g;
+      }
+    }
+
+    if (candidate && _split_group (candidate, best, b))
+      group = candidate;
+  }
+
+  /* No pipeline to share, launch the plain pipeline. */
+  if (!group) {
+    pipeline = pipeline_fusion_launch_plain (description, &sc_ret);
+    if (!pipeline) {
+      result = -ESTRPIPE;
+      goto done;
+    }
+
+    group = new pipeline_fusion_group_s ();
+    group->pipeline = pipeline;
+    group->tee = NULL;
+    group->trunk_len = 0;
+    group->live = (sc_ret == GST_STATE_CHANGE_NO_PREROLL);
+    group->started = 0;
+    g_fusion_groups.push_back (group);
+  }
+
+  b->group = group;
+  group->branches.push_back (b);
+  *branch = b;
+  b = NULL;
+
+done:
+  g_mutex_unlock (&g_fusion_lock);
+
+  if (b)
+    _branch_free (b);
+
+  return result;
+}
+
+/**
+ * @brief Change the logical state of the branch.
+ */
+GstStateChangeReturn
+pipeline_fusion_set_state (pipeline_fusion_branch_s *branch, GstState state)
+{
+  pipeline_fusion_group_s *group;
+  GstStateChangeReturn sc_ret = GST_STATE_CHANGE_SUCCESS;
+  gboolean start = (state == GST_STATE_PLAYING);
+
+  g_return_val_if_fail (branch != NULL, GST_STATE_CHANGE_FAILURE);
+
+  g_mutex_lock (&g_fusion_lock);
+  group = branch->group;
+
+  if (branch->started == start)
+    goto done;
+
+  if (!group->tee) {
+    sc_ret = gst_element_set_state (group->pipeline, state);
+  } else if (start) {
+    sc_ret = _start_branch (branch);
+  } else {
+    _unlink_branch (branch);
+
+    if (group->started == 1)
+      sc_ret = gst_element_set_state (group->pipeline, GST_STATE_PAUSED);
+  }
+
+  if (sc_ret != GST_STATE_CHANGE_FAILURE) {
+    branch->started = start;
+    group->started = start ? group->started + 1 : group->started - 1;
+  }
+
+done:
+  g_mutex_unlock (&g_fusion_lock);
+  return sc_ret;
+}
+
+/**
+ * @brief Get the logical state of the branch.
+ */
+GstStateChangeReturn
+pipeline_fusion_get_state (pipeline_fusion_branch_s *branch, GstState *state)
+{
+  GstStateChangeReturn sc_ret;
+  GstState current = GST_STATE_NULL;
+
+  g_return_val_if_fail (branch != NULL && state != NULL, GST_STATE_CHANGE_FAILURE);
+
+  g_mutex_lock (&g_fusion_lock);
+  sc_ret = gst_element_get_state (branch->group->pipeline, &current, NULL, GST_MSECOND);
+
+  if (branch->group->tee)
+    *state = branch->started ? GST_STATE_PLAYING : GST_STATE_PAUSED;
+  else
+    *state = current;
+  g_mutex_unlock (&g_fusion_lock);
+
+  return sc_ret;
+}
+
+/**
+ * @brief Destroy the branch. The fused pipeline is destroyed with its last branch.
+ */
+void
+pipeline_fusion_destroy (pipeline_fusion_branch_s *branch)
+{
+  pipeline_fusion_group_s *group;
+
+  g_return_if_fail (branch != NULL);
+
+  g_mutex_lock (&g_fusion_lock);
+  group = branch->group;
+
+  if (group->tee && branch->started) {
+    _unlink_branch (branch);
+    group->started--;
+
+    if (group->started == 0)
+      gst_element_set_state (group->pipeline, GST_STATE_PAUSED);
+  }
+
+  for (auto it = group->branches.begin (); it != group->branches.end (); ++it) {
+    if (*it == branch) {
+      group->branches.erase (it);
+      break;
+    }
+  }
+
+  if (group->branches.empty ()) {
+    g_fusion_groups.remove (group);
+
+    /* The streaming threads are stopped in the NULL state, the paused pipeline should not be released. */
+    gst_element_set_state (group->pipeline, GST_STATE_NULL);
+
+    if (group->tee)
+      gst_object_unref (group->tee);
+    gst_object_unref (group->pipeline);
+    delete group;
+  }
+
+  g_mutex_unlock (&g_fusion_lock);
+
+  _branch_free (branch);
+}
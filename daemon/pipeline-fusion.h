@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    pipeline-fusion.h
+ * @date    17 Oct 2026
+ * @brief   Internal header of the optimizer fusing pipelines sharing a common source prefix
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    Linear pipelines whose descriptions start with the same elements are merged into one pipeline.
+ *    The shared prefix (trunk) ends with a tee, and each launched pipeline becomes a branch of it.
+ *    A branch keeps its own logical id, and it is linked to the tee only while it is started.
+ *    Only the pipelines with a live source are fused, since a non-live source would drain its data
+ *    while no branch is linked.
+ */
+#ifndef __PIPELINE_FUSION_H__
+#define __PIPELINE_FUSION_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+typedef struct _pipeline_fusion_branch pipeline_fusion_branch_s;
+
+/**
+ * @brief Launch the pipeline description as a branch of the fused pipeline.
+ * @param[in] description The pipeline description to launch.
+ * @param[out] branch The launched branch. It is NULL if the description cannot be fused, then launch it normally.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint pipeline_fusion_launch (const gchar *description, pipeline_fusion_branch_s **branch);
+
+/**
+ * @brief Launch the pipeline description without fusing it, and set it as paused state.
+ * @param[in] description The pipeline description to launch.
+ * @param[out] sc_ret The result of the state change. It may be NULL.
+ * @return The launched pipeline. NULL if it cannot be launched.
+ */
+GstElement *pipeline_fusion_launch_plain (const gchar *description, GstStateChangeReturn *sc_ret);
+
+/**
+ * @brief Change the logical state of the branch.
+ * @param[in] branch The branch launched by pipeline_fusion_launch().
+ * @param[in] state GST_STATE_PLAYING to start the branch, or GST_STATE_PAUSED to stop it.
+ * @return The result of the state change.
+ */
+GstStateChangeReturn pipeline_fusion_set_state (pipeline_fusion_branch_s *branch, GstState state);
+
+/**
+ * @brief Get the logical state of the branch.
+ * @param[in] branch The branch launched by pipeline_fusion_launch().
+ * @param[out] state The logical state of the branch.
+ * @return The result of the state query of the fused pipeline.
+ */
+GstStateChangeReturn pipeline_fusion_get_state (pipeline_fusion_branch_s *branch, GstState *state);
+
+/**
+ * @brief Destroy the branch. The fused pipeline is destroyed with its last branch.
+ * @param[in] branch The branch launched by pipeline_fusion_launch().
+ */
+void pipeline_fusion_destroy (pipeline_fusion_branch_s *branch);
+
+G_END_DECLS
+#endif /* __PIPELINE_FUSION_H__ */
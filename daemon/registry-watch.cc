@@ -0,0 +1,472 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      registry-watch.cc
+ * @date      18 Oct 2026
+ * @brief     Tracking of the registered model and resource files with inotify.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   A directory is watched once and shared by the registered files in it, so the number of the watches
+ *            does not grow with the number of the versions. The events are read in the main loop.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <glib-unix.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <vector>
+
+#include "log.h"
+#include "registry-watch.h"
+
+/**
+ * @brief The events of the watched directory.
+ */
+#define REGISTRY_WATCH_MASK \
+  (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF)
+
+/**
+ * @brief The size of the buffer to read the events, enough for an event with the longest name.
+ */
+#define REGISTRY_WATCH_BUFFER_SIZE (16U * (sizeof (struct inotify_event) + NAME_MAX + 1U))
+
+/**
+ * @brief Structure for the watched directory.
+ */
+typedef struct {
+  gchar *dir;
+  int wd; /**< The watch descriptor. -1 if the directory is not watched. */
+  guint refs; /**< The number of the registered files in the directory. */
+} registry_watch_dir_s;
+
+/**
+ * @brief Structure for the registered file.
+ */
+typedef struct {
+  gchar *path;
+  registry_watch_dir_s *dir;
+  guint owners; /**< The bits of the owners. */
+  gboolean valid;
+} registry_watch_entry_s;
+
+/**
+ * @brief Structure for the listener of the owner.
+ */
+typedef struct {
+  registry_watch_cb cb;
+  gpointer user_data;
+} registry_watch_listener_s;
+
+/**
+ * @brief Structure for the change to be notified out of the lock.
+ */
+typedef struct {
+  gchar *path;
+  const gchar *event;
+  gboolean valid;
+  guint owners;
+} registry_watch_change_s;
+
+/**
+ * @brief Structure for the inotify watch.
+ */
+typedef struct {
+  guint users;
+  int fd;
+  guint source_id;
+  GHashTable *dirs; /**< The watched directories, keyed by the path. */
+  GHashTable *wds; /**< The watched directories, keyed by the watch descriptor. */
+  GHashTable *entries; /**< The registered files, keyed by the path. */
+  registry_watch_listener_s listeners[REGISTRY_WATCH_OWNER_MAX];
+} registry_watch_s;
+
+G_LOCK_DEFINE_STATIC (registry_watch_lock);
+static registry_watch_s g_watch;
+
+/**
+ * @brief Internal function to release the directory.
+ */
+static void
+_dir_free (gpointer data)
+{
+  registry_watch_dir_s *dir = (registry_watch_dir_s *) data;
+
+  g_free (dir->dir);
+  g_free (dir);
+}
+
+/**
+ * @brief Internal function to release the registered file.
+ */
+static void
+_entry_free (gpointer data)
+{
+  registry_watch_entry_s *entry = (registry_watch_entry_s *) data;
+
+  g_free (entry->path);
+  g_free (entry);
+}
+
+/**
+ * @brief Internal function to add the watch of the directory, which is not watched. Call it with the lock.
+ */
+static void
+_watch_dir_locked (registry_watch_dir_s *dir)
+{
+  dir->wd = inotify_add_watch (g_watch.fd, dir->dir, REGISTRY_WATCH_MASK | IN_ONLYDIR);
+
+  if (dir->wd >= 0)
+    g_hash_table_insert (g_watch.wds, GINT_TO_POINTER (dir->wd), dir);
+  else
+    ml_logw ("Failed to watch the directory '%s' (%d).", dir->dir, errno);
+}
+
+/**
+ * @brief Internal function to watch the directory, or to add a reference to the watched one. Call it with the lock.
+ */
+static registry_watch_dir_s *
+_ref_dir_locked (const gchar *path)
+{
+  registry_watch_dir_s *dir = (registry_watch_dir_s *) g_hash_table_lookup (g_watch.dirs, path);
+
+  if (!dir) {
+    dir = g_new0 (registry_watch_dir_s, 1);
+    dir->dir = g_strdup (path);
+    dir->wd = -1;
+    g_hash_table_insert (g_watch.dirs, dir->dir, dir);
+  }
+
+  /* The directory may be created again after it is removed. */
+  if (dir->wd < 0)
+    _watch_dir_locked (dir);
+
+  dir->refs++;
+  return dir;
+}
+
+/**
+ * @brief Internal function to release a reference to the directory, and to stop watching it. Call it with the lock.
+ */
+static void
+_unref_dir_locked (registry_watch_dir_s *dir)
+{
+  if (--dir->refs > 0)
+    return;
+
+  if (dir->wd >= 0) {
+    g_hash_table_remove (g_watch.wds, GINT_TO_POINTER (dir->wd));
+    inotify_rm_watch (g_watch.fd, dir->wd);
+  }
+
+  g_hash_table_remove (g_watch.dirs, dir->dir);
+}
+
+/**
+ * @brief Internal function to add the change of the registered file. Call it with the lock.
+ */
+static void
+_add_change_locked (std::vector<registry_watch_change_s> &changes,
+    registry_watch_entry_s *entry, const gchar *event, gboolean valid)
+{
+  registry_watch_change_s change;
+
+  entry->valid = valid;
+
+  change.path = g_strdup (entry->path);
+  change.event = event;
+  change.valid = valid;
+  change.owners = entry->owners;
+  changes.push_back (change);
+}
+
+/**
+ * @brief Internal function to check all registered files, when the events are lost. Call it with the lock.
+ */
+static void
+_rescan_locked (std::vector<registry_watch_change_s> &changes)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  g_hash_table_iter_init (&iter, g_watch.entries);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    registry_watch_entry_s *entry = (registry_watch_entry_s *) value;
+    gboolean valid = g_file_test (entry->path, G_FILE_TEST_IS_REGULAR);
+
+    /* The file may be overwritten, it is regarded as modified. */
+    if (valid)
+      _add_change_locked (changes, entry, entry->valid ? "modified" : "created", TRUE);
+    else if (entry->valid)
+      _add_change_locked (changes, entry, "deleted", FALSE);
+  }
+}
+
+/**
+ * @brief Internal function to handle the event of the watched directory. Call it with the lock.
+ */
+static void
+_handle_event_locked (const struct inotify_event *ev, std::vector<registry_watch_change_s> &changes)
+{
+  registry_watch_dir_s *dir;
+  registry_watch_entry_s *entry;
+  g_autofree gchar *path = NULL;
+  GHashTableIter iter;
+  gpointer value;
+
+  if (ev->mask & IN_Q_OVERFLOW) {
+    ml_logw ("The events of the registered files are lost, check all files.");
+    _rescan_locked (changes);
+    return;
+  }
+
+  dir = (registry_watch_dir_s *) g_hash_table_lookup (g_watch.wds, GINT_TO_POINTER (ev->wd));
+  if (!dir)
+    return;
+
+  /* The directory itself is removed or moved, all files in it are gone. */
+  if (ev->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+    g_hash_table_iter_init (&iter, g_watch.entries);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      entry = (registry_watch_entry_s *) value;
+
+      if (entry->dir == dir && entry->valid)
+        _add_change_locked (changes, entry, (ev->mask & IN_MOVE_SELF) ? "moved" : "deleted", FALSE);
+    }
+
+    /* The moved directory is still watched at the new path, stop it to be watched again at the sync. */
+    if (ev->mask & IN_MOVE_SELF)
+      inotify_rm_watch (g_watch.fd, dir->wd);
+
+    g_hash_table_remove (g_watch.wds, GINT_TO_POINTER (dir->wd));
+    dir->wd = -1;
+    return;
+  }
+
+  if (ev->len == 0)
+    return;
+
+  path = g_build_filename (dir->dir, ev->name, NULL);
+  entry = (registry_watch_entry_s *) g_hash_table_lookup (g_watch.entries, path);
+  if (!entry)
+    return;
+
+  if (ev->mask & IN_DELETE)
+    _add_change_locked (changes, entry, "deleted", FALSE);
+  else if (ev->mask & IN_MOVED_FROM)
+    _add_change_locked (changes, entry, "moved", FALSE);
+  else if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+    _add_change_locked (changes, entry, "created", TRUE);
+  else if (ev->mask & (IN_CLOSE_WRITE | IN_ATTRIB))
+    _add_change_locked (changes, entry, "modified", TRUE);
+}
+
+/**
+ * @brief Internal function to read the inotify events in the main loop.
+ */
+static gboolean
+_watch_cb (gint fd, GIOCondition condition, gpointer user_data)
+{
+  std::vector<registry_watch_change_s> changes;
+  registry_watch_listener_s listeners[REGISTRY_WATCH_OWNER_MAX];
+  gchar buf[REGISTRY_WATCH_BUFFER_SIZE] __attribute__ ((aligned (__alignof__ (struct inotify_event))));
+  ssize_t len;
+  guint i, owner;
+
+  G_LOCK (registry_watch_lock);
+  while ((len = read (fd, buf, sizeof (buf))) > 0) {
+    gchar *ptr = buf;
+
+    while (ptr < buf + len) {
+      const struct inotify_event *ev = (const struct inotify_event *) ptr;
+
+      if (g_watch.entries)
+        _handle_event_locked (ev, changes);
+
+      ptr += sizeof (struct inotify_event) + ev->len;
+    }
+  }
+
+  for (owner = 0; owner < REGISTRY_WATCH_OWNER_MAX; owner++)
+    listeners[owner] = g_watch.listeners[owner];
+  G_UNLOCK (registry_watch_lock);
+
+  /* The listener may call the watch functions. */
+  for (i = 0; i < changes.size (); i++) {
+    ml_logi ("The registered file '%s' is %s.", changes[i].path, changes[i].event);
+
+    for (owner = 0; owner < REGISTRY_WATCH_OWNER_MAX; owner++) {
+      if ((changes[i].owners & (1U << owner)) && listeners[owner].cb)
+        listeners[owner].cb (changes[i].path, changes[i].event, changes[i].valid,
+            listeners[owner].user_data);
+    }
+
+    g_free (changes[i].path);
+  }
+
+  return G_SOURCE_CONTINUE;
+}
+
+/**
+ * @brief Start the inotify watch in the default main context.
+ */
+gint
+registry_watch_init (void)
+{
+  gint ret = 0;
+
+  G_LOCK (registry_watch_lock);
+  if (g_watch.users == 0) {
+    g_watch.fd = inotify_init1 (IN_NONBLOCK | IN_CLOEXEC);
+
+    if (g_watch.fd < 0) {
+      ret = -errno;
+      ml_loge ("Failed to initialize inotify (%d), the registered files are not tracked.", ret);
+    } else {
+      g_watch.source_id = g_unix_fd_add (g_watch.fd, G_IO_IN, _watch_cb, NULL);
+      g_watch.dirs = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, _dir_free);
+      g_watch.wds = g_hash_table_new (g_direct_hash, g_direct_equal);
+      g_watch.entries = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, _entry_free);
+    }
+  }
+
+  if (ret == 0)
+    g_watch.users++;
+  G_UNLOCK (registry_watch_lock);
+
+  return ret;
+}
+
+/**
+ * @brief Stop the inotify watch when the last owner calls it.
+ */
+void
+registry_watch_fini (void)
+{
+  G_LOCK (registry_watch_lock);
+  if (g_watch.users > 0 && --g_watch.users == 0) {
+    g_source_remove (g_watch.source_id);
+    close (g_watch.fd);
+
+    g_clear_pointer (&g_watch.entries, g_hash_table_destroy);
+    g_clear_pointer (&g_watch.wds, g_hash_table_destroy);
+    g_clear_pointer (&g_watch.dirs, g_hash_table_destroy);
+
+    g_watch.source_id = 0;
+    g_watch.fd = -1;
+    memset (g_watch.listeners, 0, sizeof (g_watch.listeners));
+  }
+  G_UNLOCK (registry_watch_lock);
+}
+
+/**
+ * @brief Set the listener of the owner.
+ */
+void
+registry_watch_set_listener (registry_watch_owner_e owner, registry_watch_cb cb, gpointer user_data)
+{
+  g_return_if_fail (owner < REGISTRY_WATCH_OWNER_MAX);
+
+  G_LOCK (registry_watch_lock);
+  g_watch.listeners[owner].cb = cb;
+  g_watch.listeners[owner].user_data = user_data;
+  G_UNLOCK (registry_watch_lock);
+}
+
+/**
+ * @brief Replace the watched files of the owner with the given paths.
+ */
+void
+registry_watch_sync (registry_watch_owner_e owner, const gchar *const *paths)
+{
+  g_autoptr (GHashTable) keep = NULL;
+  registry_watch_entry_s *entry;
+  GHashTableIter iter;
+  gpointer value;
+  guint bit, i;
+
+  g_return_if_fail (owner < REGISTRY_WATCH_OWNER_MAX);
+  bit = 1U << owner;
+
+  keep = g_hash_table_new (g_str_hash, g_str_equal);
+
+  G_LOCK (registry_watch_lock);
+  if (!g_watch.entries) {
+    G_UNLOCK (registry_watch_lock);
+    return;
+  }
+
+  for (i = 0; paths && paths[i]; i++) {
+    /* The relative path cannot be resolved by the daemon. */
+    if (!g_path_is_absolute (paths[i]))
+      continue;
+
+    entry = (registry_watch_entry_s *) g_hash_table_lookup (g_watch.entries, paths[i]);
+    if (!entry) {
+      g_autofree gchar *dir = g_path_get_dirname (paths[i]);
+
+      entry = g_new0 (registry_watch_entry_s, 1);
+      entry->path = g_strdup (paths[i]);
+      entry->dir = _ref_dir_locked (dir);
+      entry->valid = g_file_test (paths[i], G_FILE_TEST_IS_REGULAR);
+      g_hash_table_insert (g_watch.entries, entry->path, entry);
+
+      if (!entry->valid)
+        ml_logw ("The registered file '%s' does not exist.", paths[i]);
+    } else if (entry->dir->wd < 0) {
+      /* The directory is removed or moved, watch it again if it is created again. */
+      _watch_dir_locked (entry->dir);
+
+      if (entry->dir->wd >= 0)
+        entry->valid = g_file_test (paths[i], G_FILE_TEST_IS_REGULAR);
+    }
+
+    entry->owners |= bit;
+    g_hash_table_add (keep, entry->path);
+  }
+
+  g_hash_table_iter_init (&iter, g_watch.entries);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    entry = (registry_watch_entry_s *) value;
+
+    if (!(entry->owners & bit) || g_hash_table_contains (keep, entry->path))
+      continue;
+
+    entry->owners &= ~bit;
+    if (entry->owners == 0) {
+      _unref_dir_locked (entry->dir);
+      g_hash_table_iter_remove (&iter);
+    }
+  }
+  G_UNLOCK (registry_watch_lock);
+}
+
+/**
+ * @brief Check whether the registered file exists.
+ */
+gboolean
+registry_watch_is_valid (const gchar *path)
+{
+  registry_watch_entry_s *entry;
+  gboolean valid = TRUE;
+
+  if (!path)
+    return TRUE;
+
+  G_LOCK (registry_watch_lock);
+  if (g_watch.entries) {
+    entry = (registry_watch_entry_s *) g_hash_table_lookup (g_watch.entries, path);
+    if (entry)
+      valid = entry->valid;
+  }
+  G_UNLOCK (registry_watch_lock);
+
+  return valid;
+}
@@ -0,0 +1,77 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    registry-watch.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the tracking of the registered model and resource files
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The directories of the registered files are watched with inotify, one watch per directory.
+ *    When a registered file is deleted, moved or overwritten, the validity index is updated and
+ *    the listener of the owner is called in the main loop. So the stale entries are found without scanning the registry.
+ */
+#ifndef __REGISTRY_WATCH_H__
+#define __REGISTRY_WATCH_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The owners of the watched files.
+ */
+typedef enum {
+  REGISTRY_WATCH_MODEL = 0,
+  REGISTRY_WATCH_RESOURCE,
+
+  REGISTRY_WATCH_OWNER_MAX
+} registry_watch_owner_e;
+
+/**
+ * @brief The callback to be called when the watched file is changed.
+ * @param[in] path The path of the changed file.
+ * @param[in] event The change, one of "created", "modified", "deleted" and "moved".
+ * @param[in] valid Whether the file exists after the change.
+ * @param[in] user_data The user data given with the listener.
+ */
+typedef void (*registry_watch_cb) (const gchar *path, const gchar *event, gboolean valid, gpointer user_data);
+
+/**
+ * @brief Start the inotify watch in the default main context. It can be called by each owner.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint registry_watch_init (void);
+
+/**
+ * @brief Stop the inotify watch when the last owner calls it.
+ */
+void registry_watch_fini (void);
+
+/**
+ * @brief Set the listener of the owner.
+ */
+void registry_watch_set_listener (registry_watch_owner_e owner, registry_watch_cb cb, gpointer user_data);
+
+/**
+ * @brief Replace the watched files of the owner with the given paths.
+ * @param[in] owner The owner of the files.
+ * @param[in] paths The NULL-terminated array of the paths. The files of the owner not in the array are not watched anymore.
+ */
+void registry_watch_sync (registry_watch_owner_e owner, const gchar *const *paths);
+
+/**
+ * @brief Check whether the registered file exists.
+ * @param[in] path The path of the file.
+ * @return FALSE if the watched file is deleted or moved. TRUE otherwise, including the file not watched.
+ */
+gboolean registry_watch_is_valid (const gchar *path);
+
+G_END_DECLS
+#endif /* __REGISTRY_WATCH_H__ */
@@ -12,17 +12,30 @@
 
 #include <errno.h>
 #include <glib.h>
+#include <json-glib/json-glib.h>
 
+#include "agent-config.h"
 #include "common.h"
 #include "dbus-interface.h"
 #include "gdbus-util.h"
 #include "log.h"
+#include "model-prefetch.h"
 #include "modules.h"
+#include "registry-watch.h"
 #include "resource-dbus.h"
+#include "resource-files.h"
 #include "service-db-util.h"
 
 static MachinelearningServiceResource *g_gdbus_res_instance = NULL;
 
+/**
+ * @brief Structure for the prefetch request of the resource, completed when the files are read ahead.
+ */
+typedef struct {
+  MachinelearningServiceResource *obj;
+  GDBusMethodInvocation *invoc;
+} resource_prefetch_req_s;
+
 /**
  * @brief Utility function to get the DBus proxy.
  */
@@ -41,6 +54,72 @@ gdbus_put_resource_instance (MachinelearningServiceResource **instance)
   g_clear_object (instance);
 }
 
+/**
+ * @brief Internal function to notify the clients of the changed resource file.
+ */
+static void
+_resource_file_changed (const gchar *path, const gchar *event, gboolean valid, gpointer user_data)
+{
+  if (g_gdbus_res_instance)
+    machinelearning_service_resource_emit_file_changed (g_gdbus_res_instance, path, event, valid);
+}
+
+/**
+ * @brief Internal function to get the paths of the resource files from the resource information.
+ * @return The NULL-terminated array of the paths, or NULL if there is no file.
+ */
+static gchar **
+_get_resource_paths (const gchar *res_info)
+{
+  g_autoptr (JsonParser) parser = json_parser_new ();
+  GPtrArray *array;
+  JsonNode *root;
+  JsonArray *list;
+  JsonObject *res;
+  const gchar *path;
+  guint i;
+
+  if (!json_parser_load_from_data (parser, res_info, -1, NULL))
+    return NULL;
+
+  root = json_parser_get_root (parser);
+  if (!root || !JSON_NODE_HOLDS_ARRAY (root))
+    return NULL;
+
+  array = g_ptr_array_new ();
+  list = json_node_get_array (root);
+
+  for (i = 0; i < json_array_get_length (list); i++) {
+    res = json_array_get_object_element (list, i);
+    path = (res && json_object_has_member (res, "path")) ? json_object_get_string_member (res, "path") : NULL;
+
+    if (path && path[0] != '\0')
+      g_ptr_array_add (array, g_strdup (path));
+  }
+
+  if (array->len == 0U) {
+    g_ptr_array_free (array, TRUE);
+    return NULL;
+  }
+
+  g_ptr_array_add (array, NULL);
+  return (gchar **) g_ptr_array_free (array, FALSE);
+}
+
+/**
+ * @brief Internal function to complete the prefetch request with the result of the files.
+ */
+static void
+_resource_prefetched (gint result, const gchar *info, gpointer user_data)
+{
+  resource_prefetch_req_s *req = (resource_prefetch_req_s *) user_data;
+
+  machinelearning_service_resource_complete_prefetch (req->obj, req->invoc, info, result);
+
+  g_object_unref (req->obj);
+  g_free (req);
+}
+
 /**
  * @brief The callback function of Add method
  * @param obj Proxy instance.
@@ -59,6 +138,16 @@ gdbus_cb_resource_add (MachinelearningServiceResource *obj, GDBusMethodInvocatio
   ret = svcdb_resource_add (name, path, description, app_info);
   machinelearning_service_resource_complete_add (obj, invoc, ret);
 
+  if (ret == 0) {
+    resource_files_sync (FALSE);
+
+    if (agent_config_get ()->resource_prefetch) {
+      const gchar *paths[] = { path, NULL };
+
+      model_prefetch_files (paths, NULL, NULL, NULL);
+    }
+  }
+
   return TRUE;
 }
 
@@ -82,6 +171,28 @@ gdbus_cb_resource_get (MachinelearningServiceResource *obj,
   return TRUE;
 }
 
+/**
+ * @brief The callback function of list method
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param pattern The GLOB pattern of the resource names. Empty string for all resources.
+ * @param cursor The cursor returned with the previous page. Empty string for the first page.
+ * @param limit The maximum number of the names in the page. 0 for the default.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ */
+static gboolean
+gdbus_cb_resource_list (MachinelearningServiceResource *obj, GDBusMethodInvocation *invoc,
+    const gchar *pattern, const gchar *cursor, guint limit)
+{
+  gint ret = 0;
+  g_autofree gchar *list = NULL;
+
+  ret = svcdb_list_names ("resource", pattern, cursor, limit, &list);
+  machinelearning_service_resource_complete_list (obj, invoc, list ? list : "", ret);
+
+  return TRUE;
+}
+
 /**
  * @brief The callback function of delete method
  * @param obj Proxy instance.
@@ -98,6 +209,55 @@ gdbus_cb_resource_delete (MachinelearningServiceResource *obj,
   ret = svcdb_resource_delete (name);
   machinelearning_service_resource_complete_delete (obj, invoc, ret);
 
+  if (ret == 0)
+    resource_files_sync (FALSE);
+
+  return TRUE;
+}
+
+/**
+ * @brief The callback function of prefetch method
+ * @param obj Proxy instance.
+ * @param invoc Method invocation handle.
+ * @param name The name of target resource.
+ * @return @c TRUE if the request is handled. FALSE if the service is not available.
+ * @details The files of the resource are validated and read ahead in parallel, and the method is completed after all of them.
+ */
+static gboolean
+gdbus_cb_resource_prefetch (MachinelearningServiceResource *obj,
+    GDBusMethodInvocation *invoc, const gchar *name)
+{
+  gint ret = 0;
+  g_autofree gchar *res_info = NULL;
+  g_auto (GStrv) paths = NULL;
+  resource_prefetch_req_s *req;
+  GMainContext *context;
+
+  ret = svcdb_resource_get (name, &res_info);
+  if (ret == 0) {
+    paths = _get_resource_paths (res_info);
+    if (!paths)
+      ret = -ENOENT;
+  }
+
+  if (ret == 0) {
+    req = g_new0 (resource_prefetch_req_s, 1);
+    req->obj = (MachinelearningServiceResource *) g_object_ref (obj);
+    req->invoc = invoc;
+
+    context = g_main_context_ref_thread_default ();
+    ret = model_prefetch_files ((const gchar *const *) paths, _resource_prefetched, req, context);
+    g_main_context_unref (context);
+
+    if (ret != 0) {
+      g_object_unref (req->obj);
+      g_free (req);
+    }
+  }
+
+  if (ret != 0)
+    machinelearning_service_resource_complete_prefetch (obj, invoc, "", ret);
+
   return TRUE;
 }
 
@@ -123,6 +283,18 @@ static struct gdbus_signal_info res_handler_infos[] = {
       .cb_data = NULL,
       .handler_id = 0,
   },
+  {
+      .signal_name = DBUS_RESOURCE_I_HANDLER_LIST,
+      .cb = G_CALLBACK (gdbus_cb_resource_list),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
+  {
+      .signal_name = DBUS_RESOURCE_I_HANDLER_PREFETCH,
+      .cb = G_CALLBACK (gdbus_cb_resource_prefetch),
+      .cb_data = NULL,
+      .handler_id = 0,
+  },
 };
 
 /**
@@ -175,7 +347,11 @@ out:
 static void
 init_resource_module (void *data)
 {
-  gdbus_initialize ();
+  if (registry_watch_init () == 0)
+    registry_watch_set_listener (REGISTRY_WATCH_RESOURCE, _resource_file_changed, NULL);
+
+  /* The files registered before the startup are not read ahead. */
+  resource_files_sync (FALSE);
 }
 
 /**
@@ -184,6 +360,8 @@ init_resource_module (void *data)
 static void
 exit_resource_module (void *data)
 {
+  registry_watch_fini ();
+
   gdbus_disconnect_signal (
       g_gdbus_res_instance, ARRAY_SIZE (res_handler_infos), res_handler_infos);
   gdbus_put_resource_instance (&g_gdbus_res_instance);
@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      resource-files.cc
+ * @date      18 Oct 2026
+ * @brief     Tracking of the registered resource files.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This keeps the paths seen at the last sync, to find the files newly registered.
+ */
+
+#include <glib.h>
+#include <json-glib/json-glib.h>
+
+#include "agent-config.h"
+#include "log.h"
+#include "model-prefetch.h"
+#include "registry-watch.h"
+#include "resource-files.h"
+#include "service-db-util.h"
+
+static GHashTable *g_resource_paths = NULL; /**< The paths of the registered resource files at the last sync. */
+G_LOCK_DEFINE_STATIC (resource_files_lock);
+
+/**
+ * @brief Watch the files of all registered resources, and read ahead the newly registered files.
+ */
+void
+resource_files_sync (gboolean prefetch)
+{
+  g_autofree gchar *paths = NULL;
+  g_autoptr (JsonParser) parser = json_parser_new ();
+  g_autoptr (GPtrArray) array = g_ptr_array_new ();
+  g_autoptr (GPtrArray) added = g_ptr_array_new ();
+  GHashTable *registered;
+  JsonNode *root;
+  JsonArray *list;
+  guint i;
+
+  if (svcdb_resource_list_paths (&paths) != 0
+      || !json_parser_load_from_data (parser, paths, -1, NULL))
+    return;
+
+  registered = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+
+  root = json_parser_get_root (parser);
+  if (root && JSON_NODE_HOLDS_ARRAY (root)) {
+    list = json_node_get_array (root);
+
+    for (i = 0; i < json_array_get_length (list); i++) {
+      const gchar *path = json_array_get_string_element (list, i);
+
+      if (!path || g_hash_table_contains (registered, path))
+        continue;
+
+      g_ptr_array_add (array, (gpointer) path);
+      g_hash_table_add (registered, g_strdup (path));
+    }
+  }
+
+  G_LOCK (resource_files_lock);
+  for (i = 0; i < array->len; i++) {
+    if (!g_resource_paths || !g_hash_table_contains (g_resource_paths, g_ptr_array_index (array, i)))
+      g_ptr_array_add (added, g_ptr_array_index (array, i));
+  }
+
+  if (g_resource_paths)
+    g_hash_table_destroy (g_resource_paths);
+  g_resource_paths = registered;
+  G_UNLOCK (resource_files_lock);
+
+  g_ptr_array_add (array, NULL);
+  registry_watch_sync (REGISTRY_WATCH_RESOURCE, (const gchar *const *) array->pdata);
+
+  if (prefetch && added->len > 0U && agent_config_get ()->resource_prefetch) {
+    g_ptr_array_add (added, NULL);
+
+    if (model_prefetch_files ((const gchar *const *) added->pdata, NULL, NULL, NULL) != 0)
+      ml_logw ("Failed to read ahead the registered resource files.");
+  }
+}
@@ -0,0 +1,33 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    resource-files.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the tracking of the registered resource files
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The resources are registered with the Add method of the resource interface, and installed with the models.
+ *    Both paths sync the watched resource files here, and the newly registered files are read ahead if it is configured.
+ */
+#ifndef __RESOURCE_FILES_H__
+#define __RESOURCE_FILES_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief Watch the files of all registered resources.
+ * @param[in] prefetch Read ahead the files registered since the last sync, if the prefetch of the resources is configured.
+ */
+void resource_files_sync (gboolean prefetch);
+
+G_END_DECLS
+#endif /* __RESOURCE_FILES_H__ */
@@ -0,0 +1,662 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file      rpk-config.cc
+ * @date      18 Oct 2026
+ * @brief     Streaming reader of the configuration file of the RPK package.
+ * @see       https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author    agent <agent@local>
+ * @bug       No known bugs except for NYI items
+ * @details   This validates the configuration in a pass, and passes the entries to the callback as they are read.
+ */
+
+#include <errno.h>
+#include <string>
+#include <unistd.h>
+
+#include "log.h"
+#include "rpk-config.h"
+
+/**
+ * @brief The size of the chunk read from the configuration file at once.
+ */
+#define RPK_CONFIG_CHUNK_SIZE (4096U)
+
+/**
+ * @brief The maximum depth of the nested values in the configuration.
+ */
+#define RPK_CONFIG_MAX_DEPTH (64U)
+
+/**
+ * @brief The maximum length of the string in the configuration.
+ */
+#define RPK_CONFIG_MAX_STRING (1024U * 1024U)
+
+/**
+ * @brief The names of the types of the entries. The type of the name at the index i is (i / 2).
+ */
+static const gchar *const rpk_config_types[] = { "model", "models", "pipeline", "pipelines", "resource", "resources" };
+
+/**
+ * @brief Internal structure to read the configuration in the memory or in the file.
+ */
+typedef struct {
+  gint fd; /**< The configuration file, or -1 for the configuration in the memory. */
+  const gchar *buf; /**< The configuration in the memory, or the chunk read from the file. */
+  gsize len; /**< The length of @a buf. */
+  gsize pos; /**< The position of the next character in @a buf. */
+  goffset offset; /**< The offset of @a buf in the configuration. */
+  guint depth; /**< The depth of the nested values being skipped. */
+  gint error; /**< The error to read the file. */
+  gchar chunk[RPK_CONFIG_CHUNK_SIZE];
+} rpk_reader_s;
+
+/**
+ * @brief Internal structure for the members of the entry being scanned.
+ */
+typedef struct {
+  std::string name;
+  std::string description;
+  std::string activate;
+  std::string value; /**< The model, pipeline or path of the entry. */
+  gboolean has_name;
+  gboolean has_description;
+  gboolean has_activate;
+  gboolean has_value;
+  goffset paths; /**< The offset of the array of the paths, or -1 if the path is a string. */
+} rpk_entry_s;
+
+/**
+ * @brief Internal function to fill the chunk of the file if all characters in the buffer are read.
+ * @return TRUE if a character is available.
+ */
+static gboolean
+_fill (rpk_reader_s *r)
+{
+  ssize_t n;
+
+  if (r->pos < r->len)
+    return TRUE;
+
+  if (r->fd < 0 || r->error != 0)
+    return FALSE;
+
+  r->offset += (goffset) r->len;
+  r->buf = r->chunk;
+  r->len = r->pos = 0U;
+
+  do {
+    n = pread (r->fd, r->chunk, sizeof (r->chunk), r->offset);
+  } while (n < 0 && errno == EINTR);
+
+  if (n < 0) {
+    ml_loge ("Failed to read the configuration file at %" G_GOFFSET_FORMAT " (%d).", r->offset, errno);
+    r->error = -EIO;
+    return FALSE;
+  }
+
+  r->len = (gsize) n;
+  return (n > 0);
+}
+
+/**
+ * @brief Internal function to get the next character without consuming it. -1 at the end of the configuration.
+ */
+static gint
+_peek (rpk_reader_s *r)
+{
+  return _fill (r) ? (guchar) r->buf[r->pos] : -1;
+}
+
+/**
+ * @brief Internal function to get the offset of the next character in the configuration.
+ */
+static goffset
+_tell (rpk_reader_s *r)
+{
+  return r->offset + (goffset) r->pos;
+}
+
+/**
+ * @brief Internal function to move to the offset in the configuration, which is already scanned.
+ */
+static void
+_seek (rpk_reader_s *r, const goffset offset)
+{
+  if (r->fd < 0) {
+    r->pos = (gsize) offset;
+  } else if (offset >= r->offset && offset <= r->offset + (goffset) r->len) {
+    r->pos = (gsize) (offset - r->offset);
+  } else {
+    /* The chunk at the offset is read at the next character. */
+    r->offset = offset;
+    r->len = r->pos = 0U;
+  }
+}
+
+/**
+ * @brief Internal function to skip the whitespaces.
+ */
+static void
+_skip_ws (rpk_reader_s *r)
+{
+  gint c;
+
+  while ((c = _peek (r)) == ' ' || c == '\t' || c == '\n' || c == '\r')
+    r->pos++;
+}
+
+/**
+ * @brief Internal function to skip the whitespaces and consume the next character if it is the given one.
+ */
+static gboolean
+_scan_char (rpk_reader_s *r, const gint c)
+{
+  _skip_ws (r);
+
+  if (_peek (r) != c)
+    return FALSE;
+
+  r->pos++;
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to consume the given word.
+ */
+static gboolean
+_scan_word (rpk_reader_s *r, const gchar *word)
+{
+  for (; *word != '\0'; word++) {
+    if (_peek (r) != (guchar) *word)
+      return FALSE;
+    r->pos++;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to scan the 4 hexadecimal digits of the unicode escape.
+ */
+static gboolean
+_scan_hex (rpk_reader_s *r, gunichar *u)
+{
+  guint i;
+  gint c;
+
+  *u = 0;
+  for (i = 0; i < 4U; i++) {
+    c = _peek (r);
+    if (c < 0 || !g_ascii_isxdigit (c))
+      return FALSE;
+
+    *u = (*u << 4) | (gunichar) g_ascii_xdigit_value (c);
+    r->pos++;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to scan the string and unescape it.
+ */
+static gboolean
+_scan_string (rpk_reader_s *r, std::string &out)
+{
+  gchar utf8[6];
+  gunichar u, low;
+  gint c;
+
+  out.clear ();
+
+  if (!_scan_char (r, '"'))
+    return FALSE;
+
+  while ((c = _peek (r)) != '"') {
+    /* The control characters should be escaped, and it also fails at the end of the configuration. */
+    if (c < 0x20)
+      return FALSE;
+
+    r->pos++;
+
+    if (c != '\\') {
+      out.push_back ((gchar) c);
+    } else {
+      if ((c = _peek (r)) < 0)
+        return FALSE;
+
+      r->pos++;
+
+      switch (c) {
+        case '"':
+        case '\\':
+        case '/':
+          out.push_back ((gchar) c);
+          break;
+        case 'b':
+          out.push_back ('\b');
+          break;
+        case 'f':
+          out.push_back ('\f');
+          break;
+        case 'n':
+          out.push_back ('\n');
+          break;
+        case 'r':
+          out.push_back ('\r');
+          break;
+        case 't':
+          out.push_back ('\t');
+          break;
+        case 'u':
+          if (!_scan_hex (r, &u))
+            return FALSE;
+
+          if (u >= 0xD800 && u <= 0xDBFF) {
+            /* The character out of the basic plane is the pair of the surrogates. */
+            if (!_scan_word (r, "\\u") || !_scan_hex (r, &low) || low < 0xDC00 || low > 0xDFFF)
+              return FALSE;
+            u = 0x10000 + ((u - 0xD800) << 10) + (low - 0xDC00);
+          } else if (u == 0 || (u >= 0xDC00 && u <= 0xDFFF)) {
+            return FALSE;
+          }
+
+          out.append (utf8, g_unichar_to_utf8 (u, utf8));
+          break;
+        default:
+          return FALSE;
+      }
+    }
+
+    if (out.size () > RPK_CONFIG_MAX_STRING) {
+      ml_loge ("The string in the configuration is longer than %u bytes.", RPK_CONFIG_MAX_STRING);
+      return FALSE;
+    }
+  }
+
+  r->pos++;
+  return g_utf8_validate (out.data (), (gssize) out.size (), NULL);
+}
+
+/**
+ * @brief Internal function to scan the digits. At least one digit is required.
+ */
+static gboolean
+_scan_digits (rpk_reader_s *r)
+{
+  gboolean found = FALSE;
+  gint c;
+
+  while ((c = _peek (r)) >= '0' && c <= '9') {
+    r->pos++;
+    found = TRUE;
+  }
+
+  return found;
+}
+
+/**
+ * @brief Internal function to scan the number.
+ */
+static gboolean
+_scan_number (rpk_reader_s *r)
+{
+  gint c;
+
+  if (_peek (r) == '-')
+    r->pos++;
+
+  if (_peek (r) == '0')
+    r->pos++;
+  else if (!_scan_digits (r))
+    return FALSE;
+
+  if (_peek (r) == '.') {
+    r->pos++;
+    if (!_scan_digits (r))
+      return FALSE;
+  }
+
+  c = _peek (r);
+  if (c == 'e' || c == 'E') {
+    r->pos++;
+    c = _peek (r);
+    if (c == '+' || c == '-')
+      r->pos++;
+    if (!_scan_digits (r))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to validate and skip any value.
+ */
+static gboolean
+_skip_value (rpk_reader_s *r, std::string &scratch)
+{
+  gboolean ret = TRUE;
+  gint close;
+
+  _skip_ws (r);
+
+  switch (_peek (r)) {
+    case '"':
+      return _scan_string (r, scratch);
+    case 't':
+      return _scan_word (r, "true");
+    case 'f':
+      return _scan_word (r, "false");
+    case 'n':
+      return _scan_word (r, "null");
+    case '{':
+      close = '}';
+      break;
+    case '[':
+      close = ']';
+      break;
+    default:
+      return _scan_number (r);
+  }
+
+  if (r->depth >= RPK_CONFIG_MAX_DEPTH)
+    return FALSE;
+
+  r->pos++;
+  r->depth++;
+
+  if (!_scan_char (r, close)) {
+    do {
+      if (close == '}' && !(_scan_string (r, scratch) && _scan_char (r, ':'))) {
+        ret = FALSE;
+        break;
+      }
+
+      if (!_skip_value (r, scratch)) {
+        ret = FALSE;
+        break;
+      }
+    } while (_scan_char (r, ','));
+
+    ret = ret && _scan_char (r, close);
+  }
+
+  r->depth--;
+  return ret;
+}
+
+/**
+ * @brief Internal function to scan the string member of the entry. The member which is not a string is regarded as not given.
+ */
+static gboolean
+_scan_member (rpk_reader_s *r, std::string &value, gboolean *has_value, std::string &scratch)
+{
+  _skip_ws (r);
+
+  *has_value = (_peek (r) == '"');
+  return *has_value ? _scan_string (r, value) : _skip_value (r, scratch);
+}
+
+/**
+ * @brief Internal function to scan the array of the paths of the resource. Each path is passed to the callback if it is given.
+ */
+static gint
+_scan_paths (rpk_reader_s *r, std::string &path, rpk_config_entry_cb cb,
+    rpk_config_entry_s *entry, gpointer user_data)
+{
+  guint index = 0U;
+  gint ret;
+
+  if (!_scan_char (r, '['))
+    return -EINVAL;
+
+  do {
+    if (!_scan_string (r, path) || path.empty ())
+      return -EINVAL;
+
+    if (cb) {
+      entry->path = path.c_str ();
+      entry->path_index = index;
+
+      if ((ret = cb (entry, user_data)) != 0)
+        return ret;
+    }
+
+    index++;
+  } while (_scan_char (r, ','));
+
+  return _scan_char (r, ']') ? 0 : -EINVAL;
+}
+
+/**
+ * @brief Internal function to scan the entry and validate its required members.
+ * @details The array of the paths is validated, and only its offset is kept.
+ */
+static gboolean
+_scan_entry (rpk_reader_s *r, const rpk_config_type_e type, rpk_entry_s *e, std::string &scratch)
+{
+  const gchar *value_key = (type == RPK_CONFIG_MODEL) ? "model" :
+                           (type == RPK_CONFIG_PIPELINE) ? "pipeline" : "path";
+
+  e->has_name = e->has_description = e->has_activate = e->has_value = FALSE;
+  e->paths = -1;
+
+  if (!_scan_char (r, '{'))
+    return FALSE;
+
+  if (!_scan_char (r, '}')) {
+    do {
+      if (!_scan_string (r, scratch) || !_scan_char (r, ':'))
+        return FALSE;
+
+      /* The last one is used if the member is duplicated. */
+      if (scratch == "name") {
+        if (!_scan_member (r, e->name, &e->has_name, scratch))
+          return FALSE;
+      } else if (scratch == "description") {
+        if (!_scan_member (r, e->description, &e->has_description, scratch))
+          return FALSE;
+      } else if (type == RPK_CONFIG_MODEL && scratch == "activate") {
+        if (!_scan_member (r, e->activate, &e->has_activate, scratch))
+          return FALSE;
+      } else if (scratch == value_key) {
+        _skip_ws (r);
+
+        if (type == RPK_CONFIG_RESOURCE && _peek (r) == '[') {
+          e->paths = _tell (r);
+          e->has_value = TRUE;
+
+          if (_scan_paths (r, scratch, NULL, NULL, NULL) != 0)
+            return FALSE;
+        } else {
+          e->paths = -1;
+
+          if (!_scan_member (r, e->value, &e->has_value, scratch))
+            return FALSE;
+        }
+      } else if (!_skip_value (r, scratch)) {
+        return FALSE;
+      }
+    } while (_scan_char (r, ','));
+
+    if (!_scan_char (r, '}'))
+      return FALSE;
+  }
+
+  if (!e->has_name || e->name.empty () || !e->has_value || (e->paths < 0 && e->value.empty ())) {
+    ml_loge ("The entry of %s in the configuration has no valid name or %s.",
+        rpk_config_types[type * 2], value_key);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to pass the scanned entry to the callback.
+ * @details The array of the paths is read again from its offset, not to keep all paths of the resource.
+ */
+static gint
+_pass_entry (rpk_reader_s *r, const rpk_config_type_e type, rpk_entry_s *e,
+    std::string &scratch, rpk_config_entry_cb cb, gpointer user_data)
+{
+  rpk_config_entry_s entry = {};
+  goffset end;
+  gint ret;
+
+  if (!cb)
+    return 0;
+
+  entry.type = type;
+  entry.name = e->name.c_str ();
+  entry.description = e->has_description ? e->description.c_str () : NULL;
+  entry.activate = e->has_activate ? e->activate.c_str () : NULL;
+
+  switch (type) {
+    case RPK_CONFIG_MODEL:
+      entry.model = e->value.c_str ();
+      break;
+    case RPK_CONFIG_PIPELINE:
+      entry.pipeline = e->value.c_str ();
+      break;
+    default:
+      entry.path = e->value.c_str ();
+      break;
+  }
+
+  if (type != RPK_CONFIG_RESOURCE || e->paths < 0)
+    return cb (&entry, user_data);
+
+  end = _tell (r);
+  _seek (r, e->paths);
+
+  ret = _scan_paths (r, scratch, cb, &entry, user_data);
+
+  _seek (r, end);
+  return ret;
+}
+
+/**
+ * @brief Internal function to scan the configuration.
+ */
+static gint
+_scan_config (rpk_reader_s *r, rpk_config_entry_cb cb, gpointer user_data)
+{
+  std::string scratch;
+  rpk_entry_s e;
+  guint seen = 0U;
+  gint ret;
+
+  if (!_scan_char (r, '{'))
+    return -EINVAL;
+
+  if (!_scan_char (r, '}')) {
+    do {
+      rpk_config_type_e type;
+      gboolean array;
+      guint i;
+
+      if (!_scan_string (r, scratch) || !_scan_char (r, ':'))
+        return -EINVAL;
+
+      for (i = 0; i < G_N_ELEMENTS (rpk_config_types); i++) {
+        if (g_ascii_strcasecmp (scratch.c_str (), rpk_config_types[i]) == 0)
+          break;
+      }
+
+      if (i >= G_N_ELEMENTS (rpk_config_types)) {
+        ml_loge ("Unsupported type '%s' in the configuration.", scratch.c_str ());
+        return -EINVAL;
+      }
+
+      /* The entries are not kept, so the duplicated type cannot be replaced by the last one. */
+      if (seen & (1U << i)) {
+        ml_loge ("Duplicated type '%s' in the configuration.", scratch.c_str ());
+        return -EINVAL;
+      }
+
+      seen |= (1U << i);
+      type = (rpk_config_type_e) (i / 2);
+
+      array = _scan_char (r, '[');
+      if (array && _scan_char (r, ']'))
+        continue;
+
+      do {
+        if (!_scan_entry (r, type, &e, scratch))
+          return -EINVAL;
+
+        if ((ret = _pass_entry (r, type, &e, scratch, cb, user_data)) != 0)
+          return ret;
+      } while (array && _scan_char (r, ','));
+
+      if (array && !_scan_char (r, ']'))
+        return -EINVAL;
+    } while (_scan_char (r, ','));
+
+    if (!_scan_char (r, '}'))
+      return -EINVAL;
+  }
+
+  /* Nothing but the whitespaces after the top object. */
+  _skip_ws (r);
+  return (_peek (r) < 0) ? 0 : -EINVAL;
+}
+
+/**
+ * @brief Internal function to scan the configuration and get the error.
+ */
+static gint
+_scan (rpk_reader_s *r, rpk_config_entry_cb cb, gpointer user_data)
+{
+  gint ret = _scan_config (r, cb, user_data);
+
+  if (ret == -EINVAL && r->error != 0)
+    return r->error;
+
+  if (ret == -EINVAL)
+    ml_loge ("Invalid configuration at %" G_GOFFSET_FORMAT ".", _tell (r));
+
+  return ret;
+}
+
+/**
+ * @brief Validate the configuration in the memory, and pass the entries to the callback in the order of the configuration.
+ */
+gint
+rpk_config_scan (const gchar *contents, const gsize length, rpk_config_entry_cb cb, gpointer user_data)
+{
+  rpk_reader_s r = {};
+
+  if (!contents)
+    return -EINVAL;
+
+  r.fd = -1;
+  r.buf = contents;
+  r.len = length;
+
+  return _scan (&r, cb, user_data);
+}
+
+/**
+ * @brief Validate the configuration in the file, and pass the entries to the callback in the order of the configuration.
+ */
+gint
+rpk_config_scan_fd (const gint fd, rpk_config_entry_cb cb, gpointer user_data)
+{
+  rpk_reader_s r = {};
+
+  if (fd < 0)
+    return -EINVAL;
+
+  r.fd = fd;
+  r.buf = r.chunk;
+
+  return _scan (&r, cb, user_data);
+}
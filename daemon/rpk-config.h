@@ -0,0 +1,78 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    rpk-config.h
+ * @date    18 Oct 2026
+ * @brief   Internal header of the streaming reader of the configuration file of the RPK package
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The configuration, in the format of rpk_config.json, is validated and passed entry by entry without building the json tree.
+ *    The file is read in the chunks of the fixed size, and only the strings of the current entry are kept.
+ *    So the memory does not grow with the size of the configuration.
+ */
+#ifndef __RPK_CONFIG_H__
+#define __RPK_CONFIG_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The types of the entries in the configuration.
+ */
+typedef enum {
+  RPK_CONFIG_MODEL = 0,
+  RPK_CONFIG_PIPELINE,
+  RPK_CONFIG_RESOURCE
+} rpk_config_type_e;
+
+/**
+ * @brief The entry of the configuration. The strings are valid only in the callback.
+ */
+typedef struct {
+  rpk_config_type_e type;
+  const gchar *name;
+  const gchar *description; /**< NULL if it is not given. */
+  const gchar *model; /**< The model file of the model entry. */
+  const gchar *activate; /**< The activation of the model entry. NULL if it is not given. */
+  const gchar *pipeline; /**< The pipeline description of the pipeline entry. */
+  const gchar *path; /**< A path of the resource entry. */
+  guint path_index; /**< The index of @a path in the paths of the resource entry. */
+} rpk_config_entry_s;
+
+/**
+ * @brief The callback for the entry of the configuration. The resource entry is passed once for each path.
+ * @return 0 to continue, or a negative error value to stop the scan.
+ */
+typedef gint (*rpk_config_entry_cb) (const rpk_config_entry_s *entry, gpointer user_data);
+
+/**
+ * @brief Validate the configuration in the memory, and pass the entries to the callback in the order of the configuration.
+ * @details Each entry is validated before it is passed. So the entries before an invalid one may be already passed.
+ * @param[in] contents The configuration string.
+ * @param[in] length The length of @a contents.
+ * @param[in] cb The callback for the entries. NULL to validate the configuration only.
+ * @param[in] user_data The data passed to @a cb.
+ * @return 0 on success. -EINVAL if the configuration is invalid, or the error value returned by @a cb.
+ */
+gint rpk_config_scan (const gchar *contents, const gsize length, rpk_config_entry_cb cb, gpointer user_data);
+
+/**
+ * @brief Validate the configuration in the file, and pass the entries to the callback in the order of the configuration.
+ * @details The file is read from the start with pread(), so the offset of @a fd is not changed.
+ * @param[in] fd The file descriptor of the configuration file.
+ * @param[in] cb The callback for the entries. NULL to validate the configuration only.
+ * @param[in] user_data The data passed to @a cb.
+ * @return 0 on success. -EINVAL if the configuration is invalid, -EIO if it fails to read the file, or the error value returned by @a cb.
+ */
+gint rpk_config_scan_fd (const gint fd, rpk_config_entry_cb cb, gpointer user_data);
+
+G_END_DECLS
+#endif /* __RPK_CONFIG_H__ */
@@ -17,6 +17,15 @@
 
 G_BEGIN_DECLS
 
+/**
+ * @brief Data structure for the last access time of the model.
+ */
+typedef struct {
+  gchar *name;
+  guint version;
+  gint64 last_access; /**< The wall-clock time in seconds. */
+} svcdb_model_access_s;
+
 void svcdb_initialize (const gchar *path);
 void svcdb_finalize (void);
 gint svcdb_pipeline_set (const gchar *name, const gchar *description);
@@ -28,10 +37,23 @@ gint svcdb_model_activate (const gchar *name, const guint version);
 gint svcdb_model_get (const gchar *name, const guint version, gchar **model_info);
 gint svcdb_model_get_activated (const gchar *name, gchar **model_info);
 gint svcdb_model_get_all (const gchar *name, gchar **model_info);
+gint svcdb_model_list_activated (gchar **model_info);
+gint svcdb_model_list_blobs (gchar **blobs);
+gint svcdb_model_pin (const gchar *name, const guint version, const gboolean pinned);
+gint svcdb_model_update_access (const svcdb_model_access_s *records, const guint num);
+gint svcdb_model_list_eviction_candidates (gchar **candidates);
+gint svcdb_model_list_paths (gchar **paths);
 gint svcdb_model_delete (const gchar *name, const guint version, const gboolean force);
 gint svcdb_resource_add (const gchar *name, const gchar *path, const gchar *description, const gchar *app_info);
 gint svcdb_resource_get (const gchar *name, gchar **res_info);
 gint svcdb_resource_delete (const gchar *name);
+gint svcdb_resource_list_paths (gchar **paths);
+gint svcdb_install (const gchar *config, const gchar *app_info, gchar **models);
+gint svcdb_upgrade (const gchar *config, const gchar *app_info, gchar **models);
+gint svcdb_install_from_fd (const gint fd, const gchar *app_info, gchar **models);
+gint svcdb_upgrade_from_fd (const gint fd, const gchar *app_info, gchar **models);
+gint svcdb_import (const guint num, const gchar *const *configs, const gchar *const *app_infos, guint *num_models);
+gint svcdb_list_names (const gchar *kind, const gchar *pattern, const gchar *cursor, const guint limit, gchar **list);
 
 G_END_DECLS
 #endif /* __SERVICE_DB_UTIL_H__ */
@@ -10,9 +10,16 @@
  * @bug     No known bugs except for NYI items
  */
 
+#include <errno.h>
+#include <json-glib/json-glib.h>
+#include <vector>
+
 #include "service-db.hh"
 #include "service-db-util.h"
 #include "log.h"
+#include "model-integrity.h"
+#include "model-metadata.h"
+#include "model-store.h"
 
 #define sqlite3_clear_errmsg(m) \
   do {                          \
@@ -30,13 +37,19 @@
 /**
  * @brief The version of model table schema. It should be a positive integer.
  */
-#define TBL_VER_MODEL_INFO (1)
+#define TBL_VER_MODEL_INFO (5)
 
 /**
  * @brief The version of resource table schema. It should be a positive integer.
  */
 #define TBL_VER_RESOURCE_INFO (1)
 
+/**
+ * @brief The default and the maximum number of the names in a page of the list.
+ */
+#define LIST_DEFAULT_LIMIT (100U)
+#define LIST_MAX_LIMIT (1000U)
+
 typedef enum {
   TBL_DB_INFO = 0,
   TBL_PIPELINE_DESCRIPTION = 1,
@@ -49,7 +62,7 @@ typedef enum {
 const char *g_mlsvc_table_schema_v1[] = {
   /* TBL_DB_INFO */ "tblMLDBInfo (name TEXT PRIMARY KEY NOT NULL, version INTEGER DEFAULT 1)",
   /* TBL_PIPELINE_DESCRIPTION */ "tblPipeline (key TEXT PRIMARY KEY NOT NULL, description TEXT, CHECK (length(description) > 0))",
-  /* TBL_MODEL_INFO */ "tblModel (key TEXT NOT NULL, version INTEGER DEFAULT 1, active TEXT DEFAULT 'F', path TEXT, description TEXT, app_info TEXT, PRIMARY KEY (key, version), CHECK (length(path) > 0), CHECK (active IN ('T', 'F')))",
+  /* TBL_MODEL_INFO */ "tblModel (key TEXT NOT NULL, version INTEGER DEFAULT 1, active TEXT DEFAULT 'F', path TEXT, description TEXT, app_info TEXT, hash TEXT, metadata TEXT, pinned TEXT DEFAULT 'F', last_access INTEGER, fingerprint TEXT, PRIMARY KEY (key, version), CHECK (length(path) > 0), CHECK (active IN ('T', 'F')))",
   /* TBL_RESOURCE_INFO */ "tblResource (key TEXT NOT NULL, path TEXT, description TEXT, app_info TEXT, PRIMARY KEY (key, path), CHECK (length(path) > 0))",
   /* Sentinel */ NULL
 };
@@ -61,7 +74,7 @@ const char **g_mlsvc_table_schema = g_mlsvc_table_schema_v1;
  * @param path database path
  */
 MLServiceDB::MLServiceDB (std::string path)
-    : _path (path), _initialized (false), _db (nullptr)
+    : _path (path), _initialized (false), _db (nullptr), _batch (false)
 {
 }
 
@@ -116,8 +129,29 @@ MLServiceDB::initDB ()
   if ((tbl_ver = get_table_version ("tblModel", TBL_VER_MODEL_INFO)) < 0)
     return;
 
-  if (tbl_ver != TBL_VER_MODEL_INFO) {
-    /** @todo update model table if table schema is changed */
+  if (tbl_ver < 2) {
+    /* Version 2 adds the hash of the model file in the model store. */
+    if (!alter_table ("tblModel ADD COLUMN hash TEXT"))
+      return;
+  }
+
+  if (tbl_ver < 3) {
+    /* Version 3 adds the metadata extracted from the model file. */
+    if (!alter_table ("tblModel ADD COLUMN metadata TEXT"))
+      return;
+  }
+
+  if (tbl_ver < 4) {
+    /* Version 4 adds the eviction states of the model. */
+    if (!alter_table ("tblModel ADD COLUMN pinned TEXT DEFAULT 'F'")
+        || !alter_table ("tblModel ADD COLUMN last_access INTEGER"))
+      return;
+  }
+
+  if (tbl_ver < 5) {
+    /* Version 5 adds the fingerprint of the model file taken at the registration. */
+    if (!alter_table ("tblModel ADD COLUMN fingerprint TEXT"))
+      return;
   }
 
   if (!set_table_version ("tblModel", TBL_VER_MODEL_INFO))
@@ -244,6 +278,26 @@ MLServiceDB::create_table (const std::string tbl_name)
   return true;
 }
 
+/**
+ * @brief Alter DB table.
+ */
+bool
+MLServiceDB::alter_table (const std::string tbl_name)
+{
+  int rc;
+  char *errmsg = nullptr;
+  std::string sql = "ALTER TABLE " + tbl_name;
+
+  rc = sqlite3_exec (_db, sql.c_str (), nullptr, nullptr, &errmsg);
+  if (rc != SQLITE_OK) {
+    ml_logw ("Failed to alter table %s: %s (%d)", tbl_name.c_str (), errmsg, rc);
+    sqlite3_clear_errmsg (errmsg);
+    return false;
+  }
+
+  return true;
+}
+
 /**
  * @brief Begin/end transaction.
  */
@@ -253,6 +307,10 @@ MLServiceDB::set_transaction (bool begin)
   int rc;
   char *errmsg = nullptr;
 
+  /* The batch install commits or rolls back all statements at once. */
+  if (_batch)
+    return true;
+
   rc = sqlite3_exec (_db, begin ? "BEGIN TRANSACTION;" : "END TRANSACTION;",
       nullptr, nullptr, &errmsg);
   if (rc != SQLITE_OK)
@@ -431,6 +489,29 @@ MLServiceDB::is_resource_registered (const std::string key)
   return registered;
 }
 
+/**
+ * @brief Remove the blob from the model store if no model refers to it.
+ */
+void
+MLServiceDB::release_model_blob (const std::string hash)
+{
+  sqlite3_stmt *res;
+  bool referenced;
+
+  if (hash.empty ())
+    return;
+
+  referenced = !(sqlite3_prepare_v2 (_db, "SELECT EXISTS(SELECT 1 FROM tblModel WHERE hash = ?1)",
+                     -1, &res, nullptr)
+                     == SQLITE_OK
+                 && sqlite3_bind_text (res, 1, hash.c_str (), -1, nullptr) == SQLITE_OK
+                 && sqlite3_step (res) == SQLITE_ROW && sqlite3_column_int (res, 0) == 0);
+  sqlite3_finalize (res);
+
+  if (!referenced)
+    model_store_remove (hash.c_str ());
+}
+
 /**
  * @brief Set the model with the given name.
  * @param[in] name Unique name for model.
@@ -446,6 +527,10 @@ MLServiceDB::set_model (const std::string name, const std::string model, const b
 {
   guint _version = 0U;
   sqlite3_stmt *res;
+  std::string path = model;
+  std::string hash;
+  std::string metadata;
+  std::string fingerprint;
 
   if (name.empty () || model.empty () || !version)
     throw std::invalid_argument ("Invalid name, model, or version parameter!");
@@ -453,6 +538,52 @@ MLServiceDB::set_model (const std::string name, const std::string model, const b
   std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_model_");
   key_with_prefix += name;
 
+  /* Keep the model file in the model store, the files not accessible from the daemon are registered as it is. */
+  if (model_store_is_enabled ()) {
+    gchar *blob_path = nullptr, *blob_hash = nullptr;
+    int err = model_store_add (model.c_str (), &blob_path, &blob_hash);
+
+    if (err == 0) {
+      path = blob_path;
+      hash = blob_hash;
+      g_free (blob_path);
+      g_free (blob_hash);
+    } else if (err != -ENOENT && err != -EACCES) {
+      throw std::runtime_error ("Failed to add the model " + name + " to the model store.");
+    }
+  } else {
+    gchar *file_hash = nullptr;
+    g_autofree gchar *file_fp = model_integrity_get_fingerprint (model.c_str ());
+
+    /* Keep the hash to verify the model file when it is served. */
+    if (model_store_hash_file (model.c_str (), &file_hash) == 0) {
+      hash = file_hash;
+      g_free (file_hash);
+
+      if (file_fp)
+        fingerprint = file_fp;
+    }
+  }
+
+  /* The file is hashed here, the first verification does not hash it again. */
+  if (!hash.empty ()) {
+    if (fingerprint.empty ()) {
+      g_autofree gchar *blob_fp = model_integrity_get_fingerprint (path.c_str ());
+
+      if (blob_fp)
+        fingerprint = blob_fp;
+    }
+
+    model_integrity_seed (path.c_str (), hash.c_str (), fingerprint.empty () ? nullptr : fingerprint.c_str ());
+  }
+
+  /* Parse the model once here, the clients get the tensor information without opening the file. */
+  gchar *model_metadata = nullptr;
+  if (model_metadata_extract (path.c_str (), &model_metadata) == 0) {
+    metadata = model_metadata;
+    g_free (model_metadata);
+  }
+
   if (!set_transaction (true))
     throw std::runtime_error ("Failed to begin transaction.");
 
@@ -470,17 +601,27 @@ MLServiceDB::set_model (const std::string name, const std::string model, const b
   }
 
   /* insert new row */
-  if (sqlite3_prepare_v2 (_db, "INSERT OR REPLACE INTO tblModel VALUES (?1, IFNULL ((SELECT version from tblModel WHERE key = ?2 ORDER BY version DESC LIMIT 1) + 1, 1), ?3, ?4, ?5, ?6)",
+  if (sqlite3_prepare_v2 (_db, "INSERT OR REPLACE INTO tblModel (key, version, active, path, description, app_info, hash, metadata, fingerprint) VALUES (?1, IFNULL ((SELECT version from tblModel WHERE key = ?2 ORDER BY version DESC LIMIT 1) + 1, 1), ?3, ?4, ?5, ?6, ?7, ?8, ?9)",
           -1, &res, nullptr)
           != SQLITE_OK
       || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
       || sqlite3_bind_text (res, 2, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
       || sqlite3_bind_text (res, 3, is_active ? "T" : "F", -1, nullptr) != SQLITE_OK
-      || sqlite3_bind_text (res, 4, model.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 4, path.c_str (), -1, nullptr) != SQLITE_OK
       || sqlite3_bind_text (res, 5, description.c_str (), -1, nullptr) != SQLITE_OK
       || sqlite3_bind_text (res, 6, app_info.c_str (), -1, nullptr) != SQLITE_OK
+      || (hash.empty () ? sqlite3_bind_null (res, 7) :
+                          sqlite3_bind_text (res, 7, hash.c_str (), -1, nullptr))
+             != SQLITE_OK
+      || (metadata.empty () ? sqlite3_bind_null (res, 8) :
+                              sqlite3_bind_text (res, 8, metadata.c_str (), -1, nullptr))
+             != SQLITE_OK
+      || ((hash.empty () || fingerprint.empty ()) ? sqlite3_bind_null (res, 9) :
+                              sqlite3_bind_text (res, 9, fingerprint.c_str (), -1, nullptr))
+             != SQLITE_OK
       || sqlite3_step (res) != SQLITE_DONE) {
     sqlite3_finalize (res);
+    release_model_blob (hash);
     throw std::runtime_error ("Failed to register the model " + name);
   }
 
@@ -505,6 +646,9 @@ MLServiceDB::set_model (const std::string name, const std::string model, const b
   if (!set_transaction (false))
     throw std::runtime_error ("Failed to end transaction.");
 
+  if (_batch && !hash.empty ())
+    _batch_hashes.push_back (hash);
+
   if (_version == 0) {
     ml_loge ("Failed to get model version with name %s: %s", name.c_str (),
         sqlite3_errmsg (_db));
@@ -626,7 +770,7 @@ void
 MLServiceDB::get_model (const std::string name, const gint version, gchar **model)
 {
   const char model_info_json[]
-      = "json_object('version', CAST(version AS TEXT), 'active', active, 'path', path, 'description', description, 'app_info', app_info)";
+      = "json_object('version', CAST(version AS TEXT), 'active', active, 'path', path, 'description', description, 'app_info', app_info, 'hash', IFNULL(hash, ''), 'metadata', json(IFNULL(metadata, '{}')), 'pinned', IFNULL(pinned, 'F'), 'fingerprint', IFNULL(fingerprint, ''))";
   char *sql;
   char *value = nullptr;
   sqlite3_stmt *res;
@@ -671,6 +815,187 @@ MLServiceDB::get_model (const std::string name, const gint version, gchar **mode
   }
 }
 
+/**
+ * @brief Get the activated models of all names.
+ * @param[out] models The JSON array of the activated models.
+ */
+void
+MLServiceDB::get_activated_models (gchar **models)
+{
+  char *value = nullptr;
+  sqlite3_stmt *res;
+
+  if (!models)
+    throw std::invalid_argument ("Invalid models parameter!");
+
+  std::string key_prefix = DB_KEY_PREFIX + std::string ("_model_");
+
+  if (sqlite3_prepare_v2 (_db, "SELECT json_group_array(json_object('name', substr(key, ?1), 'version', CAST(version AS TEXT), 'path', path, 'hash', ifnull(hash, ''))) FROM tblModel WHERE active = 'T' AND key LIKE ?2 || '%'",
+          -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_bind_int (res, 1, (int) key_prefix.length () + 1) == SQLITE_OK
+      && sqlite3_bind_text (res, 2, key_prefix.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW)
+    value = g_strdup_printf ("%s", sqlite3_column_text (res, 0));
+
+  sqlite3_finalize (res);
+
+  if (!value)
+    throw std::runtime_error ("Failed to get the activated models.");
+
+  *models = value;
+}
+
+/**
+ * @brief Get the blobs of the model store referred by the models.
+ * @param[out] blobs The JSON array of the hashes and whether any model referring to the blob is activated.
+ */
+void
+MLServiceDB::get_model_blobs (gchar **blobs)
+{
+  char *value = nullptr;
+  sqlite3_stmt *res;
+
+  if (!blobs)
+    throw std::invalid_argument ("Invalid blobs parameter!");
+
+  /* The blob is shared by the models of all names, it is active if any of them is active. */
+  if (sqlite3_prepare_v2 (_db, "SELECT json_group_array(json_object('hash', hash, 'active', active)) FROM (SELECT hash, MAX(active) AS active FROM tblModel WHERE hash IS NOT NULL AND hash != '' GROUP BY hash)",
+          -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW)
+    value = g_strdup_printf ("%s", sqlite3_column_text (res, 0));
+
+  sqlite3_finalize (res);
+
+  if (!value)
+    throw std::runtime_error ("Failed to get the blobs of the models.");
+
+  *blobs = value;
+}
+
+/**
+ * @brief Pin the model not to be evicted from the model store.
+ * @param[in] name The unique name of the model.
+ * @param[in] version The version of the model.
+ * @param[in] pinned Pin or unpin the model.
+ */
+void
+MLServiceDB::pin_model (const std::string name, const guint version, const bool pinned)
+{
+  sqlite3_stmt *res;
+
+  if (name.empty () || version == 0U)
+    throw std::invalid_argument ("Invalid name or version parameter!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_model_");
+  key_with_prefix += name;
+
+  if (!is_model_registered (key_with_prefix, version)) {
+    throw std::invalid_argument ("There is no model with name " + name
+                                 + " and version " + std::to_string (version));
+  }
+
+  if (sqlite3_prepare_v2 (_db, "UPDATE tblModel SET pinned = ?3 WHERE key = ?1 AND version = ?2",
+          -1, &res, nullptr)
+          != SQLITE_OK
+      || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_int (res, 2, version) != SQLITE_OK
+      || sqlite3_bind_text (res, 3, pinned ? "T" : "F", -1, nullptr) != SQLITE_OK
+      || sqlite3_step (res) != SQLITE_DONE) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to pin the model with name " + name
+                              + " and version " + std::to_string (version));
+  }
+
+  sqlite3_finalize (res);
+}
+
+/**
+ * @brief Update the last access time of the models in a transaction.
+ * @param[in] records The access records of the models.
+ * @param[in] num The number of the records.
+ */
+void
+MLServiceDB::update_model_access (const svcdb_model_access_s *records, const guint num)
+{
+  sqlite3_stmt *res;
+  guint i;
+
+  if (!records && num > 0U)
+    throw std::invalid_argument ("Invalid records parameter!");
+
+  if (num == 0U)
+    return;
+
+  std::string key_prefix = DB_KEY_PREFIX + std::string ("_model_");
+
+  if (!set_transaction (true))
+    throw std::runtime_error ("Failed to begin transaction.");
+
+  if (sqlite3_prepare_v2 (_db, "UPDATE tblModel SET last_access = MAX(IFNULL(last_access, 0), ?3) WHERE key = ?1 AND version = ?2",
+          -1, &res, nullptr)
+      != SQLITE_OK) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to prepare the update of the last access time.");
+  }
+
+  /* The model may be deleted since it is accessed, then no row is updated. */
+  for (i = 0; i < num; i++) {
+    std::string key_with_prefix = key_prefix + records[i].name;
+
+    if (sqlite3_reset (res) != SQLITE_OK
+        || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, SQLITE_TRANSIENT) != SQLITE_OK
+        || sqlite3_bind_int (res, 2, records[i].version) != SQLITE_OK
+        || sqlite3_bind_int64 (res, 3, records[i].last_access) != SQLITE_OK
+        || sqlite3_step (res) != SQLITE_DONE) {
+      sqlite3_finalize (res);
+      throw std::runtime_error ("Failed to update the last access time of the model " + std::string (records[i].name));
+    }
+  }
+
+  sqlite3_finalize (res);
+
+  if (!set_transaction (false))
+    throw std::runtime_error ("Failed to end transaction.");
+}
+
+/**
+ * @brief Get the models which can be evicted from the model store, the least recently accessed first.
+ * @param[out] candidates The JSON array of the inactive and unpinned models with the reference counts of their blobs.
+ */
+void
+MLServiceDB::get_eviction_candidates (gchar **candidates)
+{
+  char *value = nullptr;
+  sqlite3_stmt *res;
+
+  if (!candidates)
+    throw std::invalid_argument ("Invalid candidates parameter!");
+
+  std::string key_prefix = DB_KEY_PREFIX + std::string ("_model_");
+
+  /* 'refs' counts all models sharing the blob, and 'kept' counts the ones never evicted. */
+  if (sqlite3_prepare_v2 (_db, "SELECT json_group_array(json_object('name', substr(m.key, ?1), 'version', m.version, 'hash', m.hash, "
+                               "'refs', (SELECT COUNT(*) FROM tblModel r WHERE r.hash = m.hash), "
+                               "'kept', (SELECT COUNT(*) FROM tblModel r WHERE r.hash = m.hash AND (r.active = 'T' OR r.pinned = 'T')))) "
+                               "FROM (SELECT key, version, hash FROM tblModel WHERE active = 'F' AND IFNULL(pinned, 'F') = 'F' AND hash IS NOT NULL AND hash != '' "
+                               "AND key LIKE ?2 || '%' ORDER BY IFNULL(last_access, 0), rowid) m",
+          -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_bind_int (res, 1, (int) key_prefix.length () + 1) == SQLITE_OK
+      && sqlite3_bind_text (res, 2, key_prefix.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW)
+    value = g_strdup_printf ("%s", sqlite3_column_text (res, 0));
+
+  sqlite3_finalize (res);
+
+  if (!value)
+    throw std::runtime_error ("Failed to get the models to evict.");
+
+  *candidates = value;
+}
+
 /**
  * @brief Delete the model.
  * @param[in] name The unique name to delete.
@@ -682,6 +1007,7 @@ MLServiceDB::delete_model (const std::string name, const guint version, const gb
 {
   char *sql;
   sqlite3_stmt *res;
+  std::vector<std::string> hashes;
 
   if (name.empty ())
     throw std::invalid_argument ("Invalid name parameters!");
@@ -709,6 +1035,17 @@ MLServiceDB::delete_model (const std::string name, const guint version, const gb
     sql = g_strdup ("DELETE FROM tblModel WHERE key = ?1");
   }
 
+  /* the blobs in the model store to be released */
+  if (sqlite3_prepare_v2 (_db, "SELECT DISTINCT hash FROM tblModel WHERE key = ?1 AND hash IS NOT NULL AND (?2 = 0 OR version = ?2)",
+          -1, &res, nullptr)
+          == SQLITE_OK
+      && sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_bind_int (res, 2, version) == SQLITE_OK) {
+    while (sqlite3_step (res) == SQLITE_ROW)
+      hashes.push_back ((const char *) sqlite3_column_text (res, 0));
+  }
+  sqlite3_finalize (res);
+
   if (sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr) != SQLITE_OK
       || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
       || sqlite3_step (res) != SQLITE_DONE) {
@@ -725,6 +1062,9 @@ MLServiceDB::delete_model (const std::string name, const guint version, const gb
     throw std::invalid_argument ("There is no model with the given name " + name
                                  + " and version " + std::to_string (version));
   }
+
+  for (const std::string &hash : hashes)
+    release_model_blob (hash);
 }
 
 /**
@@ -816,87 +1156,626 @@ MLServiceDB::get_resource (const std::string name, gchar **resource)
 }
 
 /**
- * @brief Delete the resource.
- * @param[in] name The unique name to delete.
+ * @brief Get the distinct paths of the registered files in the table.
+ * @param[in] table The table of the registered files, tblModel or tblResource.
+ * @param[in] type The type of the key prefix, "_model_" or "_resource_".
+ * @param[out] paths The JSON array of the paths.
  */
 void
-MLServiceDB::delete_resource (const std::string name)
+MLServiceDB::get_registered_paths (const std::string table, const std::string type, gchar **paths)
 {
   char *sql;
+  char *value = nullptr;
   sqlite3_stmt *res;
 
-  if (name.empty ())
-    throw std::invalid_argument ("Invalid name parameters!");
-
-  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_resource_");
-  key_with_prefix += name;
+  if (!paths)
+    throw std::invalid_argument ("Invalid paths parameter!");
 
-  /* existence check */
-  if (!is_resource_registered (key_with_prefix))
-    throw std::invalid_argument ("There is no resource with name " + name);
+  std::string key_prefix = DB_KEY_PREFIX + type;
 
-  sql = g_strdup ("DELETE FROM tblResource WHERE key = ?1");
+  sql = g_strdup_printf ("SELECT json_group_array(DISTINCT path) FROM %s WHERE key LIKE ?1 || '%%' AND path IS NOT NULL",
+      table.c_str ());
 
-  if (sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr) != SQLITE_OK
-      || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
-      || sqlite3_step (res) != SQLITE_DONE) {
-    sqlite3_finalize (res);
-    g_free (sql);
-    throw std::runtime_error ("Failed to delete resource with name " + name);
-  }
+  if (sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr) == SQLITE_OK
+      && sqlite3_bind_text (res, 1, key_prefix.c_str (), -1, nullptr) == SQLITE_OK
+      && sqlite3_step (res) == SQLITE_ROW)
+    value = g_strdup_printf ("%s", sqlite3_column_text (res, 0));
 
   sqlite3_finalize (res);
   g_free (sql);
 
-  if (sqlite3_changes (_db) == 0)
-    throw std::invalid_argument ("There is no resource with name " + name);
-}
+  if (!value)
+    throw std::runtime_error ("Failed to get the paths in " + table);
 
-static MLServiceDB *g_svcdb_instance = nullptr;
+  *paths = value;
+}
 
 /**
- * @brief Get the service-db instance.
+ * @brief Get the distinct paths of the registered model files.
+ * @param[out] paths The JSON array of the paths.
  */
-static MLServiceDB *
-svcdb_get (void)
+void
+MLServiceDB::get_model_paths (gchar **paths)
 {
-  g_assert (g_svcdb_instance);
-  return g_svcdb_instance;
+  get_registered_paths ("tblModel", "_model_", paths);
 }
 
-G_BEGIN_DECLS
 /**
- * @brief Initialize the service-db.
+ * @brief Get the distinct paths of the registered resource files.
+ * @param[out] paths The JSON array of the paths.
  */
 void
-svcdb_initialize (const gchar *path)
+MLServiceDB::get_resource_paths (gchar **paths)
 {
-  if (g_svcdb_instance) {
-    ml_logw ("ML service DB is already opened, close old DB.");
-    delete g_svcdb_instance;
-  }
-
-  g_svcdb_instance = new MLServiceDB (path);
-  g_assert (g_svcdb_instance);
-  g_svcdb_instance->connectDB ();
+  get_registered_paths ("tblResource", "_resource_", paths);
 }
 
 /**
- * @brief Close the service-db.
+ * @brief List the registered names in the order of the name, a page at a time.
+ * @param[in] kind The kind of the names, "model", "resource" or "pipeline".
+ * @param[in] pattern The GLOB pattern of the names. Empty string matches all names.
+ * @param[in] cursor The cursor returned with the previous page. Empty string for the first page.
+ * @param[in] limit The maximum number of the names in the page. 0 for the default.
+ * @param[out] list The JSON object with the array of the names, and the cursor of the next page. The cursor is empty at the last page.
  */
 void
-svcdb_finalize (void)
+MLServiceDB::list_names (const std::string kind, const std::string pattern,
+    const std::string cursor, const guint limit, gchar **list)
 {
-  if (g_svcdb_instance) {
-    g_svcdb_instance->disconnectDB ();
-    delete g_svcdb_instance;
+  char *sql;
+  sqlite3_stmt *res;
+  std::string table;
+  std::vector<std::string> names;
+  guint page = (limit == 0U) ? LIST_DEFAULT_LIMIT : MIN (limit, LIST_MAX_LIMIT);
+  int rc;
+
+  if (kind == "model")
+    table = "tblModel";
+  else if (kind == "resource")
+    table = "tblResource";
+  else if (kind == "pipeline")
+    table = "tblPipeline";
+  else
+    throw std::invalid_argument ("Invalid kind parameter!");
+
+  if (!list)
+    throw std::invalid_argument ("Invalid list parameter!");
+
+  std::string key_prefix = DB_KEY_PREFIX + std::string ("_") + kind + "_";
+  std::string glob = pattern.empty () ? std::string ("*") : pattern;
+
+  /* The literal head of the pattern bounds the range scan of the key index, and GLOB filters the rest. */
+  std::string lower = key_prefix + glob.substr (0, glob.find_first_of ("*?["));
+  std::string upper = lower;
+
+  while ((unsigned char) upper.back () == 0xFFU)
+    upper.pop_back ();
+  upper.back () = (char) ((unsigned char) upper.back () + 1U);
+
+  /* The cursor is the last name of the previous page, the next page starts after it. */
+  std::string after = cursor.empty () ? std::string () : key_prefix + cursor;
+
+  sql = g_strdup_printf ("SELECT DISTINCT key FROM %s WHERE key >= ?1 AND key < ?2 AND key > ?3 AND substr(key, ?4) GLOB ?5 ORDER BY key LIMIT ?6",
+      table.c_str ());
+
+  rc = sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr);
+  g_free (sql);
+
+  if (rc != SQLITE_OK
+      || sqlite3_bind_text (res, 1, lower.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 2, upper.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 3, after.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_int (res, 4, (int) key_prefix.length () + 1) != SQLITE_OK
+      || sqlite3_bind_text (res, 5, glob.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_int (res, 6, (int) page + 1) != SQLITE_OK) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to list the names in " + table);
   }
 
-  g_svcdb_instance = nullptr;
+  /* One more name than the page tells whether the next page exists. */
+  while ((rc = sqlite3_step (res)) == SQLITE_ROW)
+    names.push_back ((const char *) sqlite3_column_text (res, 0) + key_prefix.length ());
+
+  sqlite3_finalize (res);
+
+  if (rc != SQLITE_DONE)
+    throw std::runtime_error ("Failed to list the names in " + table);
+
+  g_autoptr (JsonGenerator) gen = json_generator_new ();
+  JsonObject *object = json_object_new ();
+  JsonArray *array = json_array_new ();
+  JsonNode *root;
+  guint i;
+
+  for (i = 0; i < names.size () && i < page; i++)
+    json_array_add_string_element (array, names[i].c_str ());
+
+  json_object_set_array_member (object, "names", array);
+  json_object_set_string_member (object, "cursor", names.size () > page ? names[page - 1].c_str () : "");
+
+  root = json_node_init_object (json_node_alloc (), object);
+  json_generator_set_root (gen, root);
+  *list = json_generator_to_data (gen, NULL);
+
+  json_node_unref (root);
+  json_object_unref (object);
 }
 
 /**
- * @brief Set the pipeline description with given name.
+ * @brief Roll back the transaction of the batch install.
+ * @note Nothing of the batch is left, and the blobs referred to only by the batch are removed.
+ */
+void
+MLServiceDB::rollback_batch ()
+{
+  _batch = false;
+  sqlite3_exec (_db, "ROLLBACK TRANSACTION;", nullptr, nullptr, nullptr);
+
+  for (const std::string &hash : _batch_hashes)
+    release_model_blob (hash);
+  _batch_hashes.clear ();
+  _batch_deleted.clear ();
+}
+
+/**
+ * @brief Begin the batch. The following installs are committed or rolled back at once with end_batch().
+ */
+void
+MLServiceDB::begin_batch ()
+{
+  if (_batch)
+    throw std::runtime_error ("The batch is already in progress.");
+
+  if (!set_transaction (true))
+    throw std::runtime_error ("Failed to begin transaction.");
+
+  _batch = true;
+  _batch_hashes.clear ();
+  _batch_deleted.clear ();
+}
+
+/**
+ * @brief End the batch.
+ * @param[in] commit Commit the batch. If it is false or the commit fails, the batch is rolled back.
+ */
+void
+MLServiceDB::end_batch (const bool commit)
+{
+  if (!_batch)
+    return;
+
+  if (!commit) {
+    rollback_batch ();
+    return;
+  }
+
+  _batch = false;
+
+  if (!set_transaction (false)) {
+    rollback_batch ();
+    throw std::runtime_error ("Failed to end transaction.");
+  }
+
+  /* The blobs of the deleted models are released after the commit, so the rollback keeps them. */
+  for (const std::string &hash : _batch_deleted)
+    release_model_blob (hash);
+
+  _batch_hashes.clear ();
+  _batch_deleted.clear ();
+}
+
+/**
+ * @brief Internal function to get the string member of the entry in the configuration.
+ */
+static const gchar *
+_get_config_string (JsonObject *object, const gchar *member)
+{
+  JsonNode *node = json_object_get_member (object, member);
+
+  if (!node || !JSON_NODE_HOLDS_VALUE (node) || json_node_get_value_type (node) != G_TYPE_STRING)
+    return nullptr;
+
+  return json_node_get_string (node);
+}
+
+/**
+ * @brief Internal function to get the package id in the application information.
+ */
+static std::string
+_get_package_id (const std::string app_info)
+{
+  g_autoptr (JsonParser) parser = json_parser_new ();
+  JsonNode *root;
+  const gchar *pkg_id = nullptr;
+
+  if (!app_info.empty () && json_parser_load_from_data (parser, app_info.c_str (), -1, nullptr)
+      && (root = json_parser_get_root (parser)) && JSON_NODE_HOLDS_OBJECT (root))
+    pkg_id = _get_config_string (json_node_get_object (root), "pkg_id");
+
+  return pkg_id ? pkg_id : "";
+}
+
+/**
+ * @brief Get the rows of the models or resources registered by the package.
+ * @param[in] table The table of the rows, tblModel or tblResource.
+ * @param[in] pkg_id The package id in the application information of the rows.
+ * @param[out] rows The registered rows.
+ */
+void
+MLServiceDB::get_package_rows (const std::string table, const std::string pkg_id,
+    std::vector<package_row_s> &rows)
+{
+  sqlite3_stmt *res;
+  bool is_model = (table == "tblModel");
+  g_autofree gchar *sql = g_strdup_printf (
+      "SELECT rowid, key, path, %s, IFNULL(description, ''), %s FROM %s WHERE "
+      "CASE WHEN json_valid(app_info) THEN json_extract(app_info, '$.pkg_id') END = ?1",
+      is_model ? "IFNULL(hash, '')" : "''", is_model ? "version, active" : "0, 'F'",
+      table.c_str ());
+
+  if (sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 1, pkg_id.c_str (), -1, nullptr) != SQLITE_OK) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to get the rows of the package " + pkg_id);
+  }
+
+  while (sqlite3_step (res) == SQLITE_ROW) {
+    package_row_s row;
+
+    row.rowid = sqlite3_column_int64 (res, 0);
+    row.key = (const char *) sqlite3_column_text (res, 1);
+    row.path = (const char *) sqlite3_column_text (res, 2);
+    row.hash = (const char *) sqlite3_column_text (res, 3);
+    row.description = (const char *) sqlite3_column_text (res, 4);
+    row.version = (guint) sqlite3_column_int (res, 5);
+    row.active = g_str_equal ((const char *) sqlite3_column_text (res, 6), "T");
+    row.kept = false;
+
+    rows.push_back (row);
+  }
+
+  sqlite3_finalize (res);
+}
+
+/**
+ * @brief Keep the row registered by the package, and update its description and application information.
+ * @param[in] table The table of the row, tblModel or tblResource.
+ * @param[in,out] row The row to be kept.
+ * @param[in] description The description in the new configuration.
+ * @param[in] app_info The application information of the new package.
+ */
+void
+MLServiceDB::keep_package_row (const std::string table, package_row_s &row,
+    const std::string description, const std::string app_info)
+{
+  sqlite3_stmt *res;
+  g_autofree gchar *sql = g_strdup_printf (
+      "UPDATE %s SET description = ?1, app_info = ?2 WHERE rowid = ?3", table.c_str ());
+
+  row.kept = true;
+
+  if (sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 1, description.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 2, app_info.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_bind_int64 (res, 3, row.rowid) != SQLITE_OK
+      || sqlite3_step (res) != SQLITE_DONE) {
+    sqlite3_finalize (res);
+    throw std::runtime_error ("Failed to update the row of " + row.key);
+  }
+
+  sqlite3_finalize (res);
+}
+
+/**
+ * @brief Delete the rows registered by the package which are not kept by the new configuration.
+ * @param[in] table The table of the rows, tblModel or tblResource.
+ * @param[in] rows The registered rows.
+ * @param[out] hashes The blobs of the deleted models, to be released after the transaction.
+ */
+void
+MLServiceDB::delete_package_rows (const std::string table,
+    const std::vector<package_row_s> &rows, std::vector<std::string> &hashes)
+{
+  sqlite3_stmt *res;
+  g_autofree gchar *sql = g_strdup_printf ("DELETE FROM %s WHERE rowid = ?1", table.c_str ());
+
+  for (const package_row_s &row : rows) {
+    if (row.kept)
+      continue;
+
+    if (sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr) != SQLITE_OK
+        || sqlite3_bind_int64 (res, 1, row.rowid) != SQLITE_OK
+        || sqlite3_step (res) != SQLITE_DONE) {
+      sqlite3_finalize (res);
+      throw std::runtime_error ("Failed to delete the row of " + row.key);
+    }
+
+    sqlite3_finalize (res);
+
+    if (!row.hash.empty ())
+      hashes.push_back (row.hash);
+  }
+}
+
+/**
+ * @brief Install the entry read from the configuration.
+ * @details It is called for each entry while the configuration is being read, so the configuration is not kept.
+ *          The exception is kept in the context and thrown again after the scan is stopped.
+ */
+gint
+MLServiceDB::install_entry (const rpk_config_entry_s *entry, gpointer user_data)
+{
+  install_context_s *ctx = (install_context_s *) user_data;
+  MLServiceDB *db = ctx->db;
+  const std::string &app_info = *ctx->app_info;
+  const gchar *desc = entry->description ? entry->description : "";
+
+  try {
+    switch (entry->type) {
+      case RPK_CONFIG_MODEL:
+        {
+          bool active = (entry->activate && g_ascii_strcasecmp (entry->activate, "true") == 0);
+          std::string key = DB_KEY_PREFIX + std::string ("_model_") + entry->name;
+          package_row_s *kept = nullptr;
+          guint version = 0U;
+
+          if (!ctx->model_rows.empty ()) {
+            g_autofree gchar *hash = nullptr;
+
+            /* The file not accessible from the daemon is compared with the registered path. */
+            model_store_hash_file (entry->model, &hash);
+
+            for (package_row_s &row : ctx->model_rows) {
+              if (!row.kept && row.key == key
+                  && (hash ? row.hash == hash : (row.hash.empty () && row.path == entry->model))) {
+                kept = &row;
+                break;
+              }
+            }
+          }
+
+          if (kept) {
+            db->keep_package_row ("tblModel", *kept, desc, app_info);
+
+            if (active && !kept->active)
+              db->activate_model (entry->name, kept->version);
+
+            version = kept->version;
+            active = active || kept->active;
+          } else {
+            db->set_model (entry->name, entry->model, active, desc, app_info, &version);
+          }
+
+          JsonObject *result = json_object_new ();
+          json_object_set_string_member (result, "name", entry->name);
+          json_object_set_int_member (result, "version", version);
+          json_object_set_boolean_member (result, "active", active);
+          json_array_add_object_element (ctx->installed, result);
+        }
+        break;
+      case RPK_CONFIG_PIPELINE:
+        db->set_pipeline (entry->name, entry->pipeline);
+        break;
+      case RPK_CONFIG_RESOURCE:
+        {
+          std::string key = DB_KEY_PREFIX + std::string ("_resource_") + entry->name;
+          package_row_s *kept = nullptr;
+
+          for (package_row_s &row : ctx->resource_rows) {
+            if (!row.kept && row.key == key && row.path == entry->path) {
+              kept = &row;
+              break;
+            }
+          }
+
+          if (kept)
+            db->keep_package_row ("tblResource", *kept, desc, app_info);
+          else
+            db->set_resource (entry->name, entry->path, desc, app_info);
+        }
+        break;
+      default:
+        throw std::invalid_argument ("Unsupported entry in the config.");
+    }
+  } catch (...) {
+    ctx->error = std::current_exception ();
+    return -ECANCELED;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Install the models, pipelines and resources in the configuration in a transaction.
+ * @details The entries are installed as they are read from the configuration, and the configuration is not loaded at once.
+ *          If any entry is invalid, the transaction is rolled back.
+ * @param[in] config The configuration in the memory. It is ignored if @a fd is given.
+ * @param[in] length The length of @a config.
+ * @param[in] fd The file descriptor of the configuration file, or -1 to read @a config.
+ * @param[in] app_info The application information of the models and resources.
+ * @param[in] upgrade Apply the difference from the models and resources registered by the package in @a app_info.
+ * @param[out] models The JSON array of the names, versions and active states of the models in the configuration.
+ */
+void
+MLServiceDB::install_config (const gchar *config, const gsize length, const gint fd,
+    const std::string &app_info, const bool upgrade, gchar **models)
+{
+  g_autoptr (JsonGenerator) gen = nullptr;
+  install_context_s ctx;
+  std::string pkg_id;
+  bool nested = _batch;
+  JsonNode *root;
+  gint ret;
+
+  if (!models)
+    throw std::invalid_argument ("Invalid models parameter!");
+
+  if (upgrade && (pkg_id = _get_package_id (app_info)).empty ())
+    throw std::invalid_argument ("Invalid app_info parameter, no package id to upgrade!");
+
+  /* In the batch of the caller, it is committed or rolled back with the other installs. */
+  if (!nested)
+    begin_batch ();
+
+  ctx.db = this;
+  ctx.app_info = &app_info;
+  ctx.installed = json_array_new ();
+
+  try {
+    if (upgrade) {
+      get_package_rows ("tblModel", pkg_id, ctx.model_rows);
+      get_package_rows ("tblResource", pkg_id, ctx.resource_rows);
+    }
+
+    ret = (fd >= 0) ? rpk_config_scan_fd (fd, install_entry, &ctx) :
+                      rpk_config_scan (config, length, install_entry, &ctx);
+
+    if (ctx.error)
+      std::rethrow_exception (ctx.error);
+
+    if (ret == -EINVAL)
+      throw std::invalid_argument ("Invalid config parameter!");
+    else if (ret != 0)
+      throw std::runtime_error ("Failed to read the config.");
+
+    /* The models and resources removed from the package. */
+    delete_package_rows ("tblModel", ctx.model_rows, _batch_deleted);
+    delete_package_rows ("tblResource", ctx.resource_rows, _batch_deleted);
+
+    if (!nested)
+      end_batch (true);
+  } catch (...) {
+    if (!nested)
+      end_batch (false);
+    json_array_unref (ctx.installed);
+    throw;
+  }
+
+  root = json_node_init_array (json_node_alloc (), ctx.installed);
+  gen = json_generator_new ();
+  json_generator_set_root (gen, root);
+  *models = json_generator_to_data (gen, nullptr);
+
+  json_node_unref (root);
+  json_array_unref (ctx.installed);
+}
+
+/**
+ * @brief Install the models, pipelines and resources in the configuration in a transaction.
+ * @details In the upgrade, the models and resources registered by the same package are compared with the configuration.
+ *          The unchanged ones keep their versions and active states, and the ones not in the configuration are deleted.
+ * @param[in] config The JSON string of the configuration, in the format of rpk_config.json of the RPK package.
+ * @param[in] app_info The application information of the models and resources.
+ * @param[in] upgrade Apply the difference from the models and resources registered by the package in @a app_info.
+ * @param[out] models The JSON array of the names, versions and active states of the models in the configuration.
+ */
+void
+MLServiceDB::install (const std::string &config, const std::string &app_info,
+    const bool upgrade, gchar **models)
+{
+  install_config (config.c_str (), config.length (), -1, app_info, upgrade, models);
+}
+
+/**
+ * @brief Install the models, pipelines and resources in the configuration file in a transaction.
+ * @details The file is read in the chunks, so the memory does not grow with the size of the configuration.
+ * @param[in] fd The file descriptor of the configuration file, in the format of rpk_config.json of the RPK package.
+ * @param[in] app_info The application information of the models and resources.
+ * @param[in] upgrade Apply the difference from the models and resources registered by the package in @a app_info.
+ * @param[out] models The JSON array of the names, versions and active states of the models in the configuration.
+ */
+void
+MLServiceDB::install_from_fd (const gint fd, const std::string &app_info,
+    const bool upgrade, gchar **models)
+{
+  if (fd < 0)
+    throw std::invalid_argument ("Invalid fd parameter!");
+
+  install_config (nullptr, 0U, fd, app_info, upgrade, models);
+}
+
+/**
+ * @brief Delete the resource.
+ * @param[in] name The unique name to delete.
+ */
+void
+MLServiceDB::delete_resource (const std::string name)
+{
+  char *sql;
+  sqlite3_stmt *res;
+
+  if (name.empty ())
+    throw std::invalid_argument ("Invalid name parameters!");
+
+  std::string key_with_prefix = DB_KEY_PREFIX + std::string ("_resource_");
+  key_with_prefix += name;
+
+  /* existence check */
+  if (!is_resource_registered (key_with_prefix))
+    throw std::invalid_argument ("There is no resource with name " + name);
+
+  sql = g_strdup ("DELETE FROM tblResource WHERE key = ?1");
+
+  if (sqlite3_prepare_v2 (_db, sql, -1, &res, nullptr) != SQLITE_OK
+      || sqlite3_bind_text (res, 1, key_with_prefix.c_str (), -1, nullptr) != SQLITE_OK
+      || sqlite3_step (res) != SQLITE_DONE) {
+    sqlite3_finalize (res);
+    g_free (sql);
+    throw std::runtime_error ("Failed to delete resource with name " + name);
+  }
+
+  sqlite3_finalize (res);
+  g_free (sql);
+
+  if (sqlite3_changes (_db) == 0)
+    throw std::invalid_argument ("There is no resource with name " + name);
+}
+
+static MLServiceDB *g_svcdb_instance = nullptr;
+
+/**
+ * @brief Get the service-db instance.
+ */
+static MLServiceDB *
+svcdb_get (void)
+{
+  g_assert (g_svcdb_instance);
+  return g_svcdb_instance;
+}
+
+G_BEGIN_DECLS
+/**
+ * @brief Initialize the service-db.
+ */
+void
+svcdb_initialize (const gchar *path)
+{
+  if (g_svcdb_instance) {
+    ml_logw ("ML service DB is already opened, close old DB.");
+    delete g_svcdb_instance;
+  }
+
+  g_svcdb_instance = new MLServiceDB (path);
+  g_assert (g_svcdb_instance);
+  g_svcdb_instance->connectDB ();
+}
+
+/**
+ * @brief Close the service-db.
+ */
+void
+svcdb_finalize (void)
+{
+  if (g_svcdb_instance) {
+    g_svcdb_instance->disconnectDB ();
+    delete g_svcdb_instance;
+  }
+
+  g_svcdb_instance = nullptr;
+}
+
+/**
+ * @brief Set the pipeline description with given name.
  * @note If the name already exists, the pipeline description is overwritten.
  * @param[in] name Unique name to set the associated pipeline description.
  * @param[in] description The pipeline description to be stored.
@@ -1128,6 +2007,129 @@ svcdb_model_get_all (const gchar *name, gchar **model_info)
   return ret;
 }
 
+/**
+ * @brief Get the activated models of all names.
+ * @param[out] model_info The JSON array of the activated models.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_model_list_activated (gchar **model_info)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_activated_models (model_info);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the blobs of the model store referred by the models.
+ * @param[out] blobs The JSON array of the blobs.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_model_list_blobs (gchar **blobs)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_model_blobs (blobs);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Pin the model not to be evicted from the model store.
+ * @param[in] name The unique name of the model.
+ * @param[in] version The version of the model.
+ * @param[in] pinned Pin or unpin the model.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_model_pin (const gchar *name, const guint version, const gboolean pinned)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->pin_model (name ? name : "", version, pinned);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Update the last access time of the models in a transaction.
+ * @param[in] records The access records of the models.
+ * @param[in] num The number of the records.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_model_update_access (const svcdb_model_access_s *records, const guint num)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->update_model_access (records, num);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the models which can be evicted from the model store.
+ * @param[out] candidates The JSON array of the models, the least recently accessed first.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_model_list_eviction_candidates (gchar **candidates)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_eviction_candidates (candidates);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
 /**
  * @brief Delete the model.
  * @param[in] name The unique name to delete.
@@ -1207,6 +2209,54 @@ svcdb_resource_get (const gchar *name, gchar **res_info)
   return ret;
 }
 
+/**
+ * @brief Get the distinct paths of the registered model files.
+ * @param[out] paths The JSON array of the paths.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_model_list_paths (gchar **paths)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_model_paths (paths);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the distinct paths of the registered resource files.
+ * @param[out] paths The JSON array of the paths.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_resource_list_paths (gchar **paths)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->get_resource_paths (paths);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
 /**
  * @brief Delete the resource.
  * @param[in] name The unique name to delete.
@@ -1230,4 +2280,218 @@ svcdb_resource_delete (const gchar *name)
 
   return ret;
 }
+
+/**
+ * @brief Install the models, pipelines and resources in the configuration at once. If any of them fails, nothing is installed.
+ * @param[in] config The JSON string of the configuration, in the format of rpk_config.json of the RPK package.
+ * @param[in] app_info The application information of the models and resources.
+ * @param[out] models The JSON array of the names, versions and active states of the registered models.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_install (const gchar *config, const gchar *app_info, gchar **models)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  if (!config) {
+    ml_loge ("Invalid config parameter!");
+    return -EINVAL;
+  }
+
+  try {
+    db->install (config, app_info ? app_info : "", false, models);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Import the configurations of the packages at once. If any of them fails, nothing is imported.
+ * @param[in] num The number of the configurations.
+ * @param[in] configs The JSON strings of the configurations, in the format of rpk_config.json of the RPK package.
+ * @param[in] app_infos The application information of each configuration. NULL if it is not from a package.
+ * @param[out] num_models The number of the registered models. NULL to ignore it.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_import (const guint num, const gchar *const *configs,
+    const gchar *const *app_infos, guint *num_models)
+{
+  gint ret = 0;
+  guint i, count = 0U;
+  MLServiceDB *db = svcdb_get ();
+
+  if (num == 0U || !configs) {
+    ml_loge ("Invalid configs parameter!");
+    return -EINVAL;
+  }
+
+  try {
+    db->begin_batch ();
+
+    try {
+      for (i = 0; i < num; i++) {
+        g_autofree gchar *models = nullptr;
+        g_autoptr (JsonParser) parser = json_parser_new ();
+        JsonNode *root;
+
+        if (!configs[i])
+          throw std::invalid_argument ("Invalid config at " + std::to_string (i));
+
+        db->install (configs[i], (app_infos && app_infos[i]) ? app_infos[i] : "", false, &models);
+
+        if (json_parser_load_from_data (parser, models, -1, nullptr)
+            && (root = json_parser_get_root (parser)) && JSON_NODE_HOLDS_ARRAY (root))
+          count += json_array_get_length (json_node_get_array (root));
+      }
+
+      db->end_batch (true);
+    } catch (...) {
+      db->end_batch (false);
+      throw;
+    }
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  if (ret == 0 && num_models)
+    *num_models = count;
+
+  return ret;
+}
+
+/**
+ * @brief Upgrade the models, pipelines and resources of the package to the configuration at once.
+ * @details Only the changes from the models and resources registered by the package are applied, in a transaction.
+ * @param[in] config The JSON string of the configuration, in the format of rpk_config.json of the RPK package.
+ * @param[in] app_info The application information with the package id of the models and resources.
+ * @param[out] models The JSON array of the names, versions and active states of the models in the configuration.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_upgrade (const gchar *config, const gchar *app_info, gchar **models)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  if (!config || !app_info) {
+    ml_loge ("Invalid config or app_info parameter!");
+    return -EINVAL;
+  }
+
+  try {
+    db->install (config, app_info, true, models);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Install the models, pipelines and resources in the configuration file at once. If any of them fails, nothing is installed.
+ * @details The file is read in the chunks and the entries are installed as they are read, so the configuration is not loaded at once.
+ * @param[in] fd The file descriptor of the configuration file, in the format of rpk_config.json of the RPK package.
+ * @param[in] app_info The application information of the models and resources.
+ * @param[out] models The JSON array of the names, versions and active states of the registered models.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_install_from_fd (const gint fd, const gchar *app_info, gchar **models)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  try {
+    db->install_from_fd (fd, app_info ? app_info : "", false, models);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Upgrade the models, pipelines and resources of the package to the configuration file at once.
+ * @details Only the changes from the models and resources registered by the package are applied, in a transaction.
+ * @param[in] fd The file descriptor of the configuration file, in the format of rpk_config.json of the RPK package.
+ * @param[in] app_info The application information with the package id of the models and resources.
+ * @param[out] models The JSON array of the names, versions and active states of the models in the configuration.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_upgrade_from_fd (const gint fd, const gchar *app_info, gchar **models)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  if (!app_info) {
+    ml_loge ("Invalid app_info parameter!");
+    return -EINVAL;
+  }
+
+  try {
+    db->install_from_fd (fd, app_info, true, models);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief List the registered names of the kind matching the pattern, a page at a time.
+ * @param[in] kind The kind of the names, "model", "resource" or "pipeline".
+ * @param[in] pattern The GLOB pattern of the names. NULL or empty string matches all names.
+ * @param[in] cursor The cursor returned with the previous page. NULL or empty string for the first page.
+ * @param[in] limit The maximum number of the names in the page. 0 for the default.
+ * @param[out] list The JSON object with the array of the names, and the cursor of the next page.
+ * @return @c 0 on success. Otherwise a negative error value.
+ */
+gint
+svcdb_list_names (const gchar *kind, const gchar *pattern, const gchar *cursor, const guint limit, gchar **list)
+{
+  gint ret = 0;
+  MLServiceDB *db = svcdb_get ();
+
+  if (!kind) {
+    ml_loge ("Invalid kind parameter!");
+    return -EINVAL;
+  }
+
+  try {
+    db->list_names (kind, pattern ? pattern : "", cursor ? cursor : "", limit, list);
+  } catch (const std::invalid_argument &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EINVAL;
+  } catch (const std::exception &e) {
+    ml_loge ("%s", e.what ());
+    ret = -EIO;
+  }
+
+  return ret;
+}
 G_END_DECLS
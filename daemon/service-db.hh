@@ -13,9 +13,15 @@
 #ifndef __SERVICE_DB_HH__
 #define __SERVICE_DB_HH__
 
+#include <exception>
 #include <glib.h>
 #include <iostream>
+#include <json-glib/json-glib.h>
 #include <sqlite3.h>
+#include <vector>
+
+#include "rpk-config.h"
+#include "service-db-util.h"
 
 /**
  * @brief Class for ML-Service Database.
@@ -39,12 +45,27 @@ class MLServiceDB
       const guint version, const std::string description);
   virtual void activate_model (const std::string name, const guint version);
   virtual void get_model (const std::string name, const gint version, gchar **model);
+  virtual void get_activated_models (gchar **models);
+  virtual void get_model_blobs (gchar **blobs);
+  virtual void pin_model (const std::string name, const guint version, const bool pinned);
+  virtual void update_model_access (const svcdb_model_access_s *records, const guint num);
+  virtual void get_eviction_candidates (gchar **candidates);
   virtual void delete_model (const std::string name, const guint version,
       const gboolean force = FALSE);
   virtual void set_resource (const std::string name, const std::string path,
       const std::string description, const std::string app_info);
   virtual void get_resource (const std::string name, gchar **resource);
   virtual void delete_resource (const std::string name);
+  virtual void get_model_paths (gchar **paths);
+  virtual void get_resource_paths (gchar **paths);
+  virtual void list_names (const std::string kind, const std::string pattern,
+      const std::string cursor, const guint limit, gchar **list);
+  virtual void install (const std::string &config, const std::string &app_info,
+      const bool upgrade, gchar **models);
+  virtual void install_from_fd (const gint fd, const std::string &app_info,
+      const bool upgrade, gchar **models);
+  virtual void begin_batch ();
+  virtual void end_batch (const bool commit);
 
   MLServiceDB (std::string path);
   virtual ~MLServiceDB ();
@@ -54,14 +75,58 @@ class MLServiceDB
   int get_table_version (const std::string tbl_name, const int default_ver);
   bool set_table_version (const std::string tbl_name, const int tbl_ver);
   bool create_table (const std::string tbl_name);
+  bool alter_table (const std::string tbl_name);
   bool set_transaction (bool begin);
   bool is_model_registered (const std::string key, const guint version);
   bool is_model_activated (const std::string key, const guint version);
   bool is_resource_registered (const std::string key);
+  void release_model_blob (const std::string hash);
+  void get_registered_paths (const std::string table, const std::string type, gchar **paths);
+  void rollback_batch ();
+
+  /**
+   * @brief The row of the model or resource registered by the package, compared with the configuration in the upgrade.
+   */
+  typedef struct {
+    gint64 rowid;
+    std::string key;
+    std::string path;
+    std::string hash;
+    std::string description;
+    guint version;
+    bool active;
+    bool kept; /**< The row is in the new configuration. */
+  } package_row_s;
+
+  void get_package_rows (const std::string table, const std::string pkg_id,
+      std::vector<package_row_s> &rows);
+  void keep_package_row (const std::string table, package_row_s &row,
+      const std::string description, const std::string app_info);
+  void delete_package_rows (const std::string table,
+      const std::vector<package_row_s> &rows, std::vector<std::string> &hashes);
+
+  /**
+   * @brief The state of the install, passed to the entries read from the configuration.
+   */
+  typedef struct {
+    MLServiceDB *db;
+    const std::string *app_info;
+    std::vector<package_row_s> model_rows;
+    std::vector<package_row_s> resource_rows;
+    JsonArray *installed; /**< The names, versions and active states of the installed models. */
+    std::exception_ptr error; /**< The exception thrown while installing the entry. */
+  } install_context_s;
+
+  void install_config (const gchar *config, const gsize length, const gint fd,
+      const std::string &app_info, const bool upgrade, gchar **models);
+  static gint install_entry (const rpk_config_entry_s *entry, gpointer user_data);
 
   std::string _path;
   bool _initialized;
   sqlite3 *_db;
+  bool _batch; /**< The statements are in the transaction of the batch install. */
+  std::vector<std::string> _batch_hashes; /**< The blobs added to the model store by the batch install. */
+  std::vector<std::string> _batch_deleted; /**< The blobs of the models deleted by the batch install. */
 };
 
 #endif /* __SERVICE_DB_HH__ */
@@ -0,0 +1,145 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * Copyright (c) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file    startup-profile.c
+ * @date    18 Oct 2026
+ * @brief   Timing of the startup phases of Machine Learning agent daemon
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ */
+
+#include <glib.h>
+
+#include "log.h"
+#include "startup-profile.h"
+
+/**
+ * @brief Structure for the recorded phase.
+ */
+typedef struct {
+  gchar *name;
+  gint64 start; /**< Relative to the beginning of the profile. */
+  gint64 duration;
+} startup_phase_s;
+
+/**
+ * @brief Structure for the profile of the startup.
+ */
+static struct {
+  gint64 begin; /**< The monotonic time when the profile started. */
+  gint64 ready; /**< Relative time when the daemon is ready. 0 if it is not ready yet. */
+  GArray *phases;
+} g_profile = { 0, 0, NULL };
+
+G_LOCK_DEFINE_STATIC (startup_profile_lock);
+
+/**
+ * @brief Internal function to release the phase.
+ */
+static void
+_phase_clear (gpointer data)
+{
+  startup_phase_s *phase = (startup_phase_s *) data;
+
+  g_free (phase->name);
+}
+
+/**
+ * @brief Start the profile. The start times of the phases are relative to it.
+ */
+void
+startup_profile_begin (void)
+{
+  startup_profile_reset ();
+
+  G_LOCK (startup_profile_lock);
+  g_profile.begin = g_get_monotonic_time ();
+  g_profile.phases = g_array_new (FALSE, FALSE, sizeof (startup_phase_s));
+  g_array_set_clear_func (g_profile.phases, _phase_clear);
+  G_UNLOCK (startup_profile_lock);
+}
+
+/**
+ * @brief Record the phase which started at the given time and ends now.
+ */
+void
+startup_profile_add (const gchar *phase, gint64 start)
+{
+  startup_phase_s p;
+  gint64 now = g_get_monotonic_time ();
+
+  G_LOCK (startup_profile_lock);
+  if (g_profile.phases) {
+    p.name = g_strdup (phase);
+    p.start = start - g_profile.begin;
+    p.duration = now - start;
+    g_array_append_val (g_profile.phases, p);
+  }
+  G_UNLOCK (startup_profile_lock);
+}
+
+/**
+ * @brief Mark the daemon is ready, and log the summary of the phases.
+ */
+void
+startup_profile_ready (void)
+{
+  guint i;
+
+  G_LOCK (startup_profile_lock);
+  if (g_profile.phases && g_profile.ready == 0) {
+    g_profile.ready = g_get_monotonic_time () - g_profile.begin;
+
+    ml_logi ("Ready in %" G_GINT64_FORMAT " us after the startup.", g_profile.ready);
+    for (i = 0; i < g_profile.phases->len; i++) {
+      startup_phase_s *p = &g_array_index (g_profile.phases, startup_phase_s, i);
+
+      ml_logi ("  %-32s start %10" G_GINT64_FORMAT " us, took %10" G_GINT64_FORMAT " us",
+          p->name, p->start, p->duration);
+    }
+  }
+  G_UNLOCK (startup_profile_lock);
+}
+
+/**
+ * @brief Get the profile as the JSON string.
+ */
+gchar *
+startup_profile_get_json (void)
+{
+  GString *json = g_string_new (NULL);
+  guint i;
+
+  G_LOCK (startup_profile_lock);
+  g_string_append_printf (json, "{\"ready_us\":%" G_GINT64_FORMAT ",\"phases\":[", g_profile.ready);
+
+  for (i = 0; g_profile.phases && i < g_profile.phases->len; i++) {
+    startup_phase_s *p = &g_array_index (g_profile.phases, startup_phase_s, i);
+
+    /* The names of the phases are the internal names without the characters to be escaped. */
+    g_string_append_printf (json,
+        "%s{\"name\":\"%s\",\"start_us\":%" G_GINT64_FORMAT ",\"duration_us\":%" G_GINT64_FORMAT "}",
+        (i > 0) ? "," : "", p->name, p->start, p->duration);
+  }
+  G_UNLOCK (startup_profile_lock);
+
+  g_string_append (json, "]}");
+  return g_string_free (json, FALSE);
+}
+
+/**
+ * @brief Release the recorded phases.
+ */
+void
+startup_profile_reset (void)
+{
+  G_LOCK (startup_profile_lock);
+  if (g_profile.phases)
+    g_array_free (g_profile.phases, TRUE);
+
+  g_profile.phases = NULL;
+  g_profile.begin = g_profile.ready = 0;
+  G_UNLOCK (startup_profile_lock);
+}
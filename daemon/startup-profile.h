@@ -0,0 +1,60 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+
+/**
+ * @file    startup-profile.h
+ * @date    18 Oct 2026
+ * @brief   Internal header for the timing of the startup phases of Machine Learning agent daemon
+ * @see     https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author  agent <agent@local>
+ * @bug     No known bugs except for NYI items
+ *
+ * @details
+ *    The daemon records the monotonic start time and the duration of each startup phase, and of the probe and init of each module.
+ *    The summary is logged when the bus name is acquired and the daemon notifies READY=1.
+ *    The phases after it, e.g. the lazy init of the modules, are recorded as well.
+ */
+#ifndef __STARTUP_PROFILE_H__
+#define __STARTUP_PROFILE_H__
+
+#include <glib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Start the profile. The start times of the phases are relative to it.
+ */
+void startup_profile_begin (void);
+
+/**
+ * @brief Record the phase which started at the given time and ends now.
+ * @param[in] phase The name of the phase.
+ * @param[in] start The monotonic time in microseconds when the phase started.
+ */
+void startup_profile_add (const gchar *phase, gint64 start);
+
+/**
+ * @brief Mark the daemon is ready, and log the summary of the phases.
+ */
+void startup_profile_ready (void);
+
+/**
+ * @brief Get the profile as the JSON string, {"ready_us":N,"phases":[{"name":S,"start_us":N,"duration_us":N},...]}.
+ * @return The newly allocated string. Call g_free() to release it.
+ */
+gchar *startup_profile_get_json (void);
+
+/**
+ * @brief Release the recorded phases.
+ */
+void startup_profile_reset (void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __STARTUP_PROFILE_H__ */
@@ -184,6 +184,21 @@ export MLAGENT_BUILD_ROOT_PATH=$(pwd)/%{builddir}
 bash %{test_script} ./tests/daemon/unittest_ml_agent
 bash %{test_script} ./tests/daemon/unittest_service_db
 bash %{test_script} ./tests/daemon/unittest_gdbus_util
+bash %{test_script} ./tests/daemon/unittest_pipeline_allocator
+bash %{test_script} ./tests/daemon/unittest_pipeline_fusion
+bash %{test_script} ./tests/daemon/unittest_model_store
+bash %{test_script} ./tests/daemon/unittest_model_metadata
+bash %{test_script} ./tests/daemon/unittest_model_prefetch
+bash %{test_script} ./tests/daemon/unittest_model_integrity
+bash %{test_script} ./tests/daemon/unittest_model_quota
+bash %{test_script} ./tests/daemon/unittest_model_resident
+bash %{test_script} ./tests/daemon/unittest_registry_watch
+bash %{test_script} ./tests/daemon/unittest_model_artifact
+bash %{test_script} ./tests/daemon/unittest_io_engine
+bash %{test_script} ./tests/daemon/unittest_startup_profile
+bash %{test_script} ./tests/daemon/unittest_agent_config
+bash %{test_script} ./tests/daemon/unittest_rpk_config
+bash %{test_script} ./tests/daemon/unittest_modules
 bash %{test_script} ./tests/plugin-parser/unittest_mlops_plugin_parser
 %endif # unit_test
 
@@ -244,6 +259,7 @@ install -m 0755 packaging/run-unittest.sh %{buildroot}%{_bindir}/tizen-unittests
 %manifest mlops-agent.manifest
 %license LICENSE
 %attr(0755,root,root) %{_bindir}/mlops-agent
+%attr(0755,root,root) %{_bindir}/mlops-agent-import
 %attr(0644,root,root) %{_unitdir}/mlops-agent.service
 %attr(0644,root,root) %config %{_sysconfdir}/dbus-1/system.d/mlops-agent.conf
 %attr(0644,root,root) %{_datadir}/dbus-1/system-services/org.tizen.machinelearning.service.service
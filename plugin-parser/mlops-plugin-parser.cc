@@ -10,15 +10,20 @@
  * @author  Yongjoo Ahn <yongjoo1.ahn@samsung.com>
  * @bug     No known bugs except for NYI items
  * @todo    Add more unit tests using mocks.
- * @todo    Support UNINSTALL and UPGRADE.
+ * @todo    Support UNINSTALL.
  * @todo    Support allowed resource other than global resource.
  */
 
 #include <dlog.h>
+#include <errno.h>
+#include <fcntl.h>
 #include <glib.h>
 #include <json-glib/json-glib.h>
 #include <mlops-agent-interface.h>
 #include <pkgmgr-info.h>
+#include <unistd.h>
+
+#include "rpk-config.h"
 
 #define __TAG_ "ml-agent-plugin-parser"
 #define LOG_V(prio, tag, fmt, arg...)                                                     \
@@ -202,252 +207,133 @@ _uninstall_rpk (const gchar *name, const gchar *_info, mlsvc_json_type_e json_ty
 }
 
 /**
- * @brief Parse json and update ml-service database via invoking daemon.
+ * @brief Delete the entry of the configuration from ml-service database via invoking daemon.
+ * @details The daemon installs and upgrades the configuration file, only the uninstall is done entry by entry here.
  */
-static gboolean
-_parse_json (JsonNode *node, const gchar *app_info, mlsvc_json_type_e json_type,
-    mlsvc_package_manager_event_type_e event)
+static gint
+_uninstall_entry (const rpk_config_entry_s *entry, gpointer user_data)
 {
-  JsonArray *array = NULL;
-  JsonObject *object = NULL;
-  guint json_len = 1U;
   gint ret;
 
-  if (JSON_NODE_HOLDS_ARRAY (node)) {
-    array = json_node_get_array (node);
-    if (!array) {
-      _E ("Failed to get array from json");
-      return FALSE;
-    }
-
-    json_len = json_array_get_length (array);
-  }
-
-  /* Update ML service database. */
-  for (guint i = 0; i < json_len; ++i) {
-    if (array)
-      object = json_array_get_object_element (array, i);
-    else
-      object = json_node_get_object (node);
+  switch (entry->type) {
+    case RPK_CONFIG_MODEL:
+      {
+        g_autofree gchar *model_info = NULL;
 
-    switch (json_type) {
-      case MLSVC_JSON_MODEL:
-        {
-          const gchar *name = json_object_get_string_member (object, "name");
-          const gchar *model = json_object_get_string_member (object, "model");
-          const gchar *desc = json_object_get_string_member (object, "description");
-          const gchar *activate = json_object_get_string_member (object, "activate");
-
-          if (!name || !model) {
-            _E ("Failed to get name or model from MLSVC_JSON_MODEL.");
-            return FALSE;
-          }
+        ret = ml_agent_model_get_all (entry->name, &model_info);
 
-          if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_INSTALL) {
-            guint version;
-            bool active = (activate && g_ascii_strcasecmp (activate, "true") == 0);
-
-            ret = ml_agent_model_register (name, model, active,
-                desc ? desc : "", app_info ? app_info : "", &version);
-
-            if (ret == 0) {
-              _I ("The model with name '%s' is registered as version '%u'.", name, version);
-            } else {
-              _E ("Failed to register the model with name '%s'.", name);
-              return FALSE;
-            }
-          } else if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_UNINSTALL) {
-            g_autofree gchar *model_info = NULL;
-
-            ret = ml_agent_model_get_all (name, &model_info);
-
-            if (ret == 0) {
-              _uninstall_rpk (name, model_info, json_type);
-            } else {
-              _I ("The model with name '%s' is already deleted or not installed.", name);
-            }
-          } else {
-            _E ("Unknown event type '%d', internal error?", event);
-            return FALSE;
-          }
+        if (ret == 0) {
+          _uninstall_rpk (entry->name, model_info, MLSVC_JSON_MODEL);
+        } else {
+          _I ("The model with name '%s' is already deleted or not installed.", entry->name);
         }
+      }
+      break;
+    case RPK_CONFIG_PIPELINE:
+      ret = ml_agent_pipeline_delete (entry->name);
+
+      if (ret == 0) {
+        _I ("The pipeline description with name '%s' is deleted.", entry->name);
+      } else {
+        _E ("Failed to delete pipeline with name '%s'.", entry->name);
+        return ret;
+      }
+      break;
+    case RPK_CONFIG_RESOURCE:
+      /* The resource entry is passed for each path, and all paths are deleted with the first one. */
+      if (entry->path_index > 0U)
         break;
-      case MLSVC_JSON_PIPELINE:
-        {
-          const gchar *name = json_object_get_string_member (object, "name");
-          const gchar *pipe = json_object_get_string_member (object, "pipeline");
 
-          if (!name || !pipe) {
-            _E ("Failed to get name or pipeline from MLSVC_JSON_PIPELINE.");
-            return FALSE;
-          }
+      ret = ml_agent_resource_delete (entry->name);
+
+      if (ret == 0) {
+        _I ("The resource is deleted. - name: %s", entry->name);
+      } else {
+        _I ("The model with name '%s' is already deleted or not installed", entry->name);
+      }
+      break;
+    default:
+      _E ("Unknown data type '%d', internal error?", entry->type);
+      return -EINVAL;
+  }
 
-          if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_INSTALL) {
-            ret = ml_agent_pipeline_set_description (name, pipe);
-
-            if (ret == 0) {
-              _I ("The pipeline description with name '%s' is registered.", name);
-            } else {
-              _E ("Failed to register pipeline with name '%s'.", name);
-              return FALSE;
-            }
-          } else if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_UNINSTALL) {
-            ret = ml_agent_pipeline_delete (name);
-
-            if (ret == 0) {
-              _I ("The pipeline description with name '%s' is deleted.", name);
-            } else {
-              _E ("Failed to delete pipeline with name '%s'.", name);
-              return FALSE;
-            }
-          } else {
-            _E ("Unknown event type '%d', internal error?", event);
-            return FALSE;
-          }
-        }
-        break;
-      case MLSVC_JSON_RESOURCE:
-        {
-          const gchar *name = json_object_get_string_member (object, "name");
-          const gchar *desc = json_object_get_string_member (object, "description");
-          JsonNode *path_node = json_object_get_member (object, "path");
-          JsonArray *path_array = NULL;
-          guint path_len;
-
-          if (!name) {
-            _E ("Failed to get name from MLSVC_JSON_RESOURCE.");
-            return FALSE;
-          }
+  return 0;
+}
 
-          path_len = 1U;
-          if (JSON_NODE_HOLDS_ARRAY (path_node)) {
-            path_array = json_node_get_array (path_node);
-            path_len = (path_array) ? json_array_get_length (path_array) : 0U;
-          }
+/**
+ * @brief Internal function to uninstall the entries in the json configuration.
+ * @details The whole configuration is validated before any entry is deleted, then the entries are deleted as they are read again.
+ */
+static gboolean
+_uninstall_json_config (const gint fd)
+{
+  gint ret;
 
-          if (path_len == 0U) {
-            _E ("Failed to get path from MLSVC_JSON_RESOURCE.");
-            return FALSE;
-          }
+  ret = rpk_config_scan_fd (fd, NULL, NULL);
+  if (ret != 0) {
+    _E ("Failed to parse configuration file (%d).", ret);
+    return FALSE;
+  }
 
-          if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_INSTALL) {
-            for (guint pidx = 0; pidx < path_len; pidx++) {
-              const gchar *path = NULL;
-
-              if (path_array)
-                path = json_array_get_string_element (path_array, pidx);
-              else
-                path = json_node_get_string (path_node);
-
-              if (!path) {
-                _E ("Failed to get path at '%d'th of '%s' from MLSVC_JSON_RESOURCE.",
-                    pidx, name);
-                return FALSE;
-              }
-
-              ret = ml_agent_resource_add (
-                  name, path, desc ? desc : "", app_info ? app_info : "");
-
-              if (ret == 0) {
-                _I ("The resource at '%d'th of name '%s' is registered.", pidx, name);
-              } else {
-                _E ("Failed to register the resource with name '%s'.", name);
-                return FALSE;
-              }
-            }
-          } else if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_UNINSTALL) {
-            ret = ml_agent_resource_delete (name);
-
-            if (ret == 0) {
-              _I ("The resource is deleted. - name: %s", name);
-            } else {
-              _I ("The model with name '%s' is already deleted or not installed", name);
-            }
-          } else {
-            _E ("Unknown event type '%d', internal error?", event);
-            return FALSE;
-          }
-        }
-        break;
-      default:
-        _E ("Unknown data type '%d', internal error?", json_type);
-        return FALSE;
-    }
+  ret = rpk_config_scan_fd (fd, _uninstall_entry, NULL);
+  if (ret != 0) {
+    _E ("Failed to delete the entries in configuration file (%d).", ret);
+    return FALSE;
   }
+
   return TRUE;
 }
 
 /**
  * @brief Internal function to get json configuration file.
+ * @details The file is not loaded here. For install and upgrade, its file descriptor is passed to the daemon,
+ *          which reads the file in the chunks and installs the entries as they are read, in a transaction.
  */
 static gboolean
 _get_json_config (const gchar *json_path, const gchar *app_info,
     mlsvc_package_manager_event_type_e event)
 {
-  g_autofree gchar *json_string = NULL;
-  g_autoptr (JsonParser) parser = NULL;
-  g_autoptr (GError) err = NULL;
-  g_autoptr (GList) members = NULL;
-  GList *iter;
-  JsonNode *root;
-  JsonObject *object;
+  g_autofree gchar *models = NULL;
+  gboolean result = FALSE;
+  gint ret;
+  int fd;
 
   if (!g_file_test (json_path, (GFileTest) (G_FILE_TEST_EXISTS | G_FILE_TEST_IS_REGULAR))) {
     _E ("The parameter, json_path, is invalid. It should be a valid string.");
     return FALSE;
   }
 
-  if (!g_file_get_contents (json_path, &json_string, NULL, NULL)) {
-    _E ("Failed to read configuration file '%s'.", json_path);
+  fd = open (json_path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    _E ("Failed to open configuration file '%s' (%d).", json_path, errno);
     return FALSE;
   }
 
-  parser = json_parser_new ();
-  if (!parser) {
-    _E ("Failed to parse configuration file, cannot allocate memory for JsonParser. Out of memory?");
-    return FALSE;
-  }
-
-  if (!json_parser_load_from_data (parser, json_string, -1, &err)) {
-    _E ("Failed to parse configuration file, cannot load json string (%s).",
-        err ? err->message : "Unknown error");
-    return FALSE;
-  }
-
-  root = json_parser_get_root (parser);
-  if (!root) {
-    _E ("Failed to parse configuration file, cannot get the top node from json string.");
-    return FALSE;
-  }
-
-  object = json_node_get_object (root);
-  members = json_object_get_members (object);
-
-  for (iter = members; iter != NULL; iter = iter->next) {
-    const gchar *name = (const gchar *) iter->data;
-    JsonNode *node = json_object_get_member (object, name);
-    mlsvc_json_type_e json_type;
-
-    if (g_ascii_strcasecmp (name, "model") == 0 || g_ascii_strcasecmp (name, "models") == 0) {
-      json_type = MLSVC_JSON_MODEL;
-    } else if (g_ascii_strcasecmp (name, "pipeline") == 0
-               || g_ascii_strcasecmp (name, "pipelines") == 0) {
-      json_type = MLSVC_JSON_PIPELINE;
-    } else if (g_ascii_strcasecmp (name, "resource") == 0
-               || g_ascii_strcasecmp (name, "resources") == 0) {
-      json_type = MLSVC_JSON_RESOURCE;
+  if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_UNINSTALL) {
+    result = _uninstall_json_config (fd);
+  } else if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_INSTALL) {
+    ret = ml_agent_registry_install_from_fd (fd, app_info ? app_info : "", &models);
+    if (ret == 0) {
+      _I ("The configuration file '%s' is installed. - models: %s", json_path, models);
+      result = TRUE;
     } else {
-      _E ("Failed to parse '%s' from configuration file, unsupported type.", name);
-      return FALSE;
+      _E ("Failed to install configuration file '%s' (%d).", json_path, ret);
     }
-
-    if (!_parse_json (node, app_info, json_type, event)) {
-      _E ("Failed to parse '%s' from configuration file.", name);
-      return FALSE;
+  } else if (event == MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_UPGRADE) {
+    /* Only the changes from the models and resources registered by the package are applied. */
+    ret = ml_agent_registry_upgrade_from_fd (fd, app_info, &models);
+    if (ret == 0) {
+      _I ("The configuration file '%s' is upgraded. - models: %s", json_path, models);
+      result = TRUE;
+    } else {
+      _E ("Failed to upgrade with configuration file '%s' (%d).", json_path, ret);
     }
+  } else {
+    _E ("Unknown event type '%d', internal error?", event);
   }
 
-  return TRUE;
+  close (fd);
+  return result;
 }
 
 /**
@@ -569,9 +455,8 @@ extern "C" int
 PKGMGR_MDPARSER_PLUGIN_UPGRADE (const char *pkgid, const char *appid, GList *metadata)
 {
   _I ("PKGMGR_MDPARSER_PLUGIN_UPGRADE called");
-
-  PKGMGR_MDPARSER_PLUGIN_UNINSTALL (pkgid, appid, metadata);
-  return PKGMGR_MDPARSER_PLUGIN_INSTALL (pkgid, appid, metadata);
+  return _set_pkgmgr_plugin (
+      pkgid, appid, metadata, MLSVC_PKGMGR_MDPARSER_PLUGIN_EVENT_TYPE_UPGRADE);
 }
 
 /**
@@ -0,0 +1,86 @@
+/**
+ * @file        unittest_agent_config.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the runtime configuration of ML-Agent
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+
+#include "agent-config.h"
+#include "log.h"
+
+/**
+ * @brief Internal function to parse the options as the command line of the daemon, and check them.
+ */
+static gint
+_parse_options (const gchar *option1, const gchar *option2)
+{
+  const gchar *args[] = { "mlops-agent", option1, option2, NULL };
+  g_auto (GStrv) argv = g_strdupv ((gchar **) args);
+  GOptionContext *context = g_option_context_new (NULL);
+  gboolean parsed;
+
+  agent_config_reset ();
+
+  g_option_context_add_main_entries (context, agent_config_get_option_entries (), NULL);
+  parsed = g_option_context_parse_strv (context, &argv, NULL);
+  g_option_context_free (context);
+
+  return parsed ? agent_config_validate () : -EINVAL;
+}
+
+/**
+ * @brief Test the idle exit and the resident model files are available alone.
+ */
+TEST (agentConfig, idleExit)
+{
+  EXPECT_EQ (_parse_options ("--idle-exit-timeout=30", NULL), 0);
+  EXPECT_EQ (agent_config_get ()->idle_exit_timeout, 30);
+
+  EXPECT_EQ (_parse_options ("--model-resident-budget=4096", NULL), 0);
+  EXPECT_EQ (agent_config_get ()->idle_exit_timeout, 0);
+
+  EXPECT_EQ (_parse_options ("--idle-exit-timeout=0", "--model-resident-budget=4096"), 0);
+
+  agent_config_reset ();
+}
+
+/**
+ * @brief Test the idle exit is rejected with the resident model files, which are released at the exit.
+ */
+TEST (agentConfig, idleExitResident_n)
+{
+  EXPECT_EQ (_parse_options ("--idle-exit-timeout=30", "--model-resident-budget=4096"), -EINVAL);
+  EXPECT_EQ (_parse_options ("--idle-exit-timeout=-1", NULL), -EINVAL);
+
+  agent_config_reset ();
+  EXPECT_EQ (agent_config_validate (), 0);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
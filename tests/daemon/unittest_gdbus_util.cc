@@ -82,6 +82,27 @@ TEST (GDbusInstanceNotInitialized, get_system_connection_n)
   EXPECT_EQ (-ENOSYS, ret);
 }
 
+/**
+ * @brief Test for the idle time and the release of the name.
+ */
+TEST_F (GDbusTest, idle_time)
+{
+  int ret;
+
+  ret = gdbus_get_system_connection (true);
+  ASSERT_EQ (0, ret);
+
+  EXPECT_GE (gdbus_get_idle_time (), 0);
+  EXPECT_LE (gdbus_get_idle_time (), 1);
+
+  ret = gdbus_get_name ("org.tizen.machinelearning.service.test");
+  EXPECT_EQ (0, ret);
+
+  gdbus_put_name ();
+  gdbus_put_name ();
+  gdbus_put_system_connection ();
+}
+
 /**
  * @brief Main gtest
  */
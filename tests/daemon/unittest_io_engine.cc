@@ -0,0 +1,248 @@
+/**
+ * @file        unittest_io_engine.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the bulk I/O engine of the model files
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "io-engine.h"
+#include "log.h"
+
+/**
+ * @brief The size of the buffer of an operation in the test.
+ */
+#define TEST_BLOCK_SIZE (64U * 1024U)
+
+/**
+ * @brief The number of the operations in a batch in the test.
+ */
+#define TEST_NUM_BLOCKS (16U)
+
+/**
+ * @brief Test fixture with the temporary file.
+ */
+class IoEngineTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+  gchar *path;
+
+  /**
+   * @brief Create the temporary directory and start the engine.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-io-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+    path = g_build_filename (tmp_dir, "model.bin", NULL);
+
+    ASSERT_EQ (io_engine_init (4U), 0);
+  }
+
+  /**
+   * @brief Stop the engine and remove the temporary directory.
+   */
+  void TearDown () override
+  {
+    g_autofree gchar *cmd = g_strdup_printf ("rm -rf %s", tmp_dir);
+
+    io_engine_fini ();
+    EXPECT_EQ (system (cmd), 0);
+    g_free (path);
+    g_free (tmp_dir);
+  }
+
+  /**
+   * @brief Fill the operations on the blocks of the buffer.
+   */
+  static void fill_ops (io_engine_op_s *ops, io_engine_op_e type, int fd, guint8 *buf)
+  {
+    guint i;
+
+    for (i = 0; i < TEST_NUM_BLOCKS; i++) {
+      ops[i].type = type;
+      ops[i].fd = fd;
+      ops[i].buf = buf ? buf + i * TEST_BLOCK_SIZE : NULL;
+      ops[i].length = TEST_BLOCK_SIZE;
+      ops[i].offset = (goffset) i * TEST_BLOCK_SIZE;
+    }
+  }
+
+  /**
+   * @brief The callback to record the completion in the main context.
+   */
+  static void done_cb (io_engine_op_s *ops, guint num, gpointer user_data)
+  {
+    GThread **thread = (GThread **) user_data;
+
+    *thread = g_thread_self ();
+  }
+};
+
+/**
+ * @brief Test the batch of the writes and the reads.
+ */
+TEST_F (IoEngineTest, writeAndRead)
+{
+  io_engine_op_s ops[TEST_NUM_BLOCKS];
+  g_autofree guint8 *src = (guint8 *) g_malloc (TEST_BLOCK_SIZE * TEST_NUM_BLOCKS);
+  g_autofree guint8 *dst = (guint8 *) g_malloc0 (TEST_BLOCK_SIZE * TEST_NUM_BLOCKS);
+  guint i;
+  int fd;
+
+  EXPECT_TRUE (io_engine_get_backend () != NULL);
+
+  for (i = 0; i < TEST_BLOCK_SIZE * TEST_NUM_BLOCKS; i++)
+    src[i] = (guint8) (i * 7U);
+
+  fd = open (path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  ASSERT_GE (fd, 0);
+
+  /* More operations than the queue depth. */
+  fill_ops (ops, IO_ENGINE_OP_WRITE, fd, src);
+  EXPECT_EQ (io_engine_run (ops, TEST_NUM_BLOCKS), 0);
+
+  fill_ops (ops, IO_ENGINE_OP_READ, fd, dst);
+  EXPECT_EQ (io_engine_run (ops, TEST_NUM_BLOCKS), 0);
+  EXPECT_EQ (memcmp (src, dst, TEST_BLOCK_SIZE * TEST_NUM_BLOCKS), 0);
+
+  fill_ops (ops, IO_ENGINE_OP_READAHEAD, fd, NULL);
+  EXPECT_EQ (io_engine_run (ops, TEST_NUM_BLOCKS), 0);
+
+  close (fd);
+}
+
+/**
+ * @brief Test the completion is dispatched in the main context.
+ */
+TEST_F (IoEngineTest, mainContext)
+{
+  io_engine_op_s ops[TEST_NUM_BLOCKS];
+  g_autofree guint8 *buf = (guint8 *) g_malloc0 (TEST_BLOCK_SIZE * TEST_NUM_BLOCKS);
+  GMainContext *context = g_main_context_new ();
+  GThread *thread = NULL;
+  gint64 end = g_get_monotonic_time () + G_USEC_PER_SEC;
+  int fd;
+
+  ASSERT_TRUE (g_file_set_contents (path, (const gchar *) buf, TEST_BLOCK_SIZE * TEST_NUM_BLOCKS, NULL));
+  fd = open (path, O_RDONLY | O_CLOEXEC);
+  ASSERT_GE (fd, 0);
+
+  g_main_context_push_thread_default (context);
+
+  fill_ops (ops, IO_ENGINE_OP_READ, fd, buf);
+  EXPECT_EQ (io_engine_submit (ops, TEST_NUM_BLOCKS, done_cb, &thread, context), 0);
+
+  while (!thread && g_get_monotonic_time () < end)
+    g_main_context_iteration (context, FALSE);
+
+  EXPECT_EQ (thread, g_thread_self ());
+  EXPECT_EQ (ops[TEST_NUM_BLOCKS - 1].result, (gssize) TEST_BLOCK_SIZE);
+
+  g_main_context_pop_thread_default (context);
+  g_main_context_unref (context);
+  close (fd);
+}
+
+/**
+ * @brief Test the read over the end of the file.
+ */
+TEST_F (IoEngineTest, shortRead_n)
+{
+  io_engine_op_s op = {};
+  guint8 buf[16];
+  int fd;
+
+  ASSERT_TRUE (g_file_set_contents (path, "model", -1, NULL));
+  fd = open (path, O_RDONLY | O_CLOEXEC);
+  ASSERT_GE (fd, 0);
+
+  op.type = IO_ENGINE_OP_READ;
+  op.fd = fd;
+  op.buf = buf;
+  op.length = sizeof (buf);
+  op.offset = 0;
+
+  EXPECT_EQ (io_engine_run (&op, 1U), -EIO);
+  EXPECT_EQ (op.result, 5);
+
+  close (fd);
+}
+
+/**
+ * @brief Test the operation on the invalid file descriptor.
+ */
+TEST_F (IoEngineTest, badFd_n)
+{
+  io_engine_op_s op = {};
+  guint8 buf[16];
+
+  op.type = IO_ENGINE_OP_READ;
+  op.fd = -1;
+  op.buf = buf;
+  op.length = sizeof (buf);
+
+  EXPECT_EQ (io_engine_run (&op, 1U), -EBADF);
+  EXPECT_EQ (io_engine_submit (NULL, 1U, done_cb, NULL, NULL), -EINVAL);
+  EXPECT_EQ (io_engine_submit (&op, 0U, done_cb, NULL, NULL), -EINVAL);
+}
+
+/**
+ * @brief Test the engine is started at the first submission.
+ */
+TEST_F (IoEngineTest, lazyStart)
+{
+  io_engine_op_s op = {};
+  guint8 buf[5];
+  int fd;
+
+  io_engine_fini ();
+  EXPECT_TRUE (io_engine_get_backend () == NULL);
+
+  ASSERT_TRUE (g_file_set_contents (path, "model", -1, NULL));
+  fd = open (path, O_RDONLY | O_CLOEXEC);
+  ASSERT_GE (fd, 0);
+
+  op.type = IO_ENGINE_OP_READ;
+  op.fd = fd;
+  op.buf = buf;
+  op.length = sizeof (buf);
+
+  EXPECT_EQ (io_engine_run (&op, 1U), 0);
+  EXPECT_EQ (memcmp (buf, "model", sizeof (buf)), 0);
+  EXPECT_TRUE (io_engine_get_backend () != NULL);
+
+  close (fd);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
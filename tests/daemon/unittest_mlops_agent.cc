@@ -9,6 +9,11 @@
 
 #include <gtest/gtest.h>
 #include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "log.h"
 #include "mlops-agent-interface.h"
@@ -313,6 +318,91 @@ TEST_F (MLAgentTest, model_register_01_n)
   EXPECT_NE (ret, 0);
 }
 
+/**
+ * @brief Testcase for ML-Agent interface - model from the file descriptor.
+ */
+TEST_F (MLAgentTest, model_register_from_fd_01_n)
+{
+  gint ret;
+  guint ver;
+  int fd;
+
+  ret = ml_agent_model_register_from_fd (NULL, 0, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_register_from_fd ("", 0, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_register_from_fd ("test-model", -1, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_register_from_fd ("test-model", 0, FALSE, NULL, NULL, NULL);
+  EXPECT_NE (ret, 0);
+
+  /* The model store is not enabled in the test daemon. */
+  fd = open ("/dev/null", O_RDONLY);
+  ASSERT_GE (fd, 0);
+  ret = ml_agent_model_register_from_fd ("test-model", fd, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  close (fd);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - model from the binary delta.
+ */
+TEST_F (MLAgentTest, model_register_delta_01_n)
+{
+  gint ret;
+  guint ver;
+
+  ret = ml_agent_model_register_delta (NULL, 1U, 0, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_register_delta ("", 1U, 0, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_register_delta ("test-model", 0U, 0, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_register_delta ("test-model", 1U, -1, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_register_delta ("test-model", 1U, 0, FALSE, NULL, NULL, NULL);
+  EXPECT_NE (ret, 0);
+
+  /* The base version is not registered. */
+  ret = ml_agent_model_register_delta ("no-model", 1U, 0, FALSE, NULL, NULL, &ver);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - model.
+ */
+TEST_F (MLAgentTest, model_pin_01_n)
+{
+  gint ret;
+
+  ret = ml_agent_model_pin (NULL, 1U, TRUE);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_pin ("", 1U, TRUE);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_pin ("test-model", 0U, TRUE);
+  EXPECT_NE (ret, 0);
+
+  /* The model is not registered. */
+  ret = ml_agent_model_pin ("no-model", 1U, TRUE);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - model.
+ */
+TEST_F (MLAgentTest, model_evict_01_n)
+{
+  gint ret;
+  g_autofree gchar *report = NULL;
+
+  ret = ml_agent_model_evict (TRUE, NULL);
+  EXPECT_NE (ret, 0);
+
+  /* The quota of the model store is not set. */
+  ret = ml_agent_model_evict (TRUE, &report);
+  EXPECT_NE (ret, 0);
+}
+
 /**
  * @brief Testcase for ML-Agent interface - model.
  */
@@ -445,6 +535,46 @@ TEST_F (MLAgentTest, model_get_activated_01_n)
   EXPECT_NE (ret, 0);
 }
 
+/**
+ * @brief Testcase for ML-Agent interface - model.
+ */
+TEST_F (MLAgentTest, model_get_activated_fd_01_n)
+{
+  gint ret;
+  gchar *model_info = NULL;
+  int fd = -1;
+
+  ret = ml_agent_model_get_activated_fd (NULL, &model_info, &fd);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_get_activated_fd ("", &model_info, &fd);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_get_activated_fd ("test-model", NULL, &fd);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_model_get_activated_fd ("test-model", &model_info, NULL);
+  EXPECT_NE (ret, 0);
+
+  /* no registered model */
+  ret = ml_agent_model_get_activated_fd ("no-model", &model_info, &fd);
+  EXPECT_NE (ret, 0);
+  EXPECT_EQ (fd, -1);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - model.
+ */
+TEST_F (MLAgentTest, model_get_resident_stats)
+{
+  gint ret;
+  g_autofree gchar *stats = NULL;
+
+  ret = ml_agent_model_get_resident_stats (NULL);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_model_get_resident_stats (&stats);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (stats != NULL && strstr (stats, "\"hits\"") != NULL);
+}
+
 /**
  * @brief Testcase for ML-Agent interface - model.
  */
@@ -589,6 +719,263 @@ TEST_F (MLAgentTest, resource_get_01_n)
   EXPECT_NE (ret, 0);
 }
 
+/**
+ * @brief Testcase for ML-Agent interface - registry.
+ */
+TEST_F (MLAgentTest, registry_list)
+{
+  gint ret;
+  g_autofree gchar *list = NULL;
+
+  ret = ml_agent_resource_add ("test-list-1", "/path/res1.dat", NULL, NULL);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_resource_add ("test-list-2", "/path/res2.dat", NULL, NULL);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_registry_list ("resource", "test-list-*", NULL, 1U, &list);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (list, "{\"names\":[\"test-list-1\"],\"cursor\":\"test-list-1\"}");
+  g_free (list);
+  list = NULL;
+
+  ret = ml_agent_registry_list ("resource", "test-list-*", "test-list-1", 1U, &list);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (list, "{\"names\":[\"test-list-2\"],\"cursor\":\"\"}");
+  g_free (list);
+  list = NULL;
+
+  ret = ml_agent_registry_list ("pipeline", "test-list-*", NULL, 0U, &list);
+  EXPECT_EQ (ret, 0);
+  g_free (list);
+  list = NULL;
+
+  ret = ml_agent_registry_list ("model", "test-list-*", NULL, 0U, &list);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_resource_delete ("test-list-1");
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_resource_delete ("test-list-2");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - registry.
+ */
+TEST_F (MLAgentTest, registry_list_01_n)
+{
+  gint ret;
+  gchar *list = NULL;
+
+  ret = ml_agent_registry_list (NULL, NULL, NULL, 0U, &list);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_list ("", NULL, NULL, 0U, &list);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_list ("unknown", NULL, NULL, 0U, &list);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_list ("model", NULL, NULL, 0U, NULL);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - resource.
+ */
+TEST_F (MLAgentTest, resource_prefetch)
+{
+  gint ret;
+  gchar *dir = g_dir_make_tmp ("mlagent-res-XXXXXX", NULL);
+  g_autofree gchar *path = g_build_filename (dir, "res1.dat", NULL);
+  g_autofree gchar *info = NULL;
+
+  ASSERT_TRUE (g_file_set_contents (path, "resource", -1, NULL));
+
+  ret = ml_agent_resource_add ("test-res", path, NULL, NULL);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_resource_prefetch ("test-res", &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (info != NULL && strstr (info, "\"total_bytes\":8") != NULL);
+  g_free (info);
+  info = NULL;
+
+  /* The resource file does not exist. */
+  ret = ml_agent_resource_add ("test-res", "/path/res2.dat", NULL, NULL);
+  EXPECT_EQ (ret, 0);
+
+  ret = ml_agent_resource_prefetch ("test-res", &info);
+  EXPECT_EQ (ret, -ENOENT);
+
+  ret = ml_agent_resource_delete ("test-res");
+  EXPECT_EQ (ret, 0);
+
+  g_unlink (path);
+  g_rmdir (dir);
+  g_free (dir);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - resource.
+ */
+TEST_F (MLAgentTest, resource_prefetch_01_n)
+{
+  gint ret;
+  gchar *info = NULL;
+
+  ret = ml_agent_resource_prefetch (NULL, &info);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_resource_prefetch ("", &info);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_resource_prefetch ("test-res", NULL);
+  EXPECT_NE (ret, 0);
+
+  /* no registered resource */
+  ret = ml_agent_resource_prefetch ("test-res", &info);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - install.
+ */
+TEST_F (MLAgentTest, registry_install)
+{
+  gint ret;
+  g_autofree gchar *models = NULL;
+  g_autofree gchar *desc = NULL;
+  const gchar *config = "{\"model\":{\"name\":\"test-install\",\"model\":\"/path/to/test.tflite\",\"activate\":\"true\"},"
+                        "\"pipeline\":{\"name\":\"test-install\",\"pipeline\":\"videotestsrc ! fakesink\"}}";
+
+  ret = ml_agent_registry_install (config, "", &models);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (models, "[{\"name\":\"test-install\",\"version\":1,\"active\":true}]");
+
+  ret = ml_agent_pipeline_get_description ("test-install", &desc);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (desc, "videotestsrc ! fakesink");
+
+  ret = ml_agent_model_delete ("test-install", 0U, TRUE);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_pipeline_delete ("test-install");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - install.
+ */
+TEST_F (MLAgentTest, registry_install_01_n)
+{
+  gint ret;
+  gchar *models = NULL;
+  gchar *desc = NULL;
+  const gchar *config = "{\"pipeline\":{\"name\":\"test-install\",\"pipeline\":\"videotestsrc ! fakesink\"},"
+                        "\"model\":{\"name\":\"test-install\"}}";
+
+  ret = ml_agent_registry_install (NULL, "", &models);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_install ("", "", &models);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_install (config, "", NULL);
+  EXPECT_NE (ret, 0);
+
+  /* the pipeline is not registered with the invalid model */
+  ret = ml_agent_registry_install (config, "", &models);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_pipeline_get_description ("test-install", &desc);
+  EXPECT_NE (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - install and upgrade with the configuration file.
+ */
+TEST_F (MLAgentTest, registry_install_from_fd)
+{
+  gint ret;
+  guint i;
+  g_autofree gchar *path = NULL;
+  g_autofree gchar *models = NULL;
+  g_autofree gchar *upgraded = NULL;
+  g_autofree gchar *info = NULL;
+  GString *config = g_string_new ("{\"resources\":{\"name\":\"test-install-fd\",\"path\":[");
+  const gchar *app_info = "{\"is_rpk\":\"T\",\"pkg_id\":\"test-install-fd-pkg\"}";
+  int fd;
+
+  /* The configuration larger than a message of the configuration string usually is. */
+  for (i = 0; i < 5000U; i++)
+    g_string_append_printf (config, "%s\"/path/to/res_%04u.dat\"", (i > 0) ? "," : "", i);
+  g_string_append (config, "]},\"model\":{\"name\":\"test-install-fd\",\"model\":\"/path/to/test.tflite\",\"activate\":\"true\"}}");
+
+  fd = g_file_open_tmp ("unittest-config-XXXXXX.json", &path, NULL);
+  ASSERT_GE (fd, 0);
+  ASSERT_EQ (write (fd, config->str, config->len), (ssize_t) config->len);
+  g_string_free (config, TRUE);
+
+  ret = ml_agent_registry_install_from_fd (fd, app_info, &models);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (models, "[{\"name\":\"test-install-fd\",\"version\":1,\"active\":true}]");
+
+  ret = ml_agent_resource_get ("test-install-fd", &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (g_strstr_len (info, -1, "/path/to/res_4999.dat") != NULL);
+
+  /* Nothing is changed, the model keeps its version. */
+  ret = ml_agent_registry_upgrade_from_fd (fd, app_info, &upgraded);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (upgraded, models);
+
+  close (fd);
+  g_remove (path);
+
+  ret = ml_agent_model_delete ("test-install-fd", 0U, TRUE);
+  EXPECT_EQ (ret, 0);
+  ret = ml_agent_resource_delete ("test-install-fd");
+  EXPECT_EQ (ret, 0);
+}
+
+/**
+ * @brief Testcase for ML-Agent interface - install with the configuration file.
+ */
+TEST_F (MLAgentTest, registry_install_from_fd_01_n)
+{
+  gint ret;
+  gchar *models = NULL;
+  int fd;
+
+  ret = ml_agent_registry_install_from_fd (-1, "", &models);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_upgrade_from_fd (-1, "{\"pkg_id\":\"test\"}", &models);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_upgrade_from_fd (0, NULL, &models);
+  EXPECT_NE (ret, 0);
+  ret = ml_agent_registry_install_from_fd (0, "", NULL);
+  EXPECT_NE (ret, 0);
+
+  /* The empty file is not a valid configuration. */
+  fd = open ("/dev/null", O_RDONLY);
+  ASSERT_GE (fd, 0);
+  ret = ml_agent_registry_install_from_fd (fd, "", &models);
+  EXPECT_NE (ret, 0);
+  EXPECT_TRUE (models == NULL);
+  close (fd);
+}
+
+/**
+ * @brief Testcase for the timing of the startup phases.
+ */
+TEST_F (MLAgentTest, get_startup_stats)
+{
+  gint ret;
+  gchar *stats = NULL;
+
+  ret = ml_agent_get_startup_stats (NULL);
+  EXPECT_NE (ret, 0);
+
+  ret = ml_agent_get_startup_stats (&stats);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (stats != NULL);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"ready_us\"") != NULL);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"svcdb_initialize\"") != NULL);
+  EXPECT_TRUE (g_strstr_len (stats, -1, "\"probe:model-interface\"") != NULL);
+  g_free (stats);
+}
+
 /**
  * @brief Main gtest
  */
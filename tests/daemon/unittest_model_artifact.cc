@@ -0,0 +1,216 @@
+/**
+ * @file        unittest_model_artifact.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the cache of the compiled artifacts of the model backends
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <utime.h>
+
+#include "log.h"
+#include "model-artifact.h"
+
+#define HASH_1 "1111111111111111111111111111111111111111111111111111111111111111"
+#define HASH_2 "2222222222222222222222222222222222222222222222222222222222222222"
+
+/**
+ * @brief Test fixture with the temporary cache directory.
+ */
+class ModelArtifactTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+
+  /**
+   * @brief Create the temporary directory.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-artifact-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+  }
+
+  /**
+   * @brief Disable the cache and remove the temporary directory.
+   */
+  void TearDown () override
+  {
+    g_autofree gchar *cmd = g_strdup_printf ("rm -rf %s", tmp_dir);
+
+    model_artifact_fini ();
+    EXPECT_EQ (system (cmd), 0);
+    g_free (tmp_dir);
+  }
+
+  /**
+   * @brief Write the artifact of the given size as the backend does, and release the directory.
+   */
+  void write_artifact (const gchar *dir, gsize size, time_t used)
+  {
+    g_autofree gchar *path = g_build_filename (dir, "compiled.bin", NULL);
+    g_autofree gchar *contents = (gchar *) g_malloc0 (size);
+    struct utimbuf times = { used, used };
+
+    EXPECT_TRUE (g_file_set_contents (path, contents, size, NULL));
+    model_artifact_release (dir);
+    EXPECT_EQ (utime (dir, &times), 0);
+  }
+};
+
+/**
+ * @brief Test the artifact directory is keyed by the model hash, the backend and the options.
+ */
+TEST_F (ModelArtifactTest, key)
+{
+  g_autofree gchar *dir = NULL;
+  g_autofree gchar *same = NULL;
+  g_autofree gchar *options = NULL;
+  g_autofree gchar *backend = NULL;
+  g_autofree gchar *model = NULL;
+  g_autofree gchar *expected = g_build_filename (tmp_dir, HASH_1, NULL);
+
+  ASSERT_EQ (model_artifact_init (tmp_dir, 0), 0);
+  EXPECT_TRUE (model_artifact_is_enabled ());
+
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "tensorflow-lite", "Delegate:GPU", &dir), 0);
+  EXPECT_TRUE (g_file_test (dir, G_FILE_TEST_IS_DIR));
+  EXPECT_TRUE (g_str_has_prefix (dir, expected));
+
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "tensorflow-lite", "Delegate:GPU", &same), 0);
+  EXPECT_STREQ (dir, same);
+
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "tensorflow-lite", "Delegate:NNAPI", &options), 0);
+  EXPECT_STRNE (dir, options);
+
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "openvino", "Delegate:GPU", &backend), 0);
+  EXPECT_STRNE (dir, backend);
+
+  EXPECT_EQ (model_artifact_acquire (HASH_2, "tensorflow-lite", "Delegate:GPU", &model), 0);
+  EXPECT_STRNE (dir, model);
+}
+
+/**
+ * @brief Test the artifacts of the models not registered are removed, except the ones in use.
+ */
+TEST_F (ModelArtifactTest, retain)
+{
+  g_autofree gchar *dir1 = NULL;
+  g_autofree gchar *dir2 = NULL;
+  const gchar *hashes[] = { HASH_1, NULL };
+
+  ASSERT_EQ (model_artifact_init (tmp_dir, 0), 0);
+
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "tensorflow-lite", NULL, &dir1), 0);
+  EXPECT_EQ (model_artifact_acquire (HASH_2, "tensorflow-lite", NULL, &dir2), 0);
+
+  /* The running pipeline uses the artifacts of the deleted model. */
+  model_artifact_retain (hashes);
+  EXPECT_TRUE (g_file_test (dir2, G_FILE_TEST_IS_DIR));
+
+  write_artifact (dir2, 16, time (NULL));
+  model_artifact_retain (hashes);
+  EXPECT_FALSE (g_file_test (dir2, G_FILE_TEST_EXISTS));
+  EXPECT_TRUE (g_file_test (dir1, G_FILE_TEST_IS_DIR));
+
+  write_artifact (dir1, 16, time (NULL));
+  model_artifact_retain (NULL);
+  EXPECT_FALSE (g_file_test (dir1, G_FILE_TEST_EXISTS));
+}
+
+/**
+ * @brief Test the least recently used artifacts are removed over the quota.
+ */
+TEST_F (ModelArtifactTest, quota)
+{
+  g_autofree gchar *dir1 = NULL;
+  g_autofree gchar *dir2 = NULL;
+  g_autofree gchar *dir3 = NULL;
+  g_autofree gchar *in_use = NULL;
+  guint64 usage = 0;
+  time_t now = time (NULL);
+  struct utimbuf oldest = { now - 40, now - 40 };
+
+  ASSERT_EQ (model_artifact_init (tmp_dir, 10000), 0);
+
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "tensorflow-lite", NULL, &dir1), 0);
+  write_artifact (dir1, 4096, now - 20);
+  EXPECT_EQ (model_artifact_acquire (HASH_2, "tensorflow-lite", NULL, &dir2), 0);
+  write_artifact (dir2, 4096, now - 30);
+
+  EXPECT_EQ (model_artifact_enforce_quota (&usage), 0);
+  EXPECT_EQ (usage, 8192U);
+
+  /* The dir3 is the oldest one but in use, so the dir2 is removed. */
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "openvino", NULL, &dir3), 0);
+  write_artifact (dir3, 4096, now - 40);
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "openvino", NULL, &in_use), 0);
+  EXPECT_STREQ (dir3, in_use);
+  EXPECT_EQ (utime (dir3, &oldest), 0);
+
+  EXPECT_EQ (model_artifact_enforce_quota (&usage), 0);
+  EXPECT_EQ (usage, 8192U);
+  EXPECT_TRUE (g_file_test (dir1, G_FILE_TEST_IS_DIR));
+  EXPECT_FALSE (g_file_test (dir2, G_FILE_TEST_EXISTS));
+  EXPECT_TRUE (g_file_test (dir3, G_FILE_TEST_IS_DIR));
+}
+
+/**
+ * @brief Test the artifact cache is disabled.
+ */
+TEST_F (ModelArtifactTest, disabled_n)
+{
+  g_autofree gchar *dir = NULL;
+
+  ASSERT_EQ (model_artifact_init (NULL, 0), 0);
+  EXPECT_FALSE (model_artifact_is_enabled ());
+
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "tensorflow-lite", NULL, &dir), -ENOTSUP);
+  EXPECT_EQ (model_artifact_enforce_quota (NULL), -ENOTSUP);
+  EXPECT_TRUE (dir == NULL);
+}
+
+/**
+ * @brief Test the invalid parameters.
+ */
+TEST_F (ModelArtifactTest, invalidParam_n)
+{
+  g_autofree gchar *dir = NULL;
+
+  ASSERT_EQ (model_artifact_init (tmp_dir, 0), 0);
+
+  EXPECT_EQ (model_artifact_acquire (NULL, "tensorflow-lite", NULL, &dir), -EINVAL);
+  EXPECT_EQ (model_artifact_acquire ("../escape", "tensorflow-lite", NULL, &dir), -EINVAL);
+  EXPECT_EQ (model_artifact_acquire (HASH_1, NULL, NULL, &dir), -EINVAL);
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "", NULL, &dir), -EINVAL);
+  EXPECT_EQ (model_artifact_acquire (HASH_1, "tensorflow-lite", NULL, NULL), -EINVAL);
+  EXPECT_TRUE (dir == NULL);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file        unittest_model_integrity.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the integrity verification of the registered model files
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "model-integrity.h"
+#include "model-store.h"
+
+/**
+ * @brief Test fixture with the temporary model file.
+ */
+class ModelIntegrityTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+  gchar *path;
+  gchar *hash;
+
+  /**
+   * @brief Create the model file and get its hash.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-integrity-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+
+    path = g_build_filename (tmp_dir, "model.tflite", NULL);
+    hash = NULL;
+    ASSERT_TRUE (g_file_set_contents (path, "model contents", -1, NULL));
+    ASSERT_EQ (model_store_hash_file (path, &hash), 0);
+  }
+
+  /**
+   * @brief Remove the model file and drop the cached results.
+   */
+  void TearDown () override
+  {
+    model_integrity_invalidate (NULL);
+
+    g_unlink (path);
+    g_rmdir (tmp_dir);
+    g_free (hash);
+    g_free (path);
+    g_free (tmp_dir);
+  }
+};
+
+/**
+ * @brief Test the unmodified file is verified.
+ */
+TEST_F (ModelIntegrityTest, verified)
+{
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_VERIFIED);
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_VERIFIED);
+  EXPECT_STREQ (model_integrity_to_string (MODEL_INTEGRITY_VERIFIED), "verified");
+}
+
+/**
+ * @brief Test the modified file is flagged.
+ */
+TEST_F (ModelIntegrityTest, modified_n)
+{
+  struct timespec times[2] = { { 0, UTIME_OMIT }, { 1, 0 } };
+
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_VERIFIED);
+
+  ASSERT_TRUE (g_file_set_contents (path, "modified model", -1, NULL));
+  ASSERT_EQ (utimensat (AT_FDCWD, path, times, 0), 0);
+
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_MISMATCH);
+  EXPECT_STREQ (model_integrity_to_string (MODEL_INTEGRITY_MISMATCH), "mismatch");
+}
+
+/**
+ * @brief Internal function to overwrite the file in place with the same size, and restore the mtime.
+ */
+static void
+_overwrite_keep_mtime (const gchar *path)
+{
+  struct stat st;
+  struct timespec times[2];
+  int fd;
+
+  ASSERT_EQ (g_stat (path, &st), 0);
+  fd = g_open (path, O_WRONLY, 0);
+  ASSERT_GE (fd, 0);
+  EXPECT_EQ (pwrite (fd, "M", 1, 0), 1);
+  close (fd);
+
+  times[0].tv_sec = 0;
+  times[0].tv_nsec = UTIME_OMIT;
+  times[1] = st.st_mtim;
+  ASSERT_EQ (utimensat (AT_FDCWD, path, times, 0), 0);
+}
+
+/**
+ * @brief Test the cached result is used while the fingerprint is not changed.
+ */
+TEST_F (ModelIntegrityTest, cached)
+{
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_VERIFIED);
+
+  _overwrite_keep_mtime (path);
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_VERIFIED);
+
+  /* Hash the file again after the cached result is dropped. */
+  model_integrity_invalidate (path);
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_MISMATCH);
+}
+
+/**
+ * @brief Test the result seeded at the registration is used without hashing the file.
+ */
+TEST_F (ModelIntegrityTest, seeded)
+{
+  g_autofree gchar *fingerprint = model_integrity_get_fingerprint (path);
+
+  ASSERT_TRUE (fingerprint != NULL);
+  model_integrity_seed (path, hash, fingerprint);
+
+  _overwrite_keep_mtime (path);
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_VERIFIED);
+
+  model_integrity_invalidate (path);
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_MISMATCH);
+}
+
+/**
+ * @brief Test the file changed while computing the hash is not seeded.
+ */
+TEST_F (ModelIntegrityTest, seedChanged_n)
+{
+  struct timespec times[2] = { { 0, UTIME_OMIT }, { 1, 0 } };
+  g_autofree gchar *fingerprint = model_integrity_get_fingerprint (path);
+
+  ASSERT_TRUE (g_file_set_contents (path, "modified model", -1, NULL));
+  ASSERT_EQ (utimensat (AT_FDCWD, path, times, 0), 0);
+
+  model_integrity_seed (path, hash, fingerprint);
+  model_integrity_seed (path, hash, NULL);
+  EXPECT_EQ (model_integrity_verify (path, hash, NULL), MODEL_INTEGRITY_MISMATCH);
+
+  EXPECT_TRUE (model_integrity_get_fingerprint (NULL) == NULL);
+  EXPECT_TRUE (model_integrity_get_fingerprint (tmp_dir) == NULL);
+}
+
+/**
+ * @brief Test the fingerprint registered in the DB is used after the cached results are dropped.
+ */
+TEST_F (ModelIntegrityTest, registeredFingerprint)
+{
+  g_autofree gchar *fingerprint = model_integrity_get_fingerprint (path);
+  struct timespec times[2] = { { 0, UTIME_OMIT }, { 1, 0 } };
+
+  _overwrite_keep_mtime (path);
+  EXPECT_EQ (model_integrity_verify (path, hash, fingerprint), MODEL_INTEGRITY_VERIFIED);
+
+  /* The registered fingerprint is not matched, the file is hashed. */
+  model_integrity_invalidate (NULL);
+  ASSERT_EQ (utimensat (AT_FDCWD, path, times, 0), 0);
+  EXPECT_EQ (model_integrity_verify (path, hash, fingerprint), MODEL_INTEGRITY_MISMATCH);
+}
+
+/**
+ * @brief Test the model without the hash or the file.
+ */
+TEST_F (ModelIntegrityTest, unknown_n)
+{
+  EXPECT_EQ (model_integrity_verify (path, NULL, NULL), MODEL_INTEGRITY_UNKNOWN);
+  EXPECT_EQ (model_integrity_verify (path, "", NULL), MODEL_INTEGRITY_UNKNOWN);
+  EXPECT_EQ (model_integrity_verify (NULL, hash, NULL), MODEL_INTEGRITY_UNKNOWN);
+  EXPECT_EQ (model_integrity_verify ("/nothing/model.tflite", hash, NULL), MODEL_INTEGRITY_UNKNOWN);
+  EXPECT_STREQ (model_integrity_to_string (MODEL_INTEGRITY_UNKNOWN), "unknown");
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
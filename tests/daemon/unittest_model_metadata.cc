@@ -0,0 +1,280 @@
+/**
+ * @file        unittest_model_metadata.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the metadata extraction of the model files
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+
+#include "log.h"
+#include "model-metadata.h"
+
+/**
+ * @brief Append the 32-bit integer and return its position.
+ */
+static gsize
+_put_u32 (GByteArray *fb, guint32 value)
+{
+  gsize pos = fb->len;
+  guint32 le = GUINT32_TO_LE (value);
+
+  g_byte_array_append (fb, (const guint8 *) &le, sizeof (le));
+  return pos;
+}
+
+/**
+ * @brief Write the offset at the position to refer the target.
+ */
+static void
+_patch_offset (GByteArray *fb, gsize pos, gsize target)
+{
+  guint32 le = GUINT32_TO_LE ((guint32) (target - pos));
+
+  memcpy (fb->data + pos, &le, sizeof (le));
+}
+
+/**
+ * @brief Append the table with the 4-byte fields, and return its position. The vtable is placed before the table.
+ */
+static gsize
+_put_table (GByteArray *fb, guint num_fields, guint present)
+{
+  gsize vtable = fb->len, table;
+  guint16 value;
+  guint i;
+
+  value = GUINT16_TO_LE (4 + 2 * num_fields);
+  g_byte_array_append (fb, (const guint8 *) &value, sizeof (value));
+  value = GUINT16_TO_LE (4 + 4 * num_fields);
+  g_byte_array_append (fb, (const guint8 *) &value, sizeof (value));
+
+  for (i = 0; i < num_fields; i++) {
+    value = GUINT16_TO_LE ((present & (1U << i)) ? 4 + 4 * i : 0);
+    g_byte_array_append (fb, (const guint8 *) &value, sizeof (value));
+  }
+
+  while (fb->len % 4)
+    g_byte_array_append (fb, (const guint8 *) "", 1);
+
+  table = _put_u32 (fb, (guint32) (fb->len - vtable));
+  for (i = 0; i < num_fields; i++)
+    _put_u32 (fb, 0);
+
+  return table;
+}
+
+/**
+ * @brief Append the vector of the integers and return its position.
+ */
+static gsize
+_put_vector (GByteArray *fb, const gint32 *values, guint32 length)
+{
+  gsize pos = _put_u32 (fb, length);
+  guint32 i;
+
+  for (i = 0; i < length; i++)
+    _put_u32 (fb, (guint32) values[i]);
+
+  return pos;
+}
+
+/**
+ * @brief Append the string and return its position.
+ */
+static gsize
+_put_string (GByteArray *fb, const gchar *str)
+{
+  gsize pos = _put_u32 (fb, strlen (str));
+
+  g_byte_array_append (fb, (const guint8 *) str, strlen (str) + 1);
+  while (fb->len % 4)
+    g_byte_array_append (fb, (const guint8 *) "", 1);
+
+  return pos;
+}
+
+/**
+ * @brief Append the tensor table and return its position.
+ */
+static gsize
+_put_tensor (GByteArray *fb, const gchar *name, gint type, const gint32 *shape, guint32 rank)
+{
+  gsize tensor = _put_table (fb, 4, (type >= 0) ? 0xbU : 0x9U);
+
+  /* The type is a byte in the slot of the field 1. */
+  if (type >= 0)
+    fb->data[tensor + 8] = (guint8) type;
+
+  _patch_offset (fb, tensor + 4, _put_vector (fb, shape, rank));
+  _patch_offset (fb, tensor + 16, _put_string (fb, name));
+  return tensor;
+}
+
+/**
+ * @brief Create the minimal TFLite model with an uint8 input and a float32 output.
+ */
+static GByteArray *
+_create_tflite (void)
+{
+  GByteArray *fb = g_byte_array_new ();
+  const gint32 in_shape[] = { 1, 224, 224, 3 };
+  const gint32 out_shape[] = { 1, 1001 };
+  const gint32 in_index[] = { 0 };
+  const gint32 out_index[] = { 1 };
+  gsize root, model, subgraphs, subgraph, tensors;
+
+  root = _put_u32 (fb, 0);
+  g_byte_array_append (fb, (const guint8 *) "TFL3", 4);
+
+  model = _put_table (fb, 3, 0x4U);
+  _patch_offset (fb, root, model);
+
+  subgraphs = _put_u32 (fb, 1);
+  _put_u32 (fb, 0);
+  _patch_offset (fb, model + 12, subgraphs);
+
+  subgraph = _put_table (fb, 3, 0x7U);
+  _patch_offset (fb, subgraphs + 4, subgraph);
+
+  tensors = _put_u32 (fb, 2);
+  _put_u32 (fb, 0);
+  _put_u32 (fb, 0);
+  _patch_offset (fb, subgraph + 4, tensors);
+  _patch_offset (fb, subgraph + 8, _put_vector (fb, in_index, 1));
+  _patch_offset (fb, subgraph + 12, _put_vector (fb, out_index, 1));
+
+  _patch_offset (fb, tensors + 4, _put_tensor (fb, "input", 3, in_shape, 4));
+  _patch_offset (fb, tensors + 8, _put_tensor (fb, "output", -1, out_shape, 2));
+
+  return fb;
+}
+
+/**
+ * @brief Test fixture with the temporary directory.
+ */
+class ModelMetadataTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+
+  /**
+   * @brief Create the temporary directory.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-metadata-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+  }
+
+  /**
+   * @brief Remove the temporary directory.
+   */
+  void TearDown () override
+  {
+    g_autofree gchar *cmd = g_strdup_printf ("rm -rf %s", tmp_dir);
+
+    EXPECT_EQ (system (cmd), 0);
+    g_free (tmp_dir);
+  }
+
+  /**
+   * @brief Create the file with the given contents.
+   */
+  gchar *create_file (const gchar *name, const guint8 *contents, gssize length)
+  {
+    gchar *path = g_build_filename (tmp_dir, name, NULL);
+
+    EXPECT_TRUE (g_file_set_contents (path, (const gchar *) contents, length, NULL));
+    return path;
+  }
+};
+
+/**
+ * @brief Test the tensors of the TFLite model.
+ */
+TEST_F (ModelMetadataTest, tflite)
+{
+  GByteArray *fb = _create_tflite ();
+  g_autofree gchar *path = create_file ("model.tflite", fb->data, fb->len);
+  g_autofree gchar *metadata = NULL;
+  g_autofree gchar *size = g_strdup_printf ("\"size\":%u", fb->len);
+
+  g_byte_array_unref (fb);
+
+  ASSERT_EQ (model_metadata_extract (path, &metadata), 0);
+  EXPECT_TRUE (strstr (metadata, "\"format\":\"tflite\"") != NULL);
+  EXPECT_TRUE (strstr (metadata, size) != NULL);
+  EXPECT_TRUE (strstr (metadata, "\"name\":\"input\",\"type\":\"uint8\",\"shape\":[1,224,224,3]") != NULL);
+  EXPECT_TRUE (strstr (metadata, "\"name\":\"output\",\"type\":\"float32\",\"shape\":[1,1001]") != NULL);
+}
+
+/**
+ * @brief Test the model of the unknown format.
+ */
+TEST_F (ModelMetadataTest, unknownFormat)
+{
+  g_autofree gchar *path = create_file ("model.bin", (const guint8 *) "not a model", -1);
+  g_autofree gchar *metadata = NULL;
+
+  ASSERT_EQ (model_metadata_extract (path, &metadata), 0);
+  EXPECT_TRUE (strstr (metadata, "\"format\":\"unknown\"") != NULL);
+  EXPECT_TRUE (strstr (metadata, "\"inputs\"") == NULL);
+}
+
+/**
+ * @brief Test the truncated TFLite model.
+ */
+TEST_F (ModelMetadataTest, truncated_n)
+{
+  GByteArray *fb = _create_tflite ();
+  g_autofree gchar *path = create_file ("model.tflite", fb->data, 40);
+  g_autofree gchar *metadata = NULL;
+
+  g_byte_array_unref (fb);
+
+  ASSERT_EQ (model_metadata_extract (path, &metadata), 0);
+  EXPECT_TRUE (strstr (metadata, "\"format\":\"tflite\"") != NULL);
+  EXPECT_TRUE (strstr (metadata, "\"inputs\"") == NULL);
+}
+
+/**
+ * @brief Test the model file that does not exist.
+ */
+TEST_F (ModelMetadataTest, noFile_n)
+{
+  g_autofree gchar *path = g_build_filename (tmp_dir, "nothing.tflite", NULL);
+  gchar *metadata = NULL;
+
+  EXPECT_EQ (model_metadata_extract (path, &metadata), -ENOENT);
+  EXPECT_TRUE (metadata == NULL);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,278 @@
+/**
+ * @file        unittest_model_prefetch.cc
+ * @date        17 Oct 2026
+ * @brief       Unit test for the page-cache warming of the activated models
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+
+#include "log.h"
+#include "model-prefetch.h"
+
+/**
+ * @brief Internal function to wait until the prefetch of the file is finished.
+ */
+static const gchar *
+_wait_prefetch (const gchar *path)
+{
+  const gchar *state = model_prefetch_get_state (path);
+  guint retry = 0;
+
+  while ((g_str_equal (state, "queued") || g_str_equal (state, "running")) && retry++ < 100) {
+    g_usleep (10000);
+    state = model_prefetch_get_state (path);
+  }
+
+  return state;
+}
+
+/**
+ * @brief Test the prefetch is not available when the budget is 0.
+ */
+TEST (modelPrefetch, disabled_n)
+{
+  model_prefetch_init (0);
+
+  EXPECT_FALSE (model_prefetch_is_enabled ());
+  model_prefetch_request ("/dev/null");
+  EXPECT_STREQ (model_prefetch_get_state ("/dev/null"), "none");
+
+  model_prefetch_fini ();
+}
+
+/**
+ * @brief Test the model files are warmed within the budget.
+ */
+TEST (modelPrefetch, budget)
+{
+  gchar *dir = g_dir_make_tmp ("mlagent-prefetch-XXXXXX", NULL);
+  g_autofree gchar *m1 = g_build_filename (dir, "m1.tflite", NULL);
+  g_autofree gchar *m2 = g_build_filename (dir, "m2.tflite", NULL);
+  g_autofree gchar *data = g_strnfill (3000, 'm');
+
+  ASSERT_TRUE (g_file_set_contents (m1, data, -1, NULL));
+  ASSERT_TRUE (g_file_set_contents (m2, data, -1, NULL));
+
+  model_prefetch_init (4000);
+  EXPECT_TRUE (model_prefetch_is_enabled ());
+
+  model_prefetch_request (m1);
+  EXPECT_STREQ (_wait_prefetch (m1), "done");
+
+  /* The second file is over the budget. */
+  model_prefetch_request (m2);
+  EXPECT_STREQ (model_prefetch_get_state (m2), "skipped");
+
+  /* Warm the file again, it is counted once. */
+  model_prefetch_request (m1);
+  EXPECT_STREQ (_wait_prefetch (m1), "done");
+
+  /* The file is read ahead, nothing keeps the daemon alive. */
+  EXPECT_FALSE (model_prefetch_is_running ());
+
+  model_prefetch_fini ();
+  EXPECT_STREQ (model_prefetch_get_state (m1), "none");
+
+  g_unlink (m1);
+  g_unlink (m2);
+  g_rmdir (dir);
+  g_free (dir);
+}
+
+/**
+ * @brief Test the budget of the deactivated model file is released.
+ */
+TEST (modelPrefetch, retain)
+{
+  gchar *dir = g_dir_make_tmp ("mlagent-prefetch-XXXXXX", NULL);
+  g_autofree gchar *m1 = g_build_filename (dir, "m1.tflite", NULL);
+  g_autofree gchar *m2 = g_build_filename (dir, "m2.tflite", NULL);
+  g_autofree gchar *data = g_strnfill (3000, 'm');
+  const gchar *activated[] = { m2, NULL };
+
+  ASSERT_TRUE (g_file_set_contents (m1, data, -1, NULL));
+  ASSERT_TRUE (g_file_set_contents (m2, data, -1, NULL));
+
+  model_prefetch_init (4000);
+
+  model_prefetch_request (m1);
+  EXPECT_STREQ (_wait_prefetch (m1), "done");
+
+  /* The second model is activated and the first one is deactivated. */
+  model_prefetch_retain (activated);
+  EXPECT_STREQ (model_prefetch_get_state (m1), "none");
+
+  model_prefetch_request (m2);
+  EXPECT_STREQ (_wait_prefetch (m2), "done");
+
+  /* The activated model keeps the state, and the budget is released when it is deleted. */
+  model_prefetch_retain (activated);
+  EXPECT_STREQ (model_prefetch_get_state (m2), "done");
+
+  model_prefetch_retain (NULL);
+  EXPECT_STREQ (model_prefetch_get_state (m2), "none");
+
+  model_prefetch_request (m1);
+  EXPECT_STREQ (_wait_prefetch (m1), "done");
+
+  model_prefetch_fini ();
+
+  g_unlink (m1);
+  g_unlink (m2);
+  g_rmdir (dir);
+  g_free (dir);
+}
+
+/**
+ * @brief Test the file that does not exist.
+ */
+TEST (modelPrefetch, noFile_n)
+{
+  model_prefetch_init (4096);
+
+  model_prefetch_request ("/nothing/model.tflite");
+  EXPECT_STREQ (model_prefetch_get_state ("/nothing/model.tflite"), "none");
+  EXPECT_STREQ (model_prefetch_get_state (NULL), "none");
+
+  model_prefetch_fini ();
+}
+
+/**
+ * @brief The callback to record the result of the files.
+ */
+static void
+_files_cb (gint result, const gchar *info, gpointer user_data)
+{
+  gchar **out = (gchar **) user_data;
+
+  g_atomic_pointer_set (out, g_strdup_printf ("%d %s", result, info));
+}
+
+/**
+ * @brief Internal function to wait for the result of the files.
+ */
+static const gchar *
+_wait_files (gchar **out)
+{
+  guint retry = 0;
+
+  while (!g_atomic_pointer_get (out) && retry++ < 100)
+    g_usleep (10000);
+
+  return (const gchar *) g_atomic_pointer_get (out);
+}
+
+/**
+ * @brief Test the files of a resource are validated and read ahead without the budget.
+ */
+TEST (modelPrefetch, files)
+{
+  gchar *dir = g_dir_make_tmp ("mlagent-prefetch-XXXXXX", NULL);
+  g_autofree gchar *r1 = g_build_filename (dir, "r1.dat", NULL);
+  g_autofree gchar *r2 = g_build_filename (dir, "r2.dat", NULL);
+  g_autofree gchar *data = g_strnfill (3000, 'r');
+  g_autofree gchar *out = NULL;
+  const gchar *paths[] = { r1, r2, NULL };
+
+  ASSERT_TRUE (g_file_set_contents (r1, data, -1, NULL));
+  ASSERT_TRUE (g_file_set_contents (r2, data, 1000, NULL));
+
+  model_prefetch_init (0);
+
+  EXPECT_EQ (model_prefetch_files (paths, _files_cb, &out, NULL), 0);
+  ASSERT_TRUE (_wait_files (&out) != NULL);
+  model_prefetch_fini ();
+
+  EXPECT_TRUE (g_str_has_prefix (out, "0 "));
+  EXPECT_TRUE (strstr (out, "\"total_bytes\":4000") != NULL);
+  EXPECT_TRUE (strstr (out, "r2.dat") != NULL);
+
+  g_unlink (r1);
+  g_unlink (r2);
+  g_rmdir (dir);
+  g_free (dir);
+}
+
+/**
+ * @brief Test the files of a resource more than the files in flight at a time.
+ */
+TEST (modelPrefetch, filesMany)
+{
+  gchar *dir = g_dir_make_tmp ("mlagent-prefetch-XXXXXX", NULL);
+  g_autoptr (GPtrArray) paths = g_ptr_array_new_with_free_func (g_free);
+  g_autofree gchar *out = NULL;
+  g_autofree gchar *expected = NULL;
+  const guint num = 100;
+  guint i;
+
+  for (i = 0; i < num; i++) {
+    gchar *path = g_strdup_printf ("%s/res%u.dat", dir, i);
+
+    ASSERT_TRUE (g_file_set_contents (path, "resource", -1, NULL));
+    g_ptr_array_add (paths, path);
+  }
+  g_ptr_array_add (paths, NULL);
+
+  EXPECT_EQ (model_prefetch_files ((const gchar *const *) paths->pdata, _files_cb, &out, NULL), 0);
+  ASSERT_TRUE (_wait_files (&out) != NULL);
+
+  expected = g_strdup_printf ("\"total_bytes\":%u", num * 8U);
+  EXPECT_TRUE (g_str_has_prefix (out, "0 "));
+  EXPECT_TRUE (strstr (out, expected) != NULL);
+
+  for (i = 0; i < num; i++)
+    g_unlink ((const gchar *) g_ptr_array_index (paths, i));
+  g_rmdir (dir);
+  g_free (dir);
+}
+
+/**
+ * @brief Test the files of a resource with the invalid ones.
+ */
+TEST (modelPrefetch, filesInvalid_n)
+{
+  g_autofree gchar *out = NULL;
+  const gchar *paths[] = { "/nothing/res.dat", "/dev", NULL };
+  const gchar *empty[] = { NULL };
+
+  EXPECT_EQ (model_prefetch_files (NULL, _files_cb, &out, NULL), -EINVAL);
+  EXPECT_EQ (model_prefetch_files (empty, _files_cb, &out, NULL), -EINVAL);
+  EXPECT_TRUE (out == NULL);
+
+  EXPECT_EQ (model_prefetch_files (paths, _files_cb, &out, NULL), 0);
+  ASSERT_TRUE (_wait_files (&out) != NULL);
+
+  EXPECT_TRUE (g_str_has_prefix (out, "-2 "));
+  EXPECT_TRUE (strstr (out, "\"total_bytes\":0") != NULL);
+  EXPECT_TRUE (strstr (out, "\"result\":-22") != NULL);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file        unittest_model_quota.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the disk quota and LRU eviction of the model store
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <json-glib/json-glib.h>
+#include <string.h>
+
+#include "log.h"
+#include "model-quota.h"
+#include "model-store.h"
+#include "modules.h"
+#include "service-db-util.h"
+
+/**
+ * @brief Test fixture with the temporary model store and DB.
+ */
+class ModelQuotaTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+  gchar *store_dir;
+
+  /**
+   * @brief Create the temporary directory, and enable the model store and the DB.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-quota-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+
+    store_dir = g_build_filename (tmp_dir, "store", NULL);
+    ASSERT_EQ (model_store_init (store_dir), 0);
+
+    svcdb_initialize (tmp_dir);
+    model_quota_init (0);
+  }
+
+  /**
+   * @brief Disable the model store and remove the temporary files.
+   */
+  void TearDown () override
+  {
+    g_autofree gchar *cmd = g_strdup_printf ("rm -rf %s", tmp_dir);
+
+    model_quota_fini ();
+    svcdb_finalize ();
+    model_store_fini ();
+    EXPECT_EQ (system (cmd), 0);
+
+    g_free (store_dir);
+    g_free (tmp_dir);
+  }
+
+  /**
+   * @brief Register the model file with the given contents.
+   */
+  guint add_model (const gchar *name, const gchar *contents, gboolean active)
+  {
+    g_autofree gchar *file = g_strdup_printf ("%s-%s.tflite", name, contents);
+    g_autofree gchar *path = g_build_filename (tmp_dir, file, NULL);
+    guint version = 0U;
+
+    EXPECT_TRUE (g_file_set_contents (path, contents, -1, NULL));
+    EXPECT_EQ (svcdb_model_add (name, path, active, "", "", &version), 0);
+    return version;
+  }
+
+  /**
+   * @brief Get the evicted models in the report, as the string of "name:version" joined by the comma.
+   */
+  gchar *get_evicted (const gchar *report)
+  {
+    JsonNode *root = json_from_string (report, NULL);
+    JsonArray *evicted;
+    GString *str = g_string_new (NULL);
+    guint i;
+
+    EXPECT_TRUE (root != NULL && JSON_NODE_HOLDS_OBJECT (root));
+    if (!root)
+      return g_string_free (str, FALSE);
+
+    evicted = json_object_get_array_member (json_node_get_object (root), "evicted");
+    for (i = 0; i < json_array_get_length (evicted); i++) {
+      JsonObject *model = json_array_get_object_element (evicted, i);
+
+      g_string_append_printf (str, "%s%s:%" G_GINT64_FORMAT, (i > 0) ? "," : "",
+          json_object_get_string_member (model, "name"),
+          json_object_get_int_member (model, "version"));
+    }
+
+    json_node_unref (root);
+    return g_string_free (str, FALSE);
+  }
+};
+
+/**
+ * @brief Test the least recently accessed inactive models are evicted first.
+ */
+TEST_F (ModelQuotaTest, evictLru)
+{
+  g_autofree gchar *report = NULL;
+  g_autofree gchar *evicted = NULL;
+  g_autofree gchar *model_info = NULL;
+  guint64 used = 0;
+
+  add_model ("quota", "version one", FALSE);
+  add_model ("quota", "version two", FALSE);
+  add_model ("quota", "version three", FALSE);
+  add_model ("quota", "version four", TRUE);
+
+  /* The version 1 is accessed, then it is evicted last. */
+  model_quota_touch ("quota", 1U);
+  EXPECT_EQ (model_quota_flush (), 0);
+
+  ASSERT_EQ (model_quota_evict (0, TRUE, 0U, &report), 0);
+  evicted = get_evicted (report);
+  EXPECT_STREQ (evicted, "quota:2,quota:3,quota:1");
+  EXPECT_TRUE (strstr (report, "\"dry_run\":true") != NULL);
+
+  /* The dry run deletes nothing. */
+  EXPECT_EQ (svcdb_model_get ("quota", 2U, &model_info), 0);
+  g_clear_pointer (&model_info, g_free);
+  g_clear_pointer (&report, g_free);
+  g_clear_pointer (&evicted, g_free);
+
+  ASSERT_EQ (model_quota_evict (0, FALSE, 1U, &report), 0);
+  evicted = get_evicted (report);
+  EXPECT_STREQ (evicted, "quota:2");
+  EXPECT_NE (svcdb_model_get ("quota", 2U, &model_info), 0);
+  g_clear_pointer (&model_info, g_free);
+
+  /* Only the active model is left. */
+  EXPECT_EQ (model_quota_evict (0, FALSE, 0U, NULL), 0);
+  EXPECT_EQ (svcdb_model_get ("quota", 4U, &model_info), 0);
+  EXPECT_EQ (model_store_get_usage (&used), 0);
+  EXPECT_EQ (used, strlen ("version four"));
+}
+
+/**
+ * @brief Test the pinned model and the blob shared with the active model are never evicted.
+ */
+TEST_F (ModelQuotaTest, pinnedAndShared)
+{
+  g_autofree gchar *report = NULL;
+  g_autofree gchar *evicted = NULL;
+
+  add_model ("pinned", "pinned contents", FALSE);
+  add_model ("shared", "shared contents", FALSE);
+  add_model ("active", "shared contents", TRUE);
+  add_model ("free", "free contents", FALSE);
+
+  EXPECT_EQ (svcdb_model_pin ("pinned", 1U, TRUE), 0);
+
+  ASSERT_EQ (model_quota_evict (0, TRUE, 0U, &report), 0);
+  evicted = get_evicted (report);
+  EXPECT_STREQ (evicted, "free:1");
+  g_clear_pointer (&report, g_free);
+  g_clear_pointer (&evicted, g_free);
+
+  EXPECT_EQ (svcdb_model_pin ("pinned", 1U, FALSE), 0);
+
+  ASSERT_EQ (model_quota_evict (0, TRUE, 0U, &report), 0);
+  evicted = get_evicted (report);
+  EXPECT_STREQ (evicted, "pinned:1,free:1");
+}
+
+/**
+ * @brief Test nothing is evicted under the quota.
+ */
+TEST_F (ModelQuotaTest, underQuota)
+{
+  g_autofree gchar *report = NULL;
+  g_autofree gchar *evicted = NULL;
+
+  add_model ("small", "small contents", FALSE);
+
+  ASSERT_EQ (model_quota_evict (G_MAXUINT32, FALSE, 0U, &report), 0);
+  evicted = get_evicted (report);
+  EXPECT_STREQ (evicted, "");
+  EXPECT_TRUE (strstr (report, "\"reclaimed\":0") != NULL);
+}
+
+/**
+ * @brief Test the eviction in the background keeps the daemon alive until it is done.
+ */
+TEST_F (ModelQuotaTest, evictScheduled)
+{
+  g_autofree gchar *model_info = NULL;
+  guint retry = 0;
+
+  add_model ("idle", "idle contents", FALSE);
+  EXPECT_FALSE (model_quota_is_evicting ());
+  EXPECT_EQ (busy_modules (NULL), 0);
+
+  /* The store is over the quota, the eviction is scheduled in the idle time. */
+  model_quota_init (1);
+  EXPECT_TRUE (model_quota_is_evicting ());
+  EXPECT_NE (busy_modules (NULL), 0);
+
+  while (model_quota_is_evicting () && retry++ < 100)
+    g_main_context_iteration (NULL, FALSE);
+
+  EXPECT_FALSE (model_quota_is_evicting ());
+  EXPECT_EQ (busy_modules (NULL), 0);
+  EXPECT_NE (svcdb_model_get ("idle", 1U, &model_info), 0);
+}
+
+/**
+ * @brief Test the eviction without the model store.
+ */
+TEST_F (ModelQuotaTest, noStore_n)
+{
+  gchar *report = NULL;
+
+  model_store_fini ();
+
+  EXPECT_EQ (model_quota_evict (0, TRUE, 0U, &report), -ENOTSUP);
+  EXPECT_TRUE (report == NULL);
+}
+
+/**
+ * @brief Test to pin the model which is not registered.
+ */
+TEST_F (ModelQuotaTest, pinInvalid_n)
+{
+  EXPECT_NE (svcdb_model_pin (NULL, 1U, TRUE), 0);
+  EXPECT_NE (svcdb_model_pin ("nothing", 0U, TRUE), 0);
+  EXPECT_NE (svcdb_model_pin ("nothing", 1U, TRUE), 0);
+  EXPECT_NE (svcdb_model_update_access (NULL, 1U), 0);
+  EXPECT_EQ (svcdb_model_update_access (NULL, 0U), 0);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
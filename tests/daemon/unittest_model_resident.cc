@@ -0,0 +1,219 @@
+/**
+ * @file        unittest_model_resident.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the resident cache of the model files
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "model-resident.h"
+
+/**
+ * @brief Test fixture with the temporary model files.
+ */
+class ModelResidentTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+
+  /**
+   * @brief Create the temporary directory.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-resident-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+  }
+
+  /**
+   * @brief Disable the cache and remove the temporary directory.
+   */
+  void TearDown () override
+  {
+    g_autofree gchar *cmd = g_strdup_printf ("rm -rf %s", tmp_dir);
+
+    model_resident_fini ();
+    EXPECT_EQ (system (cmd), 0);
+    g_free (tmp_dir);
+  }
+
+  /**
+   * @brief Create the file with the given size.
+   */
+  gchar *create_file (const gchar *name, gsize size, gchar fill)
+  {
+    gchar *path = g_build_filename (tmp_dir, name, NULL);
+    g_autofree gchar *contents = (gchar *) g_malloc (size);
+
+    memset (contents, fill, size);
+    EXPECT_TRUE (g_file_set_contents (path, contents, size, NULL));
+    return path;
+  }
+
+  /**
+   * @brief Open the file with the cache, and check the descriptor reads the file.
+   */
+  gboolean open_file (const gchar *path)
+  {
+    gboolean hit = FALSE;
+    gchar c = 0;
+    int fd = -1;
+
+    EXPECT_EQ (model_resident_open (path, &fd, &hit), 0);
+    EXPECT_GE (fd, 0);
+    EXPECT_EQ (read (fd, &c, 1), 1);
+    close (fd);
+
+    return hit;
+  }
+};
+
+/**
+ * @brief Test the file is resident after the first open.
+ */
+TEST_F (ModelResidentTest, hit)
+{
+  g_autofree gchar *path = create_file ("m1.tflite", 4096, 'a');
+  g_autofree gchar *stats = NULL;
+
+  model_resident_init (1024 * 1024, FALSE);
+  EXPECT_TRUE (model_resident_is_enabled ());
+
+  EXPECT_FALSE (open_file (path));
+  EXPECT_TRUE (open_file (path));
+  EXPECT_TRUE (open_file (path));
+
+  stats = model_resident_get_stats ();
+  EXPECT_TRUE (strstr (stats, "\"used\":4096") != NULL);
+  EXPECT_TRUE (strstr (stats, "\"hits\":2") != NULL);
+  EXPECT_TRUE (strstr (stats, "\"misses\":1") != NULL);
+}
+
+/**
+ * @brief Test the least recently used file is evicted over the budget.
+ */
+TEST_F (ModelResidentTest, evictLru)
+{
+  g_autofree gchar *m1 = create_file ("m1.tflite", 4096, 'a');
+  g_autofree gchar *m2 = create_file ("m2.tflite", 4096, 'b');
+  g_autofree gchar *m3 = create_file ("m3.tflite", 4096, 'c');
+  g_autofree gchar *stats = NULL;
+
+  model_resident_init (8192, FALSE);
+
+  EXPECT_FALSE (open_file (m1));
+  EXPECT_FALSE (open_file (m2));
+  EXPECT_TRUE (open_file (m1));
+
+  /* The m2 is the least recently used one. */
+  EXPECT_FALSE (open_file (m3));
+  EXPECT_TRUE (open_file (m1));
+  EXPECT_TRUE (open_file (m3));
+  EXPECT_FALSE (open_file (m2));
+
+  stats = model_resident_get_stats ();
+  EXPECT_TRUE (strstr (stats, "\"evictions\":2") != NULL);
+  EXPECT_TRUE (strstr (stats, "\"entries\":2") != NULL);
+}
+
+/**
+ * @brief Test the modified file is mapped again.
+ */
+TEST_F (ModelResidentTest, modified)
+{
+  g_autofree gchar *path = create_file ("m1.tflite", 4096, 'a');
+  g_autofree gchar *replaced = NULL;
+
+  model_resident_init (1024 * 1024, FALSE);
+
+  EXPECT_FALSE (open_file (path));
+
+  /* The file is replaced with another inode. */
+  replaced = create_file ("m1.tflite", 8192, 'b');
+  EXPECT_FALSE (open_file (path));
+  EXPECT_TRUE (open_file (path));
+
+  model_resident_invalidate (path);
+  EXPECT_FALSE (open_file (path));
+
+  model_resident_invalidate (NULL);
+  EXPECT_FALSE (open_file (path));
+}
+
+/**
+ * @brief Test the file larger than the budget is opened without the cache.
+ */
+TEST_F (ModelResidentTest, bypass)
+{
+  g_autofree gchar *path = create_file ("large.tflite", 8192, 'a');
+  g_autofree gchar *stats = NULL;
+
+  model_resident_init (4096, FALSE);
+
+  EXPECT_FALSE (open_file (path));
+  EXPECT_FALSE (open_file (path));
+
+  stats = model_resident_get_stats ();
+  EXPECT_TRUE (strstr (stats, "\"bypasses\":2") != NULL);
+  EXPECT_TRUE (strstr (stats, "\"used\":0") != NULL);
+}
+
+/**
+ * @brief Test the file is opened without the cache if it is disabled.
+ */
+TEST_F (ModelResidentTest, disabled)
+{
+  g_autofree gchar *path = create_file ("m1.tflite", 4096, 'a');
+
+  model_resident_init (0, FALSE);
+  EXPECT_FALSE (model_resident_is_enabled ());
+
+  EXPECT_FALSE (open_file (path));
+  EXPECT_FALSE (open_file (path));
+}
+
+/**
+ * @brief Test to open the file which does not exist.
+ */
+TEST_F (ModelResidentTest, noFile_n)
+{
+  g_autofree gchar *path = g_build_filename (tmp_dir, "nothing.tflite", NULL);
+  int fd = -1;
+
+  model_resident_init (1024 * 1024, FALSE);
+
+  EXPECT_EQ (model_resident_open (path, &fd, NULL), -ENOENT);
+  EXPECT_EQ (model_resident_open (tmp_dir, &fd, NULL), -EINVAL);
+  EXPECT_EQ (fd, -1);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,570 @@
+/**
+ * @file        unittest_model_store.cc
+ * @date        17 Oct 2026
+ * @brief       Unit test for the content-addressed model store
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "model-delta.h"
+#include "model-store.h"
+
+/**
+ * @brief Test fixture with the temporary model store.
+ */
+class ModelStoreTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+  gchar *store_dir;
+
+  /**
+   * @brief Create the temporary directory and enable the model store.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-store-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+
+    store_dir = g_build_filename (tmp_dir, "store", NULL);
+    ASSERT_EQ (model_store_init (store_dir), 0);
+  }
+
+  /**
+   * @brief Disable the model store and remove the temporary files.
+   */
+  void TearDown () override
+  {
+    g_autofree gchar *cmd = g_strdup_printf ("rm -rf %s", tmp_dir);
+
+    model_store_fini ();
+    EXPECT_EQ (system (cmd), 0);
+
+    g_free (store_dir);
+    g_free (tmp_dir);
+  }
+
+  /**
+   * @brief Create the file with the given contents.
+   */
+  gchar *create_file (const gchar *name, const gchar *contents, gssize length)
+  {
+    gchar *path = g_build_filename (tmp_dir, name, NULL);
+
+    EXPECT_TRUE (g_file_set_contents (path, contents, length, NULL));
+    return path;
+  }
+};
+
+/**
+ * @brief Test the byte-identical files share a blob.
+ */
+TEST_F (ModelStoreTest, dedup)
+{
+  g_autofree gchar *m1 = create_file ("m1.tflite", "model contents", -1);
+  g_autofree gchar *m2 = create_file ("m2.tflite", "model contents", -1);
+  g_autofree gchar *m3 = create_file ("m3.tflite", "other contents", -1);
+  g_autofree gchar *b1 = NULL, *b2 = NULL, *b3 = NULL;
+  g_autofree gchar *h1 = NULL, *h2 = NULL, *h3 = NULL;
+  GDir *dir;
+  const gchar *name;
+
+  ASSERT_EQ (model_store_add (m1, &b1, &h1), 0);
+  ASSERT_EQ (model_store_add (m2, &b2, &h2), 0);
+  ASSERT_EQ (model_store_add (m3, &b3, &h3), 0);
+
+  /* The staged copy of the duplicated file is removed. */
+  dir = g_dir_open (store_dir, 0, NULL);
+  ASSERT_TRUE (dir != NULL);
+  while ((name = g_dir_read_name (dir)) != NULL)
+    EXPECT_FALSE (g_str_has_prefix (name, ".import-"));
+  g_dir_close (dir);
+
+  EXPECT_STREQ (h1, h2);
+  EXPECT_STREQ (b1, b2);
+  EXPECT_STRNE (h1, h3);
+  EXPECT_TRUE (g_str_has_prefix (b1, store_dir));
+  EXPECT_TRUE (g_file_test (b1, G_FILE_TEST_IS_REGULAR));
+
+  EXPECT_EQ (model_store_remove (h1), 0);
+  EXPECT_FALSE (g_file_test (b1, G_FILE_TEST_EXISTS));
+  EXPECT_TRUE (g_file_test (b3, G_FILE_TEST_IS_REGULAR));
+}
+
+/**
+ * @brief Test the hash of the multi-chunk file is stable and matched with the stored blob.
+ */
+TEST_F (ModelStoreTest, largeFile)
+{
+  const gsize size = 10 * 1024 * 1024 + 123;
+  g_autofree gchar *data = (gchar *) g_malloc (size);
+  g_autofree gchar *path = NULL, *blob = NULL, *hash = NULL;
+  g_autofree gchar *h1 = NULL, *h2 = NULL;
+  gsize i;
+
+  for (i = 0; i < size; i++)
+    data[i] = (gchar) (i * 31);
+
+  path = create_file ("large.bin", data, size);
+
+  ASSERT_EQ (model_store_hash_file (path, &h1), 0);
+  ASSERT_EQ (model_store_add (path, &blob, &hash), 0);
+  ASSERT_EQ (model_store_hash_file (blob, &h2), 0);
+
+  EXPECT_STREQ (h1, hash);
+  EXPECT_STREQ (h2, hash);
+}
+
+/**
+ * @brief Test the model streamed from the file is same as the model added with the path.
+ */
+TEST_F (ModelStoreTest, fromFd)
+{
+  const gsize size = 8 * 1024 * 1024;
+  g_autofree gchar *data = (gchar *) g_malloc (size);
+  g_autofree gchar *path = NULL, *b1 = NULL, *b2 = NULL;
+  g_autofree gchar *h1 = NULL, *h2 = NULL, *h3 = NULL;
+  gsize i;
+  int fd;
+
+  /* The size is a multiple of the chunk size. */
+  for (i = 0; i < size; i++)
+    data[i] = (gchar) (i * 7);
+
+  path = create_file ("chunked.bin", data, size);
+  ASSERT_EQ (model_store_hash_file (path, &h1), 0);
+
+  fd = open (path, O_RDONLY);
+  ASSERT_GE (fd, 0);
+  EXPECT_EQ (model_store_add_from_fd (fd, &b1, &h2), 0);
+  close (fd);
+
+  EXPECT_STREQ (h1, h2);
+  EXPECT_TRUE (g_str_has_prefix (b1, store_dir));
+
+  /* The blob is not staged again. */
+  ASSERT_EQ (model_store_add (b1, &b2, &h3), 0);
+  EXPECT_STREQ (b1, b2);
+  EXPECT_STREQ (h1, h3);
+}
+
+/**
+ * @brief Data to write the model into the pipe.
+ */
+typedef struct {
+  int fd;
+  const gchar *data;
+  gsize size;
+} pipe_writer_s;
+
+/**
+ * @brief The thread to write the model into the pipe.
+ */
+static gpointer
+_write_pipe (gpointer user_data)
+{
+  pipe_writer_s *writer = (pipe_writer_s *) user_data;
+  gsize done = 0;
+
+  while (done < writer->size) {
+    ssize_t n = write (writer->fd, writer->data + done, writer->size - done);
+
+    if (n <= 0)
+      break;
+    done += n;
+  }
+
+  close (writer->fd);
+  return NULL;
+}
+
+/**
+ * @brief Test the model streamed from the pipe.
+ */
+TEST_F (ModelStoreTest, fromPipe)
+{
+  const gsize size = 5 * 1024 * 1024 + 17;
+  g_autofree gchar *data = (gchar *) g_malloc (size);
+  g_autofree gchar *path = NULL, *blob = NULL, *hash = NULL, *h1 = NULL;
+  pipe_writer_s writer;
+  GThread *thread;
+  int fds[2];
+  gsize i;
+
+  for (i = 0; i < size; i++)
+    data[i] = (gchar) (i * 13);
+
+  path = create_file ("piped.bin", data, size);
+  ASSERT_EQ (model_store_hash_file (path, &h1), 0);
+  ASSERT_EQ (pipe (fds), 0);
+
+  writer.fd = fds[1];
+  writer.data = data;
+  writer.size = size;
+  thread = g_thread_new ("pipe-writer", _write_pipe, &writer);
+
+  EXPECT_EQ (model_store_add_from_fd (fds[0], &blob, &hash), 0);
+  g_thread_join (thread);
+  close (fds[0]);
+
+  EXPECT_STREQ (h1, hash);
+  EXPECT_TRUE (g_file_test (blob, G_FILE_TEST_IS_REGULAR));
+}
+
+/**
+ * @brief Append the 64-bit integer to the delta.
+ */
+static void
+_append_u64 (GByteArray *delta, guint64 value)
+{
+  guint64 le = GUINT64_TO_LE (value);
+
+  g_byte_array_append (delta, (const guint8 *) &le, sizeof (le));
+}
+
+/**
+ * @brief Create the delta which replaces the range of the base.
+ */
+static GByteArray *
+_create_delta (gsize base_size, gsize offset, const gchar *data, gsize length, const gchar *hash)
+{
+  GByteArray *delta = g_byte_array_new ();
+  guint8 op;
+
+  g_byte_array_append (delta, (const guint8 *) MODEL_DELTA_MAGIC, MODEL_DELTA_MAGIC_LEN);
+  _append_u64 (delta, base_size);
+  g_byte_array_append (delta, (const guint8 *) hash, strlen (hash));
+
+  op = MODEL_DELTA_OP_COPY;
+  g_byte_array_append (delta, &op, 1);
+  _append_u64 (delta, 0);
+  _append_u64 (delta, offset);
+
+  op = MODEL_DELTA_OP_INSERT;
+  g_byte_array_append (delta, &op, 1);
+  _append_u64 (delta, length);
+  g_byte_array_append (delta, (const guint8 *) data, length);
+
+  op = MODEL_DELTA_OP_COPY;
+  g_byte_array_append (delta, &op, 1);
+  _append_u64 (delta, offset + length);
+  _append_u64 (delta, base_size - offset - length);
+
+  op = MODEL_DELTA_OP_END;
+  g_byte_array_append (delta, &op, 1);
+
+  return delta;
+}
+
+/**
+ * @brief Test the model reconstructed from the base and the delta.
+ */
+TEST_F (ModelStoreTest, delta)
+{
+  const gsize size = 6 * 1024 * 1024;
+  g_autofree gchar *data = (gchar *) g_malloc (size);
+  g_autofree gchar *base = NULL, *target = NULL, *delta_path = NULL;
+  g_autofree gchar *expected = NULL, *blob = NULL, *hash = NULL;
+  GByteArray *delta;
+  gsize i;
+  int fd;
+
+  for (i = 0; i < size; i++)
+    data[i] = (gchar) (i * 3);
+  base = create_file ("base.bin", data, size);
+
+  /* Fine-tune a small range of the base. */
+  memcpy (data + 4096, "fine-tuned weights", 18);
+  target = create_file ("target.bin", data, size);
+  ASSERT_EQ (model_store_hash_file (target, &expected), 0);
+
+  delta = _create_delta (size, 4096, "fine-tuned weights", 18, expected);
+  delta_path = create_file ("model.delta", (const gchar *) delta->data, delta->len);
+  g_byte_array_unref (delta);
+
+  fd = open (delta_path, O_RDONLY);
+  ASSERT_GE (fd, 0);
+  EXPECT_EQ (model_store_add_delta (base, fd, &blob, &hash), 0);
+  close (fd);
+
+  EXPECT_STREQ (hash, expected);
+  EXPECT_TRUE (g_str_has_prefix (blob, store_dir));
+}
+
+/**
+ * @brief Test the delta applied to the compressed base, which is decompressed before registering the delta.
+ */
+TEST_F (ModelStoreTest, deltaCompressedBase)
+{
+  const gsize size = 1024 * 1024;
+  g_autofree gchar *data = (gchar *) g_malloc0 (size);
+  g_autofree gchar *path = NULL, *base = NULL, *base_hash = NULL, *target = NULL;
+  g_autofree gchar *delta_path = NULL, *expected = NULL, *blob = NULL, *hash = NULL;
+  guint64 reclaimed = 0;
+  GByteArray *delta;
+  int fd;
+
+  path = create_file ("base.bin", data, size);
+  ASSERT_EQ (model_store_add (path, &base, &base_hash), 0);
+  ASSERT_EQ (model_store_compress (base_hash, &reclaimed), 0);
+  ASSERT_FALSE (g_file_test (base, G_FILE_TEST_EXISTS));
+
+  memcpy (data + 4096, "fine-tuned weights", 18);
+  target = create_file ("target.bin", data, size);
+  ASSERT_EQ (model_store_hash_file (target, &expected), 0);
+
+  delta = _create_delta (size, 4096, "fine-tuned weights", 18, expected);
+  delta_path = create_file ("model.delta", (const gchar *) delta->data, delta->len);
+  g_byte_array_unref (delta);
+
+  fd = open (delta_path, O_RDONLY);
+  ASSERT_GE (fd, 0);
+  EXPECT_EQ (model_store_add_delta (base, fd, &blob, &hash), -ENOENT);
+
+  EXPECT_EQ (model_store_materialize (base_hash, FALSE), 0);
+  ASSERT_EQ (lseek (fd, 0, SEEK_SET), 0);
+  EXPECT_EQ (model_store_add_delta (base, fd, &blob, &hash), 0);
+  close (fd);
+
+  EXPECT_STREQ (hash, expected);
+}
+
+/**
+ * @brief Test the delta applied to the wrong base.
+ */
+TEST_F (ModelStoreTest, deltaMismatch_n)
+{
+  const gchar *hash = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+  g_autofree gchar *base = create_file ("base.bin", "0123456789", -1);
+  g_autofree gchar *delta_path = NULL, *blob = NULL, *h = NULL;
+  GByteArray *delta;
+  int fd;
+
+  delta = _create_delta (10, 2, "xy", 2, hash);
+  delta_path = create_file ("model.delta", (const gchar *) delta->data, delta->len);
+  g_byte_array_unref (delta);
+
+  fd = open (delta_path, O_RDONLY);
+  ASSERT_GE (fd, 0);
+  EXPECT_EQ (model_store_add_delta (base, fd, &blob, &h), -EBADMSG);
+  close (fd);
+
+  EXPECT_TRUE (blob == NULL);
+}
+
+/**
+ * @brief Test the malformed delta.
+ */
+TEST_F (ModelStoreTest, deltaMalformed_n)
+{
+  const gchar *hash = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+  g_autofree gchar *base = create_file ("base.bin", "0123456789", -1);
+  g_autofree gchar *bad_magic = create_file ("magic.delta", "NOTDELTA", -1);
+  g_autofree gchar *out_of_base = NULL, *blob = NULL, *h = NULL;
+  GByteArray *delta;
+  int fd;
+
+  fd = open (bad_magic, O_RDONLY);
+  ASSERT_GE (fd, 0);
+  EXPECT_EQ (model_store_add_delta (base, fd, &blob, &h), -EBADMSG);
+  close (fd);
+
+  /* The copy operation reads out of the base. */
+  delta = _create_delta (20, 2, "xy", 2, hash);
+  out_of_base = create_file ("range.delta", (const gchar *) delta->data, delta->len);
+  g_byte_array_unref (delta);
+
+  fd = open (out_of_base, O_RDONLY);
+  ASSERT_GE (fd, 0);
+  EXPECT_EQ (model_store_add_delta (base, fd, &blob, &h), -EBADMSG);
+  close (fd);
+}
+
+/**
+ * @brief Test the blob of the inactive model is compressed and decompressed on demand.
+ */
+TEST_F (ModelStoreTest, compress)
+{
+  const gsize size = 1024 * 1024;
+  g_autofree gchar *data = (gchar *) g_malloc0 (size);
+  g_autofree gchar *path = NULL, *blob = NULL, *hash = NULL, *compressed = NULL;
+  guint64 reclaimed = 0, reported = 0;
+
+  memcpy (data, "compressible model", 18);
+  path = create_file ("zeros.bin", data, size);
+  ASSERT_EQ (model_store_add (path, &blob, &hash), 0);
+  compressed = g_strconcat (blob, ".gz", NULL);
+
+  EXPECT_FALSE (model_store_get_compressed_info (hash, NULL));
+  EXPECT_EQ (model_store_compress (hash, &reclaimed), 0);
+  EXPECT_GT (reclaimed, 0U);
+  EXPECT_FALSE (g_file_test (blob, G_FILE_TEST_EXISTS));
+  EXPECT_TRUE (g_file_test (compressed, G_FILE_TEST_IS_REGULAR));
+
+  EXPECT_TRUE (model_store_get_compressed_info (hash, &reported));
+  EXPECT_EQ (reported, reclaimed);
+
+  /* The decompressed copy is cached, the compressed one is kept. */
+  EXPECT_EQ (model_store_materialize (hash, FALSE), 0);
+  EXPECT_TRUE (g_file_test (blob, G_FILE_TEST_IS_REGULAR));
+  EXPECT_TRUE (g_file_test (compressed, G_FILE_TEST_IS_REGULAR));
+
+  /* The decompressed copy is removed by the cache budget only. */
+  EXPECT_EQ (model_store_compress (hash, &reclaimed), 0);
+  EXPECT_EQ (reclaimed, 0U);
+  EXPECT_TRUE (g_file_test (blob, G_FILE_TEST_IS_REGULAR));
+
+  /* The active model stays decompressed. */
+  EXPECT_EQ (model_store_materialize (hash, TRUE), 0);
+  EXPECT_FALSE (g_file_test (compressed, G_FILE_TEST_EXISTS));
+  EXPECT_EQ (model_store_compress (hash, &reclaimed), -EBUSY);
+  EXPECT_TRUE (g_file_test (blob, G_FILE_TEST_IS_REGULAR));
+
+  EXPECT_EQ (model_store_remove (hash), 0);
+}
+
+/**
+ * @brief Test the blob is compressed in the background while the store reports it.
+ */
+TEST_F (ModelStoreTest, compressAsync)
+{
+  const gsize size = 256 * 1024;
+  g_autofree gchar *data = (gchar *) g_malloc0 (size);
+  g_autofree gchar *path = NULL, *blob = NULL, *hash = NULL, *compressed = NULL;
+  guint retry = 0;
+
+  path = create_file ("async.bin", data, size);
+  ASSERT_EQ (model_store_add (path, &blob, &hash), 0);
+  compressed = g_strconcat (blob, ".gz", NULL);
+
+  EXPECT_FALSE (model_store_is_compressing ());
+  model_store_compress_async (hash);
+
+  while (model_store_is_compressing () && retry++ < 100)
+    g_usleep (10000);
+
+  /* The blob is compressed when the store is not compressing anymore. */
+  EXPECT_FALSE (model_store_is_compressing ());
+  EXPECT_TRUE (g_file_test (compressed, G_FILE_TEST_IS_REGULAR));
+
+  model_store_compress_async ("invalid");
+  EXPECT_FALSE (model_store_is_compressing ());
+
+  EXPECT_EQ (model_store_remove (hash), 0);
+}
+
+/**
+ * @brief Test the least recently used decompressed copies are evicted over the budget.
+ */
+TEST_F (ModelStoreTest, cacheBudget)
+{
+  const gsize size = 64 * 1024;
+  g_autofree gchar *data = (gchar *) g_malloc0 (size);
+  g_autofree gchar *p1 = NULL, *p2 = NULL, *b1 = NULL, *b2 = NULL, *h1 = NULL, *h2 = NULL;
+  guint64 reclaimed;
+
+  model_store_set_cache_budget (size);
+
+  data[0] = 1;
+  p1 = create_file ("m1.bin", data, size);
+  data[0] = 2;
+  p2 = create_file ("m2.bin", data, size);
+
+  ASSERT_EQ (model_store_add (p1, &b1, &h1), 0);
+  ASSERT_EQ (model_store_add (p2, &b2, &h2), 0);
+  ASSERT_EQ (model_store_compress (h1, &reclaimed), 0);
+  ASSERT_EQ (model_store_compress (h2, &reclaimed), 0);
+
+  EXPECT_EQ (model_store_materialize (h1, FALSE), 0);
+  EXPECT_TRUE (g_file_test (b1, G_FILE_TEST_IS_REGULAR));
+
+  EXPECT_EQ (model_store_materialize (h2, FALSE), 0);
+  EXPECT_TRUE (g_file_test (b2, G_FILE_TEST_IS_REGULAR));
+  EXPECT_FALSE (g_file_test (b1, G_FILE_TEST_EXISTS));
+
+  model_store_set_cache_budget (0);
+}
+
+/**
+ * @brief Test the blob which is not stored.
+ */
+TEST_F (ModelStoreTest, compressNoBlob_n)
+{
+  const gchar *hash = "0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef";
+  guint64 reclaimed;
+
+  EXPECT_EQ (model_store_compress (hash, &reclaimed), -ENOENT);
+  EXPECT_EQ (model_store_compress ("invalid", &reclaimed), -EINVAL);
+  EXPECT_EQ (model_store_materialize (hash, FALSE), -ENOENT);
+  EXPECT_FALSE (model_store_get_compressed_info (hash, NULL));
+}
+
+/**
+ * @brief Test the file that does not exist.
+ */
+TEST_F (ModelStoreTest, noFile_n)
+{
+  g_autofree gchar *path = g_build_filename (tmp_dir, "nothing.tflite", NULL);
+  gchar *blob = NULL, *hash = NULL;
+
+  EXPECT_EQ (model_store_add (path, &blob, &hash), -ENOENT);
+  EXPECT_TRUE (blob == NULL);
+  EXPECT_TRUE (hash == NULL);
+}
+
+/**
+ * @brief Test the invalid hash to remove.
+ */
+TEST_F (ModelStoreTest, removeInvalid_n)
+{
+  EXPECT_EQ (model_store_remove (NULL), -EINVAL);
+  EXPECT_EQ (model_store_remove ("../../etc/passwd"), -EINVAL);
+}
+
+/**
+ * @brief Test the model store is not available when it is disabled.
+ */
+TEST (modelStore, disabled_n)
+{
+  gchar *blob = NULL, *hash = NULL;
+
+  model_store_fini ();
+  EXPECT_FALSE (model_store_is_enabled ());
+  EXPECT_EQ (model_store_init (NULL), 0);
+  EXPECT_FALSE (model_store_is_enabled ());
+  EXPECT_EQ (model_store_add ("/dev/null", &blob, &hash), -ENOTSUP);
+  EXPECT_EQ (model_store_add_from_fd (0, &blob, &hash), -ENOTSUP);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
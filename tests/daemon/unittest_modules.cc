@@ -0,0 +1,265 @@
+/**
+ * @file        unittest_modules.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the initialization order of the modules
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <glib.h>
+
+#include "log.h"
+#include "modules.h"
+
+/**
+ * @brief The names of the initialized modules, in order.
+ */
+static GString *g_order = NULL;
+
+/**
+ * @brief Internal function to record the initialized module.
+ */
+static void
+_record (const gchar *name)
+{
+  g_string_append_printf (g_order, "%s%s", (g_order->len > 0) ? "," : "", name);
+}
+
+/**
+ * @brief The init callbacks of the test modules.
+ */
+static void
+_init_a (void *data)
+{
+  _record ("a");
+}
+
+/**
+ * @brief The init callbacks of the test modules.
+ */
+static void
+_init_b (void *data)
+{
+  _record ("b");
+}
+
+/**
+ * @brief The init callbacks of the test modules.
+ */
+static void
+_init_c (void *data)
+{
+  _record ("c");
+}
+
+/**
+ * @brief The probe callback of the module not available.
+ */
+static int
+_probe_fail (void *data)
+{
+  return -1;
+}
+
+/**
+ * @brief The busy callback of the module with the running jobs.
+ */
+static int
+_busy (void *data)
+{
+  return 1;
+}
+
+static const char *const depends_a[] = { "mod-a", NULL };
+static const char *const depends_b[] = { "mod-b", NULL };
+
+/**
+ * @brief Test fixture to initialize the test modules.
+ */
+class ModulesTest : public ::testing::Test
+{
+  protected:
+  GPtrArray *modules;
+
+  /**
+   * @brief Prepare the order of the initialized modules.
+   */
+  void SetUp () override
+  {
+    g_order = g_string_new (NULL);
+    modules = g_ptr_array_new ();
+  }
+
+  /**
+   * @brief Exit and remove the test modules.
+   */
+  void TearDown () override
+  {
+    guint i;
+
+    exit_modules (NULL);
+    for (i = 0; i < modules->len; i++)
+      remove_module ((const struct module_ops *) g_ptr_array_index (modules, i));
+
+    g_ptr_array_free (modules, TRUE);
+    g_string_free (g_order, TRUE);
+    g_order = NULL;
+  }
+
+  /**
+   * @brief Add the test module.
+   */
+  void add (const struct module_ops *module)
+  {
+    add_module (module);
+    g_ptr_array_add (modules, (gpointer) module);
+  }
+};
+
+/**
+ * @brief Test the eager module is initialized after the module it depends on.
+ */
+TEST_F (ModulesTest, eagerDepends)
+{
+  static const struct module_ops mod_a = { "mod-a", NULL, _init_a, NULL, MODULE_INIT_EAGER, NULL, depends_b };
+  static const struct module_ops mod_b = { "mod-b", NULL, _init_b, NULL, MODULE_INIT_EAGER, NULL, NULL };
+  static const struct module_ops mod_c = { "mod-c", NULL, _init_c, NULL, MODULE_INIT_ON_DEMAND, NULL, NULL };
+
+  add (&mod_a);
+  add (&mod_b);
+  add (&mod_c);
+
+  init_modules (NULL);
+  EXPECT_STREQ (g_order->str, "b,a");
+
+  /* The module on demand is initialized once. */
+  ensure_module ("mod-c");
+  ensure_module ("mod-c");
+  ensure_module ("mod-a");
+  EXPECT_STREQ (g_order->str, "b,a,c");
+}
+
+/**
+ * @brief Test the lazy module pulls in the module it depends on.
+ */
+TEST_F (ModulesTest, ensureDepends)
+{
+  static const struct module_ops mod_a = { "mod-a", NULL, _init_a, NULL, MODULE_INIT_BACKGROUND, NULL, NULL };
+  static const struct module_ops mod_b = { "mod-b", NULL, _init_b, NULL, MODULE_INIT_ON_DEMAND, NULL, depends_a };
+  guint retry = 0;
+
+  add (&mod_a);
+  add (&mod_b);
+
+  init_modules (NULL);
+  EXPECT_STREQ (g_order->str, "");
+
+  ensure_module ("mod-b");
+  EXPECT_STREQ (g_order->str, "a,b");
+
+  /* The background module is already initialized as the dependency. */
+  while (g_main_context_iteration (NULL, FALSE) && retry++ < 10)
+    ;
+  EXPECT_STREQ (g_order->str, "a,b");
+}
+
+/**
+ * @brief Test the background module is initialized in the idle time after the module it depends on.
+ */
+TEST_F (ModulesTest, backgroundDepends)
+{
+  static const struct module_ops mod_a = { "mod-a", NULL, _init_a, NULL, MODULE_INIT_ON_DEMAND, NULL, depends_b };
+  static const struct module_ops mod_b = { "mod-b", NULL, _init_b, NULL, MODULE_INIT_ON_DEMAND, NULL, NULL };
+  static const struct module_ops mod_c = { "mod-c", NULL, _init_c, NULL, MODULE_INIT_BACKGROUND, NULL, depends_a };
+  guint retry = 0;
+
+  add (&mod_a);
+  add (&mod_b);
+  add (&mod_c);
+
+  init_modules (NULL);
+  EXPECT_STREQ (g_order->str, "");
+
+  while (g_main_context_iteration (NULL, FALSE) && retry++ < 10)
+    ;
+  EXPECT_STREQ (g_order->str, "b,a,c");
+}
+
+/**
+ * @brief Test the circular dependencies initialize each module once.
+ */
+TEST_F (ModulesTest, circular_n)
+{
+  static const struct module_ops mod_a = { "mod-a", NULL, _init_a, NULL, MODULE_INIT_EAGER, NULL, depends_b };
+  static const struct module_ops mod_b = { "mod-b", NULL, _init_b, NULL, MODULE_INIT_EAGER, NULL, depends_a };
+
+  add (&mod_a);
+  add (&mod_b);
+
+  init_modules (NULL);
+  EXPECT_STREQ (g_order->str, "b,a");
+
+  ensure_module ("mod-a");
+  ensure_module ("mod-b");
+  EXPECT_STREQ (g_order->str, "b,a");
+}
+
+/**
+ * @brief Test the module failed to probe is not initialized, even as a dependency.
+ */
+TEST_F (ModulesTest, probeFail_n)
+{
+  static const struct module_ops mod_a = { "mod-a", _probe_fail, _init_a, NULL, MODULE_INIT_ON_DEMAND, NULL, NULL };
+  static const struct module_ops mod_b = { "mod-b", NULL, _init_b, NULL, MODULE_INIT_EAGER, NULL, depends_a };
+
+  add (&mod_a);
+  add (&mod_b);
+
+  init_modules (NULL);
+  EXPECT_STREQ (g_order->str, "b");
+
+  ensure_module ("mod-a");
+  ensure_module ("mod-unknown");
+  EXPECT_STREQ (g_order->str, "b");
+}
+
+/**
+ * @brief Test the module with the running jobs keeps the daemon alive.
+ */
+TEST_F (ModulesTest, busy)
+{
+  static const struct module_ops mod_a = { "mod-a", NULL, _init_a, NULL, MODULE_INIT_EAGER, NULL, NULL };
+  static const struct module_ops mod_b = { "mod-b", NULL, _init_b, NULL, MODULE_INIT_EAGER, _busy, NULL };
+
+  add (&mod_a);
+  init_modules (NULL);
+  EXPECT_EQ (busy_modules (NULL), 0);
+
+  add (&mod_b);
+  EXPECT_NE (busy_modules (NULL), 0);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
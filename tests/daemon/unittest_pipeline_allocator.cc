@@ -0,0 +1,139 @@
+/**
+ * @file        unittest_pipeline_allocator.cc
+ * @date        17 Oct 2026
+ * @brief       Unit test for the shared buffer allocator of launched pipelines
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <gst/gst.h>
+
+#include "log.h"
+#include "pipeline-allocator.h"
+
+/**
+ * @brief Test the allocator is not available when the limit is 0.
+ */
+TEST (pipelineAllocator, disabled_n)
+{
+  pipeline_allocator_init (0);
+
+  EXPECT_FALSE (pipeline_allocator_is_enabled ());
+  EXPECT_TRUE (pipeline_allocator_get () == NULL);
+
+  pipeline_allocator_fini ();
+}
+
+/**
+ * @brief Test the released memory is reused by the next allocation.
+ */
+TEST (pipelineAllocator, reuse)
+{
+  GstAllocator *allocator;
+  GstMemory *mem;
+  GstMapInfo map;
+  gpointer first;
+  pipeline_allocator_stats_s stats;
+
+  pipeline_allocator_init (1024 * 1024);
+  allocator = pipeline_allocator_get ();
+  ASSERT_TRUE (allocator != NULL);
+  EXPECT_STREQ (allocator->mem_type, PIPELINE_ALLOCATOR_MEM_TYPE);
+
+  mem = gst_allocator_alloc (allocator, 1000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+  first = map.data;
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+
+  pipeline_allocator_get_stats (&stats);
+  EXPECT_EQ (stats.in_use, 0U);
+  EXPECT_GT (stats.cached, 0U);
+
+  mem = gst_allocator_alloc (allocator, 1000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (map.data, first);
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+
+  pipeline_allocator_get_stats (&stats);
+  EXPECT_EQ (stats.reused, 1U);
+
+  gst_object_unref (allocator);
+  pipeline_allocator_fini ();
+
+  pipeline_allocator_get_stats (&stats);
+  EXPECT_EQ (stats.cached, 0U);
+}
+
+/**
+ * @brief Test the allocation over the memory cap falls back to the system memory.
+ */
+TEST (pipelineAllocator, limit)
+{
+  GstAllocator *allocator;
+  GstMemory *mems[8] = { NULL };
+  guint i, shared = 0;
+  pipeline_allocator_stats_s stats;
+
+  pipeline_allocator_init (4 * 16384);
+  allocator = pipeline_allocator_get ();
+  ASSERT_TRUE (allocator != NULL);
+
+  for (i = 0; i < G_N_ELEMENTS (mems); i++) {
+    mems[i] = gst_allocator_alloc (allocator, 10000, NULL);
+    ASSERT_TRUE (mems[i] != NULL);
+    if (mems[i]->allocator == allocator)
+      shared++;
+  }
+
+  EXPECT_GT (shared, 0U);
+  EXPECT_LT (shared, G_N_ELEMENTS (mems));
+
+  pipeline_allocator_get_stats (&stats);
+  EXPECT_LE (stats.peak, stats.limit);
+  EXPECT_EQ (stats.fallback, G_N_ELEMENTS (mems) - shared);
+
+  for (i = 0; i < G_N_ELEMENTS (mems); i++) {
+    if (mems[i])
+      gst_memory_unref (mems[i]);
+  }
+
+  /* Cached chunks are evicted for the chunk of the other size. */
+  mems[0] = gst_allocator_alloc (allocator, 40000, NULL);
+  EXPECT_TRUE (mems[0] != NULL);
+  if (mems[0])
+    gst_memory_unref (mems[0]);
+
+  gst_object_unref (allocator);
+  pipeline_allocator_fini ();
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file        unittest_pipeline_fusion.cc
+ * @date        17 Oct 2026
+ * @brief       Unit test for the fusion of pipelines sharing a source prefix
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <gst/gst.h>
+
+#include "log.h"
+#include "pipeline-fusion.h"
+
+/**
+ * @brief Internal function to run the main context, which removes the unlinked branches.
+ */
+static void
+_iterate_main_context (void)
+{
+  gint64 end_time = g_get_monotonic_time () + 500 * G_TIME_SPAN_MILLISECOND;
+
+  while (g_get_monotonic_time () < end_time) {
+    if (!g_main_context_iteration (NULL, FALSE))
+      g_usleep (10000);
+  }
+}
+
+/**
+ * @brief Test the non-linear pipeline is not fused.
+ */
+TEST (pipelineFusion, nonLinear_n)
+{
+  pipeline_fusion_branch_s *branch = NULL;
+
+  EXPECT_EQ (pipeline_fusion_launch ("fakesrc is-live=true ! tee name=t t. ! queue ! fakesink", &branch), 0);
+  EXPECT_TRUE (branch == NULL);
+
+  EXPECT_EQ (pipeline_fusion_launch ("fakesrc is-live=true ! \"unterminated", &branch), 0);
+  EXPECT_TRUE (branch == NULL);
+
+  EXPECT_EQ (pipeline_fusion_launch ("fakesrc is-live=true", &branch), 0);
+  EXPECT_TRUE (branch == NULL);
+}
+
+/**
+ * @brief Test the invalid parameters.
+ */
+TEST (pipelineFusion, invalidParam_n)
+{
+  pipeline_fusion_branch_s *branch = NULL;
+
+  EXPECT_LT (pipeline_fusion_launch (NULL, &branch), 0);
+  EXPECT_LT (pipeline_fusion_launch ("fakesrc is-live=true ! fakesink", NULL), 0);
+  EXPECT_LT (pipeline_fusion_launch ("fakesrc is-live=true ! invalid_element_name", &branch), 0);
+  EXPECT_TRUE (branch == NULL);
+}
+
+/**
+ * @brief Test the live pipelines sharing the prefix are started and stopped independently.
+ */
+TEST (pipelineFusion, sharedPrefix)
+{
+  pipeline_fusion_branch_s *b1 = NULL, *b2 = NULL;
+  GstState state;
+
+  ASSERT_EQ (pipeline_fusion_launch ("fakesrc is-live=true ! identity ! fakesink", &b1), 0);
+  ASSERT_TRUE (b1 != NULL);
+  ASSERT_EQ (pipeline_fusion_launch ("fakesrc is-live=true ! identity ! fakesink sync=false", &b2), 0);
+  ASSERT_TRUE (b2 != NULL);
+
+  EXPECT_NE (pipeline_fusion_set_state (b1, GST_STATE_PLAYING), GST_STATE_CHANGE_FAILURE);
+  EXPECT_NE (pipeline_fusion_get_state (b1, &state), GST_STATE_CHANGE_FAILURE);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+  EXPECT_NE (pipeline_fusion_get_state (b2, &state), GST_STATE_CHANGE_FAILURE);
+  EXPECT_EQ (state, GST_STATE_PAUSED);
+
+  EXPECT_NE (pipeline_fusion_set_state (b2, GST_STATE_PLAYING), GST_STATE_CHANGE_FAILURE);
+  g_usleep (100000);
+
+  EXPECT_NE (pipeline_fusion_set_state (b1, GST_STATE_PAUSED), GST_STATE_CHANGE_FAILURE);
+  EXPECT_NE (pipeline_fusion_get_state (b1, &state), GST_STATE_CHANGE_FAILURE);
+  EXPECT_EQ (state, GST_STATE_PAUSED);
+  EXPECT_NE (pipeline_fusion_get_state (b2, &state), GST_STATE_CHANGE_FAILURE);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  pipeline_fusion_destroy (b2);
+  pipeline_fusion_destroy (b1);
+  _iterate_main_context ();
+}
+
+/**
+ * @brief Test the branch is started again before the main context removes its unlinked elements.
+ */
+TEST (pipelineFusion, restartUnlinking)
+{
+  pipeline_fusion_branch_s *b1 = NULL, *b2 = NULL;
+  GstState state;
+
+  ASSERT_EQ (pipeline_fusion_launch ("fakesrc is-live=true ! queue ! fakesink", &b1), 0);
+  ASSERT_TRUE (b1 != NULL);
+  ASSERT_EQ (pipeline_fusion_launch ("fakesrc is-live=true ! queue ! fakesink sync=false", &b2), 0);
+  ASSERT_TRUE (b2 != NULL);
+
+  EXPECT_NE (pipeline_fusion_set_state (b1, GST_STATE_PLAYING), GST_STATE_CHANGE_FAILURE);
+  EXPECT_NE (pipeline_fusion_set_state (b2, GST_STATE_PLAYING), GST_STATE_CHANGE_FAILURE);
+  g_usleep (100000);
+
+  /* The stop does not wait for the tee. */
+  EXPECT_NE (pipeline_fusion_set_state (b1, GST_STATE_PAUSED), GST_STATE_CHANGE_FAILURE);
+  EXPECT_NE (pipeline_fusion_set_state (b1, GST_STATE_PLAYING), GST_STATE_CHANGE_FAILURE);
+  EXPECT_NE (pipeline_fusion_get_state (b1, &state), GST_STATE_CHANGE_FAILURE);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  _iterate_main_context ();
+
+  EXPECT_NE (pipeline_fusion_set_state (b1, GST_STATE_PAUSED), GST_STATE_CHANGE_FAILURE);
+  EXPECT_NE (pipeline_fusion_get_state (b2, &state), GST_STATE_CHANGE_FAILURE);
+  EXPECT_EQ (state, GST_STATE_PLAYING);
+
+  pipeline_fusion_destroy (b1);
+  pipeline_fusion_destroy (b2);
+  _iterate_main_context ();
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file        unittest_registry_watch.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the tracking of the registered files with inotify
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "log.h"
+#include "registry-watch.h"
+
+/**
+ * @brief Test fixture with the temporary registered files.
+ */
+class RegistryWatchTest : public ::testing::Test
+{
+  protected:
+  gchar *tmp_dir;
+  gchar *last_path;
+  gchar *last_event;
+  gboolean last_valid;
+  guint num_changes;
+
+  /**
+   * @brief The listener to record the last change.
+   */
+  static void changed_cb (const gchar *path, const gchar *event, gboolean valid, gpointer user_data)
+  {
+    RegistryWatchTest *test = (RegistryWatchTest *) user_data;
+
+    g_free (test->last_path);
+    g_free (test->last_event);
+    test->last_path = g_strdup (path);
+    test->last_event = g_strdup (event);
+    test->last_valid = valid;
+    test->num_changes++;
+  }
+
+  /**
+   * @brief Create the temporary directory and start the watch.
+   */
+  void SetUp () override
+  {
+    tmp_dir = g_dir_make_tmp ("mlagent-watch-XXXXXX", NULL);
+    ASSERT_TRUE (tmp_dir != NULL);
+
+    last_path = last_event = NULL;
+    last_valid = FALSE;
+    num_changes = 0;
+
+    ASSERT_EQ (registry_watch_init (), 0);
+    registry_watch_set_listener (REGISTRY_WATCH_MODEL, changed_cb, this);
+  }
+
+  /**
+   * @brief Stop the watch and remove the temporary directory.
+   */
+  void TearDown () override
+  {
+    g_autofree gchar *cmd = g_strdup_printf ("rm -rf %s", tmp_dir);
+
+    registry_watch_fini ();
+    EXPECT_EQ (system (cmd), 0);
+
+    g_free (last_path);
+    g_free (last_event);
+    g_free (tmp_dir);
+  }
+
+  /**
+   * @brief Create the file with the given contents.
+   */
+  gchar *create_file (const gchar *name, const gchar *contents)
+  {
+    gchar *path = g_build_filename (tmp_dir, name, NULL);
+
+    EXPECT_TRUE (g_file_set_contents (path, contents, -1, NULL));
+    return path;
+  }
+
+  /**
+   * @brief Run the main loop until the number of the changes reaches the given one, or 1 second passes.
+   */
+  void wait_changes (guint num)
+  {
+    gint64 end = g_get_monotonic_time () + G_USEC_PER_SEC;
+
+    while (num_changes < num && g_get_monotonic_time () < end)
+      g_main_context_iteration (NULL, FALSE);
+  }
+};
+
+/**
+ * @brief Test the deleted and created files are tracked.
+ */
+TEST_F (RegistryWatchTest, deleteAndCreate)
+{
+  g_autofree gchar *path = create_file ("model.tflite", "model contents");
+  g_autofree gchar *other = create_file ("other.tflite", "other contents");
+  const gchar *paths[] = { path, NULL };
+
+  registry_watch_sync (REGISTRY_WATCH_MODEL, paths);
+  EXPECT_TRUE (registry_watch_is_valid (path));
+
+  EXPECT_EQ (g_unlink (path), 0);
+  wait_changes (1U);
+  EXPECT_STREQ (last_path, path);
+  EXPECT_STREQ (last_event, "deleted");
+  EXPECT_FALSE (last_valid);
+  EXPECT_FALSE (registry_watch_is_valid (path));
+
+  /* The file is written to a temporary file and renamed. */
+  g_free (create_file ("model.tflite", "new contents"));
+  wait_changes (2U);
+  EXPECT_STREQ (last_event, "created");
+  EXPECT_TRUE (last_valid);
+  EXPECT_TRUE (registry_watch_is_valid (path));
+
+  /* The file not registered is not notified. */
+  EXPECT_EQ (g_unlink (other), 0);
+  wait_changes (3U);
+  EXPECT_EQ (num_changes, 2U);
+}
+
+/**
+ * @brief Test the moved file is tracked.
+ */
+TEST_F (RegistryWatchTest, move)
+{
+  g_autofree gchar *path = create_file ("model.tflite", "model contents");
+  g_autofree gchar *moved = g_build_filename (tmp_dir, "moved.tflite", NULL);
+  const gchar *paths[] = { path, NULL };
+
+  registry_watch_sync (REGISTRY_WATCH_MODEL, paths);
+
+  EXPECT_EQ (g_rename (path, moved), 0);
+  wait_changes (1U);
+  EXPECT_STREQ (last_event, "moved");
+  EXPECT_FALSE (registry_watch_is_valid (path));
+}
+
+/**
+ * @brief Test the directory created again is watched again at the sync.
+ */
+TEST_F (RegistryWatchTest, recreateDir)
+{
+  g_autofree gchar *dir = g_build_filename (tmp_dir, "models", NULL);
+  g_autofree gchar *path = g_build_filename (dir, "model.tflite", NULL);
+  const gchar *paths[] = { path, NULL };
+
+  ASSERT_EQ (g_mkdir (dir, 0755), 0);
+  ASSERT_TRUE (g_file_set_contents (path, "model contents", -1, NULL));
+  registry_watch_sync (REGISTRY_WATCH_MODEL, paths);
+
+  EXPECT_EQ (g_unlink (path), 0);
+  EXPECT_EQ (g_rmdir (dir), 0);
+  wait_changes (1U);
+  EXPECT_STREQ (last_event, "deleted");
+  EXPECT_FALSE (registry_watch_is_valid (path));
+
+  /* The directory and the file are created again, then the registry is synced. */
+  ASSERT_EQ (g_mkdir (dir, 0755), 0);
+  ASSERT_TRUE (g_file_set_contents (path, "model contents", -1, NULL));
+  registry_watch_sync (REGISTRY_WATCH_MODEL, paths);
+  EXPECT_TRUE (registry_watch_is_valid (path));
+
+  EXPECT_EQ (g_unlink (path), 0);
+  wait_changes (2U);
+  EXPECT_EQ (num_changes, 2U);
+  EXPECT_STREQ (last_event, "deleted");
+  EXPECT_FALSE (registry_watch_is_valid (path));
+}
+
+/**
+ * @brief Test the file is not tracked after it is removed from the registered files.
+ */
+TEST_F (RegistryWatchTest, unregister)
+{
+  g_autofree gchar *path = create_file ("model.tflite", "model contents");
+  const gchar *paths[] = { path, NULL };
+
+  registry_watch_sync (REGISTRY_WATCH_MODEL, paths);
+  registry_watch_sync (REGISTRY_WATCH_MODEL, NULL);
+
+  EXPECT_EQ (g_unlink (path), 0);
+  wait_changes (1U);
+  EXPECT_EQ (num_changes, 0U);
+
+  /* The file not watched is regarded as valid. */
+  EXPECT_TRUE (registry_watch_is_valid (path));
+}
+
+/**
+ * @brief Test the registered file which does not exist.
+ */
+TEST_F (RegistryWatchTest, noFile_n)
+{
+  g_autofree gchar *path = g_build_filename (tmp_dir, "nothing.tflite", NULL);
+  const gchar *paths[] = { path, "relative/model.tflite", NULL };
+
+  registry_watch_sync (REGISTRY_WATCH_MODEL, paths);
+  EXPECT_FALSE (registry_watch_is_valid (path));
+  EXPECT_TRUE (registry_watch_is_valid ("relative/model.tflite"));
+  EXPECT_TRUE (registry_watch_is_valid (NULL));
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file        unittest_rpk_config.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the streaming reader of the configuration file of the RPK package
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <errno.h>
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "rpk-config.h"
+
+/**
+ * @brief The entries passed from the reader, one line for each entry.
+ */
+static GString *g_entries = NULL;
+
+/**
+ * @brief Internal function to record the entry passed from the reader.
+ */
+static gint
+_record_entry (const rpk_config_entry_s *entry, gpointer user_data)
+{
+  const gchar *value = (entry->type == RPK_CONFIG_MODEL) ? entry->model :
+                       (entry->type == RPK_CONFIG_PIPELINE) ? entry->pipeline : entry->path;
+
+  g_string_append_printf (g_entries, "%d|%s|%s|%s|%s|%u\n", entry->type, entry->name, value,
+      entry->description ? entry->description : "-", entry->activate ? entry->activate : "-", entry->path_index);
+
+  return 0;
+}
+
+/**
+ * @brief Internal function to stop the scan at the second entry.
+ */
+static gint
+_stop_entry (const rpk_config_entry_s *entry, gpointer user_data)
+{
+  guint *count = (guint *) user_data;
+
+  return (++(*count) > 1U) ? -ECANCELED : 0;
+}
+
+/**
+ * @brief Internal function to scan the configuration string, and get the recorded entries.
+ */
+static gint
+_scan_string (const gchar *config, gchar **entries)
+{
+  gint ret;
+
+  g_entries = g_string_new (NULL);
+  ret = rpk_config_scan (config, strlen (config), _record_entry, NULL);
+  *entries = g_string_free (g_entries, FALSE);
+  g_entries = NULL;
+
+  return ret;
+}
+
+/**
+ * @brief Test the entries are passed in the order of the configuration, with the unescaped strings.
+ */
+TEST (rpkConfig, scanEntries)
+{
+  g_autofree gchar *entries = NULL;
+  const gchar *config = "{ \"Models\" : [ { \"name\" : \"a\", \"model\" : \"\\/path\\/a.tflite\", \"activate\" : \"true\" },"
+                        " { \"model\" : \"b.tflite\", \"name\" : \"b\", \"extra\" : { \"k\" : [ 1, -2.5e3, true, null ] } } ],"
+                        " \"pipeline\" : { \"name\" : \"p\", \"pipeline\" : \"tab\\there \\u00e9 \\ud83d\\ude00\" },"
+                        " \"resources\" : { \"path\" : [ \"r0\", \"r1\" ], \"name\" : \"r\", \"description\" : \"d\" } }\n";
+
+  EXPECT_EQ (_scan_string (config, &entries), 0);
+  EXPECT_STREQ (entries, "0|a|/path/a.tflite|-|true|0\n"
+                         "0|b|b.tflite|-|-|0\n"
+                         "1|p|tab\there \xc3\xa9 \xf0\x9f\x98\x80|-|-|0\n"
+                         "2|r|r0|d|-|0\n"
+                         "2|r|r1|d|-|1\n");
+}
+
+/**
+ * @brief Test the empty configuration and the empty array of the entries.
+ */
+TEST (rpkConfig, scanEmpty)
+{
+  g_autofree gchar *entries = NULL;
+  g_autofree gchar *empty_array = NULL;
+
+  EXPECT_EQ (_scan_string (" {} ", &entries), 0);
+  EXPECT_STREQ (entries, "");
+
+  EXPECT_EQ (_scan_string ("{\"models\":[]}", &empty_array), 0);
+  EXPECT_STREQ (empty_array, "");
+
+  /* Validate only, without the callback. */
+  EXPECT_EQ (rpk_config_scan ("{}", 2U, NULL, NULL), 0);
+}
+
+/**
+ * @brief Test the invalid configurations are rejected.
+ */
+TEST (rpkConfig, scanInvalid_n)
+{
+  const gchar *invalid[] = {
+    "",
+    "[]",
+    "{",
+    "{} }",
+    "{\"unknown\":{\"name\":\"a\"}}",
+    "{\"model\":{\"name\":\"a\"}}",
+    "{\"model\":{\"name\":\"\",\"model\":\"a.tflite\"}}",
+    "{\"model\":{\"name\":1,\"model\":\"a.tflite\"}}",
+    "{\"model\":{\"name\":\"a\",\"model\":\"a.tflite\",}}",
+    "{\"model\":{\"name\":\"a\",\"model\":\"a.tflite\",\"x\":01}}",
+    "{\"model\":{\"name\":\"a\",\"model\":\"a.tflite\",\"x\":tru}}",
+    "{\"model\":{\"name\":\"a\\ud800\",\"model\":\"a.tflite\"}}",
+    "{\"model\":{\"name\":\"a\\u0000\",\"model\":\"a.tflite\"}}",
+    "{\"model\":{\"name\":\"a\\x\",\"model\":\"a.tflite\"}}",
+    "{\"model\":{\"name\":\"a\nb\",\"model\":\"a.tflite\"}}",
+    "{\"model\":{\"name\":\"\xff\",\"model\":\"a.tflite\"}}",
+    "{\"pipeline\":{\"name\":\"a\",\"model\":\"a.tflite\"}}",
+    "{\"resource\":{\"name\":\"a\",\"path\":[]}}",
+    "{\"resource\":{\"name\":\"a\",\"path\":[\"r0\",\"\"]}}",
+    "{\"resource\":{\"name\":\"a\",\"path\":[\"r0\",1]}}",
+    "{\"model\":[],\"Model\":[]}",
+  };
+  g_autofree gchar *deep = NULL;
+  GString *nested = g_string_new ("{\"model\":{\"name\":\"a\",\"model\":\"a.tflite\",\"x\":");
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (invalid); i++)
+    EXPECT_EQ (rpk_config_scan (invalid[i], strlen (invalid[i]), NULL, NULL), -EINVAL) << invalid[i];
+
+  /* The nested values deeper than the limit */
+  for (i = 0; i < 100U; i++)
+    g_string_append_c (nested, '[');
+  for (i = 0; i < 100U; i++)
+    g_string_append_c (nested, ']');
+  g_string_append (nested, "}}");
+  deep = g_string_free (nested, FALSE);
+
+  EXPECT_EQ (rpk_config_scan (deep, strlen (deep), NULL, NULL), -EINVAL);
+  EXPECT_EQ (rpk_config_scan (NULL, 0U, NULL, NULL), -EINVAL);
+  EXPECT_EQ (rpk_config_scan_fd (-1, NULL, NULL), -EINVAL);
+}
+
+/**
+ * @brief Test the error of the callback stops the scan.
+ */
+TEST (rpkConfig, scanStop_n)
+{
+  const gchar *config = "{\"resource\":{\"name\":\"a\",\"path\":[\"r0\",\"r1\",\"r2\"]}}";
+  guint count = 0U;
+
+  EXPECT_EQ (rpk_config_scan (config, strlen (config), _stop_entry, &count), -ECANCELED);
+  EXPECT_EQ (count, 2U);
+}
+
+/**
+ * @brief Test the configuration file larger than the chunk, with the strings across the chunks.
+ */
+TEST (rpkConfig, scanFd)
+{
+  g_autofree gchar *path = NULL;
+  g_autofree gchar *name = g_strnfill (5000, 'n');
+  GString *config = g_string_new ("{\"resources\":{\"path\":[");
+  g_autofree gchar *contents = NULL;
+  g_autofree gchar *entries = NULL;
+  g_autofree gchar *last = NULL;
+  gsize length;
+  guint i, count = 0U;
+  const gchar *p;
+  int fd;
+
+  /* The paths are read again after the name at the end of the entry. */
+  for (i = 0; i < 2000U; i++)
+    g_string_append_printf (config, "%s\"\\/res\\/path_%04u\"", (i > 0) ? ", " : "", i);
+  g_string_append_printf (config, "],\"name\":\"%s\"}}\n", name);
+
+  length = config->len;
+  contents = g_string_free (config, FALSE);
+
+  fd = g_file_open_tmp ("unittest-rpk-config-XXXXXX.json", &path, NULL);
+  ASSERT_GE (fd, 0);
+  ASSERT_EQ (write (fd, contents, length), (ssize_t) length);
+
+  g_entries = g_string_new (NULL);
+  EXPECT_EQ (rpk_config_scan_fd (fd, _record_entry, NULL), 0);
+  entries = g_string_free (g_entries, FALSE);
+  g_entries = NULL;
+
+  last = g_strdup_printf ("2|%s|/res/path_1999|-|-|1999\n", name);
+  EXPECT_TRUE (g_str_has_suffix (entries, last));
+
+  for (p = entries; (p = strchr (p, '\n')) != NULL; p++)
+    count++;
+  EXPECT_EQ (count, 2000U);
+
+  /* The same configuration in the memory */
+  g_free (entries);
+  EXPECT_EQ (_scan_string (contents, &entries), 0);
+  EXPECT_TRUE (g_str_has_suffix (entries, last));
+
+  /* The file truncated in the middle */
+  ASSERT_EQ (ftruncate (fd, (off_t) (length / 2)), 0);
+  EXPECT_EQ (rpk_config_scan_fd (fd, NULL, NULL), -EINVAL);
+
+  close (fd);
+  g_remove (path);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
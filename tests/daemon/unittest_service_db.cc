@@ -9,6 +9,11 @@
 
 #include <gtest/gtest.h>
 #include <gio/gio.h>
+#include <glib/gstdio.h>
+#include <errno.h>
+#include <json-glib/json-glib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include "log.h"
 #include "service-db.hh"
@@ -859,6 +864,539 @@ TEST (serviceDBUtil, model_get_all_n)
   svcdb_finalize ();
 }
 
+/**
+ * @brief Test the activated models of all names are listed.
+ */
+TEST (serviceDBUtil, model_list_activated)
+{
+  gint ret;
+  guint v1, v2;
+  gchar *models = NULL;
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_model_add ("test_list_a", "test_model_a", true, "", "", &v1);
+  EXPECT_EQ (ret, 0);
+  ret = svcdb_model_add ("test_list_b", "test_model_b", false, "", "", &v2);
+  EXPECT_EQ (ret, 0);
+
+  ret = svcdb_model_list_activated (&models);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (g_strstr_len (models, -1, "test_model_a") != NULL);
+  EXPECT_TRUE (g_strstr_len (models, -1, "test_model_b") == NULL);
+  g_free (models);
+
+  ret = svcdb_model_list_activated (NULL);
+  EXPECT_NE (ret, 0);
+
+  EXPECT_EQ (svcdb_model_delete ("test_list_a", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_model_delete ("test_list_b", 0U, TRUE), 0);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Test the blobs referred by the models are listed with the active state.
+ */
+TEST (serviceDBUtil, model_list_blobs)
+{
+  gint ret;
+  gchar *blobs = NULL;
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_model_list_blobs (&blobs);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (g_str_has_prefix (blobs, "["));
+  g_free (blobs);
+
+  ret = svcdb_model_list_blobs (NULL);
+  EXPECT_NE (ret, 0);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Test the paths of the registered models and resources are listed.
+ */
+TEST (serviceDBUtil, list_paths)
+{
+  gint ret;
+  guint version = 0U;
+  gchar *paths = NULL;
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_model_add ("test_paths", "/path/to/paths.tflite", false, "", "", &version);
+  EXPECT_EQ (ret, 0);
+  ret = svcdb_resource_add ("test_paths", "/path/to/paths.dat", "", "");
+  EXPECT_EQ (ret, 0);
+
+  ret = svcdb_model_list_paths (&paths);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (g_strstr_len (paths, -1, "\"/path/to/paths.tflite\"") != NULL);
+  EXPECT_TRUE (g_strstr_len (paths, -1, "/path/to/paths.dat") == NULL);
+  g_free (paths);
+
+  ret = svcdb_resource_list_paths (&paths);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (g_strstr_len (paths, -1, "\"/path/to/paths.dat\"") != NULL);
+  g_free (paths);
+
+  EXPECT_NE (svcdb_model_list_paths (NULL), 0);
+  EXPECT_NE (svcdb_resource_list_paths (NULL), 0);
+
+  EXPECT_EQ (svcdb_model_delete ("test_paths", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_resource_delete ("test_paths"), 0);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Test the registered names are listed with the pattern, a page at a time.
+ */
+TEST (serviceDBUtil, list_names)
+{
+  gint ret;
+  guint version = 0U;
+  gchar *list = NULL;
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_model_add ("test_list_a", "/path/to/a.tflite", false, "", "", &version);
+  EXPECT_EQ (ret, 0);
+  ret = svcdb_model_add ("test_list_a", "/path/to/a2.tflite", false, "", "", &version);
+  EXPECT_EQ (ret, 0);
+  ret = svcdb_model_add ("test_list_b", "/path/to/b.tflite", false, "", "", &version);
+  EXPECT_EQ (ret, 0);
+  ret = svcdb_model_add ("test_list_c", "/path/to/c.tflite", false, "", "", &version);
+  EXPECT_EQ (ret, 0);
+  ret = svcdb_pipeline_set ("test_list_a", "videotestsrc ! fakesink");
+  EXPECT_EQ (ret, 0);
+
+  /* The versions of a model are listed once. */
+  ret = svcdb_list_names ("model", "test_list_*", NULL, 2U, &list);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (list, "{\"names\":[\"test_list_a\",\"test_list_b\"],\"cursor\":\"test_list_b\"}");
+  g_free (list);
+
+  ret = svcdb_list_names ("model", "test_list_*", "test_list_b", 2U, &list);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (list, "{\"names\":[\"test_list_c\"],\"cursor\":\"\"}");
+  g_free (list);
+
+  ret = svcdb_list_names ("model", "test_list_[ac]", NULL, 0U, &list);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (list, "{\"names\":[\"test_list_a\",\"test_list_c\"],\"cursor\":\"\"}");
+  g_free (list);
+
+  /* The names of the other kinds are not listed. */
+  ret = svcdb_list_names ("pipeline", "test_list_*", NULL, 0U, &list);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (list, "{\"names\":[\"test_list_a\"],\"cursor\":\"\"}");
+  g_free (list);
+
+  ret = svcdb_list_names ("resource", "test_list_*", NULL, 0U, &list);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (list, "{\"names\":[],\"cursor\":\"\"}");
+  g_free (list);
+
+  EXPECT_EQ (svcdb_model_delete ("test_list_a", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_model_delete ("test_list_b", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_model_delete ("test_list_c", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_pipeline_delete ("test_list_a"), 0);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Negative test for service-db util. Invalid param case.
+ */
+TEST (serviceDBUtil, list_names_n)
+{
+  gchar *list = NULL;
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  EXPECT_EQ (svcdb_list_names (NULL, NULL, NULL, 0U, &list), -EINVAL);
+  EXPECT_EQ (svcdb_list_names ("unknown", NULL, NULL, 0U, &list), -EINVAL);
+  EXPECT_EQ (svcdb_list_names ("model", NULL, NULL, 0U, NULL), -EINVAL);
+  EXPECT_TRUE (list == NULL);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Test for service-db util. Install the configuration at once.
+ */
+TEST (serviceDBUtil, install)
+{
+  gint ret;
+  gchar *models = NULL;
+  gchar *info = NULL;
+  const gchar *config = "{\"models\":[{\"name\":\"test_install\",\"model\":\"/path/to/a.tflite\",\"activate\":\"true\"},"
+                        "{\"name\":\"test_install\",\"model\":\"/path/to/b.tflite\"}],"
+                        "\"pipeline\":{\"name\":\"test_install\",\"pipeline\":\"videotestsrc ! fakesink\"},"
+                        "\"resources\":[{\"name\":\"test_install\",\"path\":[\"/path/to/a.jpg\",\"/path/to/b.jpg\"]}]}";
+  const gchar *invalid = "{\"model\":{\"name\":\"test_install_n\",\"model\":\"/path/to/a.tflite\"},"
+                         "\"resource\":{\"path\":\"/path/to/a.jpg\"}}";
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_install (config, "", &models);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (models, "[{\"name\":\"test_install\",\"version\":1,\"active\":true},"
+                        "{\"name\":\"test_install\",\"version\":2,\"active\":false}]");
+  g_free (models);
+  models = NULL;
+
+  ret = svcdb_model_get ("test_install", 2U, &info);
+  EXPECT_EQ (ret, 0);
+  g_free (info);
+  ret = svcdb_pipeline_get ("test_install", &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (info, "videotestsrc ! fakesink");
+  g_free (info);
+  ret = svcdb_resource_get ("test_install", &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (strstr (info, "/path/to/b.jpg") != NULL);
+  g_free (info);
+  info = NULL;
+
+  /* The resource without the name fails and the model before it is not registered. */
+  ret = svcdb_install (invalid, "", &models);
+  EXPECT_EQ (ret, -EINVAL);
+  EXPECT_TRUE (models == NULL);
+  ret = svcdb_model_get ("test_install_n", 0U, &info);
+  EXPECT_NE (ret, 0);
+  EXPECT_TRUE (info == NULL);
+
+  EXPECT_EQ (svcdb_model_delete ("test_install", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_pipeline_delete ("test_install"), 0);
+  EXPECT_EQ (svcdb_resource_delete ("test_install"), 0);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Test for service-db util. Upgrade the package with the changed entries only.
+ */
+TEST (serviceDBUtil, upgrade)
+{
+  gint ret;
+  gchar *models = NULL;
+  gchar *info = NULL;
+  gchar *dir = g_dir_make_tmp ("mlagent-upgrade-XXXXXX", NULL);
+  g_autofree gchar *path_a = g_build_filename (dir, "a.tflite", NULL);
+  g_autofree gchar *path_b = g_build_filename (dir, "b.tflite", NULL);
+  g_autofree gchar *path_c = g_build_filename (dir, "c.tflite", NULL);
+  g_autofree gchar *config = NULL;
+  g_autofree gchar *upgrade = NULL;
+  const gchar *app_info = "{\"is_rpk\":\"T\",\"pkg_id\":\"test_upgrade_pkg\",\"res_version\":\"1.0\"}";
+  const gchar *new_app_info = "{\"is_rpk\":\"T\",\"pkg_id\":\"test_upgrade_pkg\",\"res_version\":\"2.0\"}";
+
+  ASSERT_TRUE (g_file_set_contents (path_a, "model-a", -1, NULL));
+  ASSERT_TRUE (g_file_set_contents (path_b, "model-b", -1, NULL));
+  ASSERT_TRUE (g_file_set_contents (path_c, "model-c", -1, NULL));
+
+  config = g_strdup_printf ("{\"models\":[{\"name\":\"test_upgrade_a\",\"model\":\"%s\",\"activate\":\"true\"},"
+                            "{\"name\":\"test_upgrade_b\",\"model\":\"%s\",\"activate\":\"true\"}],"
+                            "\"resources\":{\"name\":\"test_upgrade\",\"path\":[\"/path/to/a.jpg\",\"/path/to/b.jpg\"]}}",
+      path_a, path_b);
+  upgrade = g_strdup_printf ("{\"models\":[{\"name\":\"test_upgrade_a\",\"model\":\"%s\",\"activate\":\"true\"},"
+                             "{\"name\":\"test_upgrade_b\",\"model\":\"%s\",\"activate\":\"true\"}],"
+                             "\"resources\":{\"name\":\"test_upgrade\",\"path\":[\"/path/to/a.jpg\",\"/path/to/c.jpg\"]}}",
+      path_a, path_c);
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_install (config, app_info, &models);
+  EXPECT_EQ (ret, 0);
+  g_free (models);
+  models = NULL;
+
+  /* The unchanged model keeps the version, and the changed one is registered as a new version. */
+  ret = svcdb_upgrade (upgrade, new_app_info, &models);
+  EXPECT_EQ (ret, 0);
+  EXPECT_STREQ (models, "[{\"name\":\"test_upgrade_a\",\"version\":1,\"active\":true},"
+                        "{\"name\":\"test_upgrade_b\",\"version\":2,\"active\":true}]");
+  g_free (models);
+
+  ret = svcdb_model_get ("test_upgrade_a", 1U, &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (strstr (info, "2.0") != NULL);
+  g_free (info);
+  info = NULL;
+
+  ret = svcdb_model_get ("test_upgrade_b", 1U, &info);
+  EXPECT_NE (ret, 0);
+  EXPECT_TRUE (info == NULL);
+
+  ret = svcdb_resource_get ("test_upgrade", &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (strstr (info, "/path/to/c.jpg") != NULL);
+  EXPECT_TRUE (strstr (info, "/path/to/b.jpg") == NULL);
+  g_free (info);
+
+  /* The entries removed from the package are deleted. */
+  ret = svcdb_upgrade ("{\"model\":{\"name\":\"test_upgrade_other\",\"model\":\"/path/to/other.tflite\"}}",
+      new_app_info, &models);
+  EXPECT_EQ (ret, 0);
+  g_free (models);
+  info = NULL;
+
+  EXPECT_NE (svcdb_model_get ("test_upgrade_a", 0U, &info), 0);
+  EXPECT_NE (svcdb_resource_get ("test_upgrade", &info), 0);
+  EXPECT_TRUE (info == NULL);
+
+  EXPECT_EQ (svcdb_model_delete ("test_upgrade_other", 0U, TRUE), 0);
+
+  svcdb_finalize ();
+
+  g_remove (path_a);
+  g_remove (path_b);
+  g_remove (path_c);
+  g_rmdir (dir);
+  g_free (dir);
+}
+
+/**
+ * @brief Negative test for service-db util. Invalid param case.
+ */
+TEST (serviceDBUtil, upgrade_n)
+{
+  gchar *models = NULL;
+  const gchar *config = "{\"pipeline\":{\"name\":\"test\",\"pipeline\":\"videotestsrc ! fakesink\"}}";
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  EXPECT_EQ (svcdb_upgrade (NULL, "{\"pkg_id\":\"test\"}", &models), -EINVAL);
+  EXPECT_EQ (svcdb_upgrade (config, NULL, &models), -EINVAL);
+  EXPECT_EQ (svcdb_upgrade (config, "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_upgrade (config, "{\"is_rpk\":\"T\"}", &models), -EINVAL);
+  EXPECT_EQ (svcdb_upgrade (config, "{\"pkg_id\":\"test\"}", NULL), -EINVAL);
+  EXPECT_TRUE (models == NULL);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Test for service-db util. Import the configurations of the packages at once.
+ */
+TEST (serviceDBUtil, import)
+{
+  gint ret;
+  guint num_models = 0U;
+  gchar *info = NULL;
+  const gchar *configs[] = {
+    "{\"model\":{\"name\":\"test_import_a\",\"model\":\"/path/to/a.tflite\",\"activate\":\"true\"}}",
+    "{\"models\":[{\"name\":\"test_import_b\",\"model\":\"/path/to/b.tflite\"}],"
+    "\"pipeline\":{\"name\":\"test_import\",\"pipeline\":\"videotestsrc ! fakesink\"}}",
+    "{\"resource\":{\"name\":\"test_import\"}}",
+  };
+  const gchar *app_infos[] = { "{\"is_rpk\":\"T\",\"pkg_id\":\"test_import_pkg\"}", "", NULL };
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  /* The invalid configuration fails the import, and nothing is imported. */
+  ret = svcdb_import (3U, configs, app_infos, &num_models);
+  EXPECT_EQ (ret, -EINVAL);
+  EXPECT_NE (svcdb_model_get ("test_import_a", 0U, &info), 0);
+  EXPECT_NE (svcdb_pipeline_get ("test_import", &info), 0);
+  EXPECT_TRUE (info == NULL);
+
+  ret = svcdb_import (2U, configs, app_infos, &num_models);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (num_models, 2U);
+
+  ret = svcdb_model_get ("test_import_a", 1U, &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (strstr (info, "test_import_pkg") != NULL);
+  g_free (info);
+  info = NULL;
+
+  ret = svcdb_pipeline_get ("test_import", &info);
+  EXPECT_EQ (ret, 0);
+  g_free (info);
+
+  EXPECT_EQ (svcdb_model_delete ("test_import_a", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_model_delete ("test_import_b", 0U, TRUE), 0);
+  EXPECT_EQ (svcdb_pipeline_delete ("test_import"), 0);
+
+  /* Invalid parameters */
+  EXPECT_EQ (svcdb_import (0U, configs, app_infos, NULL), -EINVAL);
+  EXPECT_EQ (svcdb_import (1U, NULL, app_infos, NULL), -EINVAL);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Internal function to write the string to the file.
+ */
+static gboolean
+_write_string (int fd, const gchar *str)
+{
+  gsize len = strlen (str);
+
+  return (write (fd, str, len) == (ssize_t) len);
+}
+
+/**
+ * @brief Internal function to generate the configuration file with the models and a resource with the paths.
+ * @param[in] tail The string appended after the configuration. NULL to append nothing.
+ * @return The file descriptor of the configuration file, which is removed at the close. -1 if it fails.
+ */
+static int
+_generate_config_file (const guint num_models, const guint num_paths, const gchar *tail)
+{
+  g_autofree gchar *path = NULL;
+  gboolean written;
+  guint i;
+  int fd = g_file_open_tmp ("unittest-config-XXXXXX.json", &path, NULL);
+
+  if (fd < 0)
+    return -1;
+
+  g_remove (path);
+
+  written = _write_string (fd, "{\n  \"models\" : [\n");
+  for (i = 0; written && i < num_models; i++) {
+    g_autofree gchar *entry = g_strdup_printf (
+        "%s    { \"name\" : \"test_large_%u\", \"model\" : \"\\/path\\/to\\/large_%u.tflite\" }",
+        (i > 0) ? ",\n" : "", i, i);
+    written = _write_string (fd, entry);
+  }
+
+  /* The name of the resource is after its paths. */
+  written = written && _write_string (fd, "\n  ],\n  \"resources\" : {\n    \"path\" : [\n");
+  for (i = 0; written && i < num_paths; i++) {
+    g_autofree gchar *entry = g_strdup_printf (
+        "%s      \"\\/path\\/to\\/large_%05u.dat\"", (i > 0) ? ",\n" : "", i);
+    written = _write_string (fd, entry);
+  }
+
+  written = written && _write_string (fd, "\n    ],\n    \"name\" : \"test_large\"\n  }\n}\n");
+  written = written && (!tail || _write_string (fd, tail));
+
+  if (!written) {
+    close (fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+/**
+ * @brief Internal function to get the length of the JSON array.
+ */
+static guint
+_get_array_length (const gchar *json)
+{
+  g_autoptr (JsonParser) parser = json_parser_new ();
+  JsonNode *root;
+
+  if (!json || !json_parser_load_from_data (parser, json, -1, NULL)
+      || !(root = json_parser_get_root (parser)) || !JSON_NODE_HOLDS_ARRAY (root))
+    return 0U;
+
+  return json_array_get_length (json_node_get_array (root));
+}
+
+/**
+ * @brief Test for service-db util. Install the large configuration file read in the chunks.
+ */
+TEST (serviceDBUtil, install_from_fd)
+{
+  const guint num_models = 100U;
+  const guint num_paths = 20000U;
+  gint ret;
+  guint i;
+  gchar *models = NULL;
+  gchar *info = NULL;
+  int fd;
+
+  fd = _generate_config_file (num_models, num_paths, NULL);
+  ASSERT_GE (fd, 0);
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  ret = svcdb_install_from_fd (fd, "", &models);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (_get_array_length (models), num_models);
+  g_free (models);
+  close (fd);
+
+  ret = svcdb_model_get ("test_large_99", 1U, &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_TRUE (strstr (info, "/path/to/large_99.tflite") != NULL);
+  g_free (info);
+
+  ret = svcdb_resource_get ("test_large", &info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (_get_array_length (info), num_paths);
+  EXPECT_TRUE (strstr (info, "/path/to/large_19999.dat") != NULL);
+  g_free (info);
+
+  for (i = 0; i < num_models; i++) {
+    g_autofree gchar *name = g_strdup_printf ("test_large_%u", i);
+    EXPECT_EQ (svcdb_model_delete (name, 0U, TRUE), 0);
+  }
+  EXPECT_EQ (svcdb_resource_delete ("test_large"), 0);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Negative test for service-db util. The invalid configuration file is rolled back after the entries are installed.
+ */
+TEST (serviceDBUtil, install_from_fd_n)
+{
+  gchar *models = NULL;
+  gchar *info = NULL;
+  int fd;
+
+  /* The error is found after all entries are read. */
+  fd = _generate_config_file (10U, 5000U, "}");
+  ASSERT_GE (fd, 0);
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  EXPECT_EQ (svcdb_install_from_fd (fd, "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_upgrade_from_fd (fd, "{\"pkg_id\":\"test\"}", &models), -EINVAL);
+  EXPECT_TRUE (models == NULL);
+  EXPECT_NE (svcdb_model_get ("test_large_0", 0U, &info), 0);
+  EXPECT_NE (svcdb_resource_get ("test_large", &info), 0);
+  EXPECT_TRUE (info == NULL);
+  close (fd);
+
+  /* Invalid parameters */
+  EXPECT_EQ (svcdb_install_from_fd (-1, "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_upgrade_from_fd (-1, "{\"pkg_id\":\"test\"}", &models), -EINVAL);
+  EXPECT_TRUE (models == NULL);
+
+  svcdb_finalize ();
+}
+
+/**
+ * @brief Negative test for service-db util. Invalid param case.
+ */
+TEST (serviceDBUtil, install_n)
+{
+  gchar *models = NULL;
+
+  svcdb_initialize (TEST_DB_PATH);
+
+  EXPECT_EQ (svcdb_install (NULL, "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_install ("", "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_install ("[]", "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_install ("{\"model\":{\"name\":\"test\"}}", "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_install ("{\"unknown\":{\"name\":\"test\"}}", "", &models), -EINVAL);
+  EXPECT_EQ (svcdb_install ("{}", "", NULL), -EINVAL);
+  EXPECT_TRUE (models == NULL);
+
+  svcdb_finalize ();
+}
+
 /**
  * @brief Negative test for service-db util. Invalid param case.
  */
@@ -0,0 +1,78 @@
+/**
+ * @file        unittest_startup_profile.cc
+ * @date        18 Oct 2026
+ * @brief       Unit test for the timing of the startup phases
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ */
+
+#include <gtest/gtest.h>
+#include <glib.h>
+
+#include "log.h"
+#include "startup-profile.h"
+
+/**
+ * @brief Test the phases are recorded in order and reported as JSON.
+ */
+TEST (StartupProfile, phases)
+{
+  g_autofree gchar *json = NULL;
+  gint64 start;
+
+  startup_profile_begin ();
+
+  start = g_get_monotonic_time ();
+  g_usleep (1000);
+  startup_profile_add ("first", start);
+  startup_profile_add ("second", g_get_monotonic_time ());
+  startup_profile_ready ();
+
+  json = startup_profile_get_json ();
+  EXPECT_TRUE (g_str_has_prefix (json, "{\"ready_us\":"));
+  EXPECT_FALSE (g_str_has_prefix (json, "{\"ready_us\":0,"));
+  EXPECT_TRUE (g_strstr_len (json, -1, "{\"name\":\"first\",\"start_us\":") != NULL);
+  EXPECT_TRUE (g_strstr_len (json, -1, "\"second\"") > g_strstr_len (json, -1, "\"first\""));
+  EXPECT_TRUE (g_str_has_suffix (json, "}]}"));
+
+  startup_profile_reset ();
+}
+
+/**
+ * @brief Test the phases are not recorded without the profile.
+ */
+TEST (StartupProfile, notStarted_n)
+{
+  g_autofree gchar *json = NULL;
+
+  startup_profile_reset ();
+  startup_profile_add ("ignored", g_get_monotonic_time ());
+  startup_profile_ready ();
+
+  json = startup_profile_get_json ();
+  EXPECT_STREQ (json, "{\"ready_us\":0,\"phases\":[]}");
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    ml_logw ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    ml_logw ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
@@ -0,0 +1,363 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * NNStreamer API / Machine Learning Agent Daemon
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd. All Rights Reserved.
+ */
+/**
+ * @file        benchmark_mlops_plugin_parser.cc
+ * @date        18 Oct 2026
+ * @brief       Benchmark of the MLOps plugin parser with the synthetic packages.
+ * @see         https://github.com/nnstreamer/deviceMLOps.MLAgent
+ * @author      agent <agent@local>
+ * @bug         No known bugs
+ *
+ * This file generates the rpk_config.json files with N models and M resource paths, and runs the
+ * install, upgrade and uninstall entry points of the plugin parser against the daemon hosted by GTestDBus.
+ * The pkgmgr-info functions are replaced with the stubs returning the generated packages.
+ * It reports the wall time, the D-Bus round trips to the daemon and the DB commits per package.
+ * The commits are read from the file change counter of the DB, which the test daemon opens in the current directory.
+ */
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <glib.h>
+#include <gmodule.h>
+#include <gio/gio.h>
+#include <json-glib/json-glib.h>
+
+#include <mlops-agent-interface.h>
+#include <pkgmgr-info.h>
+
+#include "dbus-interface.h"
+
+/**
+ * @brief The root directory of the generated packages.
+ */
+static gchar *bench_dir = NULL;
+
+/**
+ * @brief The number of the method calls to the daemon.
+ */
+static gint round_trips = 0;
+
+static gchar bench_pkg_type[] = "rpk";
+static gchar bench_res_type[] = "bench-res";
+static gchar bench_res_version[] = "1.0.0";
+
+/**
+ * @brief The package information of the stubs.
+ */
+typedef struct {
+  gchar *root_path;
+} bench_pkginfo_s;
+
+/**
+ * @brief Stub for pkgmgrinfo_pkginfo_get_pkginfo, the root path of the package is in the benchmark directory.
+ */
+extern "C" int
+pkgmgrinfo_pkginfo_get_pkginfo (const char *pkgid, pkgmgrinfo_pkginfo_h *handle)
+{
+  bench_pkginfo_s *info = g_new0 (bench_pkginfo_s, 1);
+
+  info->root_path = g_build_filename (bench_dir, pkgid, NULL);
+  *handle = (pkgmgrinfo_pkginfo_h) info;
+
+  return PMINFO_R_OK;
+}
+
+/**
+ * @brief Stub for pkgmgrinfo_pkginfo_destroy_pkginfo
+ */
+extern "C" int
+pkgmgrinfo_pkginfo_destroy_pkginfo (pkgmgrinfo_pkginfo_h handle)
+{
+  bench_pkginfo_s *info = (bench_pkginfo_s *) handle;
+
+  g_free (info->root_path);
+  g_free (info);
+
+  return PMINFO_R_OK;
+}
+
+/**
+ * @brief Stub for pkgmgrinfo_pkginfo_get_type
+ */
+extern "C" int
+pkgmgrinfo_pkginfo_get_type (pkgmgrinfo_pkginfo_h handle, char **type)
+{
+  *type = bench_pkg_type;
+  return PMINFO_R_OK;
+}
+
+/**
+ * @brief Stub for pkgmgrinfo_pkginfo_get_root_path
+ */
+extern "C" int
+pkgmgrinfo_pkginfo_get_root_path (pkgmgrinfo_pkginfo_h handle, char **root_path)
+{
+  *root_path = ((bench_pkginfo_s *) handle)->root_path;
+  return PMINFO_R_OK;
+}
+
+/**
+ * @brief Stub for pkgmgrinfo_pkginfo_get_res_type
+ */
+extern "C" int
+pkgmgrinfo_pkginfo_get_res_type (pkgmgrinfo_pkginfo_h handle, char **res_type)
+{
+  *res_type = bench_res_type;
+  return PMINFO_R_OK;
+}
+
+/**
+ * @brief Stub for pkgmgrinfo_pkginfo_get_res_version
+ */
+extern "C" int
+pkgmgrinfo_pkginfo_get_res_version (pkgmgrinfo_pkginfo_h handle, char **res_version)
+{
+  *res_version = bench_res_version;
+  return PMINFO_R_OK;
+}
+
+/**
+ * @brief Count the method calls to the daemon on the connection of the clients.
+ */
+static GDBusMessage *
+_count_round_trip (GDBusConnection *connection, GDBusMessage *message,
+    gboolean incoming, gpointer user_data)
+{
+  if (!incoming && g_dbus_message_get_message_type (message) == G_DBUS_MESSAGE_TYPE_METHOD_CALL
+      && g_strcmp0 (g_dbus_message_get_destination (message), DBUS_ML_BUS_NAME) == 0)
+    g_atomic_int_inc (&round_trips);
+
+  return message;
+}
+
+/**
+ * @brief Get the number of the commits of the daemon. -1 if it fails.
+ * @details The file change counter at the offset 24 of the header is incremented by every write transaction in the rollback journal mode.
+ */
+static gint64
+_get_commits (void)
+{
+  g_autofree gchar *current_dir = g_get_current_dir ();
+  g_autofree gchar *db_path = g_build_filename (current_dir, ".ml-service.db", NULL);
+  guint8 counter[4];
+  ssize_t len;
+  int fd;
+
+  /* The daemon is not activated yet. */
+  fd = open (db_path, O_RDONLY);
+  if (fd < 0)
+    return (errno == ENOENT) ? 0 : -1;
+
+  len = pread (fd, counter, sizeof (counter), 24);
+  close (fd);
+
+  if (len != (ssize_t) sizeof (counter))
+    return -1;
+
+  return ((gint64) counter[0] << 24) | ((gint64) counter[1] << 16) | ((gint64) counter[2] << 8) | counter[3];
+}
+
+/**
+ * @brief Generate the package with the models, the resource paths and a pipeline.
+ */
+static gboolean
+_generate_package (const gchar *pkgid, guint num_models, guint num_paths)
+{
+  g_autofree gchar *root = g_build_filename (bench_dir, pkgid, NULL);
+  g_autofree gchar *config_dir = g_build_filename (root, "res", "global", bench_res_type, NULL);
+  g_autofree gchar *config_path = g_build_filename (config_dir, "rpk_config.json", NULL);
+  g_autofree gchar *contents = NULL;
+  g_autoptr (JsonBuilder) builder = json_builder_new ();
+  g_autoptr (JsonGenerator) gen = json_generator_new ();
+  g_autoptr (JsonNode) node = NULL;
+  guint i;
+
+  if (g_mkdir_with_parents (config_dir, 0755) != 0)
+    return FALSE;
+
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "models");
+  json_builder_begin_array (builder);
+  for (i = 0; i < num_models; i++) {
+    g_autofree gchar *name = g_strdup_printf ("%s_model_%u", pkgid, i);
+    g_autofree gchar *model = g_strdup_printf ("%s/%s.tflite", config_dir, name);
+
+    /* The model files are different, so that they are stored and hashed separately. */
+    if (!g_file_set_contents (model, name, -1, NULL))
+      return FALSE;
+
+    json_builder_begin_object (builder);
+    json_builder_set_member_name (builder, "name");
+    json_builder_add_string_value (builder, name);
+    json_builder_set_member_name (builder, "model");
+    json_builder_add_string_value (builder, model);
+    json_builder_set_member_name (builder, "activate");
+    json_builder_add_string_value (builder, "true");
+    json_builder_end_object (builder);
+  }
+  json_builder_end_array (builder);
+
+  json_builder_set_member_name (builder, "resources");
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "name");
+  json_builder_add_string_value (builder, pkgid);
+  json_builder_set_member_name (builder, "path");
+  json_builder_begin_array (builder);
+  for (i = 0; i < num_paths; i++) {
+    g_autofree gchar *path = g_strdup_printf ("%s/resource_%u.dat", config_dir, i);
+
+    json_builder_add_string_value (builder, path);
+  }
+  json_builder_end_array (builder);
+  json_builder_end_object (builder);
+
+  json_builder_set_member_name (builder, "pipelines");
+  json_builder_begin_object (builder);
+  json_builder_set_member_name (builder, "name");
+  json_builder_add_string_value (builder, pkgid);
+  json_builder_set_member_name (builder, "pipeline");
+  json_builder_add_string_value (builder, "videotestsrc ! fakesink");
+  json_builder_end_object (builder);
+
+  json_builder_end_object (builder);
+
+  node = json_builder_get_root (builder);
+  json_generator_set_root (gen, node);
+  contents = json_generator_to_data (gen, NULL);
+
+  return g_file_set_contents (config_path, contents, -1, NULL);
+}
+
+/**
+ * @brief Run the entry point for all packages, and print the costs per package.
+ */
+static gboolean
+_run_phase (GModule *module, const gchar *func, guint num_packages)
+{
+  int (*func_ptr) (const char *, const char *, GList *);
+  gint64 start, elapsed, commits;
+  guint i;
+  gint trips;
+
+  if (!g_module_symbol (module, func, (gpointer *) &func_ptr)) {
+    g_printerr ("Failed to get symbol %s\n", func);
+    return FALSE;
+  }
+
+  commits = _get_commits ();
+  g_atomic_int_set (&round_trips, 0);
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < num_packages; i++) {
+    g_autofree gchar *pkgid = g_strdup_printf ("bench_pkg_%u", i);
+
+    if (func_ptr (pkgid, "bench_app", NULL) != 0) {
+      g_printerr ("Failed to run %s for the package %s\n", func, pkgid);
+      return FALSE;
+    }
+  }
+
+  elapsed = g_get_monotonic_time () - start;
+  trips = g_atomic_int_get (&round_trips);
+  commits = _get_commits () - commits;
+
+  g_print ("%-32s %12.3f %12.1f %12.1f\n", func, elapsed / 1000.0 / num_packages,
+      (gdouble) trips / num_packages, (gdouble) commits / num_packages);
+
+  return TRUE;
+}
+
+/**
+ * @brief Main function of the benchmark.
+ */
+int
+main (int argc, char **argv)
+{
+  static guint num_models = 20U;
+  static guint num_paths = 200U;
+  static guint num_packages = 5U;
+  static GOptionEntry entries[] = {
+    { "models", 'n', 0, G_OPTION_ARG_INT, &num_models, "The number of the models in a package", "N" },
+    { "paths", 'm', 0, G_OPTION_ARG_INT, &num_paths, "The number of the resource paths in a package", "M" },
+    { "packages", 'p', 0, G_OPTION_ARG_INT, &num_packages, "The number of the packages", "P" },
+    { NULL }
+  };
+  g_autoptr (GOptionContext) context = g_option_context_new ("- benchmark of the plugin parser");
+  g_autoptr (GError) err = NULL;
+  g_autoptr (GTestDBus) dbus = NULL;
+  g_autoptr (GDBusConnection) conn = NULL;
+  g_autofree gchar *current_dir = g_get_current_dir ();
+  g_autofree gchar *services_dir = g_build_filename (current_dir, "tests", "services", NULL);
+  g_autofree gchar *cmd = NULL;
+  GModule *module = NULL;
+  gboolean ret = FALSE;
+  guint i;
+
+  g_option_context_add_main_entries (context, entries, NULL);
+  if (!g_option_context_parse (context, &argc, &argv, &err)) {
+    g_printerr ("Fail to option parsing: %s\n", err->message);
+    return 1;
+  }
+
+  if (num_packages == 0U) {
+    g_printerr ("The number of the packages should be positive.\n");
+    return 1;
+  }
+
+  bench_dir = g_dir_make_tmp ("mlagent-bench-XXXXXX", NULL);
+  if (!bench_dir)
+    return 1;
+
+  for (i = 0; i < num_packages; i++) {
+    g_autofree gchar *pkgid = g_strdup_printf ("bench_pkg_%u", i);
+
+    if (!_generate_package (pkgid, num_models, num_paths)) {
+      g_printerr ("Failed to generate the package %s\n", pkgid);
+      goto done;
+    }
+  }
+
+  dbus = g_test_dbus_new (G_TEST_DBUS_NONE);
+  g_test_dbus_add_service_dir (dbus, services_dir);
+  g_test_dbus_up (dbus);
+
+  /* The proxies of the clients share the connection of the session bus. */
+  conn = g_bus_get_sync (G_BUS_TYPE_SESSION, NULL, &err);
+  if (!conn) {
+    g_printerr ("Failed to get the session bus: %s\n", err ? err->message : "Unknown error");
+    goto done;
+  }
+  g_dbus_connection_add_filter (conn, _count_round_trip, NULL, NULL);
+
+  module = g_module_open ("plugin-parser/libmlops-plugin-parser.so", (GModuleFlags) G_MODULE_BIND_LAZY);
+  if (!module) {
+    g_printerr ("Failed to open the plugin parser: %s\n", g_module_error ());
+    goto done;
+  }
+
+  g_print ("%u packages with %u models and %u resource paths each\n", num_packages, num_models, num_paths);
+  g_print ("%-32s %12s %12s %12s\n", "entry point (per package)", "wall (ms)", "round trips", "commits");
+
+  ret = _run_phase (module, "PKGMGR_MDPARSER_PLUGIN_INSTALL", num_packages)
+        && _run_phase (module, "PKGMGR_MDPARSER_PLUGIN_UPGRADE", num_packages)
+        && _run_phase (module, "PKGMGR_MDPARSER_PLUGIN_UNINSTALL", num_packages);
+
+done:
+  if (module)
+    g_module_close (module);
+
+  g_clear_object (&conn);
+  if (dbus)
+    g_test_dbus_down (dbus);
+
+  cmd = g_strdup_printf ("rm -rf %s", bench_dir);
+  if (system (cmd) != 0)
+    g_printerr ("Failed to remove %s\n", bench_dir);
+  g_free (bench_dir);
+
+  return ret ? 0 : 1;
+}
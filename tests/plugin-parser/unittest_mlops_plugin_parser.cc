@@ -454,6 +454,46 @@ TEST_F (PkgMgrInfoMockTestFixture, rpk_install7_n)
     g_printerr ("Error removing file: %s\n", g_strerror (errno));
     ASSERT_TRUE (false);
   }
+
+  /* test 5 : the second resource has no path */
+  const gchar *json_with_no_path_resource = R""""(
+{
+  "resources" : [
+    {
+      "name" : "resource_00",
+      "path" : [ "resource_00.dat" ]
+    },
+    {
+      "name" : "resource_01",
+      "path" : [ ]
+    }
+  ]
+}
+)"""";
+  ASSERT_TRUE (create_and_set_file (config_file_path, json_with_no_path_resource));
+  EXPECT_NE (exec_plugin_parser_func ("PKGMGR_MDPARSER_PLUGIN_INSTALL", pkgid, appid, NULL), 0);
+
+  if (g_remove (config_file_path) != 0) {
+    g_printerr ("Error removing file: %s\n", g_strerror (errno));
+    ASSERT_TRUE (false);
+  }
+
+  /* test 6 : trailing characters after the top object */
+  const gchar *json_with_trailing = R""""(
+{
+  "models" : {
+    "name" : "model_00",
+    "model" : "dummy-global.tflite"
+  }
+} }
+)"""";
+  ASSERT_TRUE (create_and_set_file (config_file_path, json_with_trailing));
+  EXPECT_NE (exec_plugin_parser_func ("PKGMGR_MDPARSER_PLUGIN_INSTALL", pkgid, appid, NULL), 0);
+
+  if (g_remove (config_file_path) != 0) {
+    g_printerr ("Error removing file: %s\n", g_strerror (errno));
+    ASSERT_TRUE (false);
+  }
 }
 
 /**